@@ -90,6 +90,9 @@ Bool TAppDecCfg::parseCfg( Int argc, Char* argv[] )
   ("ForceDecodeBitDepth",       m_forceDecodeBitDepth,                 0U,         "Force the decoder to operate at a particular bit-depth (best effort decoding)")
 #endif
   ("OutputDecodedSEIMessagesFilename",  m_outputDecodedSEIMessagesFilename,    string(""), "When non empty, output decoded SEI messages to the indicated file. If file is '-', then output to stdout\n")
+  ("Threads",                   m_numThreads,                          1,          "Number of threads of the thread pool shared by the decoder stages")
+  ("FrameThreads",              m_numFrameThreads,                     1,          "Number of pictures decoded concurrently by the thread pool (requires Threads > 1)")
+  ("SIMD",                      m_simdLevel,                          -1,          "Instruction set of the SIMD kernels: -1 = highest supported by the CPU, 0 = none (C++ only), 1 = SSE4.1, 2 = AVX2, 3 = AVX-512")
   ;
 
   po::setDefaults(opts);
@@ -113,6 +116,24 @@ Bool TAppDecCfg::parseCfg( Int argc, Char* argv[] )
     return false;
   }
 
+  if (m_numThreads < 1)
+  {
+    fprintf(stderr, "Threads must be at least 1\n");
+    return false;
+  }
+
+  if (m_numFrameThreads < 1)
+  {
+    fprintf(stderr, "FrameThreads must be at least 1\n");
+    return false;
+  }
+
+  if (m_simdLevel < -1 || m_simdLevel > 3)
+  {
+    fprintf(stderr, "SIMD must be in the range -1 to 3\n");
+    return false;
+  }
+
   /* convert std::string to c string for compatability */
   m_pchBitstreamFile = cfg_BitstreamFile.empty() ? NULL : strdup(cfg_BitstreamFile.c_str());
   m_pchReconFile = cfg_ReconFile.empty() ? NULL : strdup(cfg_ReconFile.c_str());
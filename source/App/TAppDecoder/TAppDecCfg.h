@@ -71,6 +71,9 @@ protected:
   UInt          m_forceDecodeBitDepth;                ///< if non-zero, force the bit depth at the decoder (best effort decoding)
 #endif
   std::string   m_outputDecodedSEIMessagesFilename;   ///< filename to output decoded SEI messages to. If '-', then use stdout. If empty, do not output details.
+  Int           m_numThreads;                         ///< number of threads used by the decoder
+  Int           m_numFrameThreads;                    ///< number of pictures decoded concurrently
+  Int           m_simdLevel;                          ///< instruction set of the SIMD kernels, -1 for the highest supported one
 
 public:
   TAppDecCfg()
@@ -85,6 +88,9 @@ public:
 #if O0043_BEST_EFFORT_DECODING
   , m_forceDecodeBitDepth(0)
 #endif
+  , m_numThreads(1)
+  , m_numFrameThreads(1)
+  , m_simdLevel(-1)
   {
     for (UInt channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
       m_outputBitDepth[channelTypeIndex] = 0;
@@ -219,6 +219,7 @@ Void TAppDecTop::decode()
       }
       if ( (bNewPicture || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA) && m_cTDecTop.getNoOutputPriorPicsFlag() )
       {
+        m_cTDecTop.finishPictures();
         m_cTDecTop.checkNoOutputPriorPics( pcListPic );
         m_cTDecTop.setNoOutputPriorPicsFlag (false);
       }
@@ -229,10 +230,12 @@ Void TAppDecTop::decode()
             || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_RADL
             || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_LP ) )
       {
+        m_cTDecTop.finishPictures();
         xFlushOutput( pcListPic );
       }
       if (nalu.m_nalUnitType == NAL_UNIT_EOS)
       {
+        m_cTDecTop.finishPictures();
         xWriteOutput( pcListPic, nalu.m_temporalId );
         m_cTDecTop.setFirstSliceInPicture (false);
       }
@@ -244,6 +247,7 @@ Void TAppDecTop::decode()
     }
   }
 
+  m_cTDecTop.finishPictures();
   xFlushOutput( pcListPic );
   // delete buffers
   m_cTDecTop.deletePicBuffer();
@@ -276,6 +280,9 @@ Void TAppDecTop::xDestroyDecLib()
 Void TAppDecTop::xInitDecLib()
 {
   // initialize decoder class
+  m_cTDecTop.setNumThreads(m_numThreads);
+  m_cTDecTop.setNumFrameThreads(m_numFrameThreads);
+  m_cTDecTop.setSimdLevel(m_simdLevel);
   m_cTDecTop.init();
   m_cTDecTop.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
 #if O0043_BEST_EFFORT_DECODING
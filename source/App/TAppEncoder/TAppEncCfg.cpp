@@ -105,6 +105,7 @@ TAppEncCfg::TAppEncCfg()
 , m_snrInternalColourSpace(false)
 , m_outputInternalColourSpace(false)
 , m_pchdQPFile()
+, m_pchSBDShadowFile()
 , m_scalingListFile()
 {
   m_aidQP = NULL;
@@ -140,6 +141,7 @@ TAppEncCfg::~TAppEncCfg()
   free(m_pchReconFile);
   free(m_pchdQPFile);
   free(m_scalingListFile);
+  free(m_pchSBDShadowFile);
 }
 
 Void TAppEncCfg::create()
@@ -629,6 +631,7 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   string cfg_ReconFile;
   string cfg_dQPFile;
   string cfg_ScalingListFile;
+  string cfg_SBDShadowFile;
 
   Int tmpChromaFormat;
   Int tmpInputChromaFormat;
@@ -854,6 +857,10 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   ("TileRowHeightArray",                              cfg_RowHeight,                            cfg_RowHeight, "Array containing tile row height values in units of CTU")
   ("LFCrossTileBoundaryFlag",                         m_bLFCrossTileBoundaryFlag,                        true, "1: cross-tile-boundary loop filtering. 0:non-cross-tile-boundary loop filtering")
   ("WaveFrontSynchro",                                m_iWaveFrontSynchro,                                  0, "0: no synchro; 1 synchro with top-right-right")
+  ("Threads",                                         m_numThreads,                                         1, "Number of threads of the thread pool shared by the encoder stages (CTU rows, tiles, pictures, loop filters)")
+  ("FrameThreads",                                    m_numFrameThreads,                                    1, "Number of pictures of a GOP compressed in parallel (requires Threads > 1)")
+  ("IncrementalLoopFilter",                           m_bIncrementalLoopFilter,                         false, "Deblock and collect SAO statistics CTU row by row while the picture is compressed")
+  ("SIMD",                                            m_simdLevel,                                         -1, "Instruction set of the SIMD kernels: -1 = highest supported by the CPU, 0 = none (C++ only), 1 = SSE4.1, 2 = AVX2, 3 = AVX-512")
   ("ScalingList",                                     m_useScalingListId,                    SCALING_LIST_OFF, "0/off: no scaling list, 1/default: default scaling lists, 2/file: scaling lists specified in ScalingListFile")
   ("ScalingListFile",                                 cfg_ScalingListFile,                         string(""), "Scaling list file name. Use an empty string to produce help.")
   ("SignHideFlag,-SBH",                               m_signHideFlag,                                       1)
@@ -867,8 +874,19 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   ("SEIpictureDigest",                                m_decodedPictureHashSEIEnabled,                       0, "deprecated alias for SEIDecodedPictureHash")
   ("TMVPMode",                                        m_TMVPModeId,                                         1, "TMVP mode 0: TMVP disable for all slices. 1: TMVP enable for all slices (default) 2: TMVP enable for certain slices only")
   ("RRSP",                                            m_bUseReducedRegionSimilarityPartitioning,        false, "Reduced Region Similarity Partitioning")
+  ("RRSP16x16",                                       m_bUseRRSP16x16,                                  false, "RRSP: also decide from the neighbour and colocated CUs whether the 8x8 CUs of each 16x16 CU are evaluated")
   ("SBD",                                             m_bUseSimilarityBasedDecision,                    false, "Similarity Based Fast Coding Unit Depth Algorithm by R. Fan")
   ("DER",                                             m_uiR,                                               8u, "Depth Extraction Region for SBD by R. Fan")
+  ("SBDColocatedRef",                                 m_SBDColocatedRef,                                    0, "Reference picture of the colocated CTU of SBD and RRSP\n"
+                                                                                                               "\t0: first picture of reference picture list 0\n"
+                                                                                                               "\t1: picture nearest in POC\n"
+                                                                                                               "\t2: picture nearest in POC among those nearest in temporal layer")
+  ("SBDColocatedMerge",                               m_bSBDColocatedMerge,                             false, "SBD: merge the depths of the colocated CTUs selected in both reference picture lists")
+  ("SBDIntra",                                        m_bUseSBDIntra,                                   false, "Spatial-only Similarity Based Decision in intra slices")
+  ("SBDIntraHighSim",                                 m_uiSBDIntraHighSim,                                 1u, "Intra SBD: high similarity when the neighbour CTUs adopt at most this number of depths")
+  ("SBDIntraLowSim",                                  m_uiSBDIntraLowSim,                                  4u, "Intra SBD: low similarity (no restriction) when the neighbour CTUs adopt at least this number of depths")
+  ("SBDShadow",                                       m_uiSBDShadowPeriod,                                 0u, "SBD shadow mode: also compress one out of N SBD CTUs with the full depth range and compare (0: off)")
+  ("SBDShadowFile",                                   cfg_SBDShadowFile,                 string("sbd_shadow.csv"), "CSV file for the statistics of the SBD shadow mode")
   ("FEN",                                             m_bUseFastEnc,                                    false, "fast encoder setting")
   ("ECU",                                             m_bUseEarlyCU,                                    false, "Early CU setting")
   ("FDM",                                             m_useFastDecisionForMerge,                         true, "Fast decision for Merge RD Cost")
@@ -1116,6 +1134,7 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   }
 
   m_scalingListFile = cfg_ScalingListFile.empty() ? NULL : strdup(cfg_ScalingListFile.c_str());
+  m_pchSBDShadowFile = cfg_SBDShadowFile.empty() ? NULL : strdup(cfg_SBDShadowFile.c_str());
 
   /* rules for input, output and internal bitdepths as per help text */
   if (m_MSBExtendedBitDepth[CHANNEL_TYPE_LUMA  ] == 0) { m_MSBExtendedBitDepth[CHANNEL_TYPE_LUMA  ] = m_inputBitDepth      [CHANNEL_TYPE_LUMA  ]; }
@@ -2113,6 +2132,9 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_iWaveFrontSynchro < 0, "WaveFrontSynchro cannot be negative" );
   xConfirmPara( m_iWaveFrontSubstreams <= 0, "WaveFrontSubstreams must be positive" );
   xConfirmPara( m_iWaveFrontSubstreams > 1 && !m_iWaveFrontSynchro, "Must have WaveFrontSynchro > 0 in order to have WaveFrontSubstreams > 1" );
+  xConfirmPara( m_numThreads < 1, "Threads must be at least 1" );
+  xConfirmPara( m_numFrameThreads < 1, "FrameThreads must be at least 1" );
+  xConfirmPara( m_simdLevel < -1 || m_simdLevel > 3, "SIMD must be in the range -1 to 3" );
 
   xConfirmPara( m_decodedPictureHashSEIEnabled<0 || m_decodedPictureHashSEIEnabled>3, "this hash type is not correct!\n");
 
@@ -2184,6 +2206,16 @@ Void TAppEncCfg::xCheckParameter()
   {
     xConfirmPara(m_uiR != 8 && m_uiR != 16 && m_uiR != 32 && m_uiR != 64, "Depth Extracting Region (R) must be 8, 16, 32 or 64 when Similarity Based Decision (SBD) is turned on");
   }
+  xConfirmPara(m_uiSBDShadowPeriod > 0 && !m_bUseSimilarityBasedDecision, "SBDShadow requires Similarity Based Decision (SBD) to be turned on");
+  xConfirmPara(m_bUseRRSP16x16 && !m_bUseReducedRegionSimilarityPartitioning, "RRSP16x16 requires Reduced Region Similarity Partitioning (RRSP) to be turned on");
+  xConfirmPara((m_bUseReducedRegionSimilarityPartitioning || m_bUseRRSP16x16) && (m_uiMaxCUWidth != 64 || m_uiMaxCUHeight != 64), "Reduced Region Similarity Partitioning (RRSP) requires a CTU size of 64x64");
+  xConfirmPara(m_SBDColocatedRef < 0 || m_SBDColocatedRef > 2, "SBDColocatedRef must be in the range 0 to 2");
+  if (m_bUseSBDIntra)
+  {
+    xConfirmPara(!m_bUseSimilarityBasedDecision, "SBDIntra requires Similarity Based Decision (SBD) to be turned on");
+    xConfirmPara(m_uiSBDIntraHighSim < 1, "SBDIntraHighSim must be at least 1");
+    xConfirmPara(m_uiSBDIntraLowSim <= m_uiSBDIntraHighSim, "SBDIntraLowSim must be larger than SBDIntraHighSim");
+  }
 
 #undef xConfirmPara
   if (check_failed)
@@ -2349,8 +2381,13 @@ Void TAppEncCfg::xPrintParameter()
   printf("SQP:%d ", m_uiDeltaQpRD         );
   printf("ASR:%d ", m_bUseASR             );
   printf("RRSP:%d ", m_bUseReducedRegionSimilarityPartitioning);
+  printf("RRSP16x16:%d ", m_bUseRRSP16x16);
   printf("SBD:%d ", m_bUseSimilarityBasedDecision);
   printf("DER:%d ", m_uiR                 );
+  printf("SBDShadow:%d ", m_uiSBDShadowPeriod);
+  printf("SBDIntra:%d ", m_bUseSBDIntra   );
+  printf("SBDColRef:%d ", m_SBDColocatedRef);
+  printf("SBDColMerge:%d ", m_bSBDColocatedMerge);
   printf("FEN:%d ", m_bUseFastEnc         );
   printf("ECU:%d ", m_bUseEarlyCU         );
   printf("FDM:%d ", m_useFastDecisionForMerge );
@@ -2388,6 +2425,7 @@ Void TAppEncCfg::xPrintParameter()
   printf("PME:%d ", m_log2ParallelMergeLevel);
   printf(" WaveFrontSynchro:%d WaveFrontSubstreams:%d",
           m_iWaveFrontSynchro, m_iWaveFrontSubstreams);
+  printf(" Threads:%d FrameThreads:%d IncLF:%d SIMD:%d", m_numThreads, m_numFrameThreads, m_bIncrementalLoopFilter, m_simdLevel);
   printf(" ScalingList:%d ", m_useScalingListId );
   printf("TMVPMode:%d ", m_TMVPModeId     );
 #if ADAPTIVE_QP_SELECTION
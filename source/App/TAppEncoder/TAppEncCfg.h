@@ -200,8 +200,16 @@ protected:
   Int       m_iSearchRange;                                   ///< ME search range
   Int       m_bipredSearchRange;                              ///< ME search range for bipred refinement
   Bool      m_bUseReducedRegionSimilarityPartitioning;        ///< flag for using Reduced Region Similarity Partitioning
+  Bool      m_bUseRRSP16x16;                                  ///< flag for applying RRSP again to the 16x16 CUs, to decide whether their 8x8 CUs are evaluated
   Bool      m_bUseSimilarityBasedDecision;                    ///< flag for using Similarity Based Decision Algorithm by R. Fan
   UInt      m_uiR;                                            ///< Extraction Region for SBD by R. Fan
+  Int       m_SBDColocatedRef;                                ///< reference picture of the colocated CTU of SBD and RRSP (0: first of list 0, 1: nearest POC, 2: same temporal layer)
+  Bool      m_bSBDColocatedMerge;                             ///< SBD: merge the depths of the colocated CTUs of both reference picture lists
+  Bool      m_bUseSBDIntra;                                   ///< flag for using the spatial-only SBD in intra slices
+  UInt      m_uiSBDIntraHighSim;                              ///< intra SBD: high similarity up to this number of depths adopted by the neighbours
+  UInt      m_uiSBDIntraLowSim;                               ///< intra SBD: low similarity from this number of depths adopted by the neighbours
+  UInt      m_uiSBDShadowPeriod;                              ///< SBD shadow mode: one out of this many SBD CTUs is also compressed with the full depth range (0: off)
+  Char*     m_pchSBDShadowFile;                               ///< CSV file for the statistics of the SBD shadow mode
   Bool      m_bUseFastEnc;                                    ///< flag for using fast encoder setting
   Bool      m_bUseEarlyCU;                                    ///< flag for using Early CU setting
   Bool      m_useFastDecisionForMerge;                        ///< flag for using Fast Decision Merge RD-Cost
@@ -224,6 +232,10 @@ protected:
   Int       m_iWaveFrontSynchro; //< 0: no WPP. >= 1: WPP is enabled, the "Top right" from which inheritance occurs is this LCU offset in the line above the current.
   Int       m_iWaveFrontFlush; //< enable(1)/disable(0) the CABAC flush at the end of each line of LCUs.
   Int       m_iWaveFrontSubstreams; //< If iWaveFrontSynchro, this is the number of substreams per frame (dependent tiles) or per tile (independent tiles).
+  Int       m_numThreads;         //< number of threads used for CTU compression (1: single-threaded)
+  Int       m_numFrameThreads;    //< number of pictures of a GOP compressed in parallel (1: one picture at a time)
+  Bool      m_bIncrementalLoopFilter; //< deblock and collect SAO statistics CTU row by row while the picture is compressed
+  Int       m_simdLevel;          //< instruction set of the SIMD kernels (-1: highest supported by the CPU)
 
   Bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
 
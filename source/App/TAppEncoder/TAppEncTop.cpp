@@ -173,8 +173,16 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setQuadtreeTUMaxDepthInter                           ( m_uiQuadtreeTUMaxDepthInter );
   m_cTEncTop.setQuadtreeTUMaxDepthIntra                           ( m_uiQuadtreeTUMaxDepthIntra );
   m_cTEncTop.setUseRRSP                                           ( m_bUseReducedRegionSimilarityPartitioning );
+  m_cTEncTop.setUseRRSP16x16                                      ( m_bUseRRSP16x16 );
   m_cTEncTop.setUseSBD                                            ( m_bUseSimilarityBasedDecision );
   m_cTEncTop.setR                                                 ( m_uiR );
+  m_cTEncTop.setSBDColocatedRef                                   ( m_SBDColocatedRef );
+  m_cTEncTop.setSBDColocatedMerge                                 ( m_bSBDColocatedMerge );
+  m_cTEncTop.setUseSBDIntra                                       ( m_bUseSBDIntra );
+  m_cTEncTop.setSBDIntraHighSim                                   ( m_uiSBDIntraHighSim );
+  m_cTEncTop.setSBDIntraLowSim                                    ( m_uiSBDIntraLowSim );
+  m_cTEncTop.setSBDShadowPeriod                                   ( m_uiSBDShadowPeriod );
+  m_cTEncTop.setSBDShadowFile                                     ( m_pchSBDShadowFile );
   m_cTEncTop.setUseFastEnc                                        ( m_bUseFastEnc  );
   m_cTEncTop.setUseEarlyCU                                        ( m_bUseEarlyCU  );
   m_cTEncTop.setUseFastDecisionForMerge                           ( m_useFastDecisionForMerge  );
@@ -313,6 +321,10 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setLFCrossTileBoundaryFlag                           ( m_bLFCrossTileBoundaryFlag );
   m_cTEncTop.setWaveFrontSynchro                                  ( m_iWaveFrontSynchro );
   m_cTEncTop.setWaveFrontSubstreams                               ( m_iWaveFrontSubstreams );
+  m_cTEncTop.setNumThreads                                        ( m_numThreads );
+  m_cTEncTop.setNumFrameThreads                                   ( m_numFrameThreads );
+  m_cTEncTop.setIncrementalLoopFilter                             ( m_bIncrementalLoopFilter );
+  m_cTEncTop.setSimdLevel                                         ( m_simdLevel );
   m_cTEncTop.setTMVPModeId                                        ( m_TMVPModeId );
   m_cTEncTop.setUseScalingListId                                  ( m_useScalingListId  );
   m_cTEncTop.setScalingListFile                                   ( m_scalingListFile   );
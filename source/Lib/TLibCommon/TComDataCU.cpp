@@ -45,6 +45,7 @@
 
 #if ADAPTIVE_QP_SELECTION
   TCoeff * TComDataCU::m_pcGlbArlCoeff[MAX_NUM_COMPONENT] = { NULL, NULL, NULL };
+  UInt     TComDataCU::m_uiNumGlbArlCoeffUsers = 0;
 #endif
 
 // ====================================================================================================================
@@ -178,6 +179,10 @@ Void TComDataCU::create( ChromaFormat chromaFormatIDC, UInt uiNumPartition, UInt
         if (m_pcGlbArlCoeff[compID] == NULL) m_pcGlbArlCoeff[compID] = (TCoeff*)xMalloc(TCoeff, totalSize);
 
         m_pcArlCoeff[compID] = m_pcGlbArlCoeff[compID];
+        if (!m_ArlCoeffIsAliasedAllocation)
+        {
+          m_uiNumGlbArlCoeffUsers++;
+        }
         m_ArlCoeffIsAliasedAllocation = true;
       }
       else
@@ -260,13 +265,24 @@ Void TComDataCU::destroy()
       {
         if ( m_pcArlCoeff[comp]     ) { xFree(m_pcArlCoeff[comp]);      m_pcArlCoeff[comp]    = NULL; }
       }
-
-      if ( m_pcGlbArlCoeff[comp]  ) { xFree(m_pcGlbArlCoeff[comp]);   m_pcGlbArlCoeff[comp] = NULL; }
+      else
+      {
+        m_pcArlCoeff[comp] = NULL;
+        // other pictures (e.g. being decoded concurrently) may still use the global buffer
+        if ( m_uiNumGlbArlCoeffUsers == 1 && m_pcGlbArlCoeff[comp] ) { xFree(m_pcGlbArlCoeff[comp]);   m_pcGlbArlCoeff[comp] = NULL; }
+      }
 #endif
 
       if ( m_pcIPCMSample[comp]   ) { xFree(m_pcIPCMSample[comp]);    m_pcIPCMSample[comp]  = NULL; }
     }
     if ( m_pbIPCMFlag         ) { xFree(m_pbIPCMFlag   );       m_pbIPCMFlag        = NULL; }
+#if ADAPTIVE_QP_SELECTION
+    if ( m_ArlCoeffIsAliasedAllocation )
+    {
+      m_uiNumGlbArlCoeffUsers--;
+      m_ArlCoeffIsAliasedAllocation = false;
+    }
+#endif
 
     for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
     {
@@ -3195,7 +3211,11 @@ Bool TComDataCU::xAddMVPCandOrder( AMVPInfo* pInfo, RefPicList eRefPicList, Int
  */
 Bool TComDataCU::xGetColMVP( RefPicList eRefPicList, Int ctuRsAddr, Int uiPartUnitIdx, TComMv& rcMv, Int& riRefIdx )
 {
-  UInt uiAbsPartAddr = uiPartUnitIdx;
+  // the motion of the colocated picture is read at the first partition of its 16x16 block, which is what compressMV
+  // keeps, so the result does not depend on whether the motion of the colocated picture is compressed already
+  const Int scaleFactor   = 4 * AMVP_DECIMATION_FACTOR / m_unitSize;
+  const Int numPartsInBlk = scaleFactor > 0 ? scaleFactor * scaleFactor : 1;
+  UInt uiAbsPartAddr = ( uiPartUnitIdx / numPartsInBlk ) * numPartsInBlk;
 
   RefPicList  eColRefPicList;
   Int iColPOC, iColRefPOC, iCurrPOC, iCurrRefPOC, iScale;
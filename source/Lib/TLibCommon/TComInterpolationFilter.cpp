@@ -42,6 +42,7 @@
 
 #include "TComRom.h"
 #include "TComInterpolationFilter.h"
+#include "TComInterpolationFilterSIMD.h"
 #include <assert.h>
 
 #include "TComChromaFormat.h"
@@ -212,6 +213,23 @@ Void TComInterpolationFilter::filter(Int bitDepth, Pel const *src, Int srcStride
     maxVal = 0;
   }
 
+#if SIMD_X86
+  if ( g_simdLevel >= SIMD_SSE41 && width >= 4 )
+  {
+    // the columns up to a multiple of 4 are filtered with SIMD, the remaining ones (odd widths of the encoder's
+    // sub-pel search) below
+    const Int simdWidth = width & ~3;
+    TComInterpolationFilterSIMD::filter<N, isVertical, isLast>( g_simdLevel, src, srcStride, dst, dstStride, simdWidth, height, coeff, offset, shift, maxVal );
+    if ( simdWidth == width )
+    {
+      return;
+    }
+    src   += simdWidth;
+    dst   += simdWidth;
+    width -= simdWidth;
+  }
+#endif
+
   for (row = 0; row < height; row++)
   {
     for (col = 0; col < width; col++)
@@ -0,0 +1,245 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComInterpolationFilterSIMD.cpp
+    \brief    SIMD implementations of the interpolation filter
+*/
+
+#include "TComInterpolationFilterSIMD.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+#if SIMD_X86
+
+// ====================================================================================================================
+// Kernels
+// ====================================================================================================================
+
+// The taps are applied in pairs: the samples of two taps are interleaved and multiplied with the interleaved
+// coefficients by a multiply-add, which gives the 32-bit sums of the C++ filter for the horizontal and the vertical
+// direction alike (cStride is 1 or the source stride). The sums are rounded, shifted and packed back to 16 bits and,
+// for the last filtering operation, clipped to the sample range.
+
+/// interleaved pairs of filter coefficients, one register per pair of taps
+template<Int N>
+SIMD_TARGET_SSE41
+static inline Void xLoadCoeffPairs( const TFilterCoeff* coeff, __m128i* avCoeff )
+{
+  for ( Int k = 0; k < N; k += 2 )
+  {
+    avCoeff[k >> 1] = _mm_set1_epi32( ( coeff[k] & 0xffff ) | ( (Int)coeff[k + 1] << 16 ) );
+  }
+}
+
+/// 4 filtered samples
+template<Int N, Bool isLast>
+SIMD_TARGET_SSE41
+static inline __m128i xFilter4( const Pel* src, Int cStride, const __m128i* avCoeff, const __m128i& vOffset, const __m128i& vShift, const __m128i& vMax )
+{
+  __m128i vSum = vOffset;
+  for ( Int k = 0; k < N; k += 2 )
+  {
+    const __m128i vSrc0 = _mm_loadl_epi64( (const __m128i*)( src +  k      * cStride ) );
+    const __m128i vSrc1 = _mm_loadl_epi64( (const __m128i*)( src + (k + 1) * cStride ) );
+    vSum = _mm_add_epi32( vSum, _mm_madd_epi16( _mm_unpacklo_epi16( vSrc0, vSrc1 ), avCoeff[k >> 1] ) );
+  }
+  vSum = _mm_sra_epi32( vSum, vShift );
+  __m128i vVal = _mm_packs_epi32( vSum, vSum );
+  if ( isLast )
+  {
+    vVal = _mm_min_epi16( _mm_max_epi16( vVal, _mm_setzero_si128() ), vMax );
+  }
+  return vVal;
+}
+
+/// 8 filtered samples
+template<Int N, Bool isLast>
+SIMD_TARGET_SSE41
+static inline __m128i xFilter8( const Pel* src, Int cStride, const __m128i* avCoeff, const __m128i& vOffset, const __m128i& vShift, const __m128i& vMax )
+{
+  __m128i vSumLo = vOffset;
+  __m128i vSumHi = vOffset;
+  for ( Int k = 0; k < N; k += 2 )
+  {
+    const __m128i vSrc0 = _mm_loadu_si128( (const __m128i*)( src +  k      * cStride ) );
+    const __m128i vSrc1 = _mm_loadu_si128( (const __m128i*)( src + (k + 1) * cStride ) );
+    vSumLo = _mm_add_epi32( vSumLo, _mm_madd_epi16( _mm_unpacklo_epi16( vSrc0, vSrc1 ), avCoeff[k >> 1] ) );
+    vSumHi = _mm_add_epi32( vSumHi, _mm_madd_epi16( _mm_unpackhi_epi16( vSrc0, vSrc1 ), avCoeff[k >> 1] ) );
+  }
+  __m128i vVal = _mm_packs_epi32( _mm_sra_epi32( vSumLo, vShift ), _mm_sra_epi32( vSumHi, vShift ) );
+  if ( isLast )
+  {
+    vVal = _mm_min_epi16( _mm_max_epi16( vVal, _mm_setzero_si128() ), vMax );
+  }
+  return vVal;
+}
+
+/// 16 filtered samples; the unpacking and the packing both work within the 128-bit halves, so the samples stay in order
+template<Int N, Bool isLast>
+SIMD_TARGET_AVX2
+static inline __m256i xFilter16( const Pel* src, Int cStride, const __m256i* avCoeff, const __m256i& vOffset, const __m128i& vShift, const __m256i& vMax )
+{
+  __m256i vSumLo = vOffset;
+  __m256i vSumHi = vOffset;
+  for ( Int k = 0; k < N; k += 2 )
+  {
+    const __m256i vSrc0 = _mm256_loadu_si256( (const __m256i*)( src +  k      * cStride ) );
+    const __m256i vSrc1 = _mm256_loadu_si256( (const __m256i*)( src + (k + 1) * cStride ) );
+    vSumLo = _mm256_add_epi32( vSumLo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vSrc0, vSrc1 ), avCoeff[k >> 1] ) );
+    vSumHi = _mm256_add_epi32( vSumHi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vSrc0, vSrc1 ), avCoeff[k >> 1] ) );
+  }
+  __m256i vVal = _mm256_packs_epi32( _mm256_sra_epi32( vSumLo, vShift ), _mm256_sra_epi32( vSumHi, vShift ) );
+  if ( isLast )
+  {
+    vVal = _mm256_min_epi16( _mm256_max_epi16( vVal, _mm256_setzero_si256() ), vMax );
+  }
+  return vVal;
+}
+
+template<Int N, Bool isVertical, Bool isLast>
+SIMD_TARGET_SSE41
+static Void xFilterSse41( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal )
+{
+  const Int cStride = ( isVertical ) ? srcStride : 1;
+  __m128i avCoeff[N / 2];
+  xLoadCoeffPairs<N>( coeff, avCoeff );
+  const __m128i vOffset = _mm_set1_epi32( offset );
+  const __m128i vShift  = _mm_cvtsi32_si128( shift );
+  const __m128i vMax    = _mm_set1_epi16( maxVal );
+
+  for ( Int row = 0; row < height; row++ )
+  {
+    Int col = 0;
+    for ( ; col + 8 <= width; col += 8 )
+    {
+      _mm_storeu_si128( (__m128i*)( dst + col ), xFilter8<N, isLast>( src + col, cStride, avCoeff, vOffset, vShift, vMax ) );
+    }
+    if ( col < width )
+    {
+      _mm_storel_epi64( (__m128i*)( dst + col ), xFilter4<N, isLast>( src + col, cStride, avCoeff, vOffset, vShift, vMax ) );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template<Int N, Bool isVertical, Bool isLast>
+SIMD_TARGET_AVX2
+static Void xFilterAvx2( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal )
+{
+  const Int cStride = ( isVertical ) ? srcStride : 1;
+  __m128i avCoeff[N / 2];
+  __m256i avCoeff256[N / 2];
+  xLoadCoeffPairs<N>( coeff, avCoeff );
+  for ( Int k = 0; k < N / 2; k++ )
+  {
+    avCoeff256[k] = _mm256_broadcastsi128_si256( avCoeff[k] );
+  }
+  const __m128i vOffset    = _mm_set1_epi32( offset );
+  const __m256i vOffset256 = _mm256_set1_epi32( offset );
+  const __m128i vShift     = _mm_cvtsi32_si128( shift );
+  const __m128i vMax       = _mm_set1_epi16( maxVal );
+  const __m256i vMax256    = _mm256_set1_epi16( maxVal );
+
+  for ( Int row = 0; row < height; row++ )
+  {
+    Int col = 0;
+    for ( ; col + 16 <= width; col += 16 )
+    {
+      _mm256_storeu_si256( (__m256i*)( dst + col ), xFilter16<N, isLast>( src + col, cStride, avCoeff256, vOffset256, vShift, vMax256 ) );
+    }
+    if ( col + 8 <= width )
+    {
+      _mm_storeu_si128( (__m128i*)( dst + col ), xFilter8<N, isLast>( src + col, cStride, avCoeff, vOffset, vShift, vMax ) );
+      col += 8;
+    }
+    if ( col < width )
+    {
+      _mm_storel_epi64( (__m128i*)( dst + col ), xFilter4<N, isLast>( src + col, cStride, avCoeff, vOffset, vShift, vMax ) );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+#endif // SIMD_X86
+
+// ====================================================================================================================
+// Selection of the kernels
+// ====================================================================================================================
+
+/**
+ * \brief Apply FIR filter to a block of samples, see TComInterpolationFilter::filter
+ *
+ * \tparam N          Number of taps
+ * \tparam isVertical Flag indicating filtering along vertical direction
+ * \tparam isLast     Flag indicating whether it is the last filtering operation
+ * \param  level      Instruction set, at least SIMD_SSE41
+ * \param  src        Pointer to the source sample of the first tap
+ * \param  srcStride  Stride of source samples
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  width      Width of block, a multiple of 4
+ * \param  height     Height of block
+ * \param  coeff      Pointer to filter taps
+ * \param  offset     Rounding offset added to the sums
+ * \param  shift      Right shift of the sums
+ * \param  maxVal     Largest sample value, when isLast
+ */
+template<Int N, Bool isVertical, Bool isLast>
+Void TComInterpolationFilterSIMD::filter( SimdLevel level, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal )
+{
+  assert( ( width & 3 ) == 0 );
+#if SIMD_X86
+  if ( level >= SIMD_AVX2 )
+  {
+    xFilterAvx2<N, isVertical, isLast>( src, srcStride, dst, dstStride, width, height, coeff, offset, shift, maxVal );
+  }
+  else
+  {
+    xFilterSse41<N, isVertical, isLast>( src, srcStride, dst, dstStride, width, height, coeff, offset, shift, maxVal );
+  }
+#endif
+}
+
+template Void TComInterpolationFilterSIMD::filter<4, false, false>( SimdLevel level, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal );
+template Void TComInterpolationFilterSIMD::filter<4, false, true >( SimdLevel level, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal );
+template Void TComInterpolationFilterSIMD::filter<4, true,  false>( SimdLevel level, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal );
+template Void TComInterpolationFilterSIMD::filter<4, true,  true >( SimdLevel level, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal );
+template Void TComInterpolationFilterSIMD::filter<8, false, false>( SimdLevel level, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal );
+template Void TComInterpolationFilterSIMD::filter<8, false, true >( SimdLevel level, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal );
+template Void TComInterpolationFilterSIMD::filter<8, true,  false>( SimdLevel level, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal );
+template Void TComInterpolationFilterSIMD::filter<8, true,  true >( SimdLevel level, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal );
+
+//! \}
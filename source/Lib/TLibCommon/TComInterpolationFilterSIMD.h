@@ -0,0 +1,60 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComInterpolationFilterSIMD.h
+    \brief    SIMD implementations of the interpolation filter (header)
+*/
+
+#ifndef __TCOMINTERPOLATIONFILTERSIMD__
+#define __TCOMINTERPOLATIONFILTERSIMD__
+
+#include "TypeDef.h"
+#include "TComSimd.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Namespace definition
+// ====================================================================================================================
+
+/// SIMD implementations of TComInterpolationFilter::filter, giving the same results as the C++ one
+namespace TComInterpolationFilterSIMD
+{
+  template<Int N, Bool isVertical, Bool isLast>
+  Void filter( SimdLevel level, const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* coeff, Int offset, Int shift, Pel maxVal );
+}// END NAMESPACE DEFINITION TComInterpolationFilterSIMD
+
+//! \}
+
+#endif // __TCOMINTERPOLATIONFILTERSIMD__
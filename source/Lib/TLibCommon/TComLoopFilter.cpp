@@ -39,6 +39,7 @@
 #include "TComSlice.h"
 #include "TComMv.h"
 #include "TComTU.h"
+#include "TComLoopFilterSIMD.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -72,7 +73,11 @@ const UChar TComLoopFilter::sm_betaTable[MAX_QP + 1] =
 
 TComLoopFilter::TComLoopFilter()
 : m_uiNumPartitions(0)
+, m_uiMaxCUDepth(0)
 , m_bLFCrossTileBoundary(true)
+, m_pcThreadPool(NULL)
+, m_pcRowFilters(NULL)
+, m_iNumRowFilters(0)
 {
   for( Int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
   {
@@ -88,6 +93,13 @@ TComLoopFilter::~TComLoopFilter()
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
+/** \param iThreadIdx  thread slot, selects the filter holding the working data
+ */
+Void TComDeblockRowTask::run( Int iThreadIdx )
+{
+  m_pcLoopFilter[iThreadIdx].xDeblockCtuRow( m_pcPic, m_uiCtuRow, m_edgeDir );
+}
+
 Void TComLoopFilter::setCfg( Bool bLFCrossTileBoundary )
 {
   m_bLFCrossTileBoundary = bLFCrossTileBoundary;
@@ -96,6 +108,7 @@ Void TComLoopFilter::setCfg( Bool bLFCrossTileBoundary )
 Void TComLoopFilter::create( UInt uiMaxCUDepth )
 {
   destroy();
+  m_uiMaxCUDepth    = uiMaxCUDepth;
   m_uiNumPartitions = 1 << ( uiMaxCUDepth<<1 );
   for( Int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
   {
@@ -120,6 +133,17 @@ Void TComLoopFilter::destroy()
       m_aapbEdgeFilter[edgeDir] = NULL;
     }
   }
+
+  if (m_pcRowFilters)
+  {
+    for( Int i = 0; i < m_iNumRowFilters; i++ )
+    {
+      m_pcRowFilters[i].destroy();
+    }
+    delete [] m_pcRowFilters;
+    m_pcRowFilters   = NULL;
+    m_iNumRowFilters = 0;
+  }
 }
 
 /**
@@ -129,6 +153,13 @@ Void TComLoopFilter::destroy()
  */
 Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
 {
+  if ( m_pcThreadPool )
+  {
+    xDeblockPicInParallel( pcPic, EDGE_VER );
+    xDeblockPicInParallel( pcPic, EDGE_HOR );
+    return;
+  }
+
   // Horizontal filtering
   for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
   {
@@ -154,11 +185,86 @@ Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
   }
 }
 
+/**
+ - deblock the vertical and then the horizontal edges of one CTU row. Called for the CTU rows from top to bottom,
+   this gives the same result as loopFilterPic: the vertical edges only change samples of their own CTU row, and the
+   horizontal edges of a row (including the edge to the row above) neither reach the row below nor the samples the
+   vertical edges of the row above read. In the encoder, the row below has to be compressed first, as its intra
+   prediction reads the unfiltered samples of this row.
+ .
+ \param  pcPic     picture class (TComPic) pointer
+ \param  uiCtuRow  CTU row in the picture
+ */
+Void TComLoopFilter::loopFilterCtuRow( TComPic* pcPic, UInt uiCtuRow )
+{
+  xDeblockCtuRow( pcPic, uiCtuRow, EDGE_VER );
+  xDeblockCtuRow( pcPic, uiCtuRow, EDGE_HOR );
+}
+
 
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
 
+/**
+ - deblock the edges of one direction of all CTUs of a picture, one CTU row per task. Vertical edges only change
+   samples of their own CTU row and the horizontal edges of one CTU row do not reach the samples the edges of the
+   neighbouring rows read or change, so the result is the same as for the serial filter.
+ .
+ \param  pcPic    picture class (TComPic) pointer
+ \param  edgeDir  direction of the edges to be filtered
+ */
+Void TComLoopFilter::xDeblockPicInParallel( TComPic* pcPic, DeblockEdgeDir edgeDir )
+{
+  const Int iNumSlots = m_pcThreadPool->getNumThreadSlots();
+  if ( m_iNumRowFilters != iNumSlots )
+  {
+    if (m_pcRowFilters)
+    {
+      for( Int i = 0; i < m_iNumRowFilters; i++ )
+      {
+        m_pcRowFilters[i].destroy();
+      }
+      delete [] m_pcRowFilters;
+    }
+    m_iNumRowFilters = iNumSlots;
+    m_pcRowFilters   = new TComLoopFilter[m_iNumRowFilters];
+    for( Int i = 0; i < m_iNumRowFilters; i++ )
+    {
+      m_pcRowFilters[i].create( m_uiMaxCUDepth );
+    }
+  }
+  for( Int i = 0; i < m_iNumRowFilters; i++ )
+  {
+    m_pcRowFilters[i].setCfg( m_bLFCrossTileBoundary );
+  }
+
+  const UInt uiNumCtuRows = pcPic->getFrameHeightInCtus();
+  std::vector<TComDeblockRowTask> acTasks( uiNumCtuRows );
+  TComTaskGroup cGroup;
+  for ( UInt uiCtuRow = 0; uiCtuRow < uiNumCtuRows; uiCtuRow++ )
+  {
+    acTasks[uiCtuRow].init( &m_pcRowFilters[0], pcPic, uiCtuRow, edgeDir );
+    m_pcThreadPool->submit( &acTasks[uiCtuRow], &cGroup );
+  }
+  m_pcThreadPool->wait( &cGroup );
+}
+
+Void TComLoopFilter::xDeblockCtuRow( TComPic* pcPic, UInt uiCtuRow, DeblockEdgeDir edgeDir )
+{
+  const UInt frameWidthInCtus = pcPic->getFrameWidthInCtus();
+  for ( UInt ctuRsAddr = uiCtuRow * frameWidthInCtus; ctuRsAddr < ( uiCtuRow + 1 ) * frameWidthInCtus; ctuRsAddr++ )
+  {
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+    ::memset( m_aapucBS       [edgeDir], 0, sizeof( UChar ) * m_uiNumPartitions );
+    ::memset( m_aapbEdgeFilter[edgeDir], 0, sizeof( Bool  ) * m_uiNumPartitions );
+
+    // CU-based deblocking
+    xDeblockCU( pCtu, 0, 0, edgeDir );
+  }
+}
+
 /**
  - Deblocking filter process in CU-based (the same function as conventional's)
  .
@@ -578,6 +684,23 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* pcCU, UInt uiAbsZorderIdx, UIn
     piTmpSrc += iEdge*uiPelsInPart*iStride;
   }
 
+  UInt  uiBlocksInPart = uiPelsInPart / 4 ? uiPelsInPart / 4 : 1;
+#if SIMD_X86
+  // with SIMD, the parameters of the 4-line segments are collected and the whole edge is filtered at once
+  const Bool bUseSimd = ( g_simdLevel >= SIMD_SSE41 ) && ( uiPelsInPart % 4 == 0 );
+  Int   aiSegTc  [MAX_CU_SIZE/4];
+  Int   aiSegBeta[MAX_CU_SIZE/4];
+  Bool  abSegPNoFilter[MAX_CU_SIZE/4];
+  Bool  abSegQNoFilter[MAX_CU_SIZE/4];
+  if ( bUseSimd )
+  {
+    ::memset( aiSegTc,        0, sizeof( aiSegTc ) );
+    ::memset( aiSegBeta,      0, sizeof( aiSegBeta ) );
+    ::memset( abSegPNoFilter, 0, sizeof( abSegPNoFilter ) );
+    ::memset( abSegQNoFilter, 0, sizeof( abSegQNoFilter ) );
+  }
+#endif
+
   for ( UInt iIdx = 0; iIdx < uiNumParts; iIdx++ )
   {
     uiBsAbsIdx = xCalcBsIdx( pcCU, uiAbsZorderIdx, edgeDir, iEdge, iIdx);
@@ -608,8 +731,32 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* pcCU, UInt uiAbsZorderIdx, UIn
       Int iSideThreshold = (iBeta+(iBeta>>1))>>3;
       Int iThrCut = iTc*10;
 
+      if (bPCMFilter || pcCU->getSlice()->getPPS()->getTransquantBypassEnableFlag())
+      {
+        // Check if each of PUs is I_PCM with LF disabling
+        bPartPNoFilter = (bPCMFilter && pcCUP->getIPCMFlag(uiPartPIdx));
+        bPartQNoFilter = (bPCMFilter && pcCUQ->getIPCMFlag(uiPartQIdx));
+
+        // check if each of PUs is lossless coded
+        bPartPNoFilter = bPartPNoFilter || (pcCUP->isLosslessCoded(uiPartPIdx) );
+        bPartQNoFilter = bPartQNoFilter || (pcCUQ->isLosslessCoded(uiPartQIdx) );
+      }
+
+#if SIMD_X86
+      if ( bUseSimd )
+      {
+        for (UInt iBlkIdx = 0; iBlkIdx<uiBlocksInPart; iBlkIdx ++)
+        {
+          const UInt uiSeg = iIdx*uiBlocksInPart + iBlkIdx;
+          aiSegTc       [uiSeg] = iTc;
+          aiSegBeta     [uiSeg] = iBeta;
+          abSegPNoFilter[uiSeg] = bPartPNoFilter;
+          abSegQNoFilter[uiSeg] = bPartQNoFilter;
+        }
+        continue;
+      }
+#endif
 
-      UInt  uiBlocksInPart = uiPelsInPart / 4 ? uiPelsInPart / 4 : 1;
       for (UInt iBlkIdx = 0; iBlkIdx<uiBlocksInPart; iBlkIdx ++)
       {
         Int dp0 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
@@ -623,17 +770,6 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* pcCU, UInt uiAbsZorderIdx, UIn
         Int dq = dq0 + dq3;
         Int d =  d0 + d3;
 
-        if (bPCMFilter || pcCU->getSlice()->getPPS()->getTransquantBypassEnableFlag())
-        {
-          // Check if each of PUs is I_PCM with LF disabling
-          bPartPNoFilter = (bPCMFilter && pcCUP->getIPCMFlag(uiPartPIdx));
-          bPartQNoFilter = (bPCMFilter && pcCUQ->getIPCMFlag(uiPartQIdx));
-
-          // check if each of PUs is lossless coded
-          bPartPNoFilter = bPartPNoFilter || (pcCUP->isLosslessCoded(uiPartPIdx) );
-          bPartQNoFilter = bPartQNoFilter || (pcCUQ->isLosslessCoded(uiPartQIdx) );
-        }
-
         if (d < iBeta)
         {
           Bool bFilterP = (dp < iSideThreshold);
@@ -650,6 +786,14 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* pcCU, UInt uiAbsZorderIdx, UIn
       }
     }
   }
+
+#if SIMD_X86
+  if ( bUseSimd )
+  {
+    TComLoopFilterSIMD::filterLumaEdge( g_simdLevel, piTmpSrc, iOffset, iSrcStep, uiNumParts*uiBlocksInPart, aiSegTc, aiSegBeta,
+                                        abSegPNoFilter, abSegQNoFilter, (1 << g_bitDepth[CHANNEL_TYPE_LUMA]) - 1 );
+  }
+#endif
 }
 
 
@@ -719,6 +863,20 @@ Void TComLoopFilter::xEdgeFilterChroma( TComDataCU* pcCU, UInt uiAbsZorderIdx, U
     uiLoopLength=uiPelsInPartChromaH;
   }
 
+#if SIMD_X86
+  // with SIMD, the parameters of the parts are collected and the whole edge is filtered at once
+  const Bool bUseSimd = ( g_simdLevel >= SIMD_SSE41 ) && ( ( uiNumParts*uiLoopLength ) % 4 == 0 );
+  Int   aiPartTc[2][MAX_CU_SIZE/4];
+  Bool  abPartPNoFilter[MAX_CU_SIZE/4];
+  Bool  abPartQNoFilter[MAX_CU_SIZE/4];
+  if ( bUseSimd )
+  {
+    ::memset( aiPartTc,        0, sizeof( aiPartTc ) );
+    ::memset( abPartPNoFilter, 0, sizeof( abPartPNoFilter ) );
+    ::memset( abPartQNoFilter, 0, sizeof( abPartQNoFilter ) );
+  }
+#endif
+
   for ( UInt iIdx = 0; iIdx < uiNumParts; iIdx++ )
   {
     uiBsAbsIdx = xCalcBsIdx( pcCU, uiAbsZorderIdx, edgeDir, iEdge, iIdx);
@@ -775,6 +933,16 @@ Void TComLoopFilter::xEdgeFilterChroma( TComDataCU* pcCU, UInt uiAbsZorderIdx, U
         Int iIndexTC = Clip3(0, MAX_QP+DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET*(ucBs - 1) + (tcOffsetDiv2 << 1));
         Int iTc =  sm_tcTable[iIndexTC]*iBitdepthScale;
 
+#if SIMD_X86
+        if ( bUseSimd )
+        {
+          aiPartTc[chromaIdx][iIdx] = iTc;
+          abPartPNoFilter[iIdx]     = bPartPNoFilter;
+          abPartQNoFilter[iIdx]     = bPartQNoFilter;
+          continue;
+        }
+#endif
+
         for ( UInt uiStep = 0; uiStep < uiLoopLength; uiStep++ )
         {
           xPelFilterChroma( piTmpSrcChroma + iSrcStep*(uiStep+iIdx*uiLoopLength), iOffset, iTc , bPartPNoFilter, bPartQNoFilter);
@@ -782,6 +950,18 @@ Void TComLoopFilter::xEdgeFilterChroma( TComDataCU* pcCU, UInt uiAbsZorderIdx, U
       }
     }
   }
+
+#if SIMD_X86
+  if ( bUseSimd )
+  {
+    for ( UInt chromaIdx = 0; chromaIdx < 2; chromaIdx++ )
+    {
+      Pel* piTmpSrcChroma = (chromaIdx == 0) ? piTmpSrcCb : piTmpSrcCr;
+      TComLoopFilterSIMD::filterChromaEdge( g_simdLevel, piTmpSrcChroma, iOffset, iSrcStep, uiNumParts, uiLoopLength, aiPartTc[chromaIdx],
+                                            abPartPNoFilter, abPartQNoFilter, (1 << g_bitDepth[CHANNEL_TYPE_CHROMA]) - 1 );
+    }
+  }
+#endif
 }
 
 /**
@@ -40,6 +40,7 @@
 
 #include "CommonDef.h"
 #include "TComPic.h"
+#include "TComThreadPool.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -50,21 +51,51 @@
 // Class definition
 // ====================================================================================================================
 
+class TComLoopFilter;
+
+/// one CTU row of a deblocking pass, run by the thread pool
+class TComDeblockRowTask : public TComTask
+{
+public:
+  TComDeblockRowTask() : m_pcLoopFilter( NULL ), m_pcPic( NULL ), m_uiCtuRow( 0 ), m_edgeDir( EDGE_VER ) {}
+
+  Void  init  ( TComLoopFilter* pcLoopFilter, TComPic* pcPic, UInt uiCtuRow, DeblockEdgeDir edgeDir )
+  {
+    m_pcLoopFilter = pcLoopFilter;  m_pcPic = pcPic;  m_uiCtuRow = uiCtuRow;  m_edgeDir = edgeDir;
+  }
+  Void  run   ( Int iThreadIdx );
+
+private:
+  TComLoopFilter* m_pcLoopFilter;          ///< filters of all thread slots
+  TComPic*        m_pcPic;
+  UInt            m_uiCtuRow;
+  DeblockEdgeDir  m_edgeDir;
+};
+
 /// deblocking filter class
 class TComLoopFilter
 {
 private:
 
   UInt      m_uiNumPartitions;
+  UInt      m_uiMaxCUDepth;
   UChar*    m_aapucBS[NUM_EDGE_DIR];         ///< Bs for [Ver/Hor][Y/U/V][Blk_Idx]
   Bool*     m_aapbEdgeFilter[NUM_EDGE_DIR];
   LFCUParam m_stLFCUParam;                   ///< status structure
 
   Bool      m_bLFCrossTileBoundary;
 
+  // deblocking of CTU rows in parallel: the edges of one direction in different CTU rows never touch the same samples
+  TComThreadPool* m_pcThreadPool;            ///< pool the CTU rows are filtered with, NULL to filter serially
+  TComLoopFilter* m_pcRowFilters;            ///< one filter per thread slot of the pool, holding the per-CTU working data
+  Int             m_iNumRowFilters;
+
 protected:
   /// CU-level deblocking function
   Void xDeblockCU                 ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, DeblockEdgeDir edgeDir );
+  /// deblocking of the edges of one direction of all CTUs of a CTU row
+  Void xDeblockCtuRow             ( TComPic* pcPic, UInt uiCtuRow, DeblockEdgeDir edgeDir );
+  Void xDeblockPicInParallel      ( TComPic* pcPic, DeblockEdgeDir edgeDir );
 
   // set / get functions
   Void xSetLoopfilterParam        ( TComDataCU* pcCU, UInt uiAbsZorderIdx );
@@ -118,6 +149,8 @@ protected:
   static const UChar sm_tcTable[54];
   static const UChar sm_betaTable[52];
 
+  friend class TComDeblockRowTask;
+
 public:
   TComLoopFilter();
   virtual ~TComLoopFilter();
@@ -127,9 +160,13 @@ public:
 
   /// set configuration
   Void setCfg( Bool bLFCrossTileBoundary );
+  /// filter the CTU rows with the threads of a pool (NULL: serially)
+  Void setThreadPool( TComThreadPool* pcThreadPool ) { m_pcThreadPool = pcThreadPool; }
 
   /// picture-level deblocking filter
   Void loopFilterPic( TComPic* pcPic );
+  /// deblocking filter of one CTU row, when the rows above are filtered already
+  Void loopFilterCtuRow( TComPic* pcPic, UInt uiCtuRow );
 
   static Int getBeta( Int qp )
   {
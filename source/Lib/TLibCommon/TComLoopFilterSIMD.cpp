@@ -0,0 +1,433 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComLoopFilterSIMD.cpp
+    \brief    SIMD implementations of the deblocking filter
+*/
+
+#include <memory.h>
+#include <algorithm>
+#include "TComLoopFilterSIMD.h"
+#include "TComRom.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+#if SIMD_X86
+
+// ====================================================================================================================
+// Access to the lines across an edge
+// ====================================================================================================================
+
+// Eight lines across the edge are filtered at once, one 16-bit lane per line: the samples at the same distance from
+// the edge form a register (p3 ... q3). Along a horizontal edge the lines are columns, which the registers load
+// directly; along a vertical edge they are rows of the picture, which are transposed. Four lines are handled as
+// well, in the lower half of the registers.
+
+SIMD_TARGET_SSE41
+static inline Void xTranspose8x8( const __m128i* a, __m128i* v )
+{
+  const __m128i b0 = _mm_unpacklo_epi16( a[0], a[1] );
+  const __m128i b1 = _mm_unpacklo_epi16( a[2], a[3] );
+  const __m128i b2 = _mm_unpacklo_epi16( a[4], a[5] );
+  const __m128i b3 = _mm_unpacklo_epi16( a[6], a[7] );
+  const __m128i b4 = _mm_unpackhi_epi16( a[0], a[1] );
+  const __m128i b5 = _mm_unpackhi_epi16( a[2], a[3] );
+  const __m128i b6 = _mm_unpackhi_epi16( a[4], a[5] );
+  const __m128i b7 = _mm_unpackhi_epi16( a[6], a[7] );
+  const __m128i c0 = _mm_unpacklo_epi32( b0, b1 );
+  const __m128i c1 = _mm_unpackhi_epi32( b0, b1 );
+  const __m128i c2 = _mm_unpacklo_epi32( b2, b3 );
+  const __m128i c3 = _mm_unpackhi_epi32( b2, b3 );
+  const __m128i c4 = _mm_unpacklo_epi32( b4, b5 );
+  const __m128i c5 = _mm_unpackhi_epi32( b4, b5 );
+  const __m128i c6 = _mm_unpacklo_epi32( b6, b7 );
+  const __m128i c7 = _mm_unpackhi_epi32( b6, b7 );
+  v[0] = _mm_unpacklo_epi64( c0, c2 );
+  v[1] = _mm_unpackhi_epi64( c0, c2 );
+  v[2] = _mm_unpacklo_epi64( c1, c3 );
+  v[3] = _mm_unpackhi_epi64( c1, c3 );
+  v[4] = _mm_unpacklo_epi64( c4, c6 );
+  v[5] = _mm_unpackhi_epi64( c4, c6 );
+  v[6] = _mm_unpacklo_epi64( c5, c7 );
+  v[7] = _mm_unpackhi_epi64( c5, c7 );
+}
+
+/// samples p3 ... q3 of the lines, piSrc pointing at q0 of the first line
+SIMD_TARGET_SSE41
+static inline Void xLoadLumaLines( const Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumLines, __m128i* v )
+{
+  if ( iOffset == 1 )
+  {
+    __m128i a[8];
+    for ( Int i = 0; i < 8; i++ )
+    {
+      a[i] = ( i < iNumLines ) ? _mm_loadu_si128( (const __m128i*)( piSrc + i * iSrcStep - 4 ) ) : _mm_setzero_si128();
+    }
+    xTranspose8x8( a, v );
+  }
+  else
+  {
+    for ( Int k = 0; k < 8; k++ )
+    {
+      const Pel* src = piSrc + ( k - 4 ) * iOffset;
+      v[k] = ( iNumLines == 8 ) ? _mm_loadu_si128( (const __m128i*)src ) : _mm_loadl_epi64( (const __m128i*)src );
+    }
+  }
+}
+
+/// write back the samples p2 ... q2 of the lines (along a vertical edge, the unchanged p3 and q3 as well)
+SIMD_TARGET_SSE41
+static inline Void xStoreLumaLines( Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumLines, const __m128i* v )
+{
+  if ( iOffset == 1 )
+  {
+    __m128i a[8];
+    xTranspose8x8( v, a );
+    for ( Int i = 0; i < iNumLines; i++ )
+    {
+      _mm_storeu_si128( (__m128i*)( piSrc + i * iSrcStep - 4 ), a[i] );
+    }
+  }
+  else
+  {
+    for ( Int k = 1; k < 7; k++ )
+    {
+      Pel* dst = piSrc + ( k - 4 ) * iOffset;
+      if ( iNumLines == 8 )
+      {
+        _mm_storeu_si128( (__m128i*)dst, v[k] );
+      }
+      else
+      {
+        _mm_storel_epi64( (__m128i*)dst, v[k] );
+      }
+    }
+  }
+}
+
+/// samples p1 ... q1 of the lines, piSrc pointing at q0 of the first line
+SIMD_TARGET_SSE41
+static inline Void xLoadChromaLines( const Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumLines, __m128i* v )
+{
+  if ( iOffset == 1 )
+  {
+    __m128i a[8];
+    for ( Int i = 0; i < 8; i++ )
+    {
+      a[i] = ( i < iNumLines ) ? _mm_loadl_epi64( (const __m128i*)( piSrc + i * iSrcStep - 2 ) ) : _mm_setzero_si128();
+    }
+    const __m128i b0 = _mm_unpacklo_epi16( a[0], a[1] );
+    const __m128i b1 = _mm_unpacklo_epi16( a[2], a[3] );
+    const __m128i b2 = _mm_unpacklo_epi16( a[4], a[5] );
+    const __m128i b3 = _mm_unpacklo_epi16( a[6], a[7] );
+    const __m128i c0 = _mm_unpacklo_epi32( b0, b1 );
+    const __m128i c1 = _mm_unpackhi_epi32( b0, b1 );
+    const __m128i c2 = _mm_unpacklo_epi32( b2, b3 );
+    const __m128i c3 = _mm_unpackhi_epi32( b2, b3 );
+    v[0] = _mm_unpacklo_epi64( c0, c2 );
+    v[1] = _mm_unpackhi_epi64( c0, c2 );
+    v[2] = _mm_unpacklo_epi64( c1, c3 );
+    v[3] = _mm_unpackhi_epi64( c1, c3 );
+  }
+  else
+  {
+    for ( Int k = 0; k < 4; k++ )
+    {
+      const Pel* src = piSrc + ( k - 2 ) * iOffset;
+      v[k] = ( iNumLines == 8 ) ? _mm_loadu_si128( (const __m128i*)src ) : _mm_loadl_epi64( (const __m128i*)src );
+    }
+  }
+}
+
+/// write back the samples p0 and q0 of the lines
+SIMD_TARGET_SSE41
+static inline Void xStoreChromaLines( Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumLines, const __m128i* v )
+{
+  if ( iOffset == 1 )
+  {
+    Pel aiPairs[16];
+    _mm_storeu_si128( (__m128i*)( aiPairs     ), _mm_unpacklo_epi16( v[1], v[2] ) );
+    _mm_storeu_si128( (__m128i*)( aiPairs + 8 ), _mm_unpackhi_epi16( v[1], v[2] ) );
+    for ( Int i = 0; i < iNumLines; i++ )
+    {
+      ::memcpy( piSrc + i * iSrcStep - 1, aiPairs + 2 * i, 2 * sizeof( Pel ) );
+    }
+  }
+  else
+  {
+    for ( Int k = 1; k < 3; k++ )
+    {
+      Pel* dst = piSrc + ( k - 2 ) * iOffset;
+      if ( iNumLines == 8 )
+      {
+        _mm_storeu_si128( (__m128i*)dst, v[k] );
+      }
+      else
+      {
+        _mm_storel_epi64( (__m128i*)dst, v[k] );
+      }
+    }
+  }
+}
+
+// ====================================================================================================================
+// Filters
+// ====================================================================================================================
+
+/// value of line 0 of each 4-line segment in all its lanes
+SIMD_TARGET_SSE41
+static inline __m128i xLine0( const __m128i& v )
+{
+  return _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, 0x00 ), 0x00 );
+}
+
+/// value of line 3 of each 4-line segment in all its lanes
+SIMD_TARGET_SSE41
+static inline __m128i xLine3( const __m128i& v )
+{
+  return _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, 0xff ), 0xff );
+}
+
+SIMD_TARGET_SSE41
+static inline __m128i xClip3( const __m128i& vMin, const __m128i& vMax, const __m128i& v )
+{
+  return _mm_min_epi16( _mm_max_epi16( v, vMin ), vMax );
+}
+
+/// luma filtering of two 4-line segments (one when iNumLines is 4), see TComLoopFilter::xEdgeFilterLuma and
+/// xPelFilterLuma. The sums of the decisions and of the strong filter stay within 16 bits up to a bit depth of 12;
+/// the weak filter offset is computed with 32-bit multiply-adds.
+SIMD_TARGET_SSE41
+static Void xFilterLumaLines( Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumLines, const __m128i& vTc, const __m128i& vBeta,
+                              const __m128i& vPNoFilter, const __m128i& vQNoFilter, const __m128i& vMax )
+{
+  __m128i v[8];
+  xLoadLumaLines( piSrc, iOffset, iSrcStep, iNumLines, v );
+  const __m128i p3 = v[0];
+  const __m128i p2 = v[1];
+  const __m128i p1 = v[2];
+  const __m128i p0 = v[3];
+  const __m128i q0 = v[4];
+  const __m128i q1 = v[5];
+  const __m128i q2 = v[6];
+  const __m128i q3 = v[7];
+  const __m128i vZero = _mm_setzero_si128();
+
+  // decisions, from the lines 0 and 3 of each segment
+  const __m128i dp          = _mm_abs_epi16( _mm_add_epi16( _mm_sub_epi16( p2, _mm_slli_epi16( p1, 1 ) ), p0 ) );
+  const __m128i dq          = _mm_abs_epi16( _mm_add_epi16( _mm_sub_epi16( q2, _mm_slli_epi16( q1, 1 ) ), q0 ) );
+  const __m128i dLine       = _mm_add_epi16( dp, dq );
+  const __m128i vSide       = _mm_srai_epi16( _mm_add_epi16( vBeta, _mm_srai_epi16( vBeta, 1 ) ), 3 );
+  const __m128i mOn         = _mm_cmpgt_epi16( vBeta, _mm_add_epi16( xLine0( dLine ), xLine3( dLine ) ) );
+  const __m128i mFilterP    = _mm_cmpgt_epi16( vSide, _mm_add_epi16( xLine0( dp ), xLine3( dp ) ) );
+  const __m128i mFilterQ    = _mm_cmpgt_epi16( vSide, _mm_add_epi16( xLine0( dq ), xLine3( dq ) ) );
+  const __m128i dStrong     = _mm_add_epi16( _mm_abs_epi16( _mm_sub_epi16( p3, p0 ) ), _mm_abs_epi16( _mm_sub_epi16( q3, q0 ) ) );
+  const __m128i mStrongLine = _mm_and_si128( _mm_and_si128( _mm_cmpgt_epi16( _mm_srai_epi16( vBeta, 2 ), _mm_slli_epi16( dLine, 1 ) ),
+                                                            _mm_cmpgt_epi16( _mm_srai_epi16( vBeta, 3 ), dStrong ) ),
+                                             _mm_cmpgt_epi16( _mm_srai_epi16( _mm_add_epi16( _mm_mullo_epi16( vTc, _mm_set1_epi16( 5 ) ), _mm_set1_epi16( 1 ) ), 1 ),
+                                                              _mm_abs_epi16( _mm_sub_epi16( p0, q0 ) ) ) );
+  const __m128i mStrong     = _mm_and_si128( mOn, _mm_and_si128( xLine0( mStrongLine ), xLine3( mStrongLine ) ) );
+
+  // strong filter
+  const __m128i vTc2     = _mm_slli_epi16( vTc, 1 );
+  const __m128i vTwo     = _mm_set1_epi16( 2 );
+  const __m128i vFour    = _mm_set1_epi16( 4 );
+  const __m128i vP0Q0    = _mm_add_epi16( p0, q0 );
+  const __m128i vSumP    = _mm_add_epi16( vP0Q0, p1 );
+  const __m128i vSumQ    = _mm_add_epi16( vP0Q0, q1 );
+  const __m128i p0Strong = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( p2, q1 ), _mm_add_epi16( _mm_slli_epi16( vSumP, 1 ), vFour ) ), 3 );
+  const __m128i q0Strong = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( p1, q2 ), _mm_add_epi16( _mm_slli_epi16( vSumQ, 1 ), vFour ) ), 3 );
+  const __m128i p1Strong = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( vSumP, p2 ), vTwo ), 2 );
+  const __m128i q1Strong = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( vSumQ, q2 ), vTwo ), 2 );
+  const __m128i p2Strong = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( _mm_add_epi16( p3, p2 ), 1 ), _mm_add_epi16( vSumP, p2 ) ), vFour ), 3 );
+  const __m128i q2Strong = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( _mm_add_epi16( q3, q2 ), 1 ), _mm_add_epi16( vSumQ, q2 ) ), vFour ), 3 );
+
+  // weak filter
+  const __m128i vDiff0   = _mm_sub_epi16( q0, p0 );
+  const __m128i vDiff1   = _mm_sub_epi16( q1, p1 );
+  const __m128i vWeights = _mm_set1_epi32( (Int)0xfffd0009 ); // 9, -3
+  const __m128i vEight   = _mm_set1_epi32( 8 );
+  const __m128i vDeltaLo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vDiff0, vDiff1 ), vWeights ), vEight ), 4 );
+  const __m128i vDeltaHi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vDiff0, vDiff1 ), vWeights ), vEight ), 4 );
+  const __m128i vDelta   = _mm_packs_epi32( vDeltaLo, vDeltaHi );
+  const __m128i mWeak    = _mm_andnot_si128( mStrong, _mm_and_si128( mOn, _mm_cmpgt_epi16( _mm_mullo_epi16( vTc, _mm_set1_epi16( 10 ) ), _mm_abs_epi16( vDelta ) ) ) );
+  const __m128i vNegTc   = _mm_sub_epi16( vZero, vTc );
+  const __m128i vDeltaC  = xClip3( vNegTc, vTc, vDelta );
+  const __m128i vTcHalf  = _mm_srai_epi16( vTc, 1 );
+  const __m128i vNegHalf = _mm_sub_epi16( vZero, vTcHalf );
+  const __m128i p0Weak   = xClip3( vZero, vMax, _mm_add_epi16( p0, vDeltaC ) );
+  const __m128i q0Weak   = xClip3( vZero, vMax, _mm_sub_epi16( q0, vDeltaC ) );
+  const __m128i vDelta1  = xClip3( vNegHalf, vTcHalf, _mm_srai_epi16( _mm_add_epi16( _mm_sub_epi16( _mm_avg_epu16( p2, p0 ), p1 ), vDeltaC ), 1 ) );
+  const __m128i vDelta2  = xClip3( vNegHalf, vTcHalf, _mm_srai_epi16( _mm_sub_epi16( _mm_sub_epi16( _mm_avg_epu16( q2, q0 ), q1 ), vDeltaC ), 1 ) );
+  const __m128i p1Weak   = xClip3( vZero, vMax, _mm_add_epi16( p1, vDelta1 ) );
+  const __m128i q1Weak   = xClip3( vZero, vMax, _mm_add_epi16( q1, vDelta2 ) );
+
+  // selection, the samples of a PCM or lossless side being kept
+  const __m128i mStrongP = _mm_andnot_si128( vPNoFilter, mStrong );
+  const __m128i mStrongQ = _mm_andnot_si128( vQNoFilter, mStrong );
+  const __m128i mWeakP   = _mm_andnot_si128( vPNoFilter, mWeak );
+  const __m128i mWeakQ   = _mm_andnot_si128( vQNoFilter, mWeak );
+
+  v[1] = _mm_blendv_epi8( p2, xClip3( _mm_sub_epi16( p2, vTc2 ), _mm_add_epi16( p2, vTc2 ), p2Strong ), mStrongP );
+  v[2] = _mm_blendv_epi8( _mm_blendv_epi8( p1, xClip3( _mm_sub_epi16( p1, vTc2 ), _mm_add_epi16( p1, vTc2 ), p1Strong ), mStrongP ), p1Weak, _mm_and_si128( mWeakP, mFilterP ) );
+  v[3] = _mm_blendv_epi8( _mm_blendv_epi8( p0, xClip3( _mm_sub_epi16( p0, vTc2 ), _mm_add_epi16( p0, vTc2 ), p0Strong ), mStrongP ), p0Weak, mWeakP );
+  v[4] = _mm_blendv_epi8( _mm_blendv_epi8( q0, xClip3( _mm_sub_epi16( q0, vTc2 ), _mm_add_epi16( q0, vTc2 ), q0Strong ), mStrongQ ), q0Weak, mWeakQ );
+  v[5] = _mm_blendv_epi8( _mm_blendv_epi8( q1, xClip3( _mm_sub_epi16( q1, vTc2 ), _mm_add_epi16( q1, vTc2 ), q1Strong ), mStrongQ ), q1Weak, _mm_and_si128( mWeakQ, mFilterQ ) );
+  v[6] = _mm_blendv_epi8( q2, xClip3( _mm_sub_epi16( q2, vTc2 ), _mm_add_epi16( q2, vTc2 ), q2Strong ), mStrongQ );
+
+  xStoreLumaLines( piSrc, iOffset, iSrcStep, iNumLines, v );
+}
+
+/// chroma filtering of 8 (or 4) lines, see TComLoopFilter::xPelFilterChroma
+SIMD_TARGET_SSE41
+static Void xFilterChromaLines( Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumLines, const __m128i& vTc,
+                                const __m128i& vPNoFilter, const __m128i& vQNoFilter, const __m128i& vMax )
+{
+  __m128i v[4];
+  xLoadChromaLines( piSrc, iOffset, iSrcStep, iNumLines, v );
+  const __m128i p1 = v[0];
+  const __m128i p0 = v[1];
+  const __m128i q0 = v[2];
+  const __m128i q1 = v[3];
+  const __m128i vZero = _mm_setzero_si128();
+
+  const __m128i vSum   = _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( _mm_sub_epi16( q0, p0 ), 2 ), _mm_sub_epi16( p1, q1 ) ), _mm_set1_epi16( 4 ) );
+  const __m128i vDelta = xClip3( _mm_sub_epi16( vZero, vTc ), vTc, _mm_srai_epi16( vSum, 3 ) );
+
+  v[1] = _mm_blendv_epi8( xClip3( vZero, vMax, _mm_add_epi16( p0, vDelta ) ), p0, vPNoFilter );
+  v[2] = _mm_blendv_epi8( xClip3( vZero, vMax, _mm_sub_epi16( q0, vDelta ) ), q0, vQNoFilter );
+
+  xStoreChromaLines( piSrc, iOffset, iSrcStep, iNumLines, v );
+}
+
+SIMD_TARGET_SSE41
+static Void xFilterLumaEdge( Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumSegments, const Int* piTc, const Int* piBeta,
+                             const Bool* pbPartPNoFilter, const Bool* pbPartQNoFilter, Int iMaxVal )
+{
+  const __m128i vMax = _mm_set1_epi16( iMaxVal );
+  for ( Int s = 0; s < iNumSegments; s += 2 )
+  {
+    const Bool bPair = ( s + 1 < iNumSegments );
+    const Int  iTc1  = bPair ? piTc[s + 1] : 0;
+    if ( piTc[s] == 0 && iTc1 == 0 )
+    {
+      continue;
+    }
+    const __m128i vTc        = _mm_unpacklo_epi64( _mm_set1_epi16( piTc[s] ), _mm_set1_epi16( iTc1 ) );
+    const __m128i vBeta      = _mm_unpacklo_epi64( _mm_set1_epi16( piBeta[s] ), _mm_set1_epi16( bPair ? piBeta[s + 1] : 0 ) );
+    const __m128i vPNoFilter = _mm_unpacklo_epi64( _mm_set1_epi16( -(Short)pbPartPNoFilter[s] ), _mm_set1_epi16( bPair ? -(Short)pbPartPNoFilter[s + 1] : 0 ) );
+    const __m128i vQNoFilter = _mm_unpacklo_epi64( _mm_set1_epi16( -(Short)pbPartQNoFilter[s] ), _mm_set1_epi16( bPair ? -(Short)pbPartQNoFilter[s + 1] : 0 ) );
+    xFilterLumaLines( piSrc + s * 4 * iSrcStep, iOffset, iSrcStep, bPair ? 8 : 4, vTc, vBeta, vPNoFilter, vQNoFilter, vMax );
+  }
+}
+
+SIMD_TARGET_SSE41
+static Void xFilterChromaEdge( Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumParts, Int iLinesPerPart, const Int* piTc,
+                               const Bool* pbPartPNoFilter, const Bool* pbPartQNoFilter, Int iMaxVal )
+{
+  // parameters of each line
+  const Int iNumLines = iNumParts * iLinesPerPart;
+  Short     asTc[MAX_CU_SIZE + 8];
+  Short     asPNoFilter[MAX_CU_SIZE + 8];
+  Short     asQNoFilter[MAX_CU_SIZE + 8];
+  for ( Int i = 0; i < iNumLines; i++ )
+  {
+    asTc[i]        = piTc[i / iLinesPerPart];
+    asPNoFilter[i] = -(Short)pbPartPNoFilter[i / iLinesPerPart];
+    asQNoFilter[i] = -(Short)pbPartQNoFilter[i / iLinesPerPart];
+  }
+
+  const __m128i vMax = _mm_set1_epi16( iMaxVal );
+  for ( Int l = 0; l < iNumLines; l += 8 )
+  {
+    const Int     iLines = std::min( 8, iNumLines - l );
+    const __m128i vTc    = ( iLines == 8 ) ? _mm_loadu_si128( (const __m128i*)( asTc + l ) ) : _mm_loadl_epi64( (const __m128i*)( asTc + l ) );
+    if ( _mm_testz_si128( vTc, vTc ) )
+    {
+      continue;
+    }
+    const __m128i vPNoFilter = _mm_loadu_si128( (const __m128i*)( asPNoFilter + l ) );
+    const __m128i vQNoFilter = _mm_loadu_si128( (const __m128i*)( asQNoFilter + l ) );
+    xFilterChromaLines( piSrc + l * iSrcStep, iOffset, iSrcStep, iLines, vTc, vPNoFilter, vQNoFilter, vMax );
+  }
+}
+
+#endif // SIMD_X86
+
+// ====================================================================================================================
+// Selection of the kernels
+// ====================================================================================================================
+
+/** luma filtering of an edge, see TComLoopFilter::xEdgeFilterLuma
+ *  \param level            instruction set, at least SIMD_SSE41
+ *  \param piSrc            first sample after the edge (q0) of the first line
+ *  \param iOffset          offset between the samples of a line, 1 for a vertical edge
+ *  \param iSrcStep         offset between the lines
+ *  \param iNumSegments     number of 4-line segments of the edge
+ *  \param piTc             tc of each segment, 0 when the segment is not filtered
+ *  \param piBeta           beta of each segment
+ *  \param pbPartPNoFilter  the samples before the edge are kept (PCM or lossless), per segment
+ *  \param pbPartQNoFilter  the samples after the edge are kept (PCM or lossless), per segment
+ *  \param iMaxVal          largest sample value
+ */
+Void TComLoopFilterSIMD::filterLumaEdge( SimdLevel level, Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumSegments, const Int* piTc, const Int* piBeta,
+                                         const Bool* pbPartPNoFilter, const Bool* pbPartQNoFilter, Int iMaxVal )
+{
+#if SIMD_X86
+  xFilterLumaEdge( piSrc, iOffset, iSrcStep, iNumSegments, piTc, piBeta, pbPartPNoFilter, pbPartQNoFilter, iMaxVal );
+#endif
+}
+
+/** chroma filtering of an edge of one component, see TComLoopFilter::xEdgeFilterChroma
+ *  \param level            instruction set, at least SIMD_SSE41
+ *  \param piSrc            first sample after the edge (q0) of the first line
+ *  \param iOffset          offset between the samples of a line, 1 for a vertical edge
+ *  \param iSrcStep         offset between the lines
+ *  \param iNumParts        number of parts of the edge
+ *  \param iLinesPerPart    number of lines of a part, the number of lines of the edge being a multiple of 4
+ *  \param piTc             tc of each part, 0 when the part is not filtered
+ *  \param pbPartPNoFilter  the samples before the edge are kept (PCM or lossless), per part
+ *  \param pbPartQNoFilter  the samples after the edge are kept (PCM or lossless), per part
+ *  \param iMaxVal          largest sample value
+ */
+Void TComLoopFilterSIMD::filterChromaEdge( SimdLevel level, Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumParts, Int iLinesPerPart, const Int* piTc,
+                                           const Bool* pbPartPNoFilter, const Bool* pbPartQNoFilter, Int iMaxVal )
+{
+  assert( ( ( iNumParts * iLinesPerPart ) & 3 ) == 0 && iNumParts * iLinesPerPart <= MAX_CU_SIZE );
+#if SIMD_X86
+  xFilterChromaEdge( piSrc, iOffset, iSrcStep, iNumParts, iLinesPerPart, piTc, pbPartPNoFilter, pbPartQNoFilter, iMaxVal );
+#endif
+}
+
+//! \}
@@ -0,0 +1,64 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComLoopFilterSIMD.h
+    \brief    SIMD implementations of the deblocking filter (header)
+*/
+
+#ifndef __TCOMLOOPFILTERSIMD__
+#define __TCOMLOOPFILTERSIMD__
+
+#include "TypeDef.h"
+#include "TComSimd.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Namespace definition
+// ====================================================================================================================
+
+/// SIMD implementations of the edge filters of TComLoopFilter, giving the same results as the C++ ones.
+/// An edge is passed as its filtering parameters: per 4-line segment for the luma, per part for the chroma. The
+/// segments or parts that are not filtered have tc = 0.
+namespace TComLoopFilterSIMD
+{
+  Void filterLumaEdge  ( SimdLevel level, Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumSegments, const Int* piTc, const Int* piBeta,
+                         const Bool* pbPartPNoFilter, const Bool* pbPartQNoFilter, Int iMaxVal );
+  Void filterChromaEdge( SimdLevel level, Pel* piSrc, Int iOffset, Int iSrcStep, Int iNumParts, Int iLinesPerPart, const Int* piTc,
+                         const Bool* pbPartPNoFilter, const Bool* pbPartQNoFilter, Int iMaxVal );
+}// END NAMESPACE DEFINITION TComLoopFilterSIMD
+
+//! \}
+
+#endif // __TCOMLOOPFILTERSIMD__
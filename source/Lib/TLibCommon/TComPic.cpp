@@ -77,6 +77,7 @@ Void TComPic::create( Int iWidth, Int iHeight, ChromaFormat chromaFormatIDC, UIn
     m_apcPicYuv[PIC_YUV_TRUE_ORG]  = new TComPicYuv;  m_apcPicYuv[PIC_YUV_TRUE_ORG]->create( iWidth, iHeight, chromaFormatIDC, uiMaxWidth, uiMaxHeight, uiMaxDepth );
   }
   m_apcPicYuv[PIC_YUV_REC]  = new TComPicYuv;  m_apcPicYuv[PIC_YUV_REC]->create( iWidth, iHeight, chromaFormatIDC, uiMaxWidth, uiMaxHeight, uiMaxDepth );
+  m_uiCurrSliceIdx = 0;
 
   // there are no SEI messages associated with this picture initially
   if (m_SEIs.size() > 0)
@@ -129,6 +130,39 @@ Void TComPic::compressMotion()
   }
 }
 
+/** compress the motion of the CTUs of one CTU row, once nothing of the picture itself needs the uncompressed motion
+ * of the row anymore
+ * \param uiCtuRow  CTU row
+ */
+Void TComPic::compressMotion( UInt uiCtuRow )
+{
+  TComPicSym* pPicSym = getPicSym();
+  const UInt uiFrameWidthInCtus = pPicSym->getFrameWidthInCtus();
+  for ( UInt uiCUAddr = uiCtuRow*uiFrameWidthInCtus; uiCUAddr < ( uiCtuRow + 1 )*uiFrameWidthInCtus; uiCUAddr++ )
+  {
+    TComDataCU* pCtu = pPicSym->getCtu(uiCUAddr);
+    pCtu->compressMV();
+  }
+}
+
+/** publish the number of CTU rows (counted from the top of the picture) whose reconstruction is final, so that
+ * pictures referencing this one can go ahead. Resetting the progress (e.g. when the picture buffer is reused)
+ * is done with uiNumCtuRows = 0.
+ * \param uiNumCtuRows  number of completed CTU rows
+ */
+Void TComPic::setReconRowProgress( UInt uiNumCtuRows )
+{
+  m_cReconRowProgress.set( uiNumCtuRows );
+}
+
+/** block the calling thread until at least uiNumCtuRows CTU rows of this picture are reconstructed
+ * \param uiNumCtuRows  number of CTU rows required, clipped to the picture height
+ */
+Void TComPic::waitForReconRows( UInt uiNumCtuRows )
+{
+  m_cReconRowProgress.wait( std::min( uiNumCtuRows, getFrameHeightInCtus() ) );
+}
+
 Bool  TComPic::getSAOMergeAvailability(Int currAddr, Int mergeAddr)
 {
   Bool mergeCtbInSliceSeg = (mergeAddr >= getPicSym()->getCtuTsToRsAddrMap(getCtu(currAddr)->getSlice()->getSliceCurStartCtuTsAddr()));
@@ -43,6 +43,7 @@
 #include "TComPicSym.h"
 #include "TComPicYuv.h"
 #include "TComBitStream.h"
+#include "TComThreadPool.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -73,6 +74,7 @@ private:
   Bool                  m_bNeededForOutput;
   UInt                  m_uiCurrSliceIdx;         // Index of current slice
   Bool                  m_bCheckLTMSB;
+  TComProgressCounter   m_cReconRowProgress;      //  Number of CTU rows (from the top) whose final reconstruction is available
 
   Int                   m_numReorderPics[MAX_TLAYER];
   Window                m_conformanceWindow;
@@ -138,10 +140,16 @@ public:
   Void          setOutputMark (Bool b) { m_bNeededForOutput = b;     }
   Bool          getOutputMark () const      { return m_bNeededForOutput;  }
 
+  Void          setReconRowProgress ( UInt uiNumCtuRows );
+  UInt          getReconRowProgress ()                  { return m_cReconRowProgress.get(); }
+  Void          waitForReconRows    ( UInt uiNumCtuRows );
+  TComProgressCounter* getReconRowProgressCounter()     { return &m_cReconRowProgress; }
+
   Void          setNumReorderPics(Int i, UInt tlayer) { m_numReorderPics[tlayer] = i;    }
   Int           getNumReorderPics(UInt tlayer)        { return m_numReorderPics[tlayer]; }
 
   Void          compressMotion();
+  Void          compressMotion( UInt uiCtuRow );
   UInt          getCurrSliceIdx() const           { return m_uiCurrSliceIdx;                }
   Void          setCurrSliceIdx(UInt i)      { m_uiCurrSliceIdx = i;                   }
   UInt          getNumAllocatedSlice() const      {return m_apcPicSym->getNumAllocatedSlice();}
@@ -172,19 +172,32 @@ Void TComPicYuv::extendPicBorder ()
 {
   if ( m_bIsBorderExtended ) return;
 
+  extendPicBorderRows( 0, m_iPicHeight );
+
+  m_bIsBorderExtended = true;
+}
+
+/** pad the left and right margins of a band of lines of the picture, and the top or bottom margin when the band
+ * touches the top or bottom of the picture. Does not change the border extension flag.
+ * \param iLumaY       first line of the band, in luma samples
+ * \param iLumaHeight  number of lines of the band, in luma samples
+ */
+Void TComPicYuv::extendPicBorderRows( Int iLumaY, Int iLumaHeight )
+{
   for(Int chan=0; chan<getNumberValidComponents(); chan++)
   {
     const ComponentID ch=ComponentID(chan);
-    Pel *piTxt=getAddr(ch); // piTxt = point to (0,0) of image within bigger picture.
     const Int iStride=getStride(ch);
     const Int iWidth=getWidth(ch);
     const Int iHeight=getHeight(ch);
     const Int iMarginX=getMarginX(ch);
     const Int iMarginY=getMarginY(ch);
+    const Int iStartY=iLumaY >> getComponentScaleY(ch);
+    const Int iEndY=(iLumaY + iLumaHeight) >> getComponentScaleY(ch);
 
-    Pel*  pi = piTxt;
+    Pel*  pi = getAddr(ch) + iStartY*iStride; // pi = point to (0,iStartY) of image within bigger picture.
     // do left and right margins
-    for (Int y = 0; y < iHeight; y++)
+    for (Int y = iStartY; y < iEndY; y++)
     {
       for (Int x = 0; x < iMarginX; x++ )
       {
@@ -194,24 +207,26 @@ Void TComPicYuv::extendPicBorder ()
       pi += iStride;
     }
 
-    // pi is now the (0,height) (bottom left of image within bigger picture
-    pi -= (iStride + iMarginX);
-    // pi is now the (-marginX, height-1)
-    for (Int y = 0; y < iMarginY; y++ )
+    if ( iEndY == iHeight )
     {
-      ::memcpy( pi + (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+      // pi = (-marginX, height-1)
+      pi = getAddr(ch) + (iHeight-1)*iStride - iMarginX;
+      for (Int y = 0; y < iMarginY; y++ )
+      {
+        ::memcpy( pi + (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+      }
     }
 
-    // pi is still (-marginX, height-1)
-    pi -= ((iHeight-1) * iStride);
-    // pi is now (-marginX, 0)
-    for (Int y = 0; y < iMarginY; y++ )
+    if ( iStartY == 0 )
     {
-      ::memcpy( pi - (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+      // pi = (-marginX, 0)
+      pi = getAddr(ch) - iMarginX;
+      for (Int y = 0; y < iMarginY; y++ )
+      {
+        ::memcpy( pi - (y+1)*iStride, pi, sizeof(Pel)*(iWidth + (iMarginX<<1)) );
+      }
     }
   }
-
-  m_bIsBorderExtended = true;
 }
 
 
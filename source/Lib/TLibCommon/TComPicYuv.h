@@ -147,12 +147,14 @@ public:
 
   //  Extend function of picture buffer
   Void          extendPicBorder   ();
+  Void          extendPicBorderRows( Int iLumaY, Int iLumaHeight );
 
   //  Dump picture
   Void          dump              (const Char* pFileName, Bool bAdd = false) const ;
 
   // Set border extension flag
   Void          setBorderExtension(Bool b) { m_bIsBorderExtended = b; }
+  Bool          isBorderExtended  () const   { return m_bIsBorderExtended; }
 };// END CLASS DEFINITION TComPicYuv
 
 
@@ -37,6 +37,7 @@
 
 #include <memory.h>
 #include "TComPrediction.h"
+#include "TComPredictionSIMD.h"
 #include "TComTU.h"
 
 //! \ingroup TLibCommon
@@ -464,6 +465,13 @@ Void TComPrediction::predIntraAng( const ComponentID compID, UInt uiDirMode, Pel
   {
     const Pel *ptrSrc = getPredictorPtr( compID, bUseFilteredPredSamples );
 
+#if SIMD_X86
+    if ( g_simdLevel >= SIMD_SSE41 )
+    {
+      predIntraAngBatch( compID, &uiDirMode, 1, &pDst, uiStride, rTu, bAbove, bLeft, bUseFilteredPredSamples );
+    }
+    else
+#endif
     if ( uiDirMode == PLANAR_IDX )
     {
       xPredIntraPlanar( ptrSrc+sw+1, sw, pDst, uiStride, iWidth, iHeight, channelType, format );
@@ -490,6 +498,81 @@ Void TComPrediction::predIntraAng( const ComponentID compID, UInt uiDirMode, Pel
 
 }
 
+/** intra prediction of several modes from the same reference samples, filtered or not, for example for the
+ * estimation of the luma mode. With the SIMD kernels, the reference samples are gathered once for all the modes.
+ * The lossless DPCM prediction is not supported.
+ * \param compID                  component
+ * \param puiModes                intra prediction modes
+ * \param iNumModes               number of modes
+ * \param apiPred                 prediction block of each mode
+ * \param uiStride                stride of the prediction blocks
+ * \param rTu                     transform unit
+ * \param bAbove                  the reference samples above the block are available
+ * \param bLeft                   the reference samples left of the block are available
+ * \param bUseFilteredPredSamples use the filtered reference samples
+ */
+Void TComPrediction::predIntraAngBatch( const ComponentID compID, const UInt* puiModes, Int iNumModes, Pel* const* apiPred, UInt uiStride, TComTU &rTu, Bool bAbove, Bool bLeft, const Bool bUseFilteredPredSamples )
+{
+#if SIMD_X86
+  if ( g_simdLevel >= SIMD_SSE41 )
+  {
+    const ChromaFormat   format      = rTu.GetChromaFormat();
+    const ChannelType    channelType = toChannelType(compID);
+    const TComRectangle &rect        = rTu.getRect(isLuma(compID) ? COMPONENT_Y : COMPONENT_Cb);
+    const Int            iWidth      = rect.width;
+    const Int            iHeight     = rect.height;
+    const Int            sw          = (2 * iWidth + 1);
+    const Pel           *ptrSrc      = getPredictorPtr( compID, bUseFilteredPredSamples );
+
+          TComDataCU *const pcCU              = rTu.getCU();
+    const UInt              uiAbsPartIdx      = rTu.GetAbsPartIdxTU();
+    const Bool              enableEdgeFilters = !(pcCU->isRDPCMEnabled(uiAbsPartIdx) && pcCU->getCUTransquantBypass(uiAbsPartIdx));
+    const Bool              bFilteredSize     = isLuma(channelType) && (iWidth <= MAXIMUM_INTRA_FILTERED_WIDTH) && (iHeight <= MAXIMUM_INTRA_FILTERED_HEIGHT);
+#if O0043_BEST_EFFORT_DECODING
+    const Int               bitDepth          = g_bitDepthInStream[channelType];
+#else
+    const Int               bitDepth          = g_bitDepth[channelType];
+#endif
+
+    // reference samples: the top-left one followed by the row above, and by the column left of the block
+    // (one more sample than needed, read by the projection of the negative angles)
+    Pel refAbove[2*MAX_CU_SIZE+2];
+    Pel refLeft [2*MAX_CU_SIZE+2];
+    ::memcpy( refAbove, ptrSrc, (2 * iWidth + 1) * sizeof(Pel) );
+    refAbove[2 * iWidth + 1] = refAbove[2 * iWidth];
+    for (Int y=0; y<2*iHeight+1; y++)
+    {
+      refLeft[y] = ptrSrc[y*sw];
+    }
+    refLeft[2 * iHeight + 1] = refLeft[2 * iHeight];
+
+    for (Int i=0; i<iNumModes; i++)
+    {
+      const UInt uiDirMode = puiModes[i];
+      if ( uiDirMode == PLANAR_IDX )
+      {
+        TComPredictionSIMD::predIntraPlanar( g_simdLevel, refAbove, refLeft, apiPred[i], uiStride, iWidth, iHeight );
+      }
+      else if ( uiDirMode == DC_IDX )
+      {
+        const Pel dcval = predIntraGetPredValDC( ptrSrc+sw+1, sw, iWidth, iHeight, channelType, format, bAbove, bLeft );
+        TComPredictionSIMD::predIntraDC( g_simdLevel, refAbove, refLeft, apiPred[i], uiStride, iWidth, iHeight, dcval, bAbove && bLeft && bFilteredSize );
+      }
+      else
+      {
+        TComPredictionSIMD::predIntraAng( g_simdLevel, bitDepth, refAbove, refLeft, apiPred[i], uiStride, iWidth, iHeight, uiDirMode, enableEdgeFilters && bFilteredSize );
+      }
+    }
+    return;
+  }
+#endif
+
+  for (Int i=0; i<iNumModes; i++)
+  {
+    predIntraAng( compID, puiModes[i], NULL, uiStride, apiPred[i], uiStride, rTu, bAbove, bLeft, bUseFilteredPredSamples );
+  }
+}
+
 /** Function for checking identical motion.
  * \param TComDataCU* pcCU
  * \param UInt PartAddr
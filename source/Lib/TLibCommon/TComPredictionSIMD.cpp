@@ -0,0 +1,488 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComPredictionSIMD.cpp
+    \brief    SIMD implementations of the intra prediction
+*/
+
+#include <memory.h>
+#include "TComPredictionSIMD.h"
+#include "TComRom.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+#if SIMD_X86
+
+// ====================================================================================================================
+// Angular prediction
+// ====================================================================================================================
+
+// As in the C++ code, the horizontal modes are predicted as vertical ones into a temporary block, which is transposed.
+// A row of the block is either a copy of the main reference or the interpolation of two neighbouring reference
+// samples, done with a multiply-add of the interleaved samples with the interleaved weights (32 - fract, fract).
+
+/// one row of an angular prediction, width a multiple of 4
+SIMD_TARGET_SSE41
+static inline Void xPredAngRowSse41( const Pel* pRef, Pel* pDst, Int width, Int deltaFract )
+{
+  Int x = 0;
+  if ( deltaFract == 0 )
+  {
+    for ( ; x + 8 <= width; x += 8 )
+    {
+      _mm_storeu_si128( (__m128i*)( pDst + x ), _mm_loadu_si128( (const __m128i*)( pRef + x ) ) );
+    }
+    if ( x < width )
+    {
+      _mm_storel_epi64( (__m128i*)( pDst + x ), _mm_loadl_epi64( (const __m128i*)( pRef + x ) ) );
+    }
+    return;
+  }
+
+  const __m128i vWeights = _mm_set1_epi32( ( 32 - deltaFract ) | ( deltaFract << 16 ) );
+  const __m128i vRound   = _mm_set1_epi32( 16 );
+  for ( ; x + 8 <= width; x += 8 )
+  {
+    const __m128i vRef0 = _mm_loadu_si128( (const __m128i*)( pRef + x     ) );
+    const __m128i vRef1 = _mm_loadu_si128( (const __m128i*)( pRef + x + 1 ) );
+    const __m128i vLo   = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vRef0, vRef1 ), vWeights ), vRound ), 5 );
+    const __m128i vHi   = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vRef0, vRef1 ), vWeights ), vRound ), 5 );
+    _mm_storeu_si128( (__m128i*)( pDst + x ), _mm_packs_epi32( vLo, vHi ) );
+  }
+  if ( x < width )
+  {
+    const __m128i vRef0 = _mm_loadl_epi64( (const __m128i*)( pRef + x     ) );
+    const __m128i vRef1 = _mm_loadl_epi64( (const __m128i*)( pRef + x + 1 ) );
+    const __m128i vLo   = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vRef0, vRef1 ), vWeights ), vRound ), 5 );
+    _mm_storel_epi64( (__m128i*)( pDst + x ), _mm_packs_epi32( vLo, vLo ) );
+  }
+}
+
+/// one row of an angular prediction, 16 samples at a time
+SIMD_TARGET_AVX2
+static inline Void xPredAngRowAvx2( const Pel* pRef, Pel* pDst, Int width, Int deltaFract )
+{
+  Int x = 0;
+  if ( deltaFract == 0 )
+  {
+    for ( ; x + 16 <= width; x += 16 )
+    {
+      _mm256_storeu_si256( (__m256i*)( pDst + x ), _mm256_loadu_si256( (const __m256i*)( pRef + x ) ) );
+    }
+  }
+  else
+  {
+    const __m256i vWeights = _mm256_set1_epi32( ( 32 - deltaFract ) | ( deltaFract << 16 ) );
+    const __m256i vRound   = _mm256_set1_epi32( 16 );
+    for ( ; x + 16 <= width; x += 16 )
+    {
+      const __m256i vRef0 = _mm256_loadu_si256( (const __m256i*)( pRef + x     ) );
+      const __m256i vRef1 = _mm256_loadu_si256( (const __m256i*)( pRef + x + 1 ) );
+      const __m256i vLo   = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( vRef0, vRef1 ), vWeights ), vRound ), 5 );
+      const __m256i vHi   = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( vRef0, vRef1 ), vWeights ), vRound ), 5 );
+      _mm256_storeu_si256( (__m256i*)( pDst + x ), _mm256_packs_epi32( vLo, vHi ) );
+    }
+  }
+  if ( x < width )
+  {
+    xPredAngRowSse41( pRef + x, pDst + x, width - x, deltaFract );
+  }
+}
+
+/// extension of the main reference to the left for the negative angles (refMain[k] = refSide[(128 + -k*invAngle) >> 8]
+/// for iFirst <= k < 0), eight samples at a time with a gather. The samples are read as 32-bit words (scale 2), of
+/// which the low half is kept; the lanes past -1 give refSide[0] and are overwritten by the copy of the main reference.
+SIMD_TARGET_AVX2
+static Void xProjectRefAvx2( const Pel* refSide, Pel* refMain, Int iFirst, Int invAngle )
+{
+  const __m256i vInvAngle = _mm256_set1_epi32( invAngle );
+  const __m256i vRound    = _mm256_set1_epi32( 128 );
+  const __m256i vLane     = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+  const __m256i vMask     = _mm256_set1_epi32( 0xffff );
+  for ( Int k = iFirst; k < 0; k += 8 )
+  {
+    const __m256i vNegK   = _mm256_sub_epi32( _mm256_set1_epi32( -k ), vLane );
+    const __m256i vIdx    = _mm256_max_epi32( _mm256_srai_epi32( _mm256_add_epi32( _mm256_mullo_epi32( vNegK, vInvAngle ), vRound ), 8 ), _mm256_setzero_si256() );
+    const __m256i vSample = _mm256_and_si256( _mm256_i32gather_epi32( (const int*)refSide, vIdx, 2 ), vMask );
+    const __m256i vPacked = _mm256_permute4x64_epi64( _mm256_packus_epi32( vSample, vSample ), 0x08 );
+    _mm_storeu_si128( (__m128i*)( refMain + k ), _mm256_castsi256_si128( vPacked ) );
+  }
+}
+
+/// transposition of a block of 16-bit samples, width and height multiples of 4
+SIMD_TARGET_SSE41
+static Void xTranspose( const Pel* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int width, Int height )
+{
+  if ( ( ( width | height ) & 7 ) == 0 )
+  {
+    for ( Int y = 0; y < height; y += 8 )
+    {
+      for ( Int x = 0; x < width; x += 8 )
+      {
+        const Pel* src = pSrc + y * srcStride + x;
+        __m128i a[8];
+        __m128i b[8];
+        for ( Int i = 0; i < 8; i++ )
+        {
+          a[i] = _mm_loadu_si128( (const __m128i*)( src + i * srcStride ) );
+        }
+        for ( Int i = 0; i < 4; i++ )
+        {
+          b[i    ] = _mm_unpacklo_epi16( a[2 * i], a[2 * i + 1] );
+          b[i + 4] = _mm_unpackhi_epi16( a[2 * i], a[2 * i + 1] );
+        }
+        // b[0..3]: columns 0-3 of the row pairs, b[4..7]: columns 4-7
+        for ( Int i = 0; i < 8; i += 4 )
+        {
+          const __m128i c0 = _mm_unpacklo_epi32( b[i    ], b[i + 1] );
+          const __m128i c1 = _mm_unpackhi_epi32( b[i    ], b[i + 1] );
+          const __m128i c2 = _mm_unpacklo_epi32( b[i + 2], b[i + 3] );
+          const __m128i c3 = _mm_unpackhi_epi32( b[i + 2], b[i + 3] );
+          Pel* dst = pDst + ( x + i ) * dstStride + y;
+          _mm_storeu_si128( (__m128i*)( dst                 ), _mm_unpacklo_epi64( c0, c2 ) );
+          _mm_storeu_si128( (__m128i*)( dst +     dstStride ), _mm_unpackhi_epi64( c0, c2 ) );
+          _mm_storeu_si128( (__m128i*)( dst + 2 * dstStride ), _mm_unpacklo_epi64( c1, c3 ) );
+          _mm_storeu_si128( (__m128i*)( dst + 3 * dstStride ), _mm_unpackhi_epi64( c1, c3 ) );
+        }
+      }
+    }
+    return;
+  }
+
+  for ( Int y = 0; y < height; y += 4 )
+  {
+    for ( Int x = 0; x < width; x += 4 )
+    {
+      const Pel*    src = pSrc + y * srcStride + x;
+      const __m128i b0  = _mm_unpacklo_epi16( _mm_loadl_epi64( (const __m128i*)( src                 ) ), _mm_loadl_epi64( (const __m128i*)( src +     srcStride ) ) );
+      const __m128i b1  = _mm_unpacklo_epi16( _mm_loadl_epi64( (const __m128i*)( src + 2 * srcStride ) ), _mm_loadl_epi64( (const __m128i*)( src + 3 * srcStride ) ) );
+      const __m128i c0  = _mm_unpacklo_epi32( b0, b1 );
+      const __m128i c1  = _mm_unpackhi_epi32( b0, b1 );
+      Pel* dst = pDst + x * dstStride + y;
+      _mm_storel_epi64( (__m128i*)( dst                 ), c0 );
+      _mm_storel_epi64( (__m128i*)( dst +     dstStride ), _mm_srli_si128( c0, 8 ) );
+      _mm_storel_epi64( (__m128i*)( dst + 2 * dstStride ), c1 );
+      _mm_storel_epi64( (__m128i*)( dst + 3 * dstStride ), _mm_srli_si128( c1, 8 ) );
+    }
+  }
+}
+
+/// boundary filter of the pure vertical (and, transposed, horizontal) mode: the first sample of each row,
+/// refMain[1] + ((refSide[y+1] - refSide[0]) >> 1) clipped to the sample range
+SIMD_TARGET_SSE41
+static Void xEdgeFilterColumn( const Pel* refMain, const Pel* refSide, Pel* pColumn, Int height, Int bitDepth )
+{
+  const __m128i vMain   = _mm_set1_epi16( refMain[1] );
+  const __m128i vCorner = _mm_set1_epi16( refSide[0] );
+  const __m128i vMax    = _mm_set1_epi16( ( 1 << bitDepth ) - 1 );
+  for ( Int y = 0; y < height; y += 4 )
+  {
+    const __m128i vSide = _mm_loadl_epi64( (const __m128i*)( refSide + y + 1 ) );
+    const __m128i vVal  = _mm_add_epi16( vMain, _mm_srai_epi16( _mm_sub_epi16( vSide, vCorner ), 1 ) );
+    _mm_storel_epi64( (__m128i*)( pColumn + y ), _mm_min_epi16( _mm_max_epi16( vVal, _mm_setzero_si128() ), vMax ) );
+  }
+}
+
+SIMD_TARGET_SSE41
+static Void xPredIntraAng( SimdLevel level, Int bitDepth, const Pel* refAbove, const Pel* refLeft, Pel* pTrueDst, Int dstStrideTrue, Int width, Int height, UInt dirMode, Bool bEdgeFilter )
+{
+  static const Int angTable[9]    = {0,    2,    5,   9,  13,  17,  21,  26,  32};
+  static const Int invAngTable[9] = {0, 4096, 1638, 910, 630, 482, 390, 315, 256}; // (256 * 32) / Angle
+
+  const Bool bIsModeVer         = ( dirMode >= 18 );
+  const Int  intraPredAngleMode = ( bIsModeVer ) ? (Int)dirMode - VER_IDX : -( (Int)dirMode - HOR_IDX );
+  const Int  absAngMode         = abs( intraPredAngleMode );
+  const Int  intraPredAngle     = ( intraPredAngleMode < 0 ) ? -angTable[absAngMode] : angTable[absAngMode];
+
+  // swap width/height if we are doing a horizontal mode
+  if ( !bIsModeVer )
+  {
+    std::swap( width, height );
+  }
+  const Pel* refSide = bIsModeVer ? refLeft : refAbove;
+
+  // main reference, with room for its extension to the left
+  Pel  aRefMain[3 * MAX_CU_SIZE + 1];
+  Pel* refMain = aRefMain + MAX_CU_SIZE;
+
+  if ( intraPredAngle < 0 )
+  {
+    const Int invAngle = invAngTable[absAngMode];
+    const Int iFirst   = ( ( height * intraPredAngle ) >> 5 ) + 1;
+    if ( level >= SIMD_AVX2 )
+    {
+      xProjectRefAvx2( refSide, refMain, iFirst, invAngle );
+    }
+    else
+    {
+      Int invAngleSum = 128;       // rounding for (shift by 8)
+      for ( Int k = -1; k >= iFirst; k-- )
+      {
+        invAngleSum += invAngle;
+        refMain[k] = refSide[invAngleSum >> 8];
+      }
+    }
+    ::memcpy( refMain, bIsModeVer ? refAbove : refLeft, ( width + 1 ) * sizeof( Pel ) );
+  }
+  else
+  {
+    ::memcpy( refMain, bIsModeVer ? refAbove : refLeft, ( 2 * width + 1 ) * sizeof( Pel ) );
+  }
+
+  Pel        aTemp[MAX_CU_SIZE * MAX_CU_SIZE];
+  const Int  dstStride = bIsModeVer ? dstStrideTrue : MAX_CU_SIZE;
+  Pel*       pDst      = bIsModeVer ? pTrueDst : aTemp;
+
+  for ( Int y = 0, deltaPos = intraPredAngle; y < height; y++, deltaPos += intraPredAngle )
+  {
+    if ( level >= SIMD_AVX2 )
+    {
+      xPredAngRowAvx2( refMain + ( deltaPos >> 5 ) + 1, pDst + y * dstStride, width, deltaPos & 31 );
+    }
+    else
+    {
+      xPredAngRowSse41( refMain + ( deltaPos >> 5 ) + 1, pDst + y * dstStride, width, deltaPos & 31 );
+    }
+  }
+
+  if ( intraPredAngle == 0 && bEdgeFilter )
+  {
+    Pel aColumn[MAX_CU_SIZE];
+    xEdgeFilterColumn( refMain, refSide, aColumn, height, bitDepth );
+    for ( Int y = 0; y < height; y++ )
+    {
+      pDst[y * dstStride] = aColumn[y];
+    }
+  }
+
+  // flip the block if this is the horizontal mode
+  if ( !bIsModeVer )
+  {
+    xTranspose( aTemp, MAX_CU_SIZE, pTrueDst, dstStrideTrue, width, height );
+  }
+}
+
+// ====================================================================================================================
+// Planar prediction
+// ====================================================================================================================
+
+// The sums of the C++ code are formed directly for each sample:
+//   ((left[y] << shiftHor) + width + (x+1)*(topRight - left[y]) + (top[x] << shiftVer) + (y+1)*(bottomLeft - top[x]))
+//   >> (shiftHor + 1)
+// in 32-bit lanes, a column strip at a time so that the vertical part is accumulated from row to row.
+
+SIMD_TARGET_SSE41
+static inline __m128i xPlanar4( const __m128i& vVer, const __m128i& vXPlus1, Int iHorBase, Int iHorStep, const __m128i& vShift )
+{
+  const __m128i vHor = _mm_add_epi32( _mm_set1_epi32( iHorBase ), _mm_mullo_epi32( vXPlus1, _mm_set1_epi32( iHorStep ) ) );
+  return _mm_sra_epi32( _mm_add_epi32( vHor, vVer ), vShift );
+}
+
+SIMD_TARGET_AVX2
+static inline __m256i xPlanar8( const __m256i& vVer, const __m256i& vXPlus1, Int iHorBase, Int iHorStep, const __m128i& vShift )
+{
+  const __m256i vHor = _mm256_add_epi32( _mm256_set1_epi32( iHorBase ), _mm256_mullo_epi32( vXPlus1, _mm256_set1_epi32( iHorStep ) ) );
+  return _mm256_sra_epi32( _mm256_add_epi32( vHor, vVer ), vShift );
+}
+
+SIMD_TARGET_SSE41
+static Void xPredIntraPlanarSse41( const Pel* refAbove, const Pel* refLeft, Pel* pDst, Int dstStride, Int width, Int height, Int x0, Int shift1Dhor, Int shift1Dver )
+{
+  const Int     topRight   = refAbove[1 + width];
+  const Int     bottomLeft = refLeft[1 + height];
+  const __m128i vShift     = _mm_cvtsi32_si128( shift1Dhor + 1 );
+
+  for ( Int x = x0; x < width; x += 4 )
+  {
+    const __m128i vTop    = _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*)( refAbove + 1 + x ) ) );
+    const __m128i vBottom = _mm_sub_epi32( _mm_set1_epi32( bottomLeft ), vTop );
+    const __m128i vXPlus1 = _mm_setr_epi32( x + 1, x + 2, x + 3, x + 4 );
+    __m128i       vVer    = _mm_slli_epi32( vTop, shift1Dver );
+    for ( Int y = 0; y < height; y++ )
+    {
+      const Int left = refLeft[1 + y];
+      vVer = _mm_add_epi32( vVer, vBottom );
+      const __m128i vVal = xPlanar4( vVer, vXPlus1, ( left << shift1Dhor ) + width, topRight - left, vShift );
+      _mm_storel_epi64( (__m128i*)( pDst + y * dstStride + x ), _mm_packs_epi32( vVal, vVal ) );
+    }
+  }
+}
+
+SIMD_TARGET_AVX2
+static Void xPredIntraPlanarAvx2( const Pel* refAbove, const Pel* refLeft, Pel* pDst, Int dstStride, Int width, Int height, Int shift1Dhor, Int shift1Dver )
+{
+  const Int     topRight   = refAbove[1 + width];
+  const Int     bottomLeft = refLeft[1 + height];
+  const __m128i vShift     = _mm_cvtsi32_si128( shift1Dhor + 1 );
+
+  Int x = 0;
+  for ( ; x + 8 <= width; x += 8 )
+  {
+    const __m256i vTop    = _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i*)( refAbove + 1 + x ) ) );
+    const __m256i vBottom = _mm256_sub_epi32( _mm256_set1_epi32( bottomLeft ), vTop );
+    const __m256i vXPlus1 = _mm256_add_epi32( _mm256_set1_epi32( x + 1 ), _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+    __m256i       vVer    = _mm256_slli_epi32( vTop, shift1Dver );
+    for ( Int y = 0; y < height; y++ )
+    {
+      const Int left = refLeft[1 + y];
+      vVer = _mm256_add_epi32( vVer, vBottom );
+      const __m256i vVal = xPlanar8( vVer, vXPlus1, ( left << shift1Dhor ) + width, topRight - left, vShift );
+      _mm_storeu_si128( (__m128i*)( pDst + y * dstStride + x ), _mm_packs_epi32( _mm256_castsi256_si128( vVal ), _mm256_extracti128_si256( vVal, 1 ) ) );
+    }
+  }
+  if ( x < width )
+  {
+    xPredIntraPlanarSse41( refAbove, refLeft, pDst, dstStride, width, height, x, shift1Dhor, shift1Dver );
+  }
+}
+
+// ====================================================================================================================
+// DC prediction
+// ====================================================================================================================
+
+SIMD_TARGET_SSE41
+static Void xPredIntraDC( const Pel* refAbove, const Pel* refLeft, Pel* pDst, Int dstStride, Int width, Int height, Pel dcVal, Bool bFilter )
+{
+  const __m128i vDc = _mm_set1_epi16( dcVal );
+  for ( Int y = 0; y < height; y++ )
+  {
+    Pel* dst = pDst + y * dstStride;
+    Int  x   = 0;
+    for ( ; x + 8 <= width; x += 8 )
+    {
+      _mm_storeu_si128( (__m128i*)( dst + x ), vDc );
+    }
+    if ( x < width )
+    {
+      _mm_storel_epi64( (__m128i*)( dst + x ), vDc );
+    }
+  }
+
+  if ( bFilter )
+  {
+    // top row (vertical filter) and left column (horizontal filter): (ref + 3*dcVal + 2) >> 2
+    const __m128i vOffset = _mm_set1_epi16( 3 * dcVal + 2 );
+    Pel aColumn[MAX_CU_SIZE];
+    for ( Int x = 0; x < width; x += 4 )
+    {
+      const __m128i vRef = _mm_loadl_epi64( (const __m128i*)( refAbove + 1 + x ) );
+      _mm_storel_epi64( (__m128i*)( pDst + x ), _mm_srli_epi16( _mm_add_epi16( vRef, vOffset ), 2 ) );
+    }
+    for ( Int y = 0; y < height; y += 4 )
+    {
+      const __m128i vRef = _mm_loadl_epi64( (const __m128i*)( refLeft + 1 + y ) );
+      _mm_storel_epi64( (__m128i*)( aColumn + y ), _mm_srli_epi16( _mm_add_epi16( vRef, vOffset ), 2 ) );
+    }
+    for ( Int y = 1; y < height; y++ )
+    {
+      pDst[y * dstStride] = aColumn[y];
+    }
+    // top-left
+    pDst[0] = (Pel)( ( refAbove[1] + refLeft[1] + 2 * dcVal + 2 ) >> 2 );
+  }
+}
+
+#endif // SIMD_X86
+
+// ====================================================================================================================
+// Selection of the kernels
+// ====================================================================================================================
+
+/** angular prediction, see TComPrediction::xPredIntraAng
+ *  \param level       instruction set, at least SIMD_SSE41
+ *  \param bitDepth    bit depth of the samples
+ *  \param refAbove    top-left sample followed by the 2*width samples above the block
+ *  \param refLeft     top-left sample followed by the 2*height samples left of the block
+ *  \param pDst        prediction block
+ *  \param dstStride   stride of the prediction block
+ *  \param width       width of the block, a multiple of 4
+ *  \param height      height of the block, a multiple of 4
+ *  \param dirMode     intra prediction mode, angular (not planar or DC)
+ *  \param bEdgeFilter filter the first row or column of the pure vertical or horizontal mode
+ */
+Void TComPredictionSIMD::predIntraAng( SimdLevel level, Int bitDepth, const Pel* refAbove, const Pel* refLeft, Pel* pDst, Int dstStride, Int width, Int height, UInt dirMode, Bool bEdgeFilter )
+{
+  assert( dirMode != PLANAR_IDX && dirMode != DC_IDX );
+  assert( ( ( width | height ) & 3 ) == 0 );
+#if SIMD_X86
+  xPredIntraAng( level, bitDepth, refAbove, refLeft, pDst, dstStride, width, height, dirMode, bEdgeFilter );
+#endif
+}
+
+/** planar prediction, see TComPrediction::xPredIntraPlanar
+ *  \param level       instruction set, at least SIMD_SSE41
+ *  \param refAbove    top-left sample followed by the 2*width samples above the block
+ *  \param refLeft     top-left sample followed by the 2*height samples left of the block
+ *  \param pDst        prediction block
+ *  \param dstStride   stride of the prediction block
+ *  \param width       width of the block, a multiple of 4
+ *  \param height      height of the block, not smaller than the width
+ */
+Void TComPredictionSIMD::predIntraPlanar( SimdLevel level, const Pel* refAbove, const Pel* refLeft, Pel* pDst, Int dstStride, Int width, Int height )
+{
+  assert( width <= height && ( width & 3 ) == 0 );
+#if SIMD_X86
+  const Int shift1Dhor = g_aucConvertToBit[ width  ] + 2;
+  const Int shift1Dver = g_aucConvertToBit[ height ] + 2;
+  if ( level >= SIMD_AVX2 )
+  {
+    xPredIntraPlanarAvx2( refAbove, refLeft, pDst, dstStride, width, height, shift1Dhor, shift1Dver );
+  }
+  else
+  {
+    xPredIntraPlanarSse41( refAbove, refLeft, pDst, dstStride, width, height, 0, shift1Dhor, shift1Dver );
+  }
+#endif
+}
+
+/** DC prediction with the optional filtering of the top row and left column, see TComPrediction::xDCPredFiltering
+ *  \param level       instruction set, at least SIMD_SSE41
+ *  \param refAbove    top-left sample followed by the 2*width samples above the block
+ *  \param refLeft     top-left sample followed by the 2*height samples left of the block
+ *  \param pDst        prediction block
+ *  \param dstStride   stride of the prediction block
+ *  \param width       width of the block, a multiple of 4
+ *  \param height      height of the block, a multiple of 4
+ *  \param dcVal       DC value, see TComPrediction::predIntraGetPredValDC
+ *  \param bFilter     filter the top row and the left column
+ */
+Void TComPredictionSIMD::predIntraDC( SimdLevel level, const Pel* refAbove, const Pel* refLeft, Pel* pDst, Int dstStride, Int width, Int height, Pel dcVal, Bool bFilter )
+{
+  assert( ( ( width | height ) & 3 ) == 0 );
+#if SIMD_X86
+  xPredIntraDC( refAbove, refLeft, pDst, dstStride, width, height, dcVal, bFilter );
+#endif
+}
+
+//! \}
@@ -0,0 +1,63 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComPredictionSIMD.h
+    \brief    SIMD implementations of the intra prediction (header)
+*/
+
+#ifndef __TCOMPREDICTIONSIMD__
+#define __TCOMPREDICTIONSIMD__
+
+#include "TypeDef.h"
+#include "TComSimd.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Namespace definition
+// ====================================================================================================================
+
+/// SIMD implementations of the intra prediction of TComPrediction, giving the same results as the C++ one.
+/// The reference samples are passed as two arrays starting with the top-left sample: refAbove holds the 2*width samples
+/// above the block, refLeft the 2*height samples left of it.
+namespace TComPredictionSIMD
+{
+  Void predIntraAng   ( SimdLevel level, Int bitDepth, const Pel* refAbove, const Pel* refLeft, Pel* pDst, Int dstStride, Int width, Int height, UInt dirMode, Bool bEdgeFilter );
+  Void predIntraPlanar( SimdLevel level, const Pel* refAbove, const Pel* refLeft, Pel* pDst, Int dstStride, Int width, Int height );
+  Void predIntraDC    ( SimdLevel level, const Pel* refAbove, const Pel* refLeft, Pel* pDst, Int dstStride, Int width, Int height, Pel dcVal, Bool bFilter );
+}// END NAMESPACE DEFINITION TComPredictionSIMD
+
+//! \}
+
+#endif // __TCOMPREDICTIONSIMD__
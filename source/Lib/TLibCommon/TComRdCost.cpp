@@ -39,6 +39,7 @@
 #include <assert.h>
 #include "TComRom.h"
 #include "TComRdCost.h"
+#include "TComRdCostSIMD.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -265,6 +266,10 @@ Void TComRdCost::init()
   m_afpDistortFunc[DF_HADS64 ] = TComRdCost::xGetHADs;
   m_afpDistortFunc[DF_HADS16N] = TComRdCost::xGetHADs;
 
+  m_fpHADsBatchFunc            = TComRdCost::xGetHADsBatch;
+
+  TComRdCostSIMD::setDistortionFunctions( m_afpDistortFunc, m_fpHADsBatchFunc, g_simdLevel );
+
   m_costMode                   = COST_STANDARD_LOSSY;
 
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
@@ -430,6 +435,31 @@ Distortion TComRdCost::calcHAD( Int bitDepth, Pel* pi0, Int iStride0, Pel* pi1,
   return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(bitDepth-8) );
 }
 
+/** Distortion of several candidate blocks against the same original block, e.g. the fractional-sample positions of
+ * the motion estimation. The Hadamard distortion is computed by a function that goes through the original block once
+ * for all candidates, the other distortion functions are called for each candidate.
+ * \param pcDtParam  distortion parameters, pCur is not used
+ * \param apiCur     candidate blocks
+ * \param iNumCur    number of candidate blocks
+ * \param auiDist    returns the distortion of each candidate block
+ */
+Void TComRdCost::getDistBatch( DistParam* pcDtParam, Pel* const* apiCur, Int iNumCur, Distortion* auiDist )
+{
+  if ( pcDtParam->DistFunc == m_afpDistortFunc[DF_HADS] && !pcDtParam->bApplyWeight )
+  {
+    m_fpHADsBatchFunc( pcDtParam, apiCur, iNumCur, auiDist );
+    return;
+  }
+
+  Pel* piCur = pcDtParam->pCur;
+  for ( Int i = 0; i < iNumCur; i++ )
+  {
+    pcDtParam->pCur = apiCur[i];
+    auiDist[i] = pcDtParam->DistFunc( pcDtParam );
+  }
+  pcDtParam->pCur = piCur;
+}
+
 Distortion TComRdCost::getDistPart( Int bitDepth, Pel* piCur, Int iCurStride,  Pel* piOrg, Int iOrgStride, UInt uiBlkWidth, UInt uiBlkHeight, const ComponentID compID, DFunc eDFunc )
 {
   DistParam cDtParam;
@@ -1603,4 +1633,14 @@ Distortion TComRdCost::xGetHADs( DistParam* pcDtParam )
   return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
 }
 
+Void TComRdCost::xGetHADsBatch( DistParam* pcDtParam, Pel* const* apiCur, Int iNumCur, Distortion* auiDist )
+{
+  DistParam cDtParam = *pcDtParam;
+  for ( Int i = 0; i < iNumCur; i++ )
+  {
+    cDtParam.pCur = apiCur[i];
+    auiDist[i] = xGetHADs( &cDtParam );
+  }
+}
+
 //! \}
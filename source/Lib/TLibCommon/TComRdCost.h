@@ -58,6 +58,7 @@ class TComPattern;
 
 // for function pointer
 typedef Distortion (*FpDistFunc) (DistParam*); // TODO: can this pointer be replaced with a reference? - there are no NULL checks on pointer.
+typedef Void       (*FpDistBatchFunc) (DistParam*, Pel* const*, Int, Distortion*);
 
 // ====================================================================================================================
 // Class definition
@@ -107,6 +108,7 @@ private:
   // for distortion
 
   FpDistFunc              m_afpDistortFunc[DF_TOTAL_FUNCTIONS]; // [eDFunc]
+  FpDistBatchFunc         m_fpHADsBatchFunc;                    // Hadamard distortion of several candidate blocks (getDistBatch)
   CostMode                m_costMode;
   Double                  m_distortionWeight[MAX_NUM_COMPONENT]; // only chroma values are used.
   Double                  m_dLambda;
@@ -157,6 +159,9 @@ public:
 
   Distortion calcHAD(Int bitDepth, Pel* pi0, Int iStride0, Pel* pi1, Int iStride1, Int iWidth, Int iHeight );
 
+  // distortion of several candidate blocks (at pcDtParam->iStrideCur) against the original block of pcDtParam
+  Void    getDistBatch( DistParam* pcDtParam, Pel* const* apiCur, Int iNumCur, Distortion* auiDist );
+
   // for motion cost
   UInt    xGetComponentBits( Int iVal );
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
@@ -214,6 +219,7 @@ private:
 #endif
 
   static Distortion xGetHADs          ( DistParam* pcDtParam );
+  static Void       xGetHADsBatch     ( DistParam* pcDtParam, Pel* const* apiCur, Int iNumCur, Distortion* auiDist );
   static Distortion xCalcHADs2x2      ( Pel *piOrg, Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
   static Distortion xCalcHADs4x4      ( Pel *piOrg, Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
   static Distortion xCalcHADs8x8      ( Pel *piOrg, Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
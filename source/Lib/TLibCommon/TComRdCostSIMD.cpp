@@ -0,0 +1,821 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComRdCostSIMD.cpp
+    \brief    SIMD implementations of the distortion functions
+*/
+
+#include "TComRdCostSIMD.h"
+#include "TComRdCostWeightPrediction.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+#if SIMD_X86
+
+// ====================================================================================================================
+// Building blocks
+// ====================================================================================================================
+
+// The samples are 16-bit and at most 12 bits are used (see SIMD_X86), so the difference of two samples, also of the
+// original that is modified for bi-prediction motion estimation, fits into 16 bits. The absolute differences are
+// summed into 32-bit lanes by multiplying them with 1.
+
+/// absolute differences of 4 samples, summed pairwise into 32-bit lanes
+SIMD_TARGET_SSE41
+static inline __m128i xAbsDiff4( const Pel* piOrg, const Pel* piCur )
+{
+  const __m128i vOrg = _mm_loadl_epi64( (const __m128i*)piOrg );
+  const __m128i vCur = _mm_loadl_epi64( (const __m128i*)piCur );
+  return _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( vOrg, vCur ) ), _mm_set1_epi16( 1 ) );
+}
+
+/// absolute differences of 8 samples, summed pairwise into 32-bit lanes
+SIMD_TARGET_SSE41
+static inline __m128i xAbsDiff8( const Pel* piOrg, const Pel* piCur )
+{
+  const __m128i vOrg = _mm_loadu_si128( (const __m128i*)piOrg );
+  const __m128i vCur = _mm_loadu_si128( (const __m128i*)piCur );
+  return _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( vOrg, vCur ) ), _mm_set1_epi16( 1 ) );
+}
+
+/// absolute differences of 16 samples, summed pairwise into 32-bit lanes
+SIMD_TARGET_AVX2
+static inline __m256i xAbsDiff16( const Pel* piOrg, const Pel* piCur )
+{
+  const __m256i vOrg = _mm256_loadu_si256( (const __m256i*)piOrg );
+  const __m256i vCur = _mm256_loadu_si256( (const __m256i*)piCur );
+  return _mm256_madd_epi16( _mm256_abs_epi16( _mm256_sub_epi16( vOrg, vCur ) ), _mm256_set1_epi16( 1 ) );
+}
+
+/// absolute differences of 32 samples, summed pairwise into 32-bit lanes
+SIMD_TARGET_AVX512
+static inline __m512i xAbsDiff32( const Pel* piOrg, const Pel* piCur )
+{
+  const __m512i vOrg = _mm512_loadu_si512( (const void*)piOrg );
+  const __m512i vCur = _mm512_loadu_si512( (const void*)piCur );
+  return _mm512_madd_epi16( _mm512_abs_epi16( _mm512_sub_epi16( vOrg, vCur ) ), _mm512_set1_epi16( 1 ) );
+}
+
+/// sum of the four 32-bit lanes
+SIMD_TARGET_SSE41
+static inline UInt xHorizontalSum( __m128i vSum )
+{
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0x4e ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0xb1 ) );
+  return (UInt)_mm_cvtsi128_si32( vSum );
+}
+
+/// sum of the eight 32-bit lanes
+SIMD_TARGET_AVX2
+static inline UInt xHorizontalSum( __m256i vSum )
+{
+  return xHorizontalSum( _mm_add_epi32( _mm256_castsi256_si128( vSum ), _mm256_extracti128_si256( vSum, 1 ) ) );
+}
+
+// ====================================================================================================================
+// SSE
+// ====================================================================================================================
+
+// The C++ functions shift each squared difference right by (bitDepth - 8) * 2 before it is added. Without the shift
+// (8-bit video) the squares are summed pairwise by a multiply-add, otherwise the 32-bit squares are built from the
+// low and high halves of the 16-bit products and shifted one by one. The sums of the rows are accumulated in 64-bit
+// lanes.
+
+/// squared differences of 4 samples in 32-bit lanes (summed pairwise when bShift is false)
+template<Bool bShift>
+SIMD_TARGET_SSE41
+static inline __m128i xSqrDiff4( const Pel* piOrg, const Pel* piCur, const __m128i& vShift )
+{
+  const __m128i vDiff = _mm_sub_epi16( _mm_loadl_epi64( (const __m128i*)piOrg ), _mm_loadl_epi64( (const __m128i*)piCur ) );
+  if ( !bShift )
+  {
+    return _mm_madd_epi16( vDiff, vDiff );
+  }
+  const __m128i vSqr = _mm_unpacklo_epi16( _mm_mullo_epi16( vDiff, vDiff ), _mm_mulhi_epi16( vDiff, vDiff ) );
+  return _mm_srl_epi32( vSqr, vShift );
+}
+
+/// squared differences of 8 samples, summed into 32-bit lanes
+template<Bool bShift>
+SIMD_TARGET_SSE41
+static inline __m128i xSqrDiff8( const Pel* piOrg, const Pel* piCur, const __m128i& vShift )
+{
+  const __m128i vDiff = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)piOrg ), _mm_loadu_si128( (const __m128i*)piCur ) );
+  if ( !bShift )
+  {
+    return _mm_madd_epi16( vDiff, vDiff );
+  }
+  const __m128i vLo = _mm_mullo_epi16( vDiff, vDiff );
+  const __m128i vHi = _mm_mulhi_epi16( vDiff, vDiff );
+  return _mm_add_epi32( _mm_srl_epi32( _mm_unpacklo_epi16( vLo, vHi ), vShift ),
+                        _mm_srl_epi32( _mm_unpackhi_epi16( vLo, vHi ), vShift ) );
+}
+
+/// squared differences of 16 samples, summed into 32-bit lanes
+template<Bool bShift>
+SIMD_TARGET_AVX2
+static inline __m256i xSqrDiff16( const Pel* piOrg, const Pel* piCur, const __m128i& vShift )
+{
+  const __m256i vDiff = _mm256_sub_epi16( _mm256_loadu_si256( (const __m256i*)piOrg ), _mm256_loadu_si256( (const __m256i*)piCur ) );
+  if ( !bShift )
+  {
+    return _mm256_madd_epi16( vDiff, vDiff );
+  }
+  const __m256i vLo = _mm256_mullo_epi16( vDiff, vDiff );
+  const __m256i vHi = _mm256_mulhi_epi16( vDiff, vDiff );
+  return _mm256_add_epi32( _mm256_srl_epi32( _mm256_unpacklo_epi16( vLo, vHi ), vShift ),
+                           _mm256_srl_epi32( _mm256_unpackhi_epi16( vLo, vHi ), vShift ) );
+}
+
+/// unsigned 32-bit lanes added to the 64-bit lanes of the accumulator
+SIMD_TARGET_SSE41
+static inline __m128i xAccumulate64( const __m128i& vSum64, const __m128i& vSum32 )
+{
+  return _mm_add_epi64( _mm_add_epi64( vSum64, _mm_cvtepu32_epi64( vSum32 ) ), _mm_cvtepu32_epi64( _mm_unpackhi_epi64( vSum32, vSum32 ) ) );
+}
+
+/// sum of the two 64-bit lanes
+SIMD_TARGET_SSE41
+static inline UInt64 xHorizontalSum64( const __m128i& vSum64 )
+{
+  UInt64 auiSum[2];
+  _mm_storeu_si128( (__m128i*)auiSum, vSum64 );
+  return auiSum[0] + auiSum[1];
+}
+
+template<Int iWidth, Bool bShift>
+SIMD_TARGET_SSE41
+static Distortion xSumSqrDiffSse41( const DistParam* pcDtParam, UInt uiShift )
+{
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iCols      = iWidth ? iWidth : pcDtParam->iCols;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg;
+  const Int  iStrideCur = pcDtParam->iStrideCur;
+  const __m128i vShift  = _mm_cvtsi32_si128( uiShift );
+
+  __m128i vSum64 = _mm_setzero_si128();
+
+  for( Int iRows = pcDtParam->iRows; iRows != 0; iRows-- )
+  {
+    __m128i vSum = _mm_setzero_si128();
+    Int n = 0;
+    for( ; n + 8 <= iCols; n += 8 )
+    {
+      vSum = _mm_add_epi32( vSum, xSqrDiff8<bShift>( piOrg + n, piCur + n, vShift ) );
+    }
+    if ( n < iCols )
+    {
+      vSum = _mm_add_epi32( vSum, xSqrDiff4<bShift>( piOrg + n, piCur + n, vShift ) );
+    }
+    vSum64 = xAccumulate64( vSum64, vSum );
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return Distortion( xHorizontalSum64( vSum64 ) );
+}
+
+template<Int iWidth, Bool bShift>
+SIMD_TARGET_AVX2
+static Distortion xSumSqrDiffAvx2( const DistParam* pcDtParam, UInt uiShift )
+{
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iCols      = iWidth ? iWidth : pcDtParam->iCols;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg;
+  const Int  iStrideCur = pcDtParam->iStrideCur;
+  const __m128i vShift  = _mm_cvtsi32_si128( uiShift );
+
+  __m256i vSum64 = _mm256_setzero_si256();
+
+  for( Int iRows = pcDtParam->iRows; iRows != 0; iRows-- )
+  {
+    __m256i vSum    = _mm256_setzero_si256();
+    __m128i vSum128 = _mm_setzero_si128();
+    Int n = 0;
+    for( ; n + 16 <= iCols; n += 16 )
+    {
+      vSum = _mm256_add_epi32( vSum, xSqrDiff16<bShift>( piOrg + n, piCur + n, vShift ) );
+    }
+    if ( n + 8 <= iCols )
+    {
+      vSum128 = _mm_add_epi32( vSum128, xSqrDiff8<bShift>( piOrg + n, piCur + n, vShift ) );
+      n += 8;
+    }
+    if ( n < iCols )
+    {
+      vSum128 = _mm_add_epi32( vSum128, xSqrDiff4<bShift>( piOrg + n, piCur + n, vShift ) );
+    }
+    vSum128 = _mm_add_epi32( vSum128, _mm_add_epi32( _mm256_castsi256_si128( vSum ), _mm256_extracti128_si256( vSum, 1 ) ) );
+    vSum64  = _mm256_add_epi64( vSum64, _mm256_cvtepu32_epi64( vSum128 ) );
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return Distortion( xHorizontalSum64( _mm_add_epi64( _mm256_castsi256_si128( vSum64 ), _mm256_extracti128_si256( vSum64, 1 ) ) ) );
+}
+
+// The kernels follow TComRdCost::xGetSSE4 to xGetSSE16N: iWidth is the block width they are selected for (0 for the
+// multiples of 16 of xGetSSE16N).
+
+template<Int iWidth>
+SIMD_TARGET_SSE41
+static Distortion xGetSSESse41( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
+  }
+  const UInt uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
+  return uiShift ? xSumSqrDiffSse41<iWidth, true>( pcDtParam, uiShift ) : xSumSqrDiffSse41<iWidth, false>( pcDtParam, 0 );
+}
+
+template<Int iWidth>
+SIMD_TARGET_AVX2
+static Distortion xGetSSEAvx2( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
+  }
+  const UInt uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
+  return uiShift ? xSumSqrDiffAvx2<iWidth, true>( pcDtParam, uiShift ) : xSumSqrDiffAvx2<iWidth, false>( pcDtParam, 0 );
+}
+
+// ====================================================================================================================
+// SAD
+// ====================================================================================================================
+
+// The kernels follow TComRdCost::xGetSAD4 to xGetSAD16N: iWidth is the block width they are selected for (0 for the
+// multiples of 16 of xGetSAD16N), only every (1 << iSubShift)-th row is summed and bCheckWeight is false where the
+// C++ function does not branch to the weighted prediction SAD either.
+
+template<Int iWidth, Bool bCheckWeight>
+SIMD_TARGET_SSE41
+static Distortion xGetSADSse41( DistParam* pcDtParam )
+{
+  if ( bCheckWeight && pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iCols      = iWidth ? iWidth : pcDtParam->iCols;
+  Int        iRows      = pcDtParam->iRows;
+  const Int  iSubShift  = pcDtParam->iSubShift;
+  const Int  iSubStep   = ( 1 << iSubShift );
+  const Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+
+  __m128i vSum = _mm_setzero_si128();
+
+  for( ; iRows != 0; iRows-=iSubStep )
+  {
+    Int n = 0;
+    for( ; n + 8 <= iCols; n += 8 )
+    {
+      vSum = _mm_add_epi32( vSum, xAbsDiff8( piOrg + n, piCur + n ) );
+    }
+    if ( n < iCols )
+    {
+      vSum = _mm_add_epi32( vSum, xAbsDiff4( piOrg + n, piCur + n ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  Distortion uiSum = xHorizontalSum( vSum );
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+
+template<Int iWidth, Bool bCheckWeight>
+SIMD_TARGET_AVX2
+static Distortion xGetSADAvx2( DistParam* pcDtParam )
+{
+  if ( bCheckWeight && pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iCols      = iWidth ? iWidth : pcDtParam->iCols;
+  Int        iRows      = pcDtParam->iRows;
+  const Int  iSubShift  = pcDtParam->iSubShift;
+  const Int  iSubStep   = ( 1 << iSubShift );
+  const Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+
+  __m256i vSum    = _mm256_setzero_si256();
+  __m128i vSum128 = _mm_setzero_si128();
+
+  for( ; iRows != 0; iRows-=iSubStep )
+  {
+    Int n = 0;
+    for( ; n + 16 <= iCols; n += 16 )
+    {
+      vSum = _mm256_add_epi32( vSum, xAbsDiff16( piOrg + n, piCur + n ) );
+    }
+    if ( n + 8 <= iCols )
+    {
+      vSum128 = _mm_add_epi32( vSum128, xAbsDiff8( piOrg + n, piCur + n ) );
+      n += 8;
+    }
+    if ( n < iCols )
+    {
+      vSum128 = _mm_add_epi32( vSum128, xAbsDiff4( piOrg + n, piCur + n ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  Distortion uiSum = xHorizontalSum( vSum ) + xHorizontalSum( vSum128 );
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+
+template<Int iWidth, Bool bCheckWeight>
+SIMD_TARGET_AVX512
+static Distortion xGetSADAvx512( DistParam* pcDtParam )
+{
+  if ( bCheckWeight && pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iCols      = iWidth ? iWidth : pcDtParam->iCols;
+  Int        iRows      = pcDtParam->iRows;
+  const Int  iSubShift  = pcDtParam->iSubShift;
+  const Int  iSubStep   = ( 1 << iSubShift );
+  const Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+
+  __m512i vSum    = _mm512_setzero_si512();
+  __m256i vSum256 = _mm256_setzero_si256();
+  __m128i vSum128 = _mm_setzero_si128();
+
+  for( ; iRows != 0; iRows-=iSubStep )
+  {
+    Int n = 0;
+    for( ; n + 32 <= iCols; n += 32 )
+    {
+      vSum = _mm512_add_epi32( vSum, xAbsDiff32( piOrg + n, piCur + n ) );
+    }
+    if ( n + 16 <= iCols )
+    {
+      vSum256 = _mm256_add_epi32( vSum256, xAbsDiff16( piOrg + n, piCur + n ) );
+      n += 16;
+    }
+    if ( n + 8 <= iCols )
+    {
+      vSum128 = _mm_add_epi32( vSum128, xAbsDiff8( piOrg + n, piCur + n ) );
+      n += 8;
+    }
+    if ( n < iCols )
+    {
+      vSum128 = _mm_add_epi32( vSum128, xAbsDiff4( piOrg + n, piCur + n ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  Distortion uiSum = xHorizontalSum( vSum256 ) + xHorizontalSum( vSum128 );
+  Int aiSum[16];
+  _mm512_storeu_si512( (void*)aiSum, vSum );
+  for ( Int i = 0; i < 16; i++ )
+  {
+    uiSum += aiSum[i];
+  }
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+
+// ====================================================================================================================
+// Hadamard
+// ====================================================================================================================
+
+// The transforms work on 32-bit lanes like TComRdCost::xCalcHADs4x4 and xCalcHADs8x8. The Hadamard transform is
+// separable and the SATD is the sum of the absolute values of all coefficients, so the butterflies of each dimension
+// are done across registers, with a transpose in between, and the order and signs of the coefficients do not
+// matter: the results are identical to the C++ functions.
+
+/// 4-point Hadamard butterflies across the registers, for each lane
+SIMD_TARGET_SSE41
+static inline Void xHadamard4( __m128i& v0, __m128i& v1, __m128i& v2, __m128i& v3 )
+{
+  const __m128i t0 = _mm_add_epi32( v0, v2 );
+  const __m128i t1 = _mm_add_epi32( v1, v3 );
+  const __m128i t2 = _mm_sub_epi32( v0, v2 );
+  const __m128i t3 = _mm_sub_epi32( v1, v3 );
+  v0 = _mm_add_epi32( t0, t1 );
+  v1 = _mm_sub_epi32( t0, t1 );
+  v2 = _mm_add_epi32( t2, t3 );
+  v3 = _mm_sub_epi32( t2, t3 );
+}
+
+/// transpose of the 4x4 matrix held by the registers
+SIMD_TARGET_SSE41
+static inline Void xTranspose4x4( __m128i& v0, __m128i& v1, __m128i& v2, __m128i& v3 )
+{
+  const __m128i t0 = _mm_unpacklo_epi32( v0, v1 );
+  const __m128i t1 = _mm_unpacklo_epi32( v2, v3 );
+  const __m128i t2 = _mm_unpackhi_epi32( v0, v1 );
+  const __m128i t3 = _mm_unpackhi_epi32( v2, v3 );
+  v0 = _mm_unpacklo_epi64( t0, t1 );
+  v1 = _mm_unpackhi_epi64( t0, t1 );
+  v2 = _mm_unpacklo_epi64( t2, t3 );
+  v3 = _mm_unpackhi_epi64( t2, t3 );
+}
+
+/// differences of 4 samples in 32-bit lanes
+SIMD_TARGET_SSE41
+static inline __m128i xDiff4( const Pel* piOrg, const Pel* piCur )
+{
+  return _mm_cvtepi16_epi32( _mm_sub_epi16( _mm_loadl_epi64( (const __m128i*)piOrg ), _mm_loadl_epi64( (const __m128i*)piCur ) ) );
+}
+
+/// SATD of a 4x4 block, as TComRdCost::xCalcHADs4x4
+SIMD_TARGET_SSE41
+static Distortion xCalcHADs4x4Sse41( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m128i v0 = xDiff4( piOrg                 , piCur                 );
+  __m128i v1 = xDiff4( piOrg +   iStrideOrg  , piCur +   iStrideCur  );
+  __m128i v2 = xDiff4( piOrg + 2*iStrideOrg  , piCur + 2*iStrideCur  );
+  __m128i v3 = xDiff4( piOrg + 3*iStrideOrg  , piCur + 3*iStrideCur  );
+
+  xHadamard4   ( v0, v1, v2, v3 );
+  xTranspose4x4( v0, v1, v2, v3 );
+  xHadamard4   ( v0, v1, v2, v3 );
+
+  const __m128i vSum = _mm_add_epi32( _mm_add_epi32( _mm_abs_epi32( v0 ), _mm_abs_epi32( v1 ) ),
+                                      _mm_add_epi32( _mm_abs_epi32( v2 ), _mm_abs_epi32( v3 ) ) );
+  return ( xHorizontalSum( vSum ) + 1 ) >> 1;
+}
+
+/// SATD of a 2x2 block, as TComRdCost::xCalcHADs2x2 (only used for the small chroma blocks)
+static Distortion xCalcHADs2x2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  const TCoeff m0 = ( piOrg[0] - piCur[0] ) + ( piOrg[iStrideOrg    ] - piCur[iStrideCur    ] );
+  const TCoeff m1 = ( piOrg[1] - piCur[1] ) + ( piOrg[iStrideOrg + 1] - piCur[iStrideCur + 1] );
+  const TCoeff m2 = ( piOrg[0] - piCur[0] ) - ( piOrg[iStrideOrg    ] - piCur[iStrideCur    ] );
+  const TCoeff m3 = ( piOrg[1] - piCur[1] ) - ( piOrg[iStrideOrg + 1] - piCur[iStrideCur + 1] );
+  return abs( m0 + m1 ) + abs( m0 - m1 ) + abs( m2 + m3 ) + abs( m2 - m3 );
+}
+
+/// 4-point Hadamard butterflies across the registers, for each lane
+SIMD_TARGET_AVX2
+static inline Void xHadamard4( __m256i& v0, __m256i& v1, __m256i& v2, __m256i& v3 )
+{
+  const __m256i t0 = _mm256_add_epi32( v0, v2 );
+  const __m256i t1 = _mm256_add_epi32( v1, v3 );
+  const __m256i t2 = _mm256_sub_epi32( v0, v2 );
+  const __m256i t3 = _mm256_sub_epi32( v1, v3 );
+  v0 = _mm256_add_epi32( t0, t1 );
+  v1 = _mm256_sub_epi32( t0, t1 );
+  v2 = _mm256_add_epi32( t2, t3 );
+  v3 = _mm256_sub_epi32( t2, t3 );
+}
+
+/// 8-point Hadamard butterflies across the registers, for each lane
+SIMD_TARGET_AVX2
+static inline Void xHadamard8( __m256i v[8] )
+{
+  for ( Int i = 0; i < 4; i++ )
+  {
+    const __m256i t = v[i];
+    v[i    ] = _mm256_add_epi32( t, v[i + 4] );
+    v[i + 4] = _mm256_sub_epi32( t, v[i + 4] );
+  }
+  xHadamard4( v[0], v[1], v[2], v[3] );
+  xHadamard4( v[4], v[5], v[6], v[7] );
+}
+
+/// transpose of the two 4x4 matrices held by the lower and by the upper 128-bit halves of the registers
+SIMD_TARGET_AVX2
+static inline Void xTranspose4x4( __m256i& v0, __m256i& v1, __m256i& v2, __m256i& v3 )
+{
+  const __m256i t0 = _mm256_unpacklo_epi32( v0, v1 );
+  const __m256i t1 = _mm256_unpacklo_epi32( v2, v3 );
+  const __m256i t2 = _mm256_unpackhi_epi32( v0, v1 );
+  const __m256i t3 = _mm256_unpackhi_epi32( v2, v3 );
+  v0 = _mm256_unpacklo_epi64( t0, t1 );
+  v1 = _mm256_unpackhi_epi64( t0, t1 );
+  v2 = _mm256_unpacklo_epi64( t2, t3 );
+  v3 = _mm256_unpackhi_epi64( t2, t3 );
+}
+
+/// transpose of the 8x8 matrix held by the registers
+SIMD_TARGET_AVX2
+static inline Void xTranspose8x8( __m256i v[8] )
+{
+  xTranspose4x4( v[0], v[1], v[2], v[3] );
+  xTranspose4x4( v[4], v[5], v[6], v[7] );
+  for ( Int i = 0; i < 4; i++ )
+  {
+    const __m256i t = v[i];
+    v[i    ] = _mm256_permute2x128_si256( t, v[i + 4], 0x20 );
+    v[i + 4] = _mm256_permute2x128_si256( t, v[i + 4], 0x31 );
+  }
+}
+
+/// differences of 8 samples in 32-bit lanes
+SIMD_TARGET_AVX2
+static inline __m256i xDiff8( const Pel* piOrg, const Pel* piCur )
+{
+  return _mm256_cvtepi16_epi32( _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)piOrg ), _mm_loadu_si128( (const __m128i*)piCur ) ) );
+}
+
+/// sum of the absolute values of the coefficients of the transformed 8x8 block
+SIMD_TARGET_AVX2
+static inline UInt xSumAbs8x8( const __m256i v[8] )
+{
+  __m256i vSum = _mm256_abs_epi32( v[0] );
+  for ( Int i = 1; i < 8; i++ )
+  {
+    vSum = _mm256_add_epi32( vSum, _mm256_abs_epi32( v[i] ) );
+  }
+  return xHorizontalSum( vSum );
+}
+
+/// SATD of two horizontally adjacent 4x4 blocks, each as TComRdCost::xCalcHADs4x4
+SIMD_TARGET_AVX2
+static Distortion xCalcHADs4x4PairAvx2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m256i v0 = xDiff8( piOrg                 , piCur                 );
+  __m256i v1 = xDiff8( piOrg +   iStrideOrg  , piCur +   iStrideCur  );
+  __m256i v2 = xDiff8( piOrg + 2*iStrideOrg  , piCur + 2*iStrideCur  );
+  __m256i v3 = xDiff8( piOrg + 3*iStrideOrg  , piCur + 3*iStrideCur  );
+
+  xHadamard4   ( v0, v1, v2, v3 );
+  xTranspose4x4( v0, v1, v2, v3 );
+  xHadamard4   ( v0, v1, v2, v3 );
+
+  const __m256i vSum = _mm256_add_epi32( _mm256_add_epi32( _mm256_abs_epi32( v0 ), _mm256_abs_epi32( v1 ) ),
+                                         _mm256_add_epi32( _mm256_abs_epi32( v2 ), _mm256_abs_epi32( v3 ) ) );
+  const UInt uiSumLeft  = xHorizontalSum( _mm256_castsi256_si128( vSum ) );
+  const UInt uiSumRight = xHorizontalSum( _mm256_extracti128_si256( vSum, 1 ) );
+  return ( ( uiSumLeft + 1 ) >> 1 ) + ( ( uiSumRight + 1 ) >> 1 );
+}
+
+/// SATD of an 8x8 block, as TComRdCost::xCalcHADs8x8
+SIMD_TARGET_AVX2
+static Distortion xCalcHADs8x8Avx2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m256i v[8];
+  for ( Int i = 0; i < 8; i++ )
+  {
+    v[i] = xDiff8( piOrg + i*iStrideOrg, piCur + i*iStrideCur );
+  }
+
+  xHadamard8   ( v );
+  xTranspose8x8( v );
+  xHadamard8   ( v );
+
+  return ( xSumAbs8x8( v ) + 2 ) >> 2;
+}
+
+SIMD_TARGET_AVX2
+static Distortion xGetHADsAvx2( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetHADsw( pcDtParam );
+  }
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iRows      = pcDtParam->iRows;
+  const Int  iCols      = pcDtParam->iCols;
+  const Int  iStrideCur = pcDtParam->iStrideCur;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg;
+
+  assert( pcDtParam->iStep == 1 );
+
+  Distortion uiSum = 0;
+
+  if( ( iRows % 8 == 0) && (iCols % 8 == 0) )
+  {
+    for ( Int y = 0; y < iRows; y += 8 )
+    {
+      for ( Int x = 0; x < iCols; x += 8 )
+      {
+        uiSum += xCalcHADs8x8Avx2( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg<<3;
+      piCur += iStrideCur<<3;
+    }
+  }
+  else if( ( iRows % 4 == 0) && (iCols % 4 == 0) )
+  {
+    for ( Int y = 0; y < iRows; y += 4 )
+    {
+      Int x = 0;
+      for ( ; x + 8 <= iCols; x += 8 )
+      {
+        uiSum += xCalcHADs4x4PairAvx2( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      if ( x < iCols )
+      {
+        uiSum += xCalcHADs4x4Sse41( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg<<2;
+      piCur += iStrideCur<<2;
+    }
+  }
+  else if( ( iRows % 2 == 0) && (iCols % 2 == 0) )
+  {
+    for ( Int y = 0; y < iRows; y += 2 )
+    {
+      for ( Int x = 0; x < iCols; x += 2 )
+      {
+        uiSum += xCalcHADs2x2( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += iStrideOrg<<1;
+      piCur += iStrideCur<<1;
+    }
+  }
+  else
+  {
+    assert(false);
+  }
+
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+
+/** Hadamard distortion of several candidate blocks against the same original block. When the block is made of 8x8
+ * blocks, the rows of each original 8x8 block are loaded once and kept in registers for all candidates.
+ */
+SIMD_TARGET_AVX2
+static Void xGetHADsBatchAvx2( DistParam* pcDtParam, Pel* const* apiCur, Int iNumCur, Distortion* auiDist )
+{
+  const Int iRows = pcDtParam->iRows;
+  const Int iCols = pcDtParam->iCols;
+
+  if( ( iRows % 8 != 0) || (iCols % 8 != 0) )
+  {
+    DistParam cDtParam = *pcDtParam;
+    for ( Int i = 0; i < iNumCur; i++ )
+    {
+      cDtParam.pCur = apiCur[i];
+      auiDist[i] = xGetHADsAvx2( &cDtParam );
+    }
+    return;
+  }
+
+  const Int iStrideCur = pcDtParam->iStrideCur;
+  const Int iStrideOrg = pcDtParam->iStrideOrg;
+
+  assert( pcDtParam->iStep == 1 );
+
+  for ( Int i = 0; i < iNumCur; i++ )
+  {
+    auiDist[i] = 0;
+  }
+
+  for ( Int y = 0; y < iRows; y += 8 )
+  {
+    for ( Int x = 0; x < iCols; x += 8 )
+    {
+      const Pel* piOrg = pcDtParam->pOrg + y*iStrideOrg + x;
+      __m128i avOrg[8];
+      for ( Int k = 0; k < 8; k++ )
+      {
+        avOrg[k] = _mm_loadu_si128( (const __m128i*)( piOrg + k*iStrideOrg ) );
+      }
+
+      for ( Int i = 0; i < iNumCur; i++ )
+      {
+        const Pel* piCur = apiCur[i] + y*iStrideCur + x;
+        __m256i v[8];
+        for ( Int k = 0; k < 8; k++ )
+        {
+          v[k] = _mm256_cvtepi16_epi32( _mm_sub_epi16( avOrg[k], _mm_loadu_si128( (const __m128i*)( piCur + k*iStrideCur ) ) ) );
+        }
+
+        xHadamard8   ( v );
+        xTranspose8x8( v );
+        xHadamard8   ( v );
+
+        auiDist[i] += ( xSumAbs8x8( v ) + 2 ) >> 2;
+      }
+    }
+  }
+
+  for ( Int i = 0; i < iNumCur; i++ )
+  {
+    auiDist[i] >>= DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
+  }
+}
+
+#endif // SIMD_X86
+
+// ====================================================================================================================
+// Selection of the kernels
+// ====================================================================================================================
+
+#if AMP_SAD
+#define SET_SAD_FUNCTIONS_AMP( xGetSADKernel )                                     \
+  afpDistortFunc[DF_SAD12  ] = afpDistortFunc[DF_SADS12 ] = xGetSADKernel<12, true>; \
+  afpDistortFunc[DF_SAD24  ] = afpDistortFunc[DF_SADS24 ] = xGetSADKernel<24, true>; \
+  afpDistortFunc[DF_SAD48  ] = afpDistortFunc[DF_SADS48 ] = xGetSADKernel<48, true>;
+#else
+#define SET_SAD_FUNCTIONS_AMP( xGetSADKernel )
+#endif
+
+#define SET_SAD_FUNCTIONS( xGetSADKernel )                                         \
+  afpDistortFunc[DF_SAD4   ] = afpDistortFunc[DF_SADS4  ] = xGetSADKernel< 4, true>; \
+  afpDistortFunc[DF_SAD8   ] = afpDistortFunc[DF_SADS8  ] = xGetSADKernel< 8, true>; \
+  afpDistortFunc[DF_SAD16  ] = afpDistortFunc[DF_SADS16 ] = xGetSADKernel<16, true>; \
+  afpDistortFunc[DF_SAD32  ] = afpDistortFunc[DF_SADS32 ] = xGetSADKernel<32, true>; \
+  afpDistortFunc[DF_SAD64  ] = afpDistortFunc[DF_SADS64 ] = xGetSADKernel<64, true>; \
+  afpDistortFunc[DF_SAD16N ] = afpDistortFunc[DF_SADS16N] = xGetSADKernel< 0, false>; \
+  SET_SAD_FUNCTIONS_AMP( xGetSADKernel )
+
+#define SET_SSE_FUNCTIONS( xGetSSEKernel )                                         \
+  afpDistortFunc[DF_SSE4   ] = xGetSSEKernel< 4>;                                   \
+  afpDistortFunc[DF_SSE8   ] = xGetSSEKernel< 8>;                                   \
+  afpDistortFunc[DF_SSE16  ] = xGetSSEKernel<16>;                                   \
+  afpDistortFunc[DF_SSE32  ] = xGetSSEKernel<32>;                                   \
+  afpDistortFunc[DF_SSE64  ] = xGetSSEKernel<64>;                                   \
+  afpDistortFunc[DF_SSE16N ] = xGetSSEKernel< 0>;
+
+#define SET_HAD_FUNCTIONS( xGetHADsKernel, xGetHADsBatchKernel )                    \
+  afpDistortFunc[DF_HADS   ] = xGetHADsKernel;                                      \
+  afpDistortFunc[DF_HADS4  ] = xGetHADsKernel;                                      \
+  afpDistortFunc[DF_HADS8  ] = xGetHADsKernel;                                      \
+  afpDistortFunc[DF_HADS16 ] = xGetHADsKernel;                                      \
+  afpDistortFunc[DF_HADS32 ] = xGetHADsKernel;                                      \
+  afpDistortFunc[DF_HADS64 ] = xGetHADsKernel;                                      \
+  afpDistortFunc[DF_HADS16N] = xGetHADsKernel;                                      \
+  rfpHADsBatchFunc           = xGetHADsBatchKernel;
+
+/** replace the C++ distortion functions by the SIMD kernels of the given level, the ones that do not have a kernel
+ * for the level are left alone. The general SSE and SAD (DF_SSE, DF_SAD, DF_SADS) work on any block width and stay
+ * in C++, the Hadamard kernels need AVX2 and AVX-512 uses the AVX2 kernels except for the SAD.
+ * \param afpDistortFunc    function table of TComRdCost, already filled with the C++ functions
+ * \param rfpHADsBatchFunc  Hadamard distortion of several candidate blocks of TComRdCost
+ * \param level             instruction set to be used
+ */
+Void TComRdCostSIMD::setDistortionFunctions( FpDistFunc* afpDistortFunc, FpDistBatchFunc& rfpHADsBatchFunc, SimdLevel level )
+{
+#if SIMD_X86
+  switch ( level )
+  {
+    case SIMD_AVX512:
+      SET_SSE_FUNCTIONS( xGetSSEAvx2 )
+      SET_SAD_FUNCTIONS( xGetSADAvx512 )
+      SET_HAD_FUNCTIONS( xGetHADsAvx2, xGetHADsBatchAvx2 )
+      break;
+    case SIMD_AVX2:
+      SET_SSE_FUNCTIONS( xGetSSEAvx2 )
+      SET_SAD_FUNCTIONS( xGetSADAvx2 )
+      SET_HAD_FUNCTIONS( xGetHADsAvx2, xGetHADsBatchAvx2 )
+      break;
+    case SIMD_SSE41:
+      SET_SSE_FUNCTIONS( xGetSSESse41 )
+      SET_SAD_FUNCTIONS( xGetSADSse41 )
+      break;
+    default:
+      break;
+  }
+#endif
+}
+
+#undef SET_HAD_FUNCTIONS
+#undef SET_SSE_FUNCTIONS
+#undef SET_SAD_FUNCTIONS
+#undef SET_SAD_FUNCTIONS_AMP
+
+//! \}
@@ -36,6 +36,7 @@
 */
 
 #include "TComSampleAdaptiveOffset.h"
+#include "TComSampleAdaptiveOffsetSIMD.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -106,18 +107,13 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 TComSampleAdaptiveOffset::TComSampleAdaptiveOffset()
 {
   m_tempPicYuv = NULL;
-  m_lineBufWidth = 0;
-  m_signLineBuf1 = NULL;
-  m_signLineBuf2 = NULL;
+  m_pcThreadPool = NULL;
 }
 
 
 TComSampleAdaptiveOffset::~TComSampleAdaptiveOffset()
 {
   destroy();
-
-  if (m_signLineBuf1) delete[] m_signLineBuf1; m_signLineBuf1 = NULL;
-  if (m_signLineBuf2) delete[] m_signLineBuf2; m_signLineBuf2 = NULL;
 }
 
 Void TComSampleAdaptiveOffset::create( Int picWidth, Int picHeight, ChromaFormat format, UInt maxCUWidth, UInt maxCUHeight, UInt maxCUDepth, UInt lumaBitShift, UInt chromaBitShift )
@@ -310,16 +306,9 @@ Void TComSampleAdaptiveOffset::offsetBlock(ComponentID compIdx, Int typeIdx, Int
                                           , Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,  Int width, Int height
                                           , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail)
 {
-  if(m_lineBufWidth != m_maxCUWidth)
-  {
-    m_lineBufWidth = m_maxCUWidth;
-
-    if (m_signLineBuf1) delete[] m_signLineBuf1; m_signLineBuf1 = NULL;
-    m_signLineBuf1 = new Char[m_lineBufWidth+1];
-
-    if (m_signLineBuf2) delete[] m_signLineBuf2; m_signLineBuf2 = NULL;
-    m_signLineBuf2 = new Char[m_lineBufWidth+1];
-  }
+  // sign line buffers on the stack, so that CTUs can be processed by several threads at the same time
+  Char signLineBuf1[MAX_CU_SIZE+1];
+  Char signLineBuf2[MAX_CU_SIZE+1];
 
   const Int maxSampleValueIncl = (1<< g_bitDepth[toChannelType(compIdx)] )-1;
 
@@ -337,6 +326,13 @@ Void TComSampleAdaptiveOffset::offsetBlock(ComponentID compIdx, Int typeIdx, Int
       offset += 2;
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
+#if SIMD_X86
+      if ( g_simdLevel >= SIMD_SSE41 )
+      {
+        TComSampleAdaptiveOffsetSIMD::offsetEdge( g_simdLevel, srcLine, srcStride, resLine, resStride, startX, endX, height, 1, offset, maxSampleValueIncl );
+        break;
+      }
+#endif
       for (y=0; y< height; y++)
       {
         signLeft = (Char)sgn(srcLine[startX] - srcLine[startX-1]);
@@ -357,7 +353,7 @@ Void TComSampleAdaptiveOffset::offsetBlock(ComponentID compIdx, Int typeIdx, Int
   case SAO_TYPE_EO_90:
     {
       offset += 2;
-      Char *signUpLine = m_signLineBuf1;
+      Char *signUpLine = signLineBuf1;
 
       startY = isAboveAvail ? 0 : 1;
       endY   = isBelowAvail ? height : height-1;
@@ -366,6 +362,13 @@ Void TComSampleAdaptiveOffset::offsetBlock(ComponentID compIdx, Int typeIdx, Int
         srcLine += srcStride;
         resLine += resStride;
       }
+#if SIMD_X86
+      if ( g_simdLevel >= SIMD_SSE41 )
+      {
+        TComSampleAdaptiveOffsetSIMD::offsetEdge( g_simdLevel, srcLine, srcStride, resLine, resStride, 0, width, endY - startY, srcStride, offset, maxSampleValueIncl );
+        break;
+      }
+#endif
 
       Pel* srcLineAbove= srcLine- srcStride;
       for (x=0; x< width; x++)
@@ -397,11 +400,26 @@ Void TComSampleAdaptiveOffset::offsetBlock(ComponentID compIdx, Int typeIdx, Int
       offset += 2;
       Char *signUpLine, *signDownLine, *signTmpLine;
 
-      signUpLine  = m_signLineBuf1;
-      signDownLine= m_signLineBuf2;
+      signUpLine  = signLineBuf1;
+      signDownLine= signLineBuf2;
 
       startX = isLeftAvail ? 0 : 1 ;
       endX   = isRightAvail ? width : (width-1);
+#if SIMD_X86
+      if ( g_simdLevel >= SIMD_SSE41 )
+      {
+        // first line, middle lines and last line
+        const Int neighbourOffset = srcStride + 1;
+        TComSampleAdaptiveOffsetSIMD::offsetEdge( g_simdLevel, srcLine, srcStride, resLine, resStride, isAboveLeftAvail ? 0 : 1, isAboveAvail ? endX : 1, 1,
+                                                  neighbourOffset, offset, maxSampleValueIncl );
+        TComSampleAdaptiveOffsetSIMD::offsetEdge( g_simdLevel, srcLine + srcStride, srcStride, resLine + resStride, resStride, startX, endX, height - 2,
+                                                  neighbourOffset, offset, maxSampleValueIncl );
+        TComSampleAdaptiveOffsetSIMD::offsetEdge( g_simdLevel, srcLine + (height-1)*srcStride, srcStride, resLine + (height-1)*resStride, resStride,
+                                                  isBelowAvail ? startX : (width -1), isBelowRightAvail ? width : (width -1), 1,
+                                                  neighbourOffset, offset, maxSampleValueIncl );
+        break;
+      }
+#endif
 
       //prepare 2nd line's upper sign
       Pel* srcLineBelow= srcLine+ srcStride;
@@ -462,10 +480,25 @@ Void TComSampleAdaptiveOffset::offsetBlock(ComponentID compIdx, Int typeIdx, Int
   case SAO_TYPE_EO_45:
     {
       offset += 2;
-      Char *signUpLine = m_signLineBuf1+1;
+      Char *signUpLine = signLineBuf1+1;
 
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
+#if SIMD_X86
+      if ( g_simdLevel >= SIMD_SSE41 )
+      {
+        // first line, middle lines and last line
+        const Int neighbourOffset = srcStride - 1;
+        TComSampleAdaptiveOffsetSIMD::offsetEdge( g_simdLevel, srcLine, srcStride, resLine, resStride, isAboveAvail ? startX : (width -1), isAboveRightAvail ? width : (width-1), 1,
+                                                  neighbourOffset, offset, maxSampleValueIncl );
+        TComSampleAdaptiveOffsetSIMD::offsetEdge( g_simdLevel, srcLine + srcStride, srcStride, resLine + resStride, resStride, startX, endX, height - 2,
+                                                  neighbourOffset, offset, maxSampleValueIncl );
+        TComSampleAdaptiveOffsetSIMD::offsetEdge( g_simdLevel, srcLine + (height-1)*srcStride, srcStride, resLine + (height-1)*resStride, resStride,
+                                                  isBelowLeftAvail ? 0 : 1, isBelowAvail ? endX : 1, 1,
+                                                  neighbourOffset, offset, maxSampleValueIncl );
+        break;
+      }
+#endif
 
       //prepare 2nd line upper sign
       Pel* srcLineBelow= srcLine+ srcStride;
@@ -519,6 +552,13 @@ Void TComSampleAdaptiveOffset::offsetBlock(ComponentID compIdx, Int typeIdx, Int
   case SAO_TYPE_BO:
     {
       const Int shiftBits = g_bitDepth[toChannelType(compIdx)] - NUM_SAO_BO_CLASSES_LOG2;
+#if SIMD_X86
+      if ( g_simdLevel >= SIMD_SSE41 )
+      {
+        TComSampleAdaptiveOffsetSIMD::offsetBand( g_simdLevel, srcLine, srcStride, resLine, resStride, width, height, shiftBits, offset, maxSampleValueIncl );
+        break;
+      }
+#endif
       for (y=0; y< height; y++)
       {
         for (x=0; x< width; x++)
@@ -606,10 +646,86 @@ Void TComSampleAdaptiveOffset::SAOProcess(TComPic* pDecPic)
   TComPicYuv* resYuv = pDecPic->getPicYuvRec();
   TComPicYuv* srcYuv = m_tempPicYuv;
   resYuv->copyToPic(srcYuv);
-  for(Int ctuRsAddr= 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
+  offsetCtuRows(srcYuv, resYuv, pDecPic->getPicSym()->getSAOBlkParam(), pDecPic);
+}
+
+/** copy a CTU row of the deblocked picture to the unfiltered copy read by SAOProcessCtuRow. The row must not be
+ *  changed by the deblocking anymore, i.e. the CTU row below it must be deblocked.
+ * \param pDecPic  picture
+ * \param ctuRow   CTU row
+ */
+Void TComSampleAdaptiveOffset::copyDeblockedCtuRow(TComPic* pDecPic, Int ctuRow)
+{
+  TComPicYuv* resYuv = pDecPic->getPicYuvRec();
+  const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
+  for(Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+  {
+    const ComponentID component = ComponentID(compIdx);
+    const UInt csx = resYuv->getComponentScaleX(component);
+    const UInt csy = resYuv->getComponentScaleY(component);
+    const Int  startY = (ctuRow*m_maxCUHeight) >> csy;
+    const Int  endY   = std::min((ctuRow+1)*m_maxCUHeight, m_picHeight) >> csy;
+    const Int  width  = m_picWidth >> csx;
+    const Int  resStride = resYuv->getStride(component);
+    const Int  srcStride = m_tempPicYuv->getStride(component);
+    const Pel* resLine = resYuv->getAddr(component) + startY*resStride;
+    Pel*       srcLine = m_tempPicYuv->getAddr(component) + startY*srcStride;
+    for(Int y = startY; y < endY; y++, resLine += resStride, srcLine += srcStride)
+    {
+      ::memcpy(srcLine, resLine, sizeof(Pel)*width);
+    }
+  }
+}
+
+/** reconstruct the SAO parameters of a CTU row and apply them. The CTU rows must be processed in order, and the
+ *  CTU rows above, at and below the row must have been copied with copyDeblockedCtuRow.
+ * \param pDecPic  picture
+ * \param ctuRow   CTU row
+ */
+Void TComSampleAdaptiveOffset::SAOProcessCtuRow(TComPic* pDecPic, Int ctuRow)
+{
+  SAOBlkParam* saoBlkParams = pDecPic->getPicSym()->getSAOBlkParam();
+  for(Int ctuRsAddr= ctuRow*m_numCTUInWidth; ctuRsAddr < (ctuRow+1)*m_numCTUInWidth; ctuRsAddr++)
+  {
+    SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES] = { NULL };
+    getMergeList(pDecPic, ctuRsAddr, saoBlkParams, mergeList);
+
+    reconstructBlkSAOParam(saoBlkParams[ctuRsAddr], mergeList);
+
+    offsetCTU(ctuRsAddr, m_tempPicYuv, pDecPic->getPicYuvRec(), saoBlkParams[ctuRsAddr], pDecPic);
+  }
+}
+
+Void TComSampleAdaptiveOffset::offsetCtuRow(Int ctuRow, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* saoBlkParams, TComPic* pPic)
+{
+  for(Int ctuRsAddr= ctuRow*m_numCTUInWidth; ctuRsAddr < (ctuRow+1)*m_numCTUInWidth; ctuRsAddr++)
+  {
+    offsetCTU(ctuRsAddr, srcYuv, resYuv, saoBlkParams[ctuRsAddr], pPic);
+  }
+}
+
+/** apply the SAO of all CTUs. The CTUs only read the unfiltered copy srcYuv, so the CTU rows are processed in parallel
+ *  when there is a thread pool.
+ */
+Void TComSampleAdaptiveOffset::offsetCtuRows(TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* saoBlkParams, TComPic* pPic)
+{
+  if (m_pcThreadPool == NULL)
+  {
+    for(Int ctuRsAddr= 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
+    {
+      offsetCTU(ctuRsAddr, srcYuv, resYuv, saoBlkParams[ctuRsAddr], pPic);
+    } //ctu
+    return;
+  }
+
+  std::vector<TComSaoOffsetRowTask> tasks(m_numCTUInHeight);
+  TComTaskGroup group;
+  for(Int ctuRow = 0; ctuRow < m_numCTUInHeight; ctuRow++)
   {
-    offsetCTU(ctuRsAddr, srcYuv, resYuv, (pDecPic->getPicSym()->getSAOBlkParam())[ctuRsAddr], pDecPic);
-  } //ctu
+    tasks[ctuRow].init(this, ctuRow, srcYuv, resYuv, saoBlkParams, pPic);
+    m_pcThreadPool->submit(&tasks[ctuRow], &group);
+  }
+  m_pcThreadPool->wait(&group);
 }
 
 
@@ -621,20 +737,31 @@ Void TComSampleAdaptiveOffset::SAOProcess(TComPic* pDecPic)
  */
 Void TComSampleAdaptiveOffset::PCMLFDisableProcess (TComPic* pcPic)
 {
-  xPCMRestoration(pcPic);
+  xPCMRestoration(pcPic, 0, pcPic->getNumberOfCtusInFrame());
+}
+
+/** PCM LF disable process of the CTUs of one CTU row, after SAOProcessCtuRow.
+ * \param pcPic  picture (TComPic) pointer
+ * \param ctuRow CTU row
+ */
+Void TComSampleAdaptiveOffset::PCMLFDisableProcessCtuRow (TComPic* pcPic, Int ctuRow)
+{
+  xPCMRestoration(pcPic, ctuRow*m_numCTUInWidth, (ctuRow+1)*m_numCTUInWidth);
 }
 
-/** Picture-level PCM restoration.
+/** PCM restoration of a range of CTUs.
  * \param pcPic picture (TComPic) pointer
+ * \param firstCtuRsAddr first CTU, in raster scan
+ * \param endCtuRsAddr   CTU after the last one, in raster scan
  * \returns Void
  */
-Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic)
+Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic, UInt firstCtuRsAddr, UInt endCtuRsAddr)
 {
   Bool  bPCMFilter = (pcPic->getSlice(0)->getSPS()->getUsePCM() && pcPic->getSlice(0)->getSPS()->getPCMFilterDisableFlag())? true : false;
 
   if(bPCMFilter || pcPic->getSlice(0)->getPPS()->getTransquantBypassEnableFlag())
   {
-    for( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame() ; ctuRsAddr++ )
+    for( UInt ctuRsAddr = firstCtuRsAddr; ctuRsAddr < endCtuRsAddr; ctuRsAddr++ )
     {
       TComDataCU* pcCU = pcPic->getCtu(ctuRsAddr);
 
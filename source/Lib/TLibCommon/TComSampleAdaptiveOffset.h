@@ -40,6 +40,7 @@
 
 #include "CommonDef.h"
 #include "TComPic.h"
+#include "TComThreadPool.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -71,6 +72,10 @@ public:
   Void destroy();
   Void reconstructBlkSAOParams(TComPic* pic, SAOBlkParam* saoBlkParams);
   Void PCMLFDisableProcess (TComPic* pcPic);
+  Void copyDeblockedCtuRow(TComPic* pDecPic, Int ctuRow);       ///< per CTU row alternative to SAOProcess, see TDecGop
+  Void SAOProcessCtuRow(TComPic* pDecPic, Int ctuRow);
+  Void PCMLFDisableProcessCtuRow(TComPic* pcPic, Int ctuRow);
+  Void setThreadPool(TComThreadPool* pcThreadPool) { m_pcThreadPool = pcThreadPool; } ///< process the CTU rows with the threads of a pool (NULL: serially)
 protected:
   Void offsetBlock(ComponentID compIdx, Int typeIdx, Int* offset, Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,  Int width, Int height
                   , Bool isLeftAvail, Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail);
@@ -78,7 +83,9 @@ protected:
   Void reconstructBlkSAOParam(SAOBlkParam& recParam, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   Int  getMergeList(TComPic* pic, Int ctuRsAddr, SAOBlkParam* blkParams, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   Void offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam& saoblkParam, TComPic* pPic);
-  Void xPCMRestoration(TComPic* pcPic);
+  Void offsetCtuRow(Int ctuRow, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* saoBlkParams, TComPic* pPic);
+  Void offsetCtuRows(TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* saoBlkParams, TComPic* pPic);
+  Void xPCMRestoration(TComPic* pcPic, UInt firstCtuRsAddr, UInt endCtuRsAddr);
   Void xPCMCURestoration ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth );
   Void xPCMSampleRestoration (TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, ComponentID component);
 protected:
@@ -91,14 +98,32 @@ protected:
   Int m_numCTUInWidth;
   Int m_numCTUInHeight;
   Int m_numCTUsPic;
+  TComThreadPool* m_pcThreadPool;
 
-
-  Int m_lineBufWidth;
-  Char* m_signLineBuf1;
-  Char* m_signLineBuf2;
   ChromaFormat m_chromaFormatIDC;
 private:
   Bool m_picSAOEnabled[MAX_NUM_COMPONENT];
+
+  friend class TComSaoOffsetRowTask;
+};
+
+/// SAO offsetting of one CTU row, run by the thread pool
+class TComSaoOffsetRowTask : public TComTask
+{
+public:
+  TComSaoOffsetRowTask() : m_pcSAO(NULL), m_ctuRow(0), m_srcYuv(NULL), m_resYuv(NULL), m_saoBlkParams(NULL), m_pPic(NULL) {}
+  Void init(TComSampleAdaptiveOffset* pcSAO, Int ctuRow, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* saoBlkParams, TComPic* pPic)
+  {
+    m_pcSAO = pcSAO; m_ctuRow = ctuRow; m_srcYuv = srcYuv; m_resYuv = resYuv; m_saoBlkParams = saoBlkParams; m_pPic = pPic;
+  }
+  Void run(Int iThreadIdx) { m_pcSAO->offsetCtuRow(m_ctuRow, m_srcYuv, m_resYuv, m_saoBlkParams, m_pPic); }
+private:
+  TComSampleAdaptiveOffset* m_pcSAO;
+  Int          m_ctuRow;
+  TComPicYuv*  m_srcYuv;
+  TComPicYuv*  m_resYuv;
+  SAOBlkParam* m_saoBlkParams;
+  TComPic*     m_pPic;
 };
 
 //! \}
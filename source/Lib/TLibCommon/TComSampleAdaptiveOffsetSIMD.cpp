@@ -0,0 +1,374 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSampleAdaptiveOffsetSIMD.cpp
+    \brief    SIMD implementations of the sample adaptive offset
+*/
+
+#include <algorithm>
+#include "TComSampleAdaptiveOffsetSIMD.h"
+#include "TComSampleAdaptiveOffset.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+#if SIMD_X86
+
+// ====================================================================================================================
+// Edge classes and offset tables
+// ====================================================================================================================
+
+// The rows are processed 8 samples at a time; the last vector of a row ends at the last sample of the row and
+// overlaps the previous one. Rows shorter than a vector are processed in C++.
+
+/// lanes not yet visited by the previous vector, indexed by 8 minus the overlap
+static const Short s_asNewLanes[16] = { 0, 0, 0, 0, 0, 0, 0, 0, -1, -1, -1, -1, -1, -1, -1, -1 };
+
+/// sgn(a - b)
+SIMD_TARGET_SSE41
+static inline __m128i xSign( const __m128i& a, const __m128i& b )
+{
+  return _mm_sub_epi16( _mm_cmpgt_epi16( b, a ), _mm_cmpgt_epi16( a, b ) );
+}
+
+/// edge class of the samples, from 0 to 4 (the edge type plus 2)
+SIMD_TARGET_SSE41
+static inline __m128i xEdgeClass( const Pel* src, Int neighbourOffset, const __m128i& vCur )
+{
+  const __m128i vPrev = _mm_loadu_si128( (const __m128i*)( src - neighbourOffset ) );
+  const __m128i vNext = _mm_loadu_si128( (const __m128i*)( src + neighbourOffset ) );
+  return _mm_add_epi16( _mm_add_epi16( xSign( vCur, vPrev ), xSign( vCur, vNext ) ), _mm_set1_epi16( 2 ) );
+}
+
+/// shuffle control selecting the 16-bit entries idx (0 to 7) of a table
+SIMD_TARGET_SSE41
+static inline __m128i xTableControl( const __m128i& vIdx )
+{
+  return _mm_add_epi16( _mm_mullo_epi16( vIdx, _mm_set1_epi16( 0x0202 ) ), _mm_set1_epi16( 0x0100 ) );
+}
+
+// ====================================================================================================================
+// SAO application
+// ====================================================================================================================
+
+SIMD_TARGET_SSE41
+static Void xOffsetEdge( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int startX, Int endX, Int numLines,
+                         Int neighbourOffset, const Int* offset, Int maxSampleValueIncl )
+{
+  Short asTable[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  for ( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    asTable[k] = (Short)offset[k - 2];
+  }
+  const __m128i vTable = _mm_loadu_si128( (const __m128i*)asTable );
+  const __m128i vZero  = _mm_setzero_si128();
+  const __m128i vMax   = _mm_set1_epi16( maxSampleValueIncl );
+
+  for ( Int y = 0; y < numLines; y++ )
+  {
+    if ( endX - startX < 8 )
+    {
+      for ( Int x = startX; x < endX; x++ )
+      {
+        const Int edgeType = sgn( srcLine[x] - srcLine[x - neighbourOffset] ) + sgn( srcLine[x] - srcLine[x + neighbourOffset] );
+        resLine[x] = Clip3<Int>( 0, maxSampleValueIncl, srcLine[x] + offset[edgeType] );
+      }
+    }
+    else
+    {
+      for ( Int x = startX; x < endX; x += 8 )
+      {
+        const Int     xs     = std::min( x, endX - 8 );
+        const __m128i vCur   = _mm_loadu_si128( (const __m128i*)( srcLine + xs ) );
+        const __m128i vClass = xEdgeClass( srcLine + xs, neighbourOffset, vCur );
+        const __m128i vRes   = _mm_add_epi16( vCur, _mm_shuffle_epi8( vTable, xTableControl( vClass ) ) );
+        _mm_storeu_si128( (__m128i*)( resLine + xs ), _mm_min_epi16( _mm_max_epi16( vRes, vZero ), vMax ) );
+      }
+    }
+    srcLine += srcStride;
+    resLine += resStride;
+  }
+}
+
+SIMD_TARGET_SSE41
+static Void xOffsetBand( const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int width, Int numLines,
+                         Int shiftBits, const Int* offset, Int maxSampleValueIncl )
+{
+  Short asTable[NUM_SAO_BO_CLASSES];
+  for ( Int k = 0; k < NUM_SAO_BO_CLASSES; k++ )
+  {
+    asTable[k] = (Short)offset[k];
+  }
+  __m128i vTable[NUM_SAO_BO_CLASSES / 8];
+  for ( Int i = 0; i < NUM_SAO_BO_CLASSES / 8; i++ )
+  {
+    vTable[i] = _mm_loadu_si128( (const __m128i*)( asTable + 8 * i ) );
+  }
+  const __m128i vShift = _mm_cvtsi32_si128( shiftBits );
+  const __m128i vSeven = _mm_set1_epi16( 7 );
+  const __m128i vZero  = _mm_setzero_si128();
+  const __m128i vMax   = _mm_set1_epi16( maxSampleValueIncl );
+
+  for ( Int y = 0; y < numLines; y++ )
+  {
+    if ( width < 8 )
+    {
+      for ( Int x = 0; x < width; x++ )
+      {
+        resLine[x] = Clip3<Int>( 0, maxSampleValueIncl, srcLine[x] + offset[srcLine[x] >> shiftBits] );
+      }
+    }
+    else
+    {
+      for ( Int x = 0; x < width; x += 8 )
+      {
+        const Int     xs       = std::min( x, width - 8 );
+        const __m128i vCur     = _mm_loadu_si128( (const __m128i*)( srcLine + xs ) );
+        const __m128i vBand    = _mm_srl_epi16( vCur, vShift );
+        const __m128i vControl = xTableControl( _mm_and_si128( vBand, vSeven ) );
+        const __m128i vGroup   = _mm_srli_epi16( vBand, 3 );
+        __m128i       vOffset  = _mm_shuffle_epi8( vTable[0], vControl );
+        for ( Int i = 1; i < NUM_SAO_BO_CLASSES / 8; i++ )
+        {
+          vOffset = _mm_blendv_epi8( vOffset, _mm_shuffle_epi8( vTable[i], vControl ), _mm_cmpeq_epi16( vGroup, _mm_set1_epi16( i ) ) );
+        }
+        const __m128i vRes = _mm_add_epi16( vCur, vOffset );
+        _mm_storeu_si128( (__m128i*)( resLine + xs ), _mm_min_epi16( _mm_max_epi16( vRes, vZero ), vMax ) );
+      }
+    }
+    srcLine += srcStride;
+    resLine += resStride;
+  }
+}
+
+// ====================================================================================================================
+// SAO statistics
+// ====================================================================================================================
+
+SIMD_TARGET_SSE41
+static inline Int64 xHorizontalSum( const __m128i& v )
+{
+  const __m128i vSum = _mm_add_epi32( v, _mm_shuffle_epi32( v, 0x4e ) );
+  return _mm_cvtsi128_si32( _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0xb1 ) ) );
+}
+
+SIMD_TARGET_SSE41
+static Void xGetEdgeStats( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines,
+                           Int neighbourOffset, Int64* diff, Int64* count )
+{
+  // per class: sums of the differences in 32-bit lanes, counts in 16-bit lanes (at most 9 vectors per line of a CTU)
+  __m128i vDiff [NUM_SAO_EO_CLASSES];
+  __m128i vCount[NUM_SAO_EO_CLASSES];
+  for ( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    vDiff [k] = _mm_setzero_si128();
+    vCount[k] = _mm_setzero_si128();
+  }
+  const __m128i vOne = _mm_set1_epi16( 1 );
+
+  for ( Int y = 0; y < numLines; y++ )
+  {
+    if ( endX - startX < 8 )
+    {
+      for ( Int x = startX; x < endX; x++ )
+      {
+        const Int edgeType = sgn( srcLine[x] - srcLine[x - neighbourOffset] ) + sgn( srcLine[x] - srcLine[x + neighbourOffset] );
+        diff [edgeType] += ( orgLine[x] - srcLine[x] );
+        count[edgeType] ++;
+      }
+    }
+    else
+    {
+      for ( Int x = startX; x < endX; x += 8 )
+      {
+        const Int     xs     = std::min( x, endX - 8 );
+        const __m128i vNew   = _mm_loadu_si128( (const __m128i*)( s_asNewLanes + 8 - ( x - xs ) ) );
+        const __m128i vCur   = _mm_loadu_si128( (const __m128i*)( srcLine + xs ) );
+        const __m128i vClass = xEdgeClass( srcLine + xs, neighbourOffset, vCur );
+        const __m128i vDelta = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)( orgLine + xs ) ), vCur );
+        for ( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+        {
+          const __m128i vMask = _mm_and_si128( _mm_cmpeq_epi16( vClass, _mm_set1_epi16( k ) ), vNew );
+          vDiff [k] = _mm_add_epi32( vDiff[k], _mm_madd_epi16( _mm_and_si128( vDelta, vMask ), vOne ) );
+          vCount[k] = _mm_sub_epi16( vCount[k], vMask );
+        }
+      }
+    }
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+
+  for ( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    diff [k - 2] += xHorizontalSum( vDiff[k] );
+    count[k - 2] += xHorizontalSum( _mm_madd_epi16( vCount[k], vOne ) );
+  }
+}
+
+/// the band indices and the differences are computed with vectors, the histogram of the bands in C++
+SIMD_TARGET_SSE41
+static Void xGetBandStats( const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines,
+                           Int shiftBits, Int64* diff, Int64* count )
+{
+  Int   aiDiff [NUM_SAO_BO_CLASSES];
+  Int   aiCount[NUM_SAO_BO_CLASSES];
+  Short asBand [8];
+  Short asDelta[8];
+  for ( Int k = 0; k < NUM_SAO_BO_CLASSES; k++ )
+  {
+    aiDiff [k] = 0;
+    aiCount[k] = 0;
+  }
+  const __m128i vShift = _mm_cvtsi32_si128( shiftBits );
+
+  for ( Int y = 0; y < numLines; y++ )
+  {
+    Int x = startX;
+    for ( ; x + 8 <= endX; x += 8 )
+    {
+      const __m128i vCur = _mm_loadu_si128( (const __m128i*)( srcLine + x ) );
+      _mm_storeu_si128( (__m128i*)asBand,  _mm_srl_epi16( vCur, vShift ) );
+      _mm_storeu_si128( (__m128i*)asDelta, _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)( orgLine + x ) ), vCur ) );
+      for ( Int i = 0; i < 8; i++ )
+      {
+        aiDiff [asBand[i]] += asDelta[i];
+        aiCount[asBand[i]] ++;
+      }
+    }
+    for ( ; x < endX; x++ )
+    {
+      const Int bandIdx = srcLine[x] >> shiftBits;
+      aiDiff [bandIdx] += ( orgLine[x] - srcLine[x] );
+      aiCount[bandIdx] ++;
+    }
+    srcLine += srcStride;
+    orgLine += orgStride;
+  }
+
+  for ( Int k = 0; k < NUM_SAO_BO_CLASSES; k++ )
+  {
+    diff [k] += aiDiff[k];
+    count[k] += aiCount[k];
+  }
+}
+
+#endif // SIMD_X86
+
+// ====================================================================================================================
+// Selection of the kernels
+// ====================================================================================================================
+
+/** edge offset of a rectangle of samples
+ *  \param level               instruction set, at least SIMD_SSE41
+ *  \param srcLine             first line of the deblocked samples
+ *  \param srcStride           stride of srcLine
+ *  \param resLine             first line of the output samples
+ *  \param resStride           stride of resLine
+ *  \param startX              first sample of each line
+ *  \param endX                end of each line (exclusive)
+ *  \param numLines            number of lines
+ *  \param neighbourOffset     offset of the neighbours giving the edge class
+ *  \param offset              offsets indexed by the edge type, from -2 to 2
+ *  \param maxSampleValueIncl  largest sample value
+ */
+Void TComSampleAdaptiveOffsetSIMD::offsetEdge( SimdLevel level, const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int startX, Int endX, Int numLines,
+                                               Int neighbourOffset, const Int* offset, Int maxSampleValueIncl )
+{
+#if SIMD_X86
+  xOffsetEdge( srcLine, srcStride, resLine, resStride, startX, endX, numLines, neighbourOffset, offset, maxSampleValueIncl );
+#endif
+}
+
+/** band offset of a rectangle of samples
+ *  \param level               instruction set, at least SIMD_SSE41
+ *  \param srcLine             first line of the deblocked samples
+ *  \param srcStride           stride of srcLine
+ *  \param resLine             first line of the output samples
+ *  \param resStride           stride of resLine
+ *  \param width               number of samples of each line
+ *  \param numLines            number of lines
+ *  \param shiftBits           shift giving the band of a sample
+ *  \param offset              offsets of the bands
+ *  \param maxSampleValueIncl  largest sample value
+ */
+Void TComSampleAdaptiveOffsetSIMD::offsetBand( SimdLevel level, const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int width, Int numLines,
+                                               Int shiftBits, const Int* offset, Int maxSampleValueIncl )
+{
+#if SIMD_X86
+  xOffsetBand( srcLine, srcStride, resLine, resStride, width, numLines, shiftBits, offset, maxSampleValueIncl );
+#endif
+}
+
+/** accumulate the edge offset statistics of a rectangle of samples
+ *  \param level            instruction set, at least SIMD_SSE41
+ *  \param srcLine          first line of the deblocked samples
+ *  \param srcStride        stride of srcLine
+ *  \param orgLine          first line of the original samples
+ *  \param orgStride        stride of orgLine
+ *  \param startX           first sample of each line
+ *  \param endX             end of each line (exclusive)
+ *  \param numLines         number of lines
+ *  \param neighbourOffset  offset of the neighbours giving the edge class
+ *  \param diff             sums of the differences original - deblocked, indexed by the edge type, from -2 to 2
+ *  \param count            numbers of samples, indexed by the edge type
+ */
+Void TComSampleAdaptiveOffsetSIMD::getEdgeStats( SimdLevel level, const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines,
+                                                 Int neighbourOffset, Int64* diff, Int64* count )
+{
+#if SIMD_X86
+  xGetEdgeStats( srcLine, srcStride, orgLine, orgStride, startX, endX, numLines, neighbourOffset, diff, count );
+#endif
+}
+
+/** accumulate the band offset statistics of a rectangle of samples
+ *  \param level      instruction set, at least SIMD_SSE41
+ *  \param srcLine    first line of the deblocked samples
+ *  \param srcStride  stride of srcLine
+ *  \param orgLine    first line of the original samples
+ *  \param orgStride  stride of orgLine
+ *  \param startX     first sample of each line
+ *  \param endX       end of each line (exclusive)
+ *  \param numLines   number of lines
+ *  \param shiftBits  shift giving the band of a sample
+ *  \param diff       sums of the differences original - deblocked, per band
+ *  \param count      numbers of samples, per band
+ */
+Void TComSampleAdaptiveOffsetSIMD::getBandStats( SimdLevel level, const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines,
+                                                 Int shiftBits, Int64* diff, Int64* count )
+{
+#if SIMD_X86
+  xGetBandStats( srcLine, srcStride, orgLine, orgStride, startX, endX, numLines, shiftBits, diff, count );
+#endif
+}
+
+//! \}
@@ -0,0 +1,71 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSampleAdaptiveOffsetSIMD.h
+    \brief    SIMD implementations of the sample adaptive offset (header)
+*/
+
+#ifndef __TCOMSAMPLEADAPTIVEOFFSETSIMD__
+#define __TCOMSAMPLEADAPTIVEOFFSETSIMD__
+
+#include "TypeDef.h"
+#include "TComSimd.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Namespace definition
+// ====================================================================================================================
+
+/// SIMD implementations of the SAO application (TComSampleAdaptiveOffset::offsetBlock) and of the SAO statistics
+/// (TEncSampleAdaptiveOffset::getBlkStats), giving the same results as the C++ ones. They work on rectangles of
+/// samples, the callers splitting a block into the rectangles allowed by the availability of its neighbours. The edge
+/// class of a sample is derived from its two neighbours at -neighbourOffset and +neighbourOffset: 1 for EO_0,
+/// the stride for EO_90, the stride + 1 for EO_135 and the stride - 1 for EO_45.
+namespace TComSampleAdaptiveOffsetSIMD
+{
+  Void offsetEdge   ( SimdLevel level, const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int startX, Int endX, Int numLines,
+                      Int neighbourOffset, const Int* offset, Int maxSampleValueIncl );
+  Void offsetBand   ( SimdLevel level, const Pel* srcLine, Int srcStride, Pel* resLine, Int resStride, Int width, Int numLines,
+                      Int shiftBits, const Int* offset, Int maxSampleValueIncl );
+
+  Void getEdgeStats ( SimdLevel level, const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines,
+                      Int neighbourOffset, Int64* diff, Int64* count );
+  Void getBandStats ( SimdLevel level, const Pel* srcLine, Int srcStride, const Pel* orgLine, Int orgStride, Int startX, Int endX, Int numLines,
+                      Int shiftBits, Int64* diff, Int64* count );
+}// END NAMESPACE DEFINITION TComSampleAdaptiveOffsetSIMD
+
+//! \}
+
+#endif // __TCOMSAMPLEADAPTIVEOFFSETSIMD__
@@ -0,0 +1,145 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.cpp
+    \brief    instruction set level of the x86 SIMD kernels
+*/
+
+#include "TComSimd.h"
+
+#if SIMD_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+SimdLevel g_simdLevel = detectSimdLevel();
+
+#if SIMD_X86
+/** \param auiRegs    eax, ebx, ecx and edx returned by the cpuid instruction
+ * \param uiLeaf     leaf (eax)
+ * \param uiSubLeaf  sub-leaf (ecx)
+ */
+static Void xCpuid( UInt auiRegs[4], UInt uiLeaf, UInt uiSubLeaf )
+{
+#if defined(_MSC_VER)
+  Int aiRegs[4];
+  __cpuidex( aiRegs, uiLeaf, uiSubLeaf );
+  for ( Int i = 0; i < 4; i++ )
+  {
+    auiRegs[i] = aiRegs[i];
+  }
+#else
+  __cpuid_count( uiLeaf, uiSubLeaf, auiRegs[0], auiRegs[1], auiRegs[2], auiRegs[3] );
+#endif
+}
+
+/** \returns the register state enabled by the operating system (XCR0)
+ */
+static UInt64 xGetXcr0()
+{
+#if defined(_MSC_VER)
+  return _xgetbv( 0 );
+#else
+  UInt uiLow;
+  UInt uiHigh;
+  __asm__ __volatile__ ( "xgetbv" : "=a"( uiLow ), "=d"( uiHigh ) : "c"( 0 ) );
+  return ( (UInt64)uiHigh << 32 ) | uiLow;
+#endif
+}
+#endif
+
+SimdLevel detectSimdLevel()
+{
+#if SIMD_X86
+  UInt auiRegs[4];
+
+  xCpuid( auiRegs, 0, 0 );
+  const UInt uiMaxLeaf = auiRegs[0];
+
+  xCpuid( auiRegs, 1, 0 );
+  const Bool bSSSE3  = ( auiRegs[2] >>  9 ) & 1;
+  const Bool bSSE41  = ( auiRegs[2] >> 19 ) & 1;
+  const Bool bXSAVE  = ( auiRegs[2] >> 27 ) & 1;   // OSXSAVE: xgetbv is available
+  const Bool bAVX    = ( auiRegs[2] >> 28 ) & 1;
+  if ( !bSSSE3 || !bSSE41 )
+  {
+    return SIMD_SCALAR;
+  }
+  if ( !bXSAVE || !bAVX || uiMaxLeaf < 7 )
+  {
+    return SIMD_SSE41;
+  }
+
+  // the operating system has to save the YMM (and ZMM) registers
+  const UInt64 uiXcr0 = xGetXcr0();
+  if ( ( uiXcr0 & 0x06 ) != 0x06 )
+  {
+    return SIMD_SSE41;
+  }
+
+  xCpuid( auiRegs, 7, 0 );
+  const Bool bAVX2     = ( auiRegs[1] >>  5 ) & 1;
+  const Bool bAVX512F  = ( auiRegs[1] >> 16 ) & 1;
+  const Bool bAVX512BW = ( auiRegs[1] >> 30 ) & 1;
+  const Bool bAVX512VL = ( auiRegs[1] >> 31 ) & 1;
+  if ( !bAVX2 )
+  {
+    return SIMD_SSE41;
+  }
+  if ( !bAVX512F || !bAVX512BW || !bAVX512VL || ( uiXcr0 & 0xe6 ) != 0xe6 )
+  {
+    return SIMD_AVX2;
+  }
+  return SIMD_AVX512;
+#else
+  return SIMD_SCALAR;
+#endif
+}
+
+/** The kernels are selected when the classes that use them are initialised, so the level has to be set before.
+ * \param iLevel  level to be used (see SimdLevel), -1 for the highest level supported. A level that is not supported
+ *                is lowered to the highest supported one.
+ */
+Void initSimdLevel( Int iLevel )
+{
+  const SimdLevel detectedLevel = detectSimdLevel();
+  g_simdLevel = ( iLevel < 0 || iLevel > detectedLevel ) ? detectedLevel : SimdLevel( iLevel );
+}
+
+//! \}
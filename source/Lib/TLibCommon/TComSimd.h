@@ -0,0 +1,90 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.h
+    \brief    instruction set level of the x86 SIMD kernels (header)
+*/
+
+#ifndef __TCOMSIMD__
+#define __TCOMSIMD__
+
+#include "CommonDef.h"
+
+#if SIMD_X86
+#include <immintrin.h>
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// instruction set used by the kernels that have SIMD implementations, each level includes the ones below
+enum SimdLevel
+{
+  SIMD_SCALAR = 0,  ///< plain C++
+  SIMD_SSE41  = 1,  ///< SSE4.1 (and SSSE3)
+  SIMD_AVX2   = 2,  ///< AVX2
+  SIMD_AVX512 = 3   ///< AVX-512 F, BW and VL
+};
+
+// ====================================================================================================================
+// Macros
+// ====================================================================================================================
+
+// the kernels of one instruction set are compiled for it with a function attribute, so that the rest of the code does
+// not depend on the compiler flags
+#if SIMD_X86 && !defined(_MSC_VER)
+#define SIMD_TARGET_SSE41   __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2    __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512  __attribute__((target("avx512f,avx512bw,avx512vl")))
+#else
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX512
+#endif
+
+// ====================================================================================================================
+// Global variables and functions
+// ====================================================================================================================
+
+extern SimdLevel g_simdLevel;                   ///< level used when the kernels are selected, see initSimdLevel
+
+SimdLevel detectSimdLevel ();                   ///< highest level supported by the CPU and the operating system
+Void      initSimdLevel   ( Int iLevel );       ///< set g_simdLevel, -1 for the highest supported level
+
+//! \}
+
+#endif // __TCOMSIMD__
@@ -104,6 +104,7 @@ TComSlice::TComSlice()
 , m_substreamSizes                ( )
 , m_scalingList                   ( NULL )
 , m_cabacInitFlag                 ( false )
+, m_encCABACTableIdx              ( I_SLICE )
 , m_bLMvdL1Zero                   ( false )
 , m_temporalLayerNonReferenceFlag ( false )
 , m_LFCrossSliceBoundaryFlag      ( false )
@@ -199,14 +200,13 @@ Void  TComSlice::sortPicList        (TComList<TComPic*>& rcListPic)
     iterPicExtract = rcListPic.begin();
     for (Int j = 0; j < i; j++) iterPicExtract++;
     pcPicExtract = *(iterPicExtract);
-    pcPicExtract->setCurrSliceIdx(0);
 
+    // the current slice index of the pictures is left alone, as pictures may be decoded by other threads
     iterPicInsert = rcListPic.begin();
     while (iterPicInsert != iterPicExtract)
     {
       pcPicInsert = *(iterPicInsert);
-      pcPicInsert->setCurrSliceIdx(0);
-      if (pcPicInsert->getPOC() >= pcPicExtract->getPOC())
+      if (pcPicInsert->getSlice(0)->getPOC() >= pcPicExtract->getSlice(0)->getPOC())
       {
         break;
       }
@@ -602,8 +602,7 @@ Void TComSlice::decodingRefreshMarking(Int& pocCRA, Bool& bRefreshPending, TComL
     while (iterPic != rcListPic.end())
     {
       rpcPic = *(iterPic);
-      rpcPic->setCurrSliceIdx(0);
-      if (rpcPic->getPOC() != pocCurr) rpcPic->getSlice(0)->setReferenced(false);
+      if (rpcPic->getSlice(0)->getPOC() != pocCurr) rpcPic->getSlice(0)->setReferenced(false);
       iterPic++;
     }
     if ( getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_W_LP
@@ -764,6 +763,7 @@ Void TComSlice::copySliceInfo(TComSlice *pSrc)
   }
 
   m_cabacInitFlag                = pSrc->m_cabacInitFlag;
+  m_encCABACTableIdx             = pSrc->m_encCABACTableIdx;
 
   m_bLMvdL1Zero = pSrc->m_bLMvdL1Zero;
   m_LFCrossSliceBoundaryFlag = pSrc->m_LFCrossSliceBoundaryFlag;
@@ -1266,6 +1266,7 @@ private:
 
   TComScalingList*     m_scalingList;                 //!< pointer of quantization matrix
   Bool        m_cabacInitFlag;
+  UInt        m_encCABACTableIdx;           //!< encoder only: CABAC table chosen from the PPS when the slice is set up
 
   Bool       m_bLMvdL1Zero;
   Bool       m_temporalLayerNonReferenceFlag;
@@ -1341,6 +1342,7 @@ public:
   Void      setIsUsedAsLongTerm (Int i, Int j, Bool value)      { m_bIsUsedAsLongTerm[i][j] = value; }
   Bool      getCheckLDC     ()                                  { return m_bCheckLDC; }
   Bool      getMvdL1ZeroFlag ()                                 { return m_bLMvdL1Zero;    }
+  UInt      getEncCABACTableIdx ()                              { return m_encCABACTableIdx; }
   Int       getNumRpsCurrTempList();
   Int       getList1IdxToList0Idx ( Int list1Idx )              { return m_list1IdxToList0Idx[list1Idx]; }
   Void      setReferenced(Bool b)                               { m_bRefenced = b; }
@@ -1379,6 +1381,7 @@ public:
   Void      setColRefIdx        ( UInt refIdx) { m_colRefIdx = refIdx; }
   Void      setCheckLDC         ( Bool b )                      { m_bCheckLDC = b; }
   Void      setMvdL1ZeroFlag     ( Bool b)                       { m_bLMvdL1Zero = b; }
+  Void      setEncCABACTableIdx  ( UInt idx )                    { m_encCABACTableIdx = idx; }
 
   Bool      isIntra         ()                          { return  m_eSliceType == I_SLICE;  }
   Bool      isInterB        ()                          { return  m_eSliceType == B_SLICE;  }
@@ -1533,6 +1536,11 @@ public:
     return ( m_paramsetMap.find(psId) == m_paramsetMap.end() ) ? NULL : m_paramsetMap[psId];
   }
 
+  Bool isEmpty() const
+  {
+    return m_paramsetMap.empty();
+  }
+
   T* getFirstPS()
   {
     return (m_paramsetMap.begin() == m_paramsetMap.end() ) ? NULL : m_paramsetMap.begin()->second;
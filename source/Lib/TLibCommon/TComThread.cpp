@@ -0,0 +1,231 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThread.cpp
+    \brief    portable threading primitives
+*/
+
+#include "TComThread.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// TComMutex
+// ====================================================================================================================
+
+TComMutex::TComMutex()
+{
+#ifdef _WIN32
+  InitializeCriticalSection( &m_cs );
+#else
+  pthread_mutex_init( &m_mutex, NULL );
+#endif
+}
+
+TComMutex::~TComMutex()
+{
+#ifdef _WIN32
+  DeleteCriticalSection( &m_cs );
+#else
+  pthread_mutex_destroy( &m_mutex );
+#endif
+}
+
+Void TComMutex::lock()
+{
+#ifdef _WIN32
+  EnterCriticalSection( &m_cs );
+#else
+  pthread_mutex_lock( &m_mutex );
+#endif
+}
+
+Void TComMutex::unlock()
+{
+#ifdef _WIN32
+  LeaveCriticalSection( &m_cs );
+#else
+  pthread_mutex_unlock( &m_mutex );
+#endif
+}
+
+// ====================================================================================================================
+// TComCondition
+// ====================================================================================================================
+
+TComCondition::TComCondition()
+{
+#ifdef _WIN32
+  InitializeConditionVariable( &m_cond );
+#else
+  pthread_cond_init( &m_cond, NULL );
+#endif
+}
+
+TComCondition::~TComCondition()
+{
+#ifndef _WIN32
+  pthread_cond_destroy( &m_cond );
+#endif
+}
+
+Void TComCondition::wait( TComMutex& rcMutex )
+{
+#ifdef _WIN32
+  SleepConditionVariableCS( &m_cond, &rcMutex.m_cs, INFINITE );
+#else
+  pthread_cond_wait( &m_cond, &rcMutex.m_mutex );
+#endif
+}
+
+Void TComCondition::signal()
+{
+#ifdef _WIN32
+  WakeConditionVariable( &m_cond );
+#else
+  pthread_cond_signal( &m_cond );
+#endif
+}
+
+Void TComCondition::broadcast()
+{
+#ifdef _WIN32
+  WakeAllConditionVariable( &m_cond );
+#else
+  pthread_cond_broadcast( &m_cond );
+#endif
+}
+
+// ====================================================================================================================
+// TComThread
+// ====================================================================================================================
+
+TComThread::TComThread()
+: m_bRunning( false )
+{
+}
+
+TComThread::~TComThread()
+{
+  join();
+}
+
+Bool TComThread::start()
+{
+  assert( !m_bRunning );
+#ifdef _WIN32
+  m_hThread  = CreateThread( NULL, 0, xThreadEntry, this, 0, &m_dwThreadId );
+  m_bRunning = ( m_hThread != NULL );
+#else
+  m_bRunning = ( pthread_create( &m_thread, NULL, xThreadEntry, this ) == 0 );
+#endif
+  return m_bRunning;
+}
+
+Void TComThread::join()
+{
+  if ( !m_bRunning )
+  {
+    return;
+  }
+#ifdef _WIN32
+  WaitForSingleObject( m_hThread, INFINITE );
+  CloseHandle( m_hThread );
+#else
+  pthread_join( m_thread, NULL );
+#endif
+  m_bRunning = false;
+}
+
+Bool TComThread::isCurrentThread() const
+{
+  if ( !m_bRunning )
+  {
+    return false;
+  }
+#ifdef _WIN32
+  return GetCurrentThreadId() == m_dwThreadId;
+#else
+  return pthread_equal( pthread_self(), m_thread ) != 0;
+#endif
+}
+
+TComThreadId TComThread::getCurrentThreadId()
+{
+#ifdef _WIN32
+  return GetCurrentThreadId();
+#else
+  return pthread_self();
+#endif
+}
+
+Bool TComThread::isSameThread( TComThreadId cId0, TComThreadId cId1 )
+{
+#ifdef _WIN32
+  return cId0 == cId1;
+#else
+  return pthread_equal( cId0, cId1 ) != 0;
+#endif
+}
+
+Double TComThread::getWallClockTime()
+{
+#ifdef _WIN32
+  LARGE_INTEGER liCount;
+  LARGE_INTEGER liFrequency;
+  QueryPerformanceCounter( &liCount );
+  QueryPerformanceFrequency( &liFrequency );
+  return (Double)liCount.QuadPart / (Double)liFrequency.QuadPart;
+#else
+  struct timespec sTime;
+  clock_gettime( CLOCK_MONOTONIC, &sTime );
+  return (Double)sTime.tv_sec + (Double)sTime.tv_nsec * 1e-9;
+#endif
+}
+
+#ifdef _WIN32
+DWORD WINAPI TComThread::xThreadEntry( LPVOID pArg )
+{
+  static_cast<TComThread*>( pArg )->threadMain();
+  return 0;
+}
+#else
+Void* TComThread::xThreadEntry( Void* pArg )
+{
+  static_cast<TComThread*>( pArg )->threadMain();
+  return NULL;
+}
+#endif
+
+//! \}
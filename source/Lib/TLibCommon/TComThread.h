@@ -0,0 +1,158 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThread.h
+    \brief    portable threading primitives (header)
+*/
+
+#ifndef __TCOMTHREAD__
+#define __TCOMTHREAD__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonDef.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+#ifdef _WIN32
+typedef DWORD     TComThreadId;
+#else
+typedef pthread_t TComThreadId;
+#endif
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// mutual exclusion lock
+class TComMutex
+{
+public:
+  TComMutex();
+  ~TComMutex();
+
+  Void  lock    ();
+  Void  unlock  ();
+
+private:
+  TComMutex( const TComMutex& );
+  TComMutex& operator= ( const TComMutex& );
+
+#ifdef _WIN32
+  CRITICAL_SECTION    m_cs;
+#else
+  pthread_mutex_t     m_mutex;
+#endif
+
+  friend class TComCondition;
+};
+
+/// condition variable, always used together with a TComMutex
+class TComCondition
+{
+public:
+  TComCondition();
+  ~TComCondition();
+
+  Void  wait      ( TComMutex& rcMutex );           ///< atomically release the locked mutex and wait, re-locks before returning
+  Void  signal    ();                               ///< wake up one waiting thread
+  Void  broadcast ();                               ///< wake up all waiting threads
+
+private:
+  TComCondition( const TComCondition& );
+  TComCondition& operator= ( const TComCondition& );
+
+#ifdef _WIN32
+  CONDITION_VARIABLE  m_cond;
+#else
+  pthread_cond_t      m_cond;
+#endif
+};
+
+/// joinable thread, the work is done in threadMain() of the derived class
+class TComThread
+{
+public:
+  TComThread();
+  virtual ~TComThread();
+
+  Bool  start     ();                               ///< launch threadMain() on a new thread, returns false on failure
+  Void  join      ();                               ///< wait until threadMain() has returned
+  Bool  isRunning () const { return m_bRunning; }
+  Bool  isCurrentThread () const;                   ///< true when called from threadMain() of this thread
+
+  static TComThreadId getCurrentThreadId ();        ///< id of the calling thread, also for threads not started here
+  static Bool         isSameThread       ( TComThreadId cId0, TComThreadId cId1 );
+
+  /// monotonic wall-clock time in seconds, for timing work done on the calling thread (unlike clock(), which adds
+  /// up the processor time of all threads)
+  static Double getWallClockTime ();
+
+protected:
+  virtual Void threadMain() = 0;
+
+private:
+  TComThread( const TComThread& );
+  TComThread& operator= ( const TComThread& );
+
+#ifdef _WIN32
+  static DWORD WINAPI xThreadEntry( LPVOID pArg );
+  HANDLE              m_hThread;
+  DWORD               m_dwThreadId;
+#else
+  static Void*        xThreadEntry( Void* pArg );
+  pthread_t           m_thread;
+#endif
+  Bool                m_bRunning;
+};
+
+//! \}
+
+#endif // __TCOMTHREAD__
@@ -0,0 +1,273 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.cpp
+    \brief    thread pool with a shared task queue, used by the encoder and decoder stages
+*/
+
+#include "TComThreadPool.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// TComProgressCounter
+// ====================================================================================================================
+
+TComProgressCounter::TComProgressCounter()
+: m_uiValue     ( 0 )
+, m_pcThreadPool( NULL )
+{
+}
+
+/** the counter is normally only increased; setting a lower value (e.g. 0 when a picture buffer is reused) is allowed
+ * as long as nobody depends on the counter at that moment
+ * \param uiValue  new value of the counter
+ */
+Void TComProgressCounter::set( UInt uiValue )
+{
+  m_cMutex.lock();
+  m_uiValue = uiValue;
+  m_cCond.broadcast();
+  m_cMutex.unlock();
+
+  if ( m_pcThreadPool )
+  {
+    m_pcThreadPool->wakeUp();
+  }
+}
+
+UInt TComProgressCounter::get()
+{
+  m_cMutex.lock();
+  const UInt uiValue = m_uiValue;
+  m_cMutex.unlock();
+  return uiValue;
+}
+
+Void TComProgressCounter::wait( UInt uiValue )
+{
+  m_cMutex.lock();
+  while ( m_uiValue < uiValue )
+  {
+    m_cCond.wait( m_cMutex );
+  }
+  m_cMutex.unlock();
+}
+
+// ====================================================================================================================
+// TComThreadPool: constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TComThreadPool::TComThreadPool()
+: m_bStop             ( false )
+, m_bHasExternalThread( false )
+{
+}
+
+TComThreadPool::~TComThreadPool()
+{
+  destroy();
+}
+
+/** \param iNumThreads  number of pool threads, the thread that creates the pool is not counted
+ */
+Void TComThreadPool::create( Int iNumThreads )
+{
+  destroy();
+
+  m_bStop              = false;
+  m_bHasExternalThread = false;
+  for ( Int i = 0; i < iNumThreads; i++ )
+  {
+    m_apcThreads.push_back( new TComPoolThread( this, i ) );
+  }
+  for ( Int i = 0; i < iNumThreads; i++ )
+  {
+    m_apcThreads[i]->start();
+  }
+}
+
+Void TComThreadPool::destroy()
+{
+  m_cMutex.lock();
+  m_bStop = true;
+  m_cCond.broadcast();
+  m_cMutex.unlock();
+
+  for ( UInt i = 0; i < m_apcThreads.size(); i++ )
+  {
+    m_apcThreads[i]->join();
+    delete m_apcThreads[i];
+  }
+  m_apcThreads.clear();
+  m_cQueue.clear();
+}
+
+// ====================================================================================================================
+// TComThreadPool: public member functions
+// ====================================================================================================================
+
+Int TComThreadPool::getThreadIdx() const
+{
+  for ( Int i = 0; i < getNumThreads(); i++ )
+  {
+    if ( m_apcThreads[i]->isCurrentThread() )
+    {
+      return i;
+    }
+  }
+  return getNumThreads();
+}
+
+/** \param pcTask   task to be run
+ * \param pcGroup  group to wait for with wait()
+ */
+Void TComThreadPool::submit( TComTask* pcTask, TComTaskGroup* pcGroup )
+{
+  const Bool bExternal = ( getThreadIdx() == getNumThreads() );
+
+  m_cMutex.lock();
+  if ( bExternal )
+  {
+    xCheckExternalThread();
+  }
+  pcTask->m_pcGroup = pcGroup;
+  pcGroup->m_iNumPending++;
+  m_cQueue.push_back( pcTask );
+  m_cCond.broadcast();
+  m_cMutex.unlock();
+}
+
+Void TComThreadPool::wait( TComTaskGroup* pcGroup )
+{
+  const Int iThreadIdx = getThreadIdx();
+
+  m_cMutex.lock();
+  if ( iThreadIdx == getNumThreads() )
+  {
+    xCheckExternalThread();
+  }
+  while ( pcGroup->m_iNumPending > 0 )
+  {
+    TComTask* pcTask = xTakeTask( pcGroup );
+    if ( pcTask )
+    {
+      xRunTask( pcTask, iThreadIdx );
+    }
+    else
+    {
+      m_cCond.wait( m_cMutex );
+    }
+  }
+  m_cMutex.unlock();
+}
+
+Void TComThreadPool::wakeUp()
+{
+  m_cMutex.lock();
+  m_cCond.broadcast();
+  m_cMutex.unlock();
+}
+
+// ====================================================================================================================
+// TComThreadPool: private member functions
+// ====================================================================================================================
+
+/** The external thread shares one thread slot, so only one such thread may use the pool. Called with the pool
+ * locked.
+ */
+Void TComThreadPool::xCheckExternalThread()
+{
+  const TComThreadId cThread = TComThread::getCurrentThreadId();
+  if ( !m_bHasExternalThread )
+  {
+    m_cExternalThread    = cThread;
+    m_bHasExternalThread = true;
+  }
+  assert( TComThread::isSameThread( cThread, m_cExternalThread ) );
+}
+
+/** Take the oldest ready task of the queue. Called with the pool locked.
+ * \param pcGroup  only take tasks of this group, NULL for any task
+ * \returns the task removed from the queue, NULL if no task is ready
+ */
+TComTask* TComThreadPool::xTakeTask( const TComTaskGroup* pcGroup )
+{
+  for ( std::deque<TComTask*>::iterator it = m_cQueue.begin(); it != m_cQueue.end(); it++ )
+  {
+    TComTask* pcTask = *it;
+    if ( ( pcGroup == NULL || pcTask->m_pcGroup == pcGroup ) && pcTask->isReady() )
+    {
+      m_cQueue.erase( it );
+      return pcTask;
+    }
+  }
+  return NULL;
+}
+
+/** Run a task with the pool unlocked and account for it in its group. Called with the pool locked.
+ * \param pcTask      task taken from a queue
+ * \param iThreadIdx  slot of the calling thread
+ */
+Void TComThreadPool::xRunTask( TComTask* pcTask, Int iThreadIdx )
+{
+  TComTaskGroup* pcGroup = pcTask->m_pcGroup;
+
+  m_cMutex.unlock();
+  pcTask->run( iThreadIdx );
+  m_cMutex.lock();
+
+  pcGroup->m_iNumPending--;
+  m_cCond.broadcast();
+}
+
+Void TComThreadPool::xWorkerLoop( Int iThreadIdx )
+{
+  m_cMutex.lock();
+  while ( !m_bStop )
+  {
+    TComTask* pcTask = xTakeTask( NULL );
+    if ( pcTask )
+    {
+      xRunTask( pcTask, iThreadIdx );
+    }
+    else
+    {
+      m_cCond.wait( m_cMutex );
+    }
+  }
+  m_cMutex.unlock();
+}
+
+//! \}
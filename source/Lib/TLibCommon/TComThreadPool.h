@@ -0,0 +1,183 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.h
+    \brief    thread pool with a shared task queue, used by the encoder and decoder stages (header)
+*/
+
+#ifndef __TCOMTHREADPOOL__
+#define __TCOMTHREADPOOL__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <deque>
+#include <vector>
+#include "CommonDef.h"
+#include "TComThread.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+class TComThreadPool;
+class TComTaskGroup;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// unit of work (CTU row, tile, picture, ...) executed by the thread pool
+class TComTask
+{
+public:
+  TComTask() : m_pcGroup( NULL ) {}
+  virtual ~TComTask() {}
+
+  /// dependency check: the task is only started once this returns true. It is called with the pool locked, so it
+  /// must not block and may only take locks that are never held while calling into the pool (e.g. progress counters)
+  virtual Bool  isReady ()                  { return true; }
+  /// \param iThreadIdx  slot of the executing thread, in [0, TComThreadPool::getNumThreadSlots())
+  virtual Void  run     ( Int iThreadIdx ) = 0;
+
+private:
+  TComTaskGroup*  m_pcGroup;                ///< group the task was submitted with
+
+  friend class TComThreadPool;
+};
+
+/// set of tasks that are waited for together
+class TComTaskGroup
+{
+public:
+  TComTaskGroup() : m_iNumPending( 0 ) {}
+
+private:
+  TComTaskGroup( const TComTaskGroup& );
+  TComTaskGroup& operator= ( const TComTaskGroup& );
+
+  Int             m_iNumPending;            ///< submitted tasks that have not finished yet, protected by the pool lock
+
+  friend class TComThreadPool;
+};
+
+/// monotonic counter published by a producer (e.g. the number of reconstructed CTU rows of a picture) that tasks
+/// of a thread pool can depend on in TComTask::isReady() and that other threads can wait for
+class TComProgressCounter
+{
+public:
+  TComProgressCounter();
+
+  /// pool whose waiting tasks are re-examined whenever the counter changes
+  Void  setThreadPool ( TComThreadPool* pcThreadPool ) { m_pcThreadPool = pcThreadPool; }
+
+  Void  set           ( UInt uiValue );
+  UInt  get           ();
+  Void  wait          ( UInt uiValue );     ///< block until the counter is at least uiValue
+
+private:
+  TComProgressCounter( const TComProgressCounter& );
+  TComProgressCounter& operator= ( const TComProgressCounter& );
+
+  UInt            m_uiValue;
+  TComMutex       m_cMutex;
+  TComCondition   m_cCond;
+  TComThreadPool* m_pcThreadPool;
+};
+
+/** Pool of worker threads sharing one task queue. An idle thread takes the oldest task whose dependencies are met,
+ * so all queue accesses and the TComTask::isReady() checks of the queued tasks are serialized by one lock. This is
+ * cheap as long as the tasks are coarse (CTU rows, tiles, pictures) and only a few dozen of them are queued at a time;
+ * it is not meant for fine-grained tasks.
+ *
+ * Besides the pool threads, one external thread (the thread driving the encoder or decoder) may submit tasks and
+ * wait for them. It gets the extra thread slot, which is why there is one thread slot more than there are pool
+ * threads; submitting or waiting from a second external thread is not supported.
+ *
+ * A thread that waits for a task group helps: it runs the ready tasks of that group itself. It never picks up
+ * tasks of other groups while waiting, so that a waiting task cannot end up underneath one it depends on.
+ */
+class TComThreadPool
+{
+public:
+  TComThreadPool();
+  ~TComThreadPool();
+
+  Void  create            ( Int iNumThreads );
+  Void  destroy           ();
+
+  Int   getNumThreads     () const { return (Int)m_apcThreads.size(); }
+  Int   getNumThreadSlots () const { return getNumThreads() + 1;     }
+  /// slot of the calling thread: its index for a pool thread, getNumThreads() for the external thread
+  Int   getThreadIdx      () const;
+
+  /// queue a task; the task and the group have to stay alive until the group has been waited for
+  Void  submit            ( TComTask* pcTask, TComTaskGroup* pcGroup );
+  /// return once all tasks of the group have finished, running ready tasks of the group meanwhile
+  Void  wait              ( TComTaskGroup* pcGroup );
+  /// re-examine the dependencies of the queued tasks, to be called when something a task depends on has changed
+  Void  wakeUp            ();
+
+private:
+  TComThreadPool( const TComThreadPool& );
+  TComThreadPool& operator= ( const TComThreadPool& );
+
+  class TComPoolThread : public TComThread
+  {
+  public:
+    TComPoolThread( TComThreadPool* pcPool, Int iThreadIdx ) : m_pcPool( pcPool ), m_iThreadIdx( iThreadIdx ) {}
+  protected:
+    Void  threadMain() { m_pcPool->xWorkerLoop( m_iThreadIdx ); }
+  private:
+    TComThreadPool* m_pcPool;
+    Int             m_iThreadIdx;
+  };
+  friend class TComPoolThread;
+
+  Void      xCheckExternalThread ();
+  TComTask* xTakeTask     ( const TComTaskGroup* pcGroup );
+  Void      xRunTask      ( TComTask* pcTask, Int iThreadIdx );
+  Void      xWorkerLoop   ( Int iThreadIdx );
+
+  std::vector<TComPoolThread*>        m_apcThreads;
+  std::deque<TComTask*>               m_cQueue;     ///< tasks not started yet, oldest first
+  TComMutex                           m_cMutex;     ///< protects the queue, the task groups and the external thread
+  TComCondition                       m_cCond;      ///< signalled when a task is queued or finished, or on wakeUp()
+  Bool                                m_bStop;
+  Bool                                m_bHasExternalThread;
+  TComThreadId                        m_cExternalThread;  ///< the only non-pool thread allowed to submit and wait
+};
+
+//! \}
+
+#endif // __TCOMTHREADPOOL__
@@ -40,6 +40,7 @@
 #include <limits>
 #include <memory.h>
 #include "TComTrQuant.h"
+#include "TComTrQuantSIMD.h"
 #include "TComPic.h"
 #include "ContextTables.h"
 #include "TComTU.h"
@@ -1166,6 +1167,18 @@ Void TComTrQuant::xQuant(       TComTU       &rTu,
     const Int iAdd   = (pcCU->getSlice()->getSliceType()==I_SLICE ? 171 : 85) << (iQBits-9);
     const Int qBits8 = iQBits - 8;
 
+#if SIMD_X86
+#if ADAPTIVE_QP_SELECTION
+    if ( g_simdLevel >= SIMD_SSE41 && !m_bUseAdaptQpSelect )
+#else
+    if ( g_simdLevel >= SIMD_SSE41 )
+#endif
+    {
+      uiAbsSum += TComTrQuantSIMD::quant( g_simdLevel, piCoef, piQCoef, deltaU, uiWidth*uiHeight, enableScalingLists ? piQuantCoeff : NULL, defaultQuantisationCoefficient,
+                                          iQBits, iAdd, entropyCodingMinimum, entropyCodingMaximum );
+    }
+    else
+#endif
     for( Int uiBlockPos = 0; uiBlockPos < uiWidth*uiHeight; uiBlockPos++ )
     {
       const TCoeff iLevel   = piCoef[uiBlockPos];
@@ -1248,6 +1261,13 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
 
     Int *piDequantCoef = getDequantCoeff(scalingListType,QP_rem,uiLog2TrSize-2);
 
+#if SIMD_X86
+    if ( g_simdLevel >= SIMD_SSE41 )
+    {
+      TComTrQuantSIMD::dequant( g_simdLevel, piQCoef, piCoef, numSamplesInBlock, piDequantCoef, 0, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+    }
+    else
+#endif
     if(rightShift > 0)
     {
       const Intermediate_Int iAdd = 1 << (rightShift - 1);
@@ -1285,6 +1305,13 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
+#if SIMD_X86
+    if ( g_simdLevel >= SIMD_SSE41 )
+    {
+      TComTrQuantSIMD::dequant( g_simdLevel, piQCoef, piCoef, numSamplesInBlock, NULL, scale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+    }
+    else
+#endif
     if (rightShift > 0)
     {
       const Intermediate_Int iAdd = 1 << (rightShift - 1);
@@ -1812,6 +1839,14 @@ Void TComTrQuant::xT( const ComponentID compID, Bool useDST, Pel* piBlkResi, UIn
   }
 #endif
 
+#if SIMD_X86
+  if ( g_simdLevel >= SIMD_SSE41 &&
+       TComTrQuantSIMD::forwardTransform( g_simdLevel, g_bitDepth[toChannelType(compID)], piBlkResi, uiStride, psCoeff, iWidth, iHeight, useDST, g_maxTrDynamicRange[toChannelType(compID)] ) )
+  {
+    return;
+  }
+#endif
+
   TCoeff block[ MAX_TU_SIZE * MAX_TU_SIZE ];
   TCoeff coeff[ MAX_TU_SIZE * MAX_TU_SIZE ];
 
@@ -1847,6 +1882,19 @@ Void TComTrQuant::xIT( const ComponentID compID, Bool useDST, TCoeff* plCoef, Pe
   }
 #endif
 
+#if SIMD_X86
+#if O0043_BEST_EFFORT_DECODING
+  if ( g_simdLevel >= SIMD_SSE41 &&
+       TComTrQuantSIMD::inverseTransform( g_simdLevel, g_bitDepthInStream[toChannelType(compID)], plCoef, pResidual, uiStride, iWidth, iHeight, useDST, g_maxTrDynamicRange[toChannelType(compID)] ) )
+#else
+  if ( g_simdLevel >= SIMD_SSE41 &&
+       TComTrQuantSIMD::inverseTransform( g_simdLevel, g_bitDepth[toChannelType(compID)], plCoef, pResidual, uiStride, iWidth, iHeight, useDST, g_maxTrDynamicRange[toChannelType(compID)] ) )
+#endif
+  {
+    return;
+  }
+#endif
+
   TCoeff block[ MAX_TU_SIZE * MAX_TU_SIZE ];
   TCoeff coeff[ MAX_TU_SIZE * MAX_TU_SIZE ];
 
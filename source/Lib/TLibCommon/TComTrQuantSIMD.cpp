@@ -0,0 +1,781 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComTrQuantSIMD.cpp
+    \brief    SIMD implementations of the transforms and the quantisation
+*/
+
+#include "TComTrQuantSIMD.h"
+#include "TComRom.h"
+#include <memory.h>
+#include <limits>
+
+//! \ingroup TLibCommon
+//! \{
+
+#if SIMD_X86
+
+// ====================================================================================================================
+// Tables
+// ====================================================================================================================
+
+// The one-dimensional transforms are computed as matrix multiplications rather than as partial butterflies. The sums
+// of products are the same, so are the results after the rounding, the shift and the clipping. The inputs are taken
+// as 16-bit values, in pairs, and multiplied with pairs of matrix coefficients by the multiply-add instructions,
+// which give the 32-bit sums.
+
+static const Int NUM_TRANSFORM_MATRICES = 5;    ///< DST 4x4 and DCT 4x4 to 32x32
+
+/// matrix of the DST (index 0) or of the DCT of size 4 << (iMatrix - 1)
+static const TMatrixCoeff* xGetMatrix( Int iMatrix, Int dir )
+{
+  switch ( iMatrix )
+  {
+    case 0:  return &g_as_DST_MAT_4[dir][0][0];
+    case 1:  return &g_aiT4 [dir][0][0];
+    case 2:  return &g_aiT8 [dir][0][0];
+    case 3:  return &g_aiT16[dir][0][0];
+    default: return &g_aiT32[dir][0][0];
+  }
+}
+
+static inline Int xGetMatrixIndex( Int iSize, Bool useDST )
+{
+  return useDST ? 0 : g_aucConvertToBit[iSize] + 1;
+}
+
+/// matrix coefficients of the inputs 2p and 2p+1 for each output, two 16-bit ones per Int
+struct TransformPairs
+{
+  Int aiRows   [TRANSFORM_NUMBER_OF_DIRECTIONS][NUM_TRANSFORM_MATRICES][MAX_TU_SIZE * MAX_TU_SIZE / 2];   ///< at p * size + output, for the transforms of the rows
+  Int aiColumns[TRANSFORM_NUMBER_OF_DIRECTIONS][NUM_TRANSFORM_MATRICES][MAX_TU_SIZE * MAX_TU_SIZE / 2];   ///< at output * size / 2 + p, for the transforms of the columns
+
+  TransformPairs()
+  {
+    for ( Int dir = 0; dir < TRANSFORM_NUMBER_OF_DIRECTIONS; dir++ )
+    {
+      for ( Int iMatrix = 0; iMatrix < NUM_TRANSFORM_MATRICES; iMatrix++ )
+      {
+        const Int iSize = ( iMatrix == 0 ) ? 4 : 2 << iMatrix;
+        const TMatrixCoeff* piMatrix = xGetMatrix( iMatrix, dir );
+        for ( Int p = 0; p < iSize / 2; p++ )
+        {
+          for ( Int o = 0; o < iSize; o++ )
+          {
+            // the forward matrices have a row per output, the inverse ones a row per input
+            const TMatrixCoeff c0 = ( dir == TRANSFORM_FORWARD ) ? piMatrix[o * iSize + 2 * p    ] : piMatrix[(2 * p    ) * iSize + o];
+            const TMatrixCoeff c1 = ( dir == TRANSFORM_FORWARD ) ? piMatrix[o * iSize + 2 * p + 1] : piMatrix[(2 * p + 1) * iSize + o];
+            const Int iPair = (Int)( UInt( UShort( c0 ) ) | ( UInt( UShort( c1 ) ) << 16 ) );
+            aiRows   [dir][iMatrix][p * iSize + o        ] = iPair;
+            aiColumns[dir][iMatrix][o * iSize / 2 + p    ] = iPair;
+          }
+        }
+      }
+    }
+  }
+};
+
+static const TransformPairs s_cPairs;
+
+// ====================================================================================================================
+// Building blocks
+// ====================================================================================================================
+
+/// maximum of the four 32-bit lanes
+SIMD_TARGET_SSE41
+static inline Int xHorizontalMax( __m128i vMax )
+{
+  vMax = _mm_max_epi32( vMax, _mm_shuffle_epi32( vMax, 0x4e ) );
+  vMax = _mm_max_epi32( vMax, _mm_shuffle_epi32( vMax, 0xb1 ) );
+  return _mm_cvtsi128_si32( vMax );
+}
+
+/// maximum of the eight 32-bit lanes
+SIMD_TARGET_AVX2
+static inline Int xHorizontalMax( __m256i vMax )
+{
+  return xHorizontalMax( _mm_max_epi32( _mm256_castsi256_si128( vMax ), _mm256_extracti128_si256( vMax, 1 ) ) );
+}
+
+/// store 4 outputs given as 32-bit values, either as 16-bit values, with saturation, or as 32-bit ones
+SIMD_TARGET_SSE41
+static inline Void xStore4( Short* dst, __m128i vVal )
+{
+  _mm_storel_epi64( (__m128i*)dst, _mm_packs_epi32( vVal, vVal ) );
+}
+
+SIMD_TARGET_SSE41
+static inline Void xStore4( TCoeff* dst, __m128i vVal )
+{
+  _mm_storeu_si128( (__m128i*)dst, vVal );
+}
+
+/// store 8 outputs given as two sets of 4 32-bit values
+SIMD_TARGET_SSE41
+static inline Void xStore8( Short* dst, __m128i vLo, __m128i vHi )
+{
+  _mm_storeu_si128( (__m128i*)dst, _mm_packs_epi32( vLo, vHi ) );
+}
+
+SIMD_TARGET_SSE41
+static inline Void xStore8( TCoeff* dst, __m128i vLo, __m128i vHi )
+{
+  _mm_storeu_si128( (__m128i*)dst,       vLo );
+  _mm_storeu_si128( (__m128i*)( dst + 4 ), vHi );
+}
+
+/// store 16 outputs given as two sets of 8 32-bit values, outputs 0..3 and 8..11 in vLo and 4..7 and 12..15 in vHi
+SIMD_TARGET_AVX2
+static inline Void xStore16( Short* dst, __m256i vLo, __m256i vHi )
+{
+  _mm256_storeu_si256( (__m256i*)dst, _mm256_packs_epi32( vLo, vHi ) );
+}
+
+SIMD_TARGET_AVX2
+static inline Void xStore16( TCoeff* dst, __m256i vLo, __m256i vHi )
+{
+  _mm256_storeu_si256( (__m256i*)dst,       _mm256_permute2x128_si256( vLo, vHi, 0x20 ) );
+  _mm256_storeu_si256( (__m256i*)( dst + 8 ), _mm256_permute2x128_si256( vLo, vHi, 0x31 ) );
+}
+
+// ====================================================================================================================
+// Transforms of the rows
+// ====================================================================================================================
+
+// Each row of N inputs gives a row of N outputs: the pairs of inputs are broadcast and multiplied with the matrix
+// coefficients of all outputs. The outputs are stored as 16-bit values with saturation. Only the first iNumPairs
+// pairs of inputs are used, the other ones being zero. With bTrackRange, the largest magnitude of the outputs before
+// the saturation is returned.
+
+template<Int N, Bool bTrackRange>
+SIMD_TARGET_SSE41
+static Int xTransformRowsSse41( const Short* src, Int srcStride, Short* dst, Int dstStride, Int iRows, Int iNumPairs, const Int* piPairs, Int shift )
+{
+  const __m128i vAdd   = _mm_set1_epi32( ( shift > 0 ) ? 1 << ( shift - 1 ) : 0 );
+  const __m128i vShift = _mm_cvtsi32_si128( shift );
+  __m128i vMaxAbs = _mm_setzero_si128();
+
+  for ( Int j = 0; j < iRows; j++ )
+  {
+    __m128i avSum[MAX_TU_SIZE / 4];
+    for ( Int k = 0; k < N / 4; k++ )
+    {
+      avSum[k] = vAdd;
+    }
+    for ( Int p = 0; p < iNumPairs; p++ )
+    {
+      Int iPair;
+      memcpy( &iPair, src + 2 * p, sizeof( Int ) );
+      const __m128i vPair = _mm_set1_epi32( iPair );
+      for ( Int k = 0; k < N / 4; k++ )
+      {
+        avSum[k] = _mm_add_epi32( avSum[k], _mm_madd_epi16( vPair, _mm_loadu_si128( (const __m128i*)( piPairs + p * N + 4 * k ) ) ) );
+      }
+    }
+    for ( Int k = 0; k < N / 4; k++ )
+    {
+      avSum[k] = _mm_sra_epi32( avSum[k], vShift );
+      if ( bTrackRange )
+      {
+        vMaxAbs = _mm_max_epi32( vMaxAbs, _mm_abs_epi32( avSum[k] ) );
+      }
+    }
+    if ( N == 4 )
+    {
+      xStore4( dst, avSum[0] );
+    }
+    else
+    {
+      for ( Int k = 0; k < N / 4; k += 2 )
+      {
+        xStore8( dst + 4 * k, avSum[k], avSum[k + 1] );
+      }
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+  return bTrackRange ? xHorizontalMax( vMaxAbs ) : 0;
+}
+
+template<Int N, Bool bTrackRange>
+SIMD_TARGET_AVX2
+static Int xTransformRowsAvx2( const Short* src, Int srcStride, Short* dst, Int dstStride, Int iRows, Int iNumPairs, const Int* piPairs, Int shift )
+{
+  const __m256i vAdd   = _mm256_set1_epi32( ( shift > 0 ) ? 1 << ( shift - 1 ) : 0 );
+  const __m128i vShift = _mm_cvtsi32_si128( shift );
+  __m256i vMaxAbs = _mm256_setzero_si256();
+
+  for ( Int j = 0; j < iRows; j++ )
+  {
+    __m256i avSum[MAX_TU_SIZE / 8];
+    for ( Int k = 0; k < N / 8; k++ )
+    {
+      avSum[k] = vAdd;
+    }
+    for ( Int p = 0; p < iNumPairs; p++ )
+    {
+      Int iPair;
+      memcpy( &iPair, src + 2 * p, sizeof( Int ) );
+      const __m256i vPair = _mm256_set1_epi32( iPair );
+      for ( Int k = 0; k < N / 8; k++ )
+      {
+        avSum[k] = _mm256_add_epi32( avSum[k], _mm256_madd_epi16( vPair, _mm256_loadu_si256( (const __m256i*)( piPairs + p * N + 8 * k ) ) ) );
+      }
+    }
+    for ( Int k = 0; k < N / 8; k++ )
+    {
+      avSum[k] = _mm256_sra_epi32( avSum[k], vShift );
+      if ( bTrackRange )
+      {
+        vMaxAbs = _mm256_max_epi32( vMaxAbs, _mm256_abs_epi32( avSum[k] ) );
+      }
+    }
+    // the packing works within the 128-bit halves, the permutation puts the outputs back in order
+    if ( N == 8 )
+    {
+      _mm_storeu_si128( (__m128i*)dst, _mm256_castsi256_si128( _mm256_permute4x64_epi64( _mm256_packs_epi32( avSum[0], avSum[0] ), 0xd8 ) ) );
+    }
+    else
+    {
+      for ( Int k = 0; k < N / 8; k += 2 )
+      {
+        _mm256_storeu_si256( (__m256i*)( dst + 8 * k ), _mm256_permute4x64_epi64( _mm256_packs_epi32( avSum[k], avSum[k + 1] ), 0xd8 ) );
+      }
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+  return bTrackRange ? xHorizontalMax( vMaxAbs ) : 0;
+}
+
+template<Bool bTrackRange>
+static Int xTransformRows( SimdLevel level, const Short* src, Int srcStride, Short* dst, Int dstStride, Int iSize, Int iRows, Int iNumPairs, const Int* piPairs, Int shift )
+{
+  if ( level >= SIMD_AVX2 )
+  {
+    switch ( iSize )
+    {
+      case 8:  return xTransformRowsAvx2< 8, bTrackRange>( src, srcStride, dst, dstStride, iRows, iNumPairs, piPairs, shift );
+      case 16: return xTransformRowsAvx2<16, bTrackRange>( src, srcStride, dst, dstStride, iRows, iNumPairs, piPairs, shift );
+      case 32: return xTransformRowsAvx2<32, bTrackRange>( src, srcStride, dst, dstStride, iRows, iNumPairs, piPairs, shift );
+      default: break;
+    }
+  }
+  switch ( iSize )
+  {
+    case 4:  return xTransformRowsSse41< 4, bTrackRange>( src, srcStride, dst, dstStride, iRows, iNumPairs, piPairs, shift );
+    case 8:  return xTransformRowsSse41< 8, bTrackRange>( src, srcStride, dst, dstStride, iRows, iNumPairs, piPairs, shift );
+    case 16: return xTransformRowsSse41<16, bTrackRange>( src, srcStride, dst, dstStride, iRows, iNumPairs, piPairs, shift );
+    default: return xTransformRowsSse41<32, bTrackRange>( src, srcStride, dst, dstStride, iRows, iNumPairs, piPairs, shift );
+  }
+}
+
+// ====================================================================================================================
+// Transforms of the columns
+// ====================================================================================================================
+
+// The rows 2p and 2p+1 of the input block are interleaved and multiplied with the broadcast matrix coefficients of an
+// output row, so the iCols columns are transformed side by side. Only the first iNumPairs pairs of input rows are
+// used, the other ones being zero.
+
+template<typename T>
+SIMD_TARGET_SSE41
+static Void xTransformColumnsSse41( const Short* src, Int iCols, Int iNumOutputs, Int iNumPairs, const Int* piPairs, Int iPairStride, Int shift, T* dst )
+{
+  const __m128i vAdd   = _mm_set1_epi32( ( shift > 0 ) ? 1 << ( shift - 1 ) : 0 );
+  const __m128i vShift = _mm_cvtsi32_si128( shift );
+
+  for ( Int o = 0; o < iNumOutputs; o++ )
+  {
+    const Int* piPairsOfOutput = piPairs + o * iPairStride;
+    if ( iCols == 4 )
+    {
+      __m128i vSum = vAdd;
+      for ( Int p = 0; p < iNumPairs; p++ )
+      {
+        const __m128i vSrc0 = _mm_loadl_epi64( (const __m128i*)( src + ( 2 * p     ) * iCols ) );
+        const __m128i vSrc1 = _mm_loadl_epi64( (const __m128i*)( src + ( 2 * p + 1 ) * iCols ) );
+        vSum = _mm_add_epi32( vSum, _mm_madd_epi16( _mm_unpacklo_epi16( vSrc0, vSrc1 ), _mm_set1_epi32( piPairsOfOutput[p] ) ) );
+      }
+      xStore4( dst, _mm_sra_epi32( vSum, vShift ) );
+    }
+    else
+    {
+      for ( Int c = 0; c < iCols; c += 8 )
+      {
+        __m128i vSumLo = vAdd;
+        __m128i vSumHi = vAdd;
+        for ( Int p = 0; p < iNumPairs; p++ )
+        {
+          const __m128i vPair = _mm_set1_epi32( piPairsOfOutput[p] );
+          const __m128i vSrc0 = _mm_loadu_si128( (const __m128i*)( src + ( 2 * p     ) * iCols + c ) );
+          const __m128i vSrc1 = _mm_loadu_si128( (const __m128i*)( src + ( 2 * p + 1 ) * iCols + c ) );
+          vSumLo = _mm_add_epi32( vSumLo, _mm_madd_epi16( _mm_unpacklo_epi16( vSrc0, vSrc1 ), vPair ) );
+          vSumHi = _mm_add_epi32( vSumHi, _mm_madd_epi16( _mm_unpackhi_epi16( vSrc0, vSrc1 ), vPair ) );
+        }
+        xStore8( dst + c, _mm_sra_epi32( vSumLo, vShift ), _mm_sra_epi32( vSumHi, vShift ) );
+      }
+    }
+    dst += iCols;
+  }
+}
+
+template<typename T>
+SIMD_TARGET_AVX2
+static Void xTransformColumnsAvx2( const Short* src, Int iCols, Int iNumOutputs, Int iNumPairs, const Int* piPairs, Int iPairStride, Int shift, T* dst )
+{
+  if ( iCols < 16 )
+  {
+    xTransformColumnsSse41( src, iCols, iNumOutputs, iNumPairs, piPairs, iPairStride, shift, dst );
+    return;
+  }
+  const __m256i vAdd   = _mm256_set1_epi32( ( shift > 0 ) ? 1 << ( shift - 1 ) : 0 );
+  const __m128i vShift = _mm_cvtsi32_si128( shift );
+
+  for ( Int o = 0; o < iNumOutputs; o++ )
+  {
+    const Int* piPairsOfOutput = piPairs + o * iPairStride;
+    for ( Int c = 0; c < iCols; c += 16 )
+    {
+      __m256i vSumLo = vAdd;
+      __m256i vSumHi = vAdd;
+      for ( Int p = 0; p < iNumPairs; p++ )
+      {
+        const __m256i vPair = _mm256_set1_epi32( piPairsOfOutput[p] );
+        const __m256i vSrc0 = _mm256_loadu_si256( (const __m256i*)( src + ( 2 * p     ) * iCols + c ) );
+        const __m256i vSrc1 = _mm256_loadu_si256( (const __m256i*)( src + ( 2 * p + 1 ) * iCols + c ) );
+        vSumLo = _mm256_add_epi32( vSumLo, _mm256_madd_epi16( _mm256_unpacklo_epi16( vSrc0, vSrc1 ), vPair ) );
+        vSumHi = _mm256_add_epi32( vSumHi, _mm256_madd_epi16( _mm256_unpackhi_epi16( vSrc0, vSrc1 ), vPair ) );
+      }
+      xStore16( dst + c, _mm256_sra_epi32( vSumLo, vShift ), _mm256_sra_epi32( vSumHi, vShift ) );
+    }
+    dst += iCols;
+  }
+}
+
+template<typename T>
+static Void xTransformColumns( SimdLevel level, const Short* src, Int iCols, Int iNumOutputs, Int iNumPairs, const Int* piPairs, Int iPairStride, Int shift, T* dst )
+{
+  if ( level >= SIMD_AVX2 )
+  {
+    xTransformColumnsAvx2( src, iCols, iNumOutputs, iNumPairs, piPairs, iPairStride, shift, dst );
+  }
+  else
+  {
+    xTransformColumnsSse41( src, iCols, iNumOutputs, iNumPairs, piPairs, iPairStride, shift, dst );
+  }
+}
+
+// ====================================================================================================================
+// Coefficients
+// ====================================================================================================================
+
+/** copy the coefficients to 16-bit values, find the rows and the columns with non-zero coefficients
+ * \param src          coefficients
+ * \param dst          16-bit coefficients
+ * \param iWidth       width of the block
+ * \param iHeight      height of the block
+ * \param riNumRows    number of rows up to the last one with a non-zero coefficient
+ * \param riNumColumns number of columns up to the last one with a non-zero coefficient
+ * \returns false when a coefficient does not fit in 16 bits
+ */
+SIMD_TARGET_SSE41
+static Bool xPackCoefficients( const TCoeff* src, Short* dst, Int iWidth, Int iHeight, Int& riNumRows, Int& riNumColumns )
+{
+  const __m128i vMin = _mm_set1_epi32( std::numeric_limits<Short>::min() );
+  const __m128i vMax = _mm_set1_epi32( std::numeric_limits<Short>::max() );
+  __m128i vOutOfRange = _mm_setzero_si128();
+  UInt    uiColumns   = 0;
+
+  riNumRows = 0;
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    UInt uiRow = 0;
+    for ( Int x = 0; x < iWidth; x += 4 )
+    {
+      const __m128i vCoeff = _mm_loadu_si128( (const __m128i*)( src + x ) );
+      vOutOfRange = _mm_or_si128( vOutOfRange, _mm_or_si128( _mm_cmplt_epi32( vCoeff, vMin ), _mm_cmpgt_epi32( vCoeff, vMax ) ) );
+      _mm_storel_epi64( (__m128i*)( dst + x ), _mm_packs_epi32( vCoeff, vCoeff ) );
+      const UInt uiZero = (UInt)_mm_movemask_ps( _mm_castsi128_ps( _mm_cmpeq_epi32( vCoeff, _mm_setzero_si128() ) ) );
+      uiRow |= ( ~uiZero & 0xf ) << x;
+    }
+    if ( uiRow )
+    {
+      riNumRows  = y + 1;
+      uiColumns |= uiRow;
+    }
+    src += iWidth;
+    dst += iWidth;
+  }
+
+  riNumColumns = iWidth;
+  while ( riNumColumns > 0 && !( uiColumns & ( 1u << ( riNumColumns - 1 ) ) ) )
+  {
+    riNumColumns--;
+  }
+  return _mm_testz_si128( vOutOfRange, vOutOfRange ) != 0;
+}
+
+// ====================================================================================================================
+// Quantisation
+// ====================================================================================================================
+
+// The product of a magnitude and a quantisation coefficient may not fit in 32 bits, so it is computed as a 64-bit
+// value, lanes 0 and 2 and lanes 1 and 3 separately. The quantised magnitude is the low 32 bits of the shifted product,
+// like the conversion to TCoeff of the C++ code. The remainder for the sign bit hiding is computed as there too: the
+// product minus the 32-bit quantised magnitude << iQBits, sign-extended, shifted right as a 64-bit value; only the
+// low 32 bits are kept, for which a logical shift does as well as an arithmetic one.
+
+SIMD_TARGET_SSE41
+static inline __m128i xQuant4( const __m128i& vCoef, const __m128i& vQuantCoeff, const __m128i& vAdd, const __m128i& vQBits, const __m128i& vQBits8,
+                               const __m128i& vMin, const __m128i& vMax, __m128i& rvQCoef, __m128i& rvDeltaU )
+{
+  const __m128i vAbs   = _mm_abs_epi32( vCoef );
+  const __m128i vProd0 = _mm_mul_epu32( vAbs, vQuantCoeff );
+  const __m128i vProd1 = _mm_mul_epu32( _mm_srli_epi64( vAbs, 32 ), _mm_srli_epi64( vQuantCoeff, 32 ) );
+  const __m128i vLevel = _mm_blend_epi16( _mm_srl_epi64( _mm_add_epi64( vProd0, vAdd ), vQBits ),
+                                          _mm_slli_epi64( _mm_srl_epi64( _mm_add_epi64( vProd1, vAdd ), vQBits ), 32 ), 0xcc );
+
+  const __m128i vLevelShifted = _mm_sll_epi32( vLevel, vQBits );
+  const __m128i vSign         = _mm_srai_epi32( vLevelShifted, 31 );
+  const __m128i vDeltaU0      = _mm_srl_epi64( _mm_sub_epi64( vProd0, _mm_blend_epi16( vLevelShifted, _mm_slli_epi64( vSign, 32 ), 0xcc ) ), vQBits8 );
+  const __m128i vDeltaU1      = _mm_srl_epi64( _mm_sub_epi64( vProd1, _mm_blend_epi16( _mm_srli_epi64( vLevelShifted, 32 ), vSign, 0xcc ) ), vQBits8 );
+
+  rvDeltaU = _mm_blend_epi16( vDeltaU0, _mm_slli_epi64( vDeltaU1, 32 ), 0xcc );
+  rvQCoef  = _mm_min_epi32( _mm_max_epi32( _mm_sign_epi32( vLevel, vCoef ), vMin ), vMax );
+  return vLevel;
+}
+
+SIMD_TARGET_AVX2
+static inline __m256i xQuant8( const __m256i& vCoef, const __m256i& vQuantCoeff, const __m256i& vAdd, const __m128i& vQBits, const __m128i& vQBits8,
+                               const __m256i& vMin, const __m256i& vMax, __m256i& rvQCoef, __m256i& rvDeltaU )
+{
+  const __m256i vAbs   = _mm256_abs_epi32( vCoef );
+  const __m256i vProd0 = _mm256_mul_epu32( vAbs, vQuantCoeff );
+  const __m256i vProd1 = _mm256_mul_epu32( _mm256_srli_epi64( vAbs, 32 ), _mm256_srli_epi64( vQuantCoeff, 32 ) );
+  const __m256i vLevel = _mm256_blend_epi32( _mm256_srl_epi64( _mm256_add_epi64( vProd0, vAdd ), vQBits ),
+                                             _mm256_slli_epi64( _mm256_srl_epi64( _mm256_add_epi64( vProd1, vAdd ), vQBits ), 32 ), 0xaa );
+
+  const __m256i vLevelShifted = _mm256_sll_epi32( vLevel, vQBits );
+  const __m256i vSign         = _mm256_srai_epi32( vLevelShifted, 31 );
+  const __m256i vDeltaU0      = _mm256_srl_epi64( _mm256_sub_epi64( vProd0, _mm256_blend_epi32( vLevelShifted, _mm256_slli_epi64( vSign, 32 ), 0xaa ) ), vQBits8 );
+  const __m256i vDeltaU1      = _mm256_srl_epi64( _mm256_sub_epi64( vProd1, _mm256_blend_epi32( _mm256_srli_epi64( vLevelShifted, 32 ), vSign, 0xaa ) ), vQBits8 );
+
+  rvDeltaU = _mm256_blend_epi32( vDeltaU0, _mm256_slli_epi64( vDeltaU1, 32 ), 0xaa );
+  rvQCoef  = _mm256_min_epi32( _mm256_max_epi32( _mm256_sign_epi32( vLevel, vCoef ), vMin ), vMax );
+  return vLevel;
+}
+
+SIMD_TARGET_SSE41
+static TCoeff xQuantSse41( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* piDeltaU, Int iNumCoeff, const Int* piQuantCoeff, Int iQuantCoeff,
+                           Int iQBits, Int iAdd, TCoeff entropyCodingMinimum, TCoeff entropyCodingMaximum )
+{
+  const __m128i vAdd    = _mm_set1_epi64x( iAdd );
+  const __m128i vQBits  = _mm_cvtsi32_si128( iQBits );
+  const __m128i vQBits8 = _mm_cvtsi32_si128( iQBits - 8 );
+  const __m128i vMin    = _mm_set1_epi32( entropyCodingMinimum );
+  const __m128i vMax    = _mm_set1_epi32( entropyCodingMaximum );
+  __m128i vQuantCoeff   = _mm_set1_epi32( iQuantCoeff );
+  __m128i vAbsSum       = _mm_setzero_si128();
+
+  for ( Int n = 0; n < iNumCoeff; n += 4 )
+  {
+    if ( piQuantCoeff )
+    {
+      vQuantCoeff = _mm_loadu_si128( (const __m128i*)( piQuantCoeff + n ) );
+    }
+    __m128i vQCoef;
+    __m128i vDeltaU;
+    vAbsSum = _mm_add_epi32( vAbsSum, xQuant4( _mm_loadu_si128( (const __m128i*)( piCoef + n ) ), vQuantCoeff, vAdd, vQBits, vQBits8, vMin, vMax, vQCoef, vDeltaU ) );
+    _mm_storeu_si128( (__m128i*)( piQCoef  + n ), vQCoef );
+    _mm_storeu_si128( (__m128i*)( piDeltaU + n ), vDeltaU );
+  }
+  vAbsSum = _mm_add_epi32( vAbsSum, _mm_shuffle_epi32( vAbsSum, 0x4e ) );
+  vAbsSum = _mm_add_epi32( vAbsSum, _mm_shuffle_epi32( vAbsSum, 0xb1 ) );
+  return _mm_cvtsi128_si32( vAbsSum );
+}
+
+SIMD_TARGET_AVX2
+static TCoeff xQuantAvx2( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* piDeltaU, Int iNumCoeff, const Int* piQuantCoeff, Int iQuantCoeff,
+                          Int iQBits, Int iAdd, TCoeff entropyCodingMinimum, TCoeff entropyCodingMaximum )
+{
+  const __m256i vAdd    = _mm256_set1_epi64x( iAdd );
+  const __m128i vQBits  = _mm_cvtsi32_si128( iQBits );
+  const __m128i vQBits8 = _mm_cvtsi32_si128( iQBits - 8 );
+  const __m256i vMin    = _mm256_set1_epi32( entropyCodingMinimum );
+  const __m256i vMax    = _mm256_set1_epi32( entropyCodingMaximum );
+  __m256i vQuantCoeff   = _mm256_set1_epi32( iQuantCoeff );
+  __m256i vAbsSum       = _mm256_setzero_si256();
+
+  for ( Int n = 0; n < iNumCoeff; n += 8 )
+  {
+    if ( piQuantCoeff )
+    {
+      vQuantCoeff = _mm256_loadu_si256( (const __m256i*)( piQuantCoeff + n ) );
+    }
+    __m256i vQCoef;
+    __m256i vDeltaU;
+    vAbsSum = _mm256_add_epi32( vAbsSum, xQuant8( _mm256_loadu_si256( (const __m256i*)( piCoef + n ) ), vQuantCoeff, vAdd, vQBits, vQBits8, vMin, vMax, vQCoef, vDeltaU ) );
+    _mm256_storeu_si256( (__m256i*)( piQCoef  + n ), vQCoef );
+    _mm256_storeu_si256( (__m256i*)( piDeltaU + n ), vDeltaU );
+  }
+  __m128i vSum = _mm_add_epi32( _mm256_castsi256_si128( vAbsSum ), _mm256_extracti128_si256( vAbsSum, 1 ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0x4e ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, 0xb1 ) );
+  return _mm_cvtsi128_si32( vSum );
+}
+
+// ====================================================================================================================
+// Dequantisation
+// ====================================================================================================================
+
+// The dequantisation of the C++ code is done with 32-bit arithmetic (Intermediate_Int), the input clipping keeping the
+// products in range. A left shift (rightShift <= 0) and a rounded right shift are applied as one: the product is
+// shifted left by iLeftShift, then iAdd is added and the sum shifted right by iRightShift, one of the two shifts
+// being 0.
+
+SIMD_TARGET_SSE41
+static Void xDequantSse41( const TCoeff* piQCoef, TCoeff* piCoef, Int iNumCoeff, const Int* piDequantCoeff, Int iScale, Int iLeftShift, Int iRightShift, Int iAdd,
+                           TCoeff inputMinimum, TCoeff inputMaximum, TCoeff transformMinimum, TCoeff transformMaximum )
+{
+  const __m128i vAdd        = _mm_set1_epi32( iAdd );
+  const __m128i vLeftShift  = _mm_cvtsi32_si128( iLeftShift );
+  const __m128i vRightShift = _mm_cvtsi32_si128( iRightShift );
+  const __m128i vInputMin   = _mm_set1_epi32( inputMinimum );
+  const __m128i vInputMax   = _mm_set1_epi32( inputMaximum );
+  const __m128i vMin        = _mm_set1_epi32( transformMinimum );
+  const __m128i vMax        = _mm_set1_epi32( transformMaximum );
+  __m128i vScale            = _mm_set1_epi32( iScale );
+
+  for ( Int n = 0; n < iNumCoeff; n += 4 )
+  {
+    if ( piDequantCoeff )
+    {
+      vScale = _mm_loadu_si128( (const __m128i*)( piDequantCoeff + n ) );
+    }
+    const __m128i vQCoef = _mm_min_epi32( _mm_max_epi32( _mm_loadu_si128( (const __m128i*)( piQCoef + n ) ), vInputMin ), vInputMax );
+    const __m128i vCoef  = _mm_sra_epi32( _mm_add_epi32( _mm_sll_epi32( _mm_mullo_epi32( vQCoef, vScale ), vLeftShift ), vAdd ), vRightShift );
+    _mm_storeu_si128( (__m128i*)( piCoef + n ), _mm_min_epi32( _mm_max_epi32( vCoef, vMin ), vMax ) );
+  }
+}
+
+SIMD_TARGET_AVX2
+static Void xDequantAvx2( const TCoeff* piQCoef, TCoeff* piCoef, Int iNumCoeff, const Int* piDequantCoeff, Int iScale, Int iLeftShift, Int iRightShift, Int iAdd,
+                          TCoeff inputMinimum, TCoeff inputMaximum, TCoeff transformMinimum, TCoeff transformMaximum )
+{
+  const __m256i vAdd        = _mm256_set1_epi32( iAdd );
+  const __m128i vLeftShift  = _mm_cvtsi32_si128( iLeftShift );
+  const __m128i vRightShift = _mm_cvtsi32_si128( iRightShift );
+  const __m256i vInputMin   = _mm256_set1_epi32( inputMinimum );
+  const __m256i vInputMax   = _mm256_set1_epi32( inputMaximum );
+  const __m256i vMin        = _mm256_set1_epi32( transformMinimum );
+  const __m256i vMax        = _mm256_set1_epi32( transformMaximum );
+  __m256i vScale            = _mm256_set1_epi32( iScale );
+
+  for ( Int n = 0; n < iNumCoeff; n += 8 )
+  {
+    if ( piDequantCoeff )
+    {
+      vScale = _mm256_loadu_si256( (const __m256i*)( piDequantCoeff + n ) );
+    }
+    const __m256i vQCoef = _mm256_min_epi32( _mm256_max_epi32( _mm256_loadu_si256( (const __m256i*)( piQCoef + n ) ), vInputMin ), vInputMax );
+    const __m256i vCoef  = _mm256_sra_epi32( _mm256_add_epi32( _mm256_sll_epi32( _mm256_mullo_epi32( vQCoef, vScale ), vLeftShift ), vAdd ), vRightShift );
+    _mm256_storeu_si256( (__m256i*)( piCoef + n ), _mm256_min_epi32( _mm256_max_epi32( vCoef, vMin ), vMax ) );
+  }
+}
+
+#endif // SIMD_X86
+
+// ====================================================================================================================
+// Two-dimensional transforms
+// ====================================================================================================================
+
+/** MxN forward transform (2D), see xTrMxN of TComTrQuant
+ *  \param level             instruction set, at least SIMD_SSE41
+ *  \param bitDepth          bit depth of the residual
+ *  \param piBlkResi         input data (residual)
+ *  \param uiStride          stride of the residual
+ *  \param psCoeff           output data (transform coefficients)
+ *  \param iWidth            width of transform
+ *  \param iHeight           height of transform
+ *  \param useDST            use the DST for 4x4 blocks
+ *  \param maxTrDynamicRange transform dynamic range
+ *  \returns false when the block is left to the C++ function
+ */
+Bool TComTrQuantSIMD::forwardTransform( SimdLevel level, Int bitDepth, const Pel* piBlkResi, UInt uiStride, TCoeff* psCoeff, Int iWidth, Int iHeight, Bool useDST, Int maxTrDynamicRange )
+{
+#if SIMD_X86
+  const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_FORWARD];
+
+  const Int shift_1st = ((g_aucConvertToBit[iWidth] + 2) +  bitDepth + TRANSFORM_MATRIX_SHIFT) - maxTrDynamicRange;
+  const Int shift_2nd = (g_aucConvertToBit[iHeight] + 2) + TRANSFORM_MATRIX_SHIFT;
+  const Bool bDST     = useDST && iWidth == 4 && iHeight == 4;
+
+  Short tmp[MAX_TU_SIZE * MAX_TU_SIZE];
+
+  // the transformed rows are the 16-bit inputs of the transforms of the columns, which they fit in for any residual
+  // whose magnitude is below 1 << bitDepth; other residuals are left to the C++ function
+  const Int iMaxAbs = xTransformRows<true>( level, piBlkResi, uiStride, tmp, iWidth, iWidth, iHeight, iWidth / 2,
+                                            s_cPairs.aiRows[TRANSFORM_FORWARD][xGetMatrixIndex( iWidth, bDST )], shift_1st );
+  if ( iMaxAbs > std::numeric_limits<Short>::max() )
+  {
+    return false;
+  }
+  xTransformColumns( level, tmp, iWidth, iHeight, iHeight / 2, s_cPairs.aiColumns[TRANSFORM_FORWARD][xGetMatrixIndex( iHeight, bDST )], iHeight / 2, shift_2nd, psCoeff );
+  return true;
+#else
+  return false;
+#endif
+}
+
+/** MxN inverse transform (2D), see xITrMxN of TComTrQuant
+ *  \param level             instruction set, at least SIMD_SSE41
+ *  \param bitDepth          bit depth of the residual
+ *  \param plCoef            input data (transform coefficients)
+ *  \param pResidual         output data (residual)
+ *  \param uiStride          stride of the residual
+ *  \param iWidth            width of transform
+ *  \param iHeight           height of transform
+ *  \param useDST            use the DST for 4x4 blocks
+ *  \param maxTrDynamicRange transform dynamic range
+ *  \returns false when the block is left to the C++ function
+ */
+Bool TComTrQuantSIMD::inverseTransform( SimdLevel level, Int bitDepth, const TCoeff* plCoef, Pel* pResidual, UInt uiStride, Int iWidth, Int iHeight, Bool useDST, Int maxTrDynamicRange )
+{
+#if SIMD_X86
+  // the clipping of the transformed columns to the dynamic range is the saturation to 16 bits
+  if ( maxTrDynamicRange != 15 )
+  {
+    return false;
+  }
+
+  const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_INVERSE];
+
+  const Int shift_1st = TRANSFORM_MATRIX_SHIFT + 1; //1 has been added to shift_1st at the expense of shift_2nd
+  const Int shift_2nd = (TRANSFORM_MATRIX_SHIFT + maxTrDynamicRange - 1) - bitDepth;
+  const Bool bDST     = useDST && iWidth == 4 && iHeight == 4;
+
+  Short coeff[MAX_TU_SIZE * MAX_TU_SIZE];
+  Short tmp  [MAX_TU_SIZE * MAX_TU_SIZE];
+  Int   iNumRows;
+  Int   iNumColumns;
+
+  if ( !xPackCoefficients( plCoef, coeff, iWidth, iHeight, iNumRows, iNumColumns ) )
+  {
+    return false;
+  }
+  if ( iNumRows == 0 )
+  {
+    for ( Int y = 0; y < iHeight; y++ )
+    {
+      memset( pResidual + y * uiStride, 0, iWidth * sizeof( Pel ) );
+    }
+    return true;
+  }
+
+  // the coefficients past the last non-zero row, and the transformed columns past the last non-zero column, are zero
+  // and skipped
+  xTransformColumns( level, coeff, iWidth, iHeight, ( iNumRows + 1 ) / 2, s_cPairs.aiColumns[TRANSFORM_INVERSE][xGetMatrixIndex( iHeight, bDST )], iHeight / 2, shift_1st, tmp );
+  xTransformRows<false>( level, tmp, iWidth, pResidual, uiStride, iWidth, iHeight, ( iNumColumns + 1 ) / 2,
+                         s_cPairs.aiRows[TRANSFORM_INVERSE][xGetMatrixIndex( iWidth, bDST )], shift_2nd );
+  return true;
+#else
+  return false;
+#endif
+}
+
+// ====================================================================================================================
+// Quantisation and dequantisation
+// ====================================================================================================================
+
+/** quantisation of the non-RDOQ path of xQuant of TComTrQuant, without adaptive QP selection
+ *  \param level                instruction set, at least SIMD_SSE41
+ *  \param piCoef               input data (transform coefficients)
+ *  \param piQCoef              output data (quantised coefficients)
+ *  \param piDeltaU             output data (rounding errors for the sign bit hiding)
+ *  \param iNumCoeff            number of coefficients, a multiple of 8
+ *  \param piQuantCoeff         quantisation coefficients of the scaling list, NULL when it is not used
+ *  \param iQuantCoeff          quantisation coefficient without scaling list
+ *  \param iQBits               quantisation shift
+ *  \param iAdd                 rounding offset
+ *  \param entropyCodingMinimum minimum quantised coefficient
+ *  \param entropyCodingMaximum maximum quantised coefficient
+ *  \returns sum of the quantised magnitudes
+ */
+TCoeff TComTrQuantSIMD::quant( SimdLevel level, const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* piDeltaU, Int iNumCoeff, const Int* piQuantCoeff, Int iQuantCoeff,
+                               Int iQBits, Int iAdd, TCoeff entropyCodingMinimum, TCoeff entropyCodingMaximum )
+{
+#if SIMD_X86
+  if ( level >= SIMD_AVX2 )
+  {
+    return xQuantAvx2( piCoef, piQCoef, piDeltaU, iNumCoeff, piQuantCoeff, iQuantCoeff, iQBits, iAdd, entropyCodingMinimum, entropyCodingMaximum );
+  }
+  return xQuantSse41( piCoef, piQCoef, piDeltaU, iNumCoeff, piQuantCoeff, iQuantCoeff, iQBits, iAdd, entropyCodingMinimum, entropyCodingMaximum );
+#else
+  return 0;
+#endif
+}
+
+/** dequantisation of xDeQuant of TComTrQuant
+ *  \param level            instruction set, at least SIMD_SSE41
+ *  \param piQCoef          input data (quantised coefficients)
+ *  \param piCoef           output data (transform coefficients)
+ *  \param iNumCoeff        number of coefficients, a multiple of 8
+ *  \param piDequantCoeff   dequantisation coefficients of the scaling list, NULL when it is not used
+ *  \param iScale           dequantisation coefficient without scaling list
+ *  \param rightShift       right shift of the products, a left shift when negative
+ *  \param inputMinimum     minimum quantised coefficient
+ *  \param inputMaximum     maximum quantised coefficient
+ *  \param transformMinimum minimum transform coefficient
+ *  \param transformMaximum maximum transform coefficient
+ */
+Void TComTrQuantSIMD::dequant( SimdLevel level, const TCoeff* piQCoef, TCoeff* piCoef, Int iNumCoeff, const Int* piDequantCoeff, Int iScale, Int rightShift,
+                               TCoeff inputMinimum, TCoeff inputMaximum, TCoeff transformMinimum, TCoeff transformMaximum )
+{
+#if SIMD_X86
+  const Int iLeftShift  = ( rightShift > 0 ) ? 0 : -rightShift;
+  const Int iRightShift = ( rightShift > 0 ) ? rightShift : 0;
+  const Int iAdd        = ( rightShift > 0 ) ? 1 << ( rightShift - 1 ) : 0;
+
+  if ( level >= SIMD_AVX2 )
+  {
+    xDequantAvx2( piQCoef, piCoef, iNumCoeff, piDequantCoeff, iScale, iLeftShift, iRightShift, iAdd, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+  }
+  else
+  {
+    xDequantSse41( piQCoef, piCoef, iNumCoeff, piDequantCoeff, iScale, iLeftShift, iRightShift, iAdd, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+  }
+#endif
+}
+
+//! \}
@@ -0,0 +1,67 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComTrQuantSIMD.h
+    \brief    SIMD implementations of the transforms and the quantisation (header)
+*/
+
+#ifndef __TCOMTRQUANTSIMD__
+#define __TCOMTRQUANTSIMD__
+
+#include "TypeDef.h"
+#include "TComSimd.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Namespace definition
+// ====================================================================================================================
+
+/// SIMD implementations of the transforms (xTrMxN and xITrMxN), the quantisation (the non-RDOQ path of xQuant) and the
+/// dequantisation (xDeQuant) of TComTrQuant, giving the same results as the C++ ones. The transforms return false,
+/// without output, for blocks they do not handle, which are then transformed by the C++ functions.
+namespace TComTrQuantSIMD
+{
+  Bool   forwardTransform( SimdLevel level, Int bitDepth, const Pel* piBlkResi, UInt uiStride, TCoeff* psCoeff, Int iWidth, Int iHeight, Bool useDST, Int maxTrDynamicRange );
+  Bool   inverseTransform( SimdLevel level, Int bitDepth, const TCoeff* plCoef, Pel* pResidual, UInt uiStride, Int iWidth, Int iHeight, Bool useDST, Int maxTrDynamicRange );
+
+  TCoeff quant           ( SimdLevel level, const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* piDeltaU, Int iNumCoeff, const Int* piQuantCoeff, Int iQuantCoeff,
+                           Int iQBits, Int iAdd, TCoeff entropyCodingMinimum, TCoeff entropyCodingMaximum );
+  Void   dequant         ( SimdLevel level, const TCoeff* piQCoef, TCoeff* piCoef, Int iNumCoeff, const Int* piDequantCoeff, Int iScale, Int rightShift,
+                           TCoeff inputMinimum, TCoeff inputMaximum, TCoeff transformMinimum, TCoeff transformMaximum );
+}// END NAMESPACE DEFINITION TComTrQuantSIMD
+
+//! \}
+
+#endif // __TCOMTRQUANTSIMD__
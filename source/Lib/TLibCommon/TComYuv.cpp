@@ -44,6 +44,7 @@
 #include "CommonDef.h"
 #include "TComYuv.h"
 #include "TComInterpolationFilter.h"
+#include "TComYuvSIMD.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -112,6 +113,13 @@ Void TComYuv::copyToPicComponent  ( const ComponentID ch, TComPicYuv* pcPicYuvDs
   const UInt  iSrcStride  = getStride(ch);
   const UInt  iDstStride  = pcPicYuvDst->getStride(ch);
 
+#if SIMD_X86
+  if ( g_simdLevel >= SIMD_SSE41 )
+  {
+    TComYuvSIMD::copyBlock( g_simdLevel, pSrc, iSrcStride, pDst, iDstStride, iWidth, iHeight );
+    return;
+  }
+#endif
   for ( Int y = iHeight; y != 0; y-- )
   {
     ::memcpy( pDst, pSrc, sizeof(Pel)*iWidth);
@@ -139,6 +147,13 @@ Void TComYuv::copyFromPicComponent  ( const ComponentID ch, const TComPicYuv* pc
   const Int  iWidth=getWidth(ch);
   const Int  iHeight=getHeight(ch);
 
+#if SIMD_X86
+  if ( g_simdLevel >= SIMD_SSE41 )
+  {
+    TComYuvSIMD::copyBlock( g_simdLevel, pSrc, iSrcStride, pDst, iDstStride, iWidth, iHeight );
+    return;
+  }
+#endif
   for (Int y = iHeight; y != 0; y-- )
   {
     ::memcpy( pDst, pSrc, sizeof(Pel)*iWidth);
@@ -166,6 +181,13 @@ Void TComYuv::copyToPartComponent( const ComponentID ch, TComYuv* pcYuvDst, cons
   const Int  iWidth=getWidth(ch);
   const Int  iHeight=getHeight(ch);
 
+#if SIMD_X86
+  if ( g_simdLevel >= SIMD_SSE41 )
+  {
+    TComYuvSIMD::copyBlock( g_simdLevel, pSrc, iSrcStride, pDst, iDstStride, iWidth, iHeight );
+    return;
+  }
+#endif
   for (Int y = iHeight; y != 0; y-- )
   {
     ::memcpy( pDst, pSrc, sizeof(Pel)*iWidth);
@@ -194,6 +216,13 @@ Void TComYuv::copyPartToComponent( const ComponentID ch, TComYuv* pcYuvDst, cons
   const UInt uiHeight = pcYuvDst->getHeight(ch);
   const UInt uiWidth = pcYuvDst->getWidth(ch);
 
+#if SIMD_X86
+  if ( g_simdLevel >= SIMD_SSE41 )
+  {
+    TComYuvSIMD::copyBlock( g_simdLevel, pSrc, iSrcStride, pDst, iDstStride, uiWidth, uiHeight );
+    return;
+  }
+#endif
   for ( UInt y = uiHeight; y != 0; y-- )
   {
     ::memcpy( pDst, pSrc, sizeof(Pel)*uiWidth);
@@ -224,6 +253,13 @@ Void TComYuv::copyPartToPartComponent  ( const ComponentID ch, TComYuv* pcYuvDst
 
   const UInt  iSrcStride = getStride(ch);
   const UInt  iDstStride = pcYuvDst->getStride(ch);
+#if SIMD_X86
+  if ( g_simdLevel >= SIMD_SSE41 )
+  {
+    TComYuvSIMD::copyBlock( g_simdLevel, pSrc, iSrcStride, pDst, iDstStride, iWidthComponent, iHeightComponent );
+    return;
+  }
+#endif
   for ( UInt y = iHeightComponent; y != 0; y-- )
   {
     ::memcpy( pDst, pSrc, iWidthComponent * sizeof(Pel) );
@@ -250,6 +286,13 @@ Void TComYuv::copyPartToPartComponentMxN  ( const ComponentID ch, TComYuv* pcYuv
   const UInt  iDstStride = pcYuvDst->getStride(ch);
   const UInt uiHeightComponent=rect.height;
   const UInt uiWidthComponent=rect.width;
+#if SIMD_X86
+  if ( g_simdLevel >= SIMD_SSE41 )
+  {
+    TComYuvSIMD::copyBlock( g_simdLevel, pSrc, iSrcStride, pDst, iDstStride, uiWidthComponent, uiHeightComponent );
+    return;
+  }
+#endif
   for ( UInt y = uiHeightComponent; y != 0; y-- )
   {
     ::memcpy( pDst, pSrc, uiWidthComponent * sizeof( Pel ) );
@@ -281,6 +324,13 @@ Void TComYuv::addClip( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, const
     const Int bitDepthDelta = g_bitDepthInStream[toChannelType(ch)] - g_bitDepth[toChannelType(ch)];
 #endif
 
+#if SIMD_X86 && !O0043_BEST_EFFORT_DECODING
+    if ( g_simdLevel >= SIMD_SSE41 )
+    {
+      TComYuvSIMD::addClip( g_simdLevel, pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, uiPartWidth, uiPartHeight, (1 << clipbd) - 1 );
+      continue;
+    }
+#endif
     for ( Int y = uiPartHeight-1; y >= 0; y-- )
     {
       for ( Int x = uiPartWidth-1; x >= 0; x-- )
@@ -317,6 +367,13 @@ Void TComYuv::subtract( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, cons
     const Int  iSrc1Stride = pcYuvSrc1->getStride(ch);
     const Int  iDstStride  = getStride(ch);
 
+#if SIMD_X86
+    if ( g_simdLevel >= SIMD_SSE41 )
+    {
+      TComYuvSIMD::subtract( g_simdLevel, pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, uiPartWidth, uiPartHeight );
+      continue;
+    }
+#endif
     for (Int y = uiPartHeight-1; y >= 0; y-- )
     {
       for (Int x = uiPartWidth-1; x >= 0; x-- )
@@ -352,6 +409,13 @@ Void TComYuv::addAvg( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, const
     const Int   iWidth      = uiWidth  >> getComponentScaleX(ch);
     const Int   iHeight     = uiHeight >> getComponentScaleY(ch);
 
+#if SIMD_X86
+    if ( g_simdLevel >= SIMD_SSE41 && !(iWidth&1) )
+    {
+      TComYuvSIMD::addAvg( g_simdLevel, pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, shiftNum, offset, (1 << clipbd) - 1 );
+      continue;
+    }
+#endif
     if (iWidth&1)
     {
       assert(0);
@@ -407,6 +471,14 @@ Void TComYuv::removeHighFreq( const TComYuv* pcYuvSrc, const UInt uiPartIdx, con
     const Int iWidth  = uiWidth >>getComponentScaleX(ch);
     const Int iHeight = uiHeight>>getComponentScaleY(ch);
 
+#if SIMD_X86
+    if ( g_simdLevel >= SIMD_SSE41 )
+    {
+      TComYuvSIMD::removeHighFreq( g_simdLevel, pSrc, iSrcStride, pDst, iDstStride, iWidth, iHeight, !DISABLING_CLIP_FOR_BIPREDME,
+                                   (1 << g_bitDepth[toChannelType(ch)]) - 1 );
+      continue;
+    }
+#endif
     for ( Int y = iHeight-1; y >= 0; y-- )
     {
       for ( Int x = iWidth-1; x >= 0; x-- )
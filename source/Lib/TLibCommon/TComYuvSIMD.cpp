@@ -0,0 +1,333 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComYuvSIMD.cpp
+    \brief    SIMD implementations of the block operations of TComYuv
+*/
+
+#include "TComYuvSIMD.h"
+#include "CommonDef.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+#if SIMD_X86
+
+// ====================================================================================================================
+// Kernels
+// ====================================================================================================================
+
+// Each line is processed 8 samples at a time, then 4 samples at a time (the chroma blocks of small partitions), the
+// 2 samples wide blocks remaining in C++.
+
+SIMD_TARGET_SSE41
+static inline __m128i xLoad4( const Pel* p )
+{
+  return _mm_loadl_epi64( (const __m128i*)p );
+}
+
+SIMD_TARGET_SSE41
+static inline __m128i xLoad8( const Pel* p )
+{
+  return _mm_loadu_si128( (const __m128i*)p );
+}
+
+SIMD_TARGET_SSE41
+static inline Void xStore4( Pel* p, const __m128i& v )
+{
+  _mm_storel_epi64( (__m128i*)p, v );
+}
+
+SIMD_TARGET_SSE41
+static inline Void xStore8( Pel* p, const __m128i& v )
+{
+  _mm_storeu_si128( (__m128i*)p, v );
+}
+
+SIMD_TARGET_SSE41
+static Void xCopyBlock( const Pel* pSrc, Int iSrcStride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight )
+{
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    Int x = 0;
+    for ( ; x + 8 <= iWidth; x += 8 )
+    {
+      xStore8( pDst + x, xLoad8( pSrc + x ) );
+    }
+    if ( x + 4 <= iWidth )
+    {
+      xStore4( pDst + x, xLoad4( pSrc + x ) );
+      x += 4;
+    }
+    for ( ; x < iWidth; x++ )
+    {
+      pDst[x] = pSrc[x];
+    }
+    pSrc += iSrcStride;
+    pDst += iDstStride;
+  }
+}
+
+SIMD_TARGET_SSE41
+static Void xSubtract( const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight )
+{
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    Int x = 0;
+    for ( ; x + 8 <= iWidth; x += 8 )
+    {
+      xStore8( pDst + x, _mm_sub_epi16( xLoad8( pSrc0 + x ), xLoad8( pSrc1 + x ) ) );
+    }
+    if ( x + 4 <= iWidth )
+    {
+      xStore4( pDst + x, _mm_sub_epi16( xLoad4( pSrc0 + x ), xLoad4( pSrc1 + x ) ) );
+      x += 4;
+    }
+    for ( ; x < iWidth; x++ )
+    {
+      pDst[x] = pSrc0[x] - pSrc1[x];
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+/// the saturating addition gives the same clipped result as the addition in 32 bits
+SIMD_TARGET_SSE41
+static Void xAddClip( const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight, Int iMaxVal )
+{
+  const __m128i vZero = _mm_setzero_si128();
+  const __m128i vMax  = _mm_set1_epi16( iMaxVal );
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    Int x = 0;
+    for ( ; x + 8 <= iWidth; x += 8 )
+    {
+      const __m128i vSum = _mm_adds_epi16( xLoad8( pSrc0 + x ), xLoad8( pSrc1 + x ) );
+      xStore8( pDst + x, _mm_min_epi16( _mm_max_epi16( vSum, vZero ), vMax ) );
+    }
+    if ( x + 4 <= iWidth )
+    {
+      const __m128i vSum = _mm_adds_epi16( xLoad4( pSrc0 + x ), xLoad4( pSrc1 + x ) );
+      xStore4( pDst + x, _mm_min_epi16( _mm_max_epi16( vSum, vZero ), vMax ) );
+      x += 4;
+    }
+    for ( ; x < iWidth; x++ )
+    {
+      pDst[x] = Pel( Clip3<Int>( 0, iMaxVal, Int( pSrc0[x] ) + Int( pSrc1[x] ) ) );
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+/// (a + b + offset) >> shiftNum of 8 samples, computed in 32 bits
+SIMD_TARGET_SSE41
+static inline __m128i xAvg( const __m128i& vSrc0, const __m128i& vSrc1, const __m128i& vOffset, const __m128i& vShift, const __m128i& vMax )
+{
+  const __m128i vOne = _mm_set1_epi16( 1 );
+  const __m128i vLo  = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vSrc0, vSrc1 ), vOne ), vOffset ), vShift );
+  const __m128i vHi  = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vSrc0, vSrc1 ), vOne ), vOffset ), vShift );
+  return _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( vLo, vHi ), _mm_setzero_si128() ), vMax );
+}
+
+SIMD_TARGET_SSE41
+static Void xAddAvg( const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight,
+                     Int shiftNum, Int offset, Int iMaxVal )
+{
+  const __m128i vOffset = _mm_set1_epi32( offset );
+  const __m128i vShift  = _mm_cvtsi32_si128( shiftNum );
+  const __m128i vMax    = _mm_set1_epi16( iMaxVal );
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    Int x = 0;
+    for ( ; x + 8 <= iWidth; x += 8 )
+    {
+      xStore8( pDst + x, xAvg( xLoad8( pSrc0 + x ), xLoad8( pSrc1 + x ), vOffset, vShift, vMax ) );
+    }
+    if ( x + 4 <= iWidth )
+    {
+      xStore4( pDst + x, xAvg( xLoad4( pSrc0 + x ), xLoad4( pSrc1 + x ), vOffset, vShift, vMax ) );
+      x += 4;
+    }
+    for ( ; x < iWidth; x++ )
+    {
+      pDst[x] = Pel( Clip3<Int>( 0, iMaxVal, rightShift( pSrc0[x] + pSrc1[x] + offset, shiftNum ) ) );
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+/// 2 * dst - src: wrapping like the C++ conversion to Pel without clipping, saturating (then clipped) with clipping
+SIMD_TARGET_SSE41
+static inline __m128i xRemoveHighFreq( const __m128i& vSrc, const __m128i& vDst, Bool bClip, const __m128i& vMax )
+{
+  if ( bClip )
+  {
+    const __m128i vRes = _mm_subs_epi16( _mm_adds_epi16( vDst, vDst ), vSrc );
+    return _mm_min_epi16( _mm_max_epi16( vRes, _mm_setzero_si128() ), vMax );
+  }
+  return _mm_sub_epi16( _mm_add_epi16( vDst, vDst ), vSrc );
+}
+
+SIMD_TARGET_SSE41
+static Void xRemoveHighFreq( const Pel* pSrc, Int iSrcStride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight, Bool bClip, Int iMaxVal )
+{
+  const __m128i vMax = _mm_set1_epi16( iMaxVal );
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    Int x = 0;
+    for ( ; x + 8 <= iWidth; x += 8 )
+    {
+      xStore8( pDst + x, xRemoveHighFreq( xLoad8( pSrc + x ), xLoad8( pDst + x ), bClip, vMax ) );
+    }
+    if ( x + 4 <= iWidth )
+    {
+      xStore4( pDst + x, xRemoveHighFreq( xLoad4( pSrc + x ), xLoad4( pDst + x ), bClip, vMax ) );
+      x += 4;
+    }
+    for ( ; x < iWidth; x++ )
+    {
+      const Int iRes = ( 2 * pDst[x] ) - pSrc[x];
+      pDst[x] = bClip ? Pel( Clip3<Int>( 0, iMaxVal, iRes ) ) : Pel( iRes );
+    }
+    pSrc += iSrcStride;
+    pDst += iDstStride;
+  }
+}
+
+#endif // SIMD_X86
+
+// ====================================================================================================================
+// Selection of the kernels
+// ====================================================================================================================
+
+/** copy of a block, see TComYuv::copyToPartComponent and the other copies
+ *  \param level       instruction set, at least SIMD_SSE41
+ *  \param pSrc        source block
+ *  \param iSrcStride  stride of pSrc
+ *  \param pDst        destination block
+ *  \param iDstStride  stride of pDst
+ *  \param iWidth      width of the block
+ *  \param iHeight     height of the block
+ */
+Void TComYuvSIMD::copyBlock( SimdLevel level, const Pel* pSrc, Int iSrcStride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight )
+{
+#if SIMD_X86
+  xCopyBlock( pSrc, iSrcStride, pDst, iDstStride, iWidth, iHeight );
+#endif
+}
+
+/** residual pSrc0 - pSrc1, see TComYuv::subtract
+ *  \param level        instruction set, at least SIMD_SSE41
+ *  \param pSrc0        original block
+ *  \param iSrc0Stride  stride of pSrc0
+ *  \param pSrc1        prediction block
+ *  \param iSrc1Stride  stride of pSrc1
+ *  \param pDst         residual block
+ *  \param iDstStride   stride of pDst
+ *  \param iWidth       width of the block
+ *  \param iHeight      height of the block
+ */
+Void TComYuvSIMD::subtract( SimdLevel level, const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight )
+{
+#if SIMD_X86
+  xSubtract( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight );
+#endif
+}
+
+/** reconstruction pSrc0 + pSrc1 clipped to [0, iMaxVal], see TComYuv::addClip
+ *  \param level        instruction set, at least SIMD_SSE41
+ *  \param pSrc0        prediction block
+ *  \param iSrc0Stride  stride of pSrc0
+ *  \param pSrc1        residual block
+ *  \param iSrc1Stride  stride of pSrc1
+ *  \param pDst         reconstructed block
+ *  \param iDstStride   stride of pDst
+ *  \param iWidth       width of the block
+ *  \param iHeight      height of the block
+ *  \param iMaxVal      largest sample value
+ */
+Void TComYuvSIMD::addClip( SimdLevel level, const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight,
+                           Int iMaxVal )
+{
+#if SIMD_X86
+  xAddClip( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, iMaxVal );
+#endif
+}
+
+/** bi-prediction average (pSrc0 + pSrc1 + offset) >> shiftNum clipped to [0, iMaxVal], see TComYuv::addAvg
+ *  \param level        instruction set, at least SIMD_SSE41
+ *  \param pSrc0        first prediction, at the internal precision of the interpolation filter
+ *  \param iSrc0Stride  stride of pSrc0
+ *  \param pSrc1        second prediction, at the internal precision of the interpolation filter
+ *  \param iSrc1Stride  stride of pSrc1
+ *  \param pDst         bi-prediction
+ *  \param iDstStride   stride of pDst
+ *  \param iWidth       width of the block
+ *  \param iHeight      height of the block
+ *  \param shiftNum     right shift
+ *  \param offset       rounding offset, including the internal offsets of both predictions
+ *  \param iMaxVal      largest sample value
+ */
+Void TComYuvSIMD::addAvg( SimdLevel level, const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight,
+                          Int shiftNum, Int offset, Int iMaxVal )
+{
+#if SIMD_X86
+  xAddAvg( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, shiftNum, offset, iMaxVal );
+#endif
+}
+
+/** pDst = 2 * pDst - pSrc, see TComYuv::removeHighFreq
+ *  \param level       instruction set, at least SIMD_SSE41
+ *  \param pSrc        block removed
+ *  \param iSrcStride  stride of pSrc
+ *  \param pDst        block updated
+ *  \param iDstStride  stride of pDst
+ *  \param iWidth      width of the block
+ *  \param iHeight     height of the block
+ *  \param bClip       clip the result to [0, iMaxVal]
+ *  \param iMaxVal     largest sample value
+ */
+Void TComYuvSIMD::removeHighFreq( SimdLevel level, const Pel* pSrc, Int iSrcStride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight, Bool bClip, Int iMaxVal )
+{
+#if SIMD_X86
+  xRemoveHighFreq( pSrc, iSrcStride, pDst, iDstStride, iWidth, iHeight, bClip, iMaxVal );
+#endif
+}
+
+//! \}
@@ -243,6 +243,11 @@
 #define RExt__HIGH_BIT_DEPTH_SUPPORT                                           0 ///< 0 (default) use data type definitions for 8-10 bit video, 1 = use larger data types to allow for up to 16-bit video (originally developed as part of N0188)
 #endif
 
+// This can be disabled by the makefile
+#ifndef ENABLE_SIMD_OPT
+#define ENABLE_SIMD_OPT                                                        1 ///< 0 = scalar kernels only, 1 (default) = x86 SIMD kernels (SSE4.1, AVX2, AVX-512) selected at run time for the instruction sets of the CPU
+#endif
+
 #define RExt__GOLOMB_RICE_ADAPTATION_STATISTICS_SETS                           4
 #define RExt__GOLOMB_RICE_INCREMENT_DIVISOR                                    4
 
@@ -263,6 +268,12 @@
 #define RExt__HIGH_PRECISION_FORWARD_TRANSFORM                                 0 ///< 0 (default) use original 6-bit transform matrices for both forward and inverse transform, 1 = use original matrices for inverse transform and high precision matrices for forward transform
 #endif
 
+#if ENABLE_SIMD_OPT && !RExt__HIGH_BIT_DEPTH_SUPPORT && ( defined(__i386__) || defined(__x86_64__) || ( defined(_MSC_VER) && _MSC_VER >= 1910 && ( defined(_M_IX86) || defined(_M_X64) ) ) )
+#define SIMD_X86                                                               1 ///< the SIMD kernels are compiled in, they work on 16-bit samples
+#else
+#define SIMD_X86                                                               0
+#endif
+
 #if FULL_NBIT
 # define DISTORTION_PRECISION_ADJUSTMENT(x)  0
 #else
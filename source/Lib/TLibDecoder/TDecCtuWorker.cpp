@@ -0,0 +1,105 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TDecCtuWorker.cpp
+    \brief    per-thread CTU decoder used for parallel CTU decoding
+*/
+
+#include "TDecCtuWorker.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TDecCtuWorker::TDecCtuWorker()
+: m_bCreated( false )
+{
+}
+
+TDecCtuWorker::~TDecCtuWorker()
+{
+  destroy();
+}
+
+/** create the CTU decoding engine of this worker for the current CTU size
+ * \param chromaFormatIDC  chroma format of the sequence
+ * \param uiMaxTrSize      maximum transform size of the sequence
+ */
+Void TDecCtuWorker::create( ChromaFormat chromaFormatIDC, UInt uiMaxTrSize )
+{
+  destroy();
+
+  m_cSbacDecoder.init( &m_cBinCABAC );
+  m_cEntropyDecoder.init( &m_cPrediction );
+  m_cEntropyDecoder.setEntropyDecoder( &m_cSbacDecoder );
+  m_cPrediction.initTempBuff( chromaFormatIDC );
+
+  m_cCuDecoder.create ( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight, chromaFormatIDC );
+  m_cCuDecoder.init   ( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
+  m_cTrQuant.init     ( g_uiMaxCUWidth, g_uiMaxCUHeight, uiMaxTrSize );
+  m_bCreated = true;
+}
+
+Void TDecCtuWorker::destroy()
+{
+  if ( m_bCreated )
+  {
+    m_cCuDecoder.destroy();
+    m_bCreated = false;
+  }
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param pcSlice  slice to be decoded, its scaling list has been set up by TDecTop
+ */
+Void TDecCtuWorker::initSlice( TComSlice* pcSlice )
+{
+  if ( pcSlice->getSPS()->getScalingListFlag() )
+  {
+    m_cTrQuant.setScalingListDec( pcSlice->getScalingList(), pcSlice->getSPS()->getChromaFormatIdc() );
+    m_cTrQuant.setUseScalingList( true );
+  }
+  else
+  {
+    m_cTrQuant.setFlatScalingList( pcSlice->getSPS()->getChromaFormatIdc() );
+    m_cTrQuant.setUseScalingList( false );
+  }
+}
+
+//! \}
@@ -133,6 +133,8 @@ Void TDecCu::decodeCtu( TComDataCU* pCtu, Bool& isLastCtuOfSliceSegment )
     setIsChromaQpAdjCoded(true);
   }
 
+  xWaitForColocatedRows( pCtu );
+
   // start from the top level CU
   xDecodeCU( pCtu, 0, 0, isLastCtuOfSliceSegment);
 }
@@ -148,6 +150,58 @@ Void TDecCu::decompressCtu( TComDataCU* pCtu )
 // Protected member functions
 // ====================================================================================================================
 
+/** With frame-parallel decoding, the colocated picture may still be in reconstruction. The temporal motion vector
+ * prediction of a CTU reads the motion of the colocated CTU and of the CTU to its right, so the CTU row of the CTU
+ * has to be final in the colocated picture.
+ * \param pCtu  CTU about to be parsed
+ */
+Void TDecCu::xWaitForColocatedRows( TComDataCU* pCtu )
+{
+  TComSlice* pcSlice = pCtu->getSlice();
+  if ( pcSlice->isIntra() || !pcSlice->getEnableTMVPFlag() )
+  {
+    return;
+  }
+
+  TComPic* pcColPic = pcSlice->getRefPic( RefPicList( pcSlice->isInterB() ? 1 - pcSlice->getColFromL0Flag() : 0 ), pcSlice->getColRefIdx() );
+  pcColPic->waitForReconRows( pCtu->getCUPelY() / g_uiMaxCUHeight + 1 );
+}
+
+/** With frame-parallel decoding, a reference picture may still be in reconstruction. Wait until the CTU rows that the
+ * motion compensation of the prediction units of the CU reads from, including the rows below used by the
+ * interpolation filter, are final in the reference pictures.
+ * \param pcCU  CU about to be motion compensated
+ */
+Void TDecCu::xWaitForReferenceRows( TComDataCU* pcCU )
+{
+  TComSlice* pcSlice = pcCU->getSlice();
+
+  for ( UInt uiPartIdx = 0; uiPartIdx < pcCU->getNumPartitions(); uiPartIdx++ )
+  {
+    UInt uiPartAddr;
+    Int  iWidth;
+    Int  iHeight;
+    pcCU->getPartIndexAndSize( uiPartIdx, uiPartAddr, iWidth, iHeight );
+
+    for ( UInt refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+    {
+      const RefPicList eRefPicList = RefPicList( refList );
+      const Int        iRefIdx     = pcCU->getCUMvField( eRefPicList )->getRefIdx( uiPartAddr );
+      if ( iRefIdx < 0 )
+      {
+        continue;
+      }
+
+      TComMv cMv = pcCU->getCUMvField( eRefPicList )->getMv( uiPartAddr );
+      pcCU->clipMv( cMv );
+
+      const Int iBottom = pcCU->getCUPelY() + g_auiRasterToPelY[g_auiZscanToRaster[uiPartAddr]] + iHeight - 1
+                        + ( cMv.getVer() >> 2 ) + NTAPS_LUMA / 2;
+      pcSlice->getRefPic( eRefPicList, iRefIdx )->waitForReconRows( std::max( iBottom, 0 ) / g_uiMaxCUHeight + 1 );
+    }
+  }
+}
+
 /**decode end-of-slice flag
  * \param pcCU
  * \param uiAbsPartIdx
@@ -412,6 +466,7 @@ Void TDecCu::xReconInter( TComDataCU* pcCU, UInt uiDepth )
 {
 
   // inter prediction
+  xWaitForReferenceRows( pcCU );
   m_pcPrediction->motionCompensation( pcCU, m_ppcYuvReco[uiDepth] );
 
 #ifdef DEBUG_STRING
@@ -96,6 +96,9 @@ protected:
   Bool xDecodeSliceEnd          ( TComDataCU* pcCU, UInt uiAbsPartIdx );
   Void xDecompressCU            ( TComDataCU* pCtu, UInt uiAbsPartIdx, UInt uiDepth );
 
+  Void xWaitForColocatedRows    ( TComDataCU* pCtu );
+  Void xWaitForReferenceRows    ( TComDataCU* pcCU );
+
   Void xReconInter              ( TComDataCU* pcCU, UInt uiDepth );
 
   Void xReconIntraQT            ( TComDataCU* pcCU, UInt uiDepth );
@@ -57,6 +57,11 @@ static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash*
 TDecGop::TDecGop()
 {
   m_dDecTime = 0;
+  m_pcThreadPool = NULL;
+  m_pcFilterPic = NULL;
+  m_bPadFilterRows = false;
+  m_uiReconRows = 0;
+  m_uiDoneFilterSteps = 0;
 }
 
 TDecGop::~TDecGop()
@@ -96,10 +101,178 @@ Void TDecGop::init( TDecEntropy*            pcEntropyDecoder,
 // ====================================================================================================================
 // Private member functions
 // ====================================================================================================================
+
+/** Start filtering the CTU rows of a picture as they are reconstructed. Filter step s deblocks CTU row s, copies the
+ * deblocked CTU row s-1 for the SAO and compresses its motion, then applies the SAO to CTU row s-2 and publishes it to
+ * the pictures referencing this one. With frame-parallel decoding, the picture border is marked as extended while the
+ * picture is decoded (see TDecTop::xInitPicProgress), and the border of the published CTU rows is padded here.
+ * \param pcPic  picture whose first slice segment is about to be decoded
+ */
+Void TDecGop::xStartRowFilters( TComPic* pcPic )
+{
+  const UInt uiFrameHeightInCtus = pcPic->getFrameHeightInCtus();
+
+  m_pcLoopFilter->setCfg( pcPic->getSlice(pcPic->getCurrSliceIdx())->getPPS()->getLoopFilterAcrossTilesEnabledFlag() );
+  m_bPadFilterRows = pcPic->getPicYuvRec()->isBorderExtended();
+
+  m_cFilterMutex.lock();
+  m_pcFilterPic = pcPic;
+  m_auiRowReconCtus.assign( uiFrameHeightInCtus, 0 );
+  m_uiReconRows = 0;
+  m_uiDoneFilterSteps = 0;
+  m_cFilterMutex.unlock();
+
+  if ( m_pcThreadPool )
+  {
+    m_acFilterSteps.resize( uiFrameHeightInCtus + 2 );
+    for ( UInt uiStep = 0; uiStep < uiFrameHeightInCtus + 2; uiStep++ )
+    {
+      m_acFilterSteps[uiStep].init( this, uiStep );
+      m_pcThreadPool->submit( &m_acFilterSteps[uiStep], &m_cFilterGroup );
+    }
+  }
+}
+
+/** run the filter steps that are left once all slice segments of the picture are decoded
+ */
+Void TDecGop::xFinishRowFilters()
+{
+  // CTUs that are missing from the bitstream are never reconstructed, filter the picture as it is
+  m_cFilterMutex.lock();
+  m_uiReconRows = (UInt)m_auiRowReconCtus.size();
+  m_cFilterMutex.unlock();
+
+  if ( m_pcThreadPool )
+  {
+    m_pcThreadPool->wakeUp();
+    m_pcThreadPool->wait( &m_cFilterGroup );
+  }
+  else
+  {
+    xRunReadyFilterSteps();
+  }
+
+  m_cFilterMutex.lock();
+  m_pcFilterPic = NULL;
+  m_cFilterMutex.unlock();
+}
+
+/** run the filter steps that can go ahead on the calling thread, without thread pool
+ */
+Void TDecGop::xRunReadyFilterSteps()
+{
+  while ( isFilterStepReady( m_uiDoneFilterSteps ) )
+  {
+    runFilterStep( m_uiDoneFilterSteps );
+  }
+}
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
 
+Bool TDecLoopFilterStepTask::isReady()
+{
+  return m_pcGopDecoder->isFilterStepReady( m_uiStep );
+}
+
+Void TDecLoopFilterStepTask::run( Int iThreadIdx )
+{
+  m_pcGopDecoder->runFilterStep( m_uiStep );
+}
+
+/** count a reconstructed CTU of the picture, and let the filter steps go ahead once its CTU row is complete. May be
+ * called by several threads at the same time.
+ * \param pcPic        picture
+ * \param uiCtuRsAddr  reconstructed CTU, in raster scan
+ */
+Void TDecGop::ctuReconstructed( TComPic* pcPic, UInt uiCtuRsAddr )
+{
+  const UInt uiFrameWidthInCtus = pcPic->getFrameWidthInCtus();
+  const UInt uiCtuRow           = uiCtuRsAddr / uiFrameWidthInCtus;
+  Bool bRowsReconstructed = false;
+
+  m_cFilterMutex.lock();
+  if ( pcPic == m_pcFilterPic && ++m_auiRowReconCtus[uiCtuRow] == uiFrameWidthInCtus )
+  {
+    while ( m_uiReconRows < m_auiRowReconCtus.size() && m_auiRowReconCtus[m_uiReconRows] >= uiFrameWidthInCtus )
+    {
+      m_uiReconRows++;
+      bRowsReconstructed = true;
+    }
+  }
+  m_cFilterMutex.unlock();
+
+  if ( bRowsReconstructed )
+  {
+    if ( m_pcThreadPool )
+    {
+      m_pcThreadPool->wakeUp();
+    }
+    else
+    {
+      xRunReadyFilterSteps();
+    }
+  }
+}
+
+/** filter step s can go ahead when the previous step is done and the CTU rows up to s+1 are reconstructed
+ * \param uiStep  filter step
+ */
+Bool TDecGop::isFilterStepReady( UInt uiStep )
+{
+  m_cFilterMutex.lock();
+  const UInt uiNumRows = (UInt)m_auiRowReconCtus.size();
+  const Bool bReady    = m_pcFilterPic != NULL && m_uiDoneFilterSteps == uiStep && uiStep < uiNumRows + 2 && m_uiReconRows >= std::min( uiStep + 2, uiNumRows );
+  m_cFilterMutex.unlock();
+  return bReady;
+}
+
+/** \param uiStep  filter step, see xStartRowFilters
+ */
+Void TDecGop::runFilterStep( UInt uiStep )
+{
+  TComPic*   pcPic     = m_pcFilterPic;
+  const UInt uiNumRows = pcPic->getFrameHeightInCtus();
+  const Bool bUseSAO   = pcPic->getSlice(0)->getSPS()->getUseSAO();
+
+  if ( uiStep < uiNumRows )
+  {
+    m_pcLoopFilter->loopFilterCtuRow( pcPic, uiStep );
+  }
+
+  if ( uiStep >= 1 && uiStep <= uiNumRows )
+  {
+    // the CTU row above is not changed by the deblocking anymore
+    if ( bUseSAO )
+    {
+      m_pcSAO->copyDeblockedCtuRow( pcPic, uiStep - 1 );
+    }
+    pcPic->compressMotion( uiStep - 1 );
+  }
+
+  if ( uiStep >= 2 )
+  {
+    const UInt uiCtuRow = uiStep - 2;
+    if ( bUseSAO )
+    {
+      m_pcSAO->SAOProcessCtuRow( pcPic, uiCtuRow );
+      m_pcSAO->PCMLFDisableProcessCtuRow( pcPic, uiCtuRow );
+    }
+    if ( m_bPadFilterRows )
+    {
+      const Int iMaxCUHeight = pcPic->getSlice(0)->getSPS()->getMaxCUHeight();
+      const Int iStartY      = uiCtuRow*iMaxCUHeight;
+      pcPic->getPicYuvRec()->extendPicBorderRows( iStartY, std::min( iMaxCUHeight, pcPic->getPicYuvRec()->getHeight(COMPONENT_Y) - iStartY ) );
+    }
+    pcPic->setReconRowProgress( uiCtuRow + 1 );
+  }
+
+  m_cFilterMutex.lock();
+  m_uiDoneFilterSteps++;
+  m_cFilterMutex.unlock();
+}
+
 Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic)
 {
   TComSlice*  pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
@@ -109,6 +282,15 @@ Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic)
 
   //-- For time output for each slice
   clock_t iBeforeTime = clock();
+  if ( m_pcFilterPic != pcPic )
+  {
+    if ( m_pcFilterPic )
+    {
+      xFinishRowFilters();
+    }
+    xStartRowFilters( pcPic );
+  }
+
   m_pcSbacDecoder->init( (TDecBinIf*)m_pcBinCABAC );
   m_pcEntropyDecoder->setEntropyDecoder (m_pcSbacDecoder);
 
@@ -135,12 +317,30 @@ Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic)
 }
 
 Void TDecGop::filterPicture(TComPic* pcPic)
+{
+  applyLoopFilters( pcPic );
+  finishPicture( pcPic, pcPic->getSlice(pcPic->getCurrSliceIdx())->isReferenced() );
+}
+
+/** deblocking, SAO and motion compression of a picture whose slices have all been decoded, after which the picture is
+ * published to the pictures referencing it. Most of the picture is normally filtered already, as its CTU rows were
+ * reconstructed.
+ * \param pcPic  picture
+ */
+Void TDecGop::applyLoopFilters(TComPic* pcPic)
 {
   TComSlice*  pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
 
   //-- For time output for each slice
   clock_t iBeforeTime = clock();
 
+  if ( pcPic == m_pcFilterPic )
+  {
+    xFinishRowFilters();
+    m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+    return;
+  }
+
   // deblocking filter
   Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
   m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
@@ -154,8 +354,28 @@ Void TDecGop::filterPicture(TComPic* pcPic)
   }
 
   pcPic->compressMotion();
+
+  // with frame-parallel decoding, the main decoder does not pad pictures that are being decoded
+  if ( pcPic->getPicYuvRec()->isBorderExtended() )
+  {
+    pcPic->getPicYuvRec()->setBorderExtension( false );
+    pcPic->getPicYuvRec()->extendPicBorder();
+  }
+  pcPic->setReconRowProgress( pcPic->getFrameHeightInCtus() );
+
+  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+}
+
+/** print the status line of a filtered picture, check its decoded picture hash and mark it for output
+ * \param pcPic        picture
+ * \param bReferenced  picture was used for reference when its last slice was decoded
+ */
+Void TDecGop::finishPicture(TComPic* pcPic, Bool bReferenced)
+{
+  TComSlice*  pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
+
   Char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!pcSlice->isReferenced()) c += 32;
+  if (!bReferenced) c += 32;
 
   //-- For time output for each slice
   printf("POC %4d TId: %1d ( %c-SLICE, QP%3d ) ", pcSlice->getPOC(),
@@ -163,7 +383,6 @@ Void TDecGop::filterPicture(TComPic* pcPic)
                                                   c,
                                                   pcSlice->getSliceQp() );
 
-  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
   printf ("[DT %6.3f] ", m_dDecTime );
   m_dDecTime  = 0;
 
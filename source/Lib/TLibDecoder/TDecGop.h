@@ -49,19 +49,38 @@
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TDecEntropy.h"
 #include "TDecSlice.h"
 #include "TDecBinCoder.h"
 #include "TDecBinCoderCABAC.h"
+#include <vector>
 
 //! \ingroup TLibDecoder
 //! \{
 
+class TDecGop;
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
 
+/// step of the in-loop filtering trailing the reconstruction of the CTU rows of a picture, run by the thread pool
+class TDecLoopFilterStepTask : public TComTask
+{
+public:
+  TDecLoopFilterStepTask() : m_pcGopDecoder( NULL ), m_uiStep( 0 ) {}
+
+  Void  init    ( TDecGop* pcGopDecoder, UInt uiStep ) { m_pcGopDecoder = pcGopDecoder; m_uiStep = uiStep; }
+  Bool  isReady ();
+  Void  run     ( Int iThreadIdx );
+
+private:
+  TDecGop*    m_pcGopDecoder;
+  UInt        m_uiStep;
+};
+
 /// GOP decoder class
 class TDecGop
 {
@@ -77,9 +96,24 @@ private:
   TComLoopFilter*       m_pcLoopFilter;
 
   TComSampleAdaptiveOffset*     m_pcSAO;
+  TComThreadPool*       m_pcThreadPool;                  ///< thread pool of the decoder, NULL when running single-threaded
   Double                m_dDecTime;
   Int                   m_decodedPictureHashSEIEnabled;  ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
 
+  // in-loop filtering trailing the reconstruction of the CTU rows
+  TComPic*              m_pcFilterPic;                   ///< picture whose CTU rows are filtered as they are reconstructed, NULL if none
+  Bool                  m_bPadFilterRows;                ///< the border of the filtered CTU rows is padded
+  std::vector<UInt>     m_auiRowReconCtus;               ///< per CTU row: number of reconstructed CTUs, protected by m_cFilterMutex
+  UInt                  m_uiReconRows;                   ///< number of CTU rows (from the top) that are reconstructed, protected by m_cFilterMutex
+  UInt                  m_uiDoneFilterSteps;             ///< number of filter steps that are done, protected by m_cFilterMutex
+  TComMutex             m_cFilterMutex;
+  std::vector<TDecLoopFilterStepTask> m_acFilterSteps;   ///< tasks of the filter steps of the picture
+  TComTaskGroup         m_cFilterGroup;
+
+  Void  xStartRowFilters    ( TComPic* pcPic );
+  Void  xFinishRowFilters   ();
+  Void  xRunReadyFilterSteps();
+
 public:
   TDecGop();
   virtual ~TDecGop();
@@ -94,8 +128,15 @@ public:
                  );
   Void  create  ();
   Void  destroy ();
+  Void  setThreadPool  ( TComThreadPool* pcThreadPool ) { m_pcThreadPool = pcThreadPool; }
   Void  decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic );
   Void  filterPicture  (TComPic* pcPic );
+  Void  applyLoopFilters(TComPic* pcPic );                   ///< first part of filterPicture, may run on a thread of the pool
+  Void  finishPicture  (TComPic* pcPic, Bool bReferenced );  ///< second part of filterPicture, on the thread calling the decoder
+
+  Void  ctuReconstructed    ( TComPic* pcPic, UInt uiCtuRsAddr ); ///< called by the slice decoder for every reconstructed CTU
+  Bool  isFilterStepReady   ( UInt uiStep );
+  Void  runFilterStep       ( UInt uiStep );
 
   Void setDecodedPictureHashSEIEnabled(Int enabled) { m_decodedPictureHashSEIEnabled = enabled; }
 
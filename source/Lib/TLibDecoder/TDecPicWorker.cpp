@@ -0,0 +1,167 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TDecPicWorker.cpp
+    \brief    picture worker used for frame-parallel decoding
+*/
+
+#include "TDecPicWorker.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TDecPicWorker::TDecPicWorker()
+: m_pcPic      ( NULL )
+, m_bReferenced( false )
+{
+}
+
+TDecPicWorker::~TDecPicWorker()
+{
+  destroy();
+}
+
+/** connect the decoding stages of this worker the same way as TDecTop does for the main decoder
+ * \param pcThreadPool  thread pool of the decoder, also used for the CTU rows and tiles of the picture
+ */
+Void TDecPicWorker::create( TComThreadPool* pcThreadPool )
+{
+  m_cGopDecoder.init( m_cCtuDecoder.getEntropyDecoder(), m_cCtuDecoder.getSbacDecoder(), m_cCtuDecoder.getBinCABAC(), &m_cCavlcDecoder, &m_cSliceDecoder, &m_cLoopFilter, &m_cSAO );
+  m_cSliceDecoder.init( m_cCtuDecoder.getEntropyDecoder(), m_cCtuDecoder.getCuDecoder(), &m_cGopDecoder );
+
+  m_cGopDecoder.setThreadPool( pcThreadPool );
+  m_cSliceDecoder.setThreadPool( pcThreadPool );
+  m_cLoopFilter.setThreadPool( pcThreadPool );
+  m_cSAO.setThreadPool( pcThreadPool );
+}
+
+Void TDecPicWorker::destroy()
+{
+  for ( UInt i = 0; i < m_apcSliceData.size(); i++ )
+  {
+    m_apcSliceData[i]->deleteFifo();
+    delete m_apcSliceData[i];
+  }
+  m_apcSliceData.clear();
+
+  m_cCtuDecoder.destroy();
+  m_cSliceDecoder.destroy();
+  m_cLoopFilter.destroy();
+  m_cSAO.destroy();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param pcPic    picture to be decoded by this worker
+ * \param pcSlice  first slice segment of the picture, with its parameter sets activated
+ */
+Void TDecPicWorker::setPicture( TComPic* pcPic, TComSlice* pcSlice )
+{
+  TComSPS* sps = pcSlice->getSPS();
+  TComPPS* pps = pcSlice->getPPS();
+
+  m_pcPic       = pcPic;
+  m_bReferenced = false;
+
+  m_cCtuDecoder.create( sps->getChromaFormatIdc(), sps->getMaxTrSize() );
+  m_cSAO.destroy();
+  m_cSAO.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxCUDepth(), pps->getSaoOffsetBitShift(CHANNEL_TYPE_LUMA), pps->getSaoOffsetBitShift(CHANNEL_TYPE_CHROMA) );
+  m_cLoopFilter.create( sps->getMaxCUDepth() );
+}
+
+/** The bitstream has been read up to the end of the slice segment header. The slice segment is the current slice of
+ * the picture.
+ * \param pcBitstream  bitstream of the slice segment NAL unit
+ */
+Void TDecPicWorker::addSliceSegment( TComInputBitstream* pcBitstream )
+{
+  m_apcSliceData.push_back( pcBitstream->extractSubstream( pcBitstream->getNumBitsLeft() ) );
+  m_bReferenced = m_pcPic->getSlice( m_pcPic->getCurrSliceIdx() )->isReferenced();
+}
+
+Void TDecPicWorker::finishPicture()
+{
+  m_cGopDecoder.finishPicture( m_pcPic, m_bReferenced );
+}
+
+/** the picture is started once its reference pictures have reconstructed their first CTU row, so that it does not
+ * occupy a thread of the pool while waiting for pictures that have not been started yet
+ */
+Bool TDecPicWorker::isReady()
+{
+  for ( UInt uiSliceIdx = 0; uiSliceIdx < m_apcSliceData.size(); uiSliceIdx++ )
+  {
+    TComSlice* pcSlice = m_pcPic->getSlice( uiSliceIdx );
+    if ( pcSlice->isIntra() )
+    {
+      continue;
+    }
+    for ( UInt refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+    {
+      for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( RefPicList( refList ) ); iRefIdx++ )
+      {
+        if ( pcSlice->getRefPic( RefPicList( refList ), iRefIdx )->getReconRowProgress() == 0 )
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/** decode the slice segments of the picture, filter it and publish it to the pictures referencing it
+ */
+Void TDecPicWorker::run( Int iThreadIdx )
+{
+  for ( UInt uiSliceIdx = 0; uiSliceIdx < m_apcSliceData.size(); uiSliceIdx++ )
+  {
+    m_pcPic->setCurrSliceIdx( uiSliceIdx );
+    m_cCtuDecoder.initSlice( m_pcPic->getSlice( uiSliceIdx ) );
+    m_cGopDecoder.decompressSlice( m_apcSliceData[uiSliceIdx], m_pcPic );
+
+    m_apcSliceData[uiSliceIdx]->deleteFifo();
+    delete m_apcSliceData[uiSliceIdx];
+  }
+  m_apcSliceData.clear();
+
+  m_cGopDecoder.applyLoopFilters( m_pcPic );
+}
+
+//! \}
@@ -0,0 +1,104 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TDecPicWorker.h
+    \brief    picture worker used for frame-parallel decoding (header)
+*/
+
+#ifndef __TDECPICWORKER__
+#define __TDECPICWORKER__
+
+// Include files
+#include <vector>
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComBitStream.h"
+#include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TLibCommon/TComThreadPool.h"
+#include "TDecCtuWorker.h"
+#include "TDecCAVLC.h"
+#include "TDecSlice.h"
+#include "TDecGop.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// reconstructs the slice segments of one picture as a task of the thread pool, with a decoding engine of its own,
+/// while the decoder goes on parsing the slice headers of the following pictures
+class TDecPicWorker : public TComTask
+{
+private:
+  TDecCtuWorker           m_cCtuDecoder;                  ///< CTU decoding engine for the serial CTUs of the slices
+  TDecCavlc               m_cCavlcDecoder;                ///< CAVLC decoder required by the GOP decoder
+  TDecSlice               m_cSliceDecoder;                ///< slice decoder
+  TDecGop                 m_cGopDecoder;                  ///< GOP decoder, reconstructs and filters the picture
+  TComLoopFilter          m_cLoopFilter;                  ///< deblocking filter
+  TComSampleAdaptiveOffset m_cSAO;                        ///< sample adaptive offset
+
+  // picture being decoded
+  TComPic*                m_pcPic;                        ///< picture
+  std::vector<TComInputBitstream*> m_apcSliceData;        ///< slice data of the slice segments, following the slice headers
+  Bool                    m_bReferenced;                  ///< picture was used for reference when its last slice segment was parsed
+  TComTaskGroup           m_cTaskGroup;                   ///< group the picture task is submitted with
+
+public:
+  TDecPicWorker();
+  virtual ~TDecPicWorker();
+
+  Void  create            ( TComThreadPool* pcThreadPool );
+  Void  destroy           ();
+
+  /// set the picture whose first slice segment has just been parsed, and set up the decoding engine for its SPS and PPS
+  Void  setPicture        ( TComPic* pcPic, TComSlice* pcSlice );
+  /// keep a copy of the slice data of the current slice segment of the picture, to be decoded when the worker runs
+  Void  addSliceSegment   ( TComInputBitstream* pcBitstream );
+  /// print the status line of the picture and mark it as decoded, from the thread that calls the decoder
+  Void  finishPicture     ();
+
+  Void  setDecodedPictureHashSEIEnabled( Int enabled ) { m_cGopDecoder.setDecodedPictureHashSEIEnabled( enabled ); }
+
+  Bool  isReady           ();
+  Void  run               ( Int iThreadIdx );
+
+  TComTaskGroup*          getTaskGroup          () { return &m_cTaskGroup; }
+  TComPic*                getPic                () { return m_pcPic;       }
+};
+
+//! \}
+
+#endif // __TDECPICWORKER__
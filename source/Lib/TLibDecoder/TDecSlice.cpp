@@ -36,6 +36,7 @@
 */
 
 #include "TDecSlice.h"
+#include "TDecGop.h"
 
 //! \ingroup TLibDecoder
 //! \{
@@ -45,6 +46,26 @@
 //////////////////////////////////////////////////////////////////////
 
 TDecSlice::TDecSlice()
+: m_pcThreadPool            ( NULL )
+, m_pcCtuWorkers            ( NULL )
+, m_iNumCtuWorkers          ( 0 )
+, m_workerChromaFormat      ( CHROMA_420 )
+, m_uiWorkerMaxCUWidth      ( 0 )
+, m_uiWorkerMaxCUHeight     ( 0 )
+, m_uiWorkerMaxCUDepth      ( 0 )
+, m_uiWorkerMaxTrSize       ( 0 )
+, m_pcRowSyncContextStates  ( NULL )
+, m_puiRowProgress          ( NULL )
+, m_uiNumCtuRows            ( 0 )
+, m_pcParallelPic           ( NULL )
+, m_ppcParallelSubstreams   ( NULL )
+, m_uiParallelStartCtuRsAddr( 0 )
+, m_uiFirstJob              ( 0 )
+, m_uiLastJob               ( 0 )
+, m_bParallelTiles          ( false )
+, m_uiReconStartCtuTsAddr   ( 0 )
+, m_uiParsedCtuTsAddr       ( 0 )
+, m_bParsingFinished        ( false )
 {
 }
 
@@ -58,12 +79,14 @@ Void TDecSlice::create()
 
 Void TDecSlice::destroy()
 {
+  xDestroyCtuWorkers();
 }
 
-Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder)
+Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder, TDecGop* pcGopDecoder)
 {
   m_pcEntropyDecoder  = pcEntropyDecoder;
   m_pcCuDecoder       = pcCuDecoder;
+  m_pcGopDecoder      = pcGopDecoder;
 }
 
 Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecSbac* pcSbacDecoder)
@@ -78,14 +101,40 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
   const Bool depSliceSegmentsEnabled = pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
   const Bool wavefrontsEnabled       = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
 
-  m_pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder  );
-  m_pcEntropyDecoder->setBitstream      ( ppcSubstreams[0] );
-  m_pcEntropyDecoder->resetEntropy      (pcSlice);
-
   // decoder doesn't need prediction & residual frame buffer
   pcPic->setPicYuvPred( 0 );
   pcPic->setPicYuvResi( 0 );
 
+  const Bool bParallelTiles = xUseParallelTiles( pcPic, pcSlice );
+  if ( bParallelTiles || xUseParallelCtuRows( pcPic, pcSlice ) )
+  {
+    xDecodeInParallel( ppcSubstreams, pcPic, pcSlice, startCtuRsAddr, bParallelTiles );
+    return;
+  }
+
+  // the CTUs are parsed on this thread, into the CTU data of the picture, and reconstructed by a task of the pool
+  const Bool bPipelinedRecon = xUsePipelinedRecon( pcPic, pcSlice );
+  TComTaskGroup cReconGroup;
+  if ( bPipelinedRecon )
+  {
+    xCreateCtuWorkers( pcSlice, pcPic->getPicSym()->getFrameHeightInCtus() );
+    for ( Int i = 0; i < m_iNumCtuWorkers; i++ )
+    {
+      m_pcCtuWorkers[i].initSlice( pcSlice );
+    }
+
+    m_pcParallelPic         = pcPic;
+    m_uiReconStartCtuTsAddr = startCtuTsAddr;
+    m_uiParsedCtuTsAddr     = startCtuTsAddr;
+    m_bParsingFinished      = false;
+    m_cReconJob.init( this );
+    m_pcThreadPool->submit( &m_cReconJob, &cReconGroup );
+  }
+
+  m_pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder  );
+  m_pcEntropyDecoder->setBitstream      ( ppcSubstreams[0] );
+  m_pcEntropyDecoder->resetEntropy      (pcSlice);
+
 #if ENC_DEC_TRACE
   g_bJustDoIt = g_bEncDecTraceEnable;
 #endif
@@ -170,40 +219,19 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
 
     if ( pcSlice->getSPS()->getUseSAO() )
     {
-      SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
-      Bool bIsSAOSliceEnabled = false;
-      Bool sliceEnabled[MAX_NUM_COMPONENT];
-      for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
-      {
-        ComponentID compId=ComponentID(comp);
-        sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
-        if (sliceEnabled[compId]) bIsSAOSliceEnabled=true;
-        saoblkParam[compId].modeIdc = SAO_MODE_OFF;
-      }
-      if (bIsSAOSliceEnabled)
-      {
-        Bool leftMergeAvail = false;
-        Bool aboveMergeAvail= false;
-
-        //merge left condition
-        Int rx = (ctuRsAddr % frameWidthInCtus);
-        if(rx > 0)
-        {
-          leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
-        }
-        //merge up condition
-        Int ry = (ctuRsAddr / frameWidthInCtus);
-        if(ry > 0)
-        {
-          aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
-        }
-
-        pcSbacDecoder->parseSAOBlkParam( saoblkParam, sliceEnabled, leftMergeAvail, aboveMergeAvail);
-      }
+      xParseSAOBlkParam( pcPic, pcSlice, ctuRsAddr, pcSbacDecoder );
     }
 
     m_pcCuDecoder->decodeCtu     ( pCtu, isLastCtuOfSliceSegment );
-    m_pcCuDecoder->decompressCtu ( pCtu );
+    if ( bPipelinedRecon )
+    {
+      xPublishParsedCtus( ctuTsAddr + 1, false );
+    }
+    else
+    {
+      m_pcCuDecoder->decompressCtu ( pCtu );
+      m_pcGopDecoder->ctuReconstructed( pcPic, ctuRsAddr );
+    }
 
 #if ENC_DEC_TRACE
     g_bJustDoIt = g_bEncDecTraceDisable;
@@ -244,6 +272,11 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
 
   assert(isLastCtuOfSliceSegment == true);
 
+  if ( bPipelinedRecon )
+  {
+    xPublishParsedCtus( pcSlice->getSliceSegmentCurEndCtuTsAddr(), true );
+    m_pcThreadPool->wait( &cReconGroup );
+  }
 
   if( depSliceSegmentsEnabled )
   {
@@ -252,6 +285,535 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
 
 }
 
+/** parse the SAO parameters of a CTU
+ \param  pcPic          picture being decoded
+ \param  pcSlice        slice of the CTU
+ \param  ctuRsAddr      CTU address in raster scan
+ \param  pcSbacDecoder  SBAC decoder positioned at the CTU
+ */
+Void TDecSlice::xParseSAOBlkParam( TComPic* pcPic, TComSlice* pcSlice, UInt ctuRsAddr, TDecSbac* pcSbacDecoder )
+{
+  const UInt frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+
+  SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
+  Bool bIsSAOSliceEnabled = false;
+  Bool sliceEnabled[MAX_NUM_COMPONENT];
+  for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    ComponentID compId=ComponentID(comp);
+    sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
+    if (sliceEnabled[compId]) bIsSAOSliceEnabled=true;
+    saoblkParam[compId].modeIdc = SAO_MODE_OFF;
+  }
+  if (bIsSAOSliceEnabled)
+  {
+    Bool leftMergeAvail = false;
+    Bool aboveMergeAvail= false;
+
+    //merge left condition
+    Int rx = (ctuRsAddr % frameWidthInCtus);
+    if(rx > 0)
+    {
+      leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
+    }
+    //merge up condition
+    Int ry = (ctuRsAddr / frameWidthInCtus);
+    if(ry > 0)
+    {
+      aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
+    }
+
+    pcSbacDecoder->parseSAOBlkParam( saoblkParam, sliceEnabled, leftMergeAvail, aboveMergeAvail);
+  }
+}
+
+/** The substreams of a wavefront slice segment are decoded in parallel when a thread pool is available and the
+ * picture has a single tile. The trace file and the bit statistics of the analyser are global, so they keep the
+ * serial path.
+ \param  pcPic    picture being decoded
+ \param  pcSlice  slice segment being decoded
+ \returns true if the CTU rows of the slice segment are decoded by the thread pool
+ */
+Bool TDecSlice::xUseParallelCtuRows( TComPic* pcPic, TComSlice* pcSlice )
+{
+#if ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS
+  return false;
+#else
+  const TComPicSym* pcPicSym       = pcPic->getPicSym();
+  const UInt        startCtuRsAddr = pcPicSym->getCtuTsToRsAddrMap( pcSlice->getSliceSegmentCurStartCtuTsAddr() );
+  const UInt        uiNumRows      = pcSlice->getNumberOfSubstreamSizes() + 1;
+
+  return m_pcThreadPool != NULL
+      && pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag()
+      && pcPicSym->getNumTiles() == 1
+      && uiNumRows > 1
+      && startCtuRsAddr / pcPicSym->getFrameWidthInCtus() + uiNumRows <= pcPicSym->getFrameHeightInCtus();
+#endif
+}
+
+/** The tiles of a slice segment are decoded in parallel when a thread pool is available, the slice segment starts at
+ * the first CTU of a tile and has one substream per tile, i.e. it is made of whole tiles. Tiles combined with
+ * wavefronts keep the serial path, as do the trace file and the bit statistics of the analyser.
+ \param  pcPic    picture being decoded
+ \param  pcSlice  slice segment being decoded
+ \returns true if the tiles of the slice segment are decoded by the thread pool
+ */
+Bool TDecSlice::xUseParallelTiles( TComPic* pcPic, TComSlice* pcSlice )
+{
+#if ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS
+  return false;
+#else
+  const TComPicSym* pcPicSym       = pcPic->getPicSym();
+  const UInt        startCtuRsAddr = pcPicSym->getCtuTsToRsAddrMap( pcSlice->getSliceSegmentCurStartCtuTsAddr() );
+  const UInt        startTileIdx   = pcPicSym->getTileIdxMap( startCtuRsAddr );
+  const UInt        uiNumTiles     = pcSlice->getNumberOfSubstreamSizes() + 1;
+
+  return m_pcThreadPool != NULL
+      && !pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag()
+      && pcPicSym->getNumTiles() > 1
+      && uiNumTiles > 1
+      && pcPicSym->getTComTile( startTileIdx )->getFirstCtuRsAddr() == startCtuRsAddr
+      && startTileIdx + uiNumTiles <= pcPicSym->getNumTiles();
+#endif
+}
+
+/** The CTUs of a slice segment that is not decoded by CTU rows or tiles are parsed and reconstructed in a pipeline
+ * when a thread pool is available. CABAC parsing of a CTU only depends on the syntax of the CTUs parsed before it,
+ * so it runs ahead of the reconstruction, which keeps the CTU order. The picture has to have a single tile, so that
+ * the neighbouring CTUs that the reconstruction looks at are the ones parsed before. The trace file and the bit
+ * statistics of the analyser keep the serial path.
+ \param  pcPic    picture being decoded
+ \param  pcSlice  slice segment being decoded
+ \returns true if the reconstruction of the slice segment is done by a task of the thread pool
+ */
+Bool TDecSlice::xUsePipelinedRecon( TComPic* pcPic, TComSlice* pcSlice )
+{
+#if ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS
+  return false;
+#else
+  return m_pcThreadPool != NULL
+      && pcPic->getPicSym()->getNumTiles() == 1;
+#endif
+}
+
+/** hand the parsed CTUs over to the reconstruction task
+ \param  uiParsedCtuTsAddr  the CTUs of the slice segment before this address (in tile scan) are parsed
+ \param  bFinished          the slice segment is parsed completely
+ */
+Void TDecSlice::xPublishParsedCtus( UInt uiParsedCtuTsAddr, Bool bFinished )
+{
+  m_cRowMutex.lock();
+  m_uiParsedCtuTsAddr = uiParsedCtuTsAddr;
+  m_bParsingFinished  = bFinished;
+  m_cRowProgressCond.broadcast();
+  m_cRowMutex.unlock();
+}
+
+/** (re)create the CTU decoders when the CTU size, chroma format or maximum transform size has changed
+ \param  pcSlice              slice to be decoded
+ \param  uiFrameHeightInCtus  number of CTU rows of the picture
+ */
+Void TDecSlice::xCreateCtuWorkers( TComSlice* pcSlice, UInt uiFrameHeightInCtus )
+{
+  TComSPS* pcSPS = pcSlice->getSPS();
+
+  if ( m_pcCtuWorkers == NULL
+    || m_workerChromaFormat  != pcSPS->getChromaFormatIdc()
+    || m_uiWorkerMaxCUWidth  != g_uiMaxCUWidth
+    || m_uiWorkerMaxCUHeight != g_uiMaxCUHeight
+    || m_uiWorkerMaxCUDepth  != g_uiMaxCUDepth
+    || m_uiWorkerMaxTrSize   != pcSPS->getMaxTrSize() )
+  {
+    xDestroyCtuWorkers();
+
+    m_workerChromaFormat  = pcSPS->getChromaFormatIdc();
+    m_uiWorkerMaxCUWidth  = g_uiMaxCUWidth;
+    m_uiWorkerMaxCUHeight = g_uiMaxCUHeight;
+    m_uiWorkerMaxCUDepth  = g_uiMaxCUDepth;
+    m_uiWorkerMaxTrSize   = pcSPS->getMaxTrSize();
+
+    m_iNumCtuWorkers = m_pcThreadPool->getNumThreadSlots();
+    m_pcCtuWorkers   = new TDecCtuWorker[m_iNumCtuWorkers];
+    for ( Int i = 0; i < m_iNumCtuWorkers; i++ )
+    {
+      m_pcCtuWorkers[i].create( m_workerChromaFormat, m_uiWorkerMaxTrSize );
+    }
+  }
+
+  if ( m_uiNumCtuRows < uiFrameHeightInCtus )
+  {
+    delete [] m_pcRowSyncContextStates;
+    delete [] m_puiRowProgress;
+    m_uiNumCtuRows           = uiFrameHeightInCtus;
+    m_pcRowSyncContextStates = new TDecSbac[m_uiNumCtuRows];
+    m_puiRowProgress         = new UInt    [m_uiNumCtuRows];
+  }
+}
+
+Void TDecSlice::xDestroyCtuWorkers()
+{
+  if ( m_pcCtuWorkers )
+  {
+    for ( Int i = 0; i < m_iNumCtuWorkers; i++ )
+    {
+      m_pcCtuWorkers[i].destroy();
+    }
+    delete [] m_pcCtuWorkers;
+    m_pcCtuWorkers   = NULL;
+    m_iNumCtuWorkers = 0;
+  }
+  if ( m_pcRowSyncContextStates ) { delete [] m_pcRowSyncContextStates; m_pcRowSyncContextStates = NULL; }
+  if ( m_puiRowProgress         ) { delete [] m_puiRowProgress;         m_puiRowProgress         = NULL; }
+  m_uiNumCtuRows = 0;
+}
+
+/** Decode the substreams (CTU rows or tiles) of a slice segment as tasks of the thread pool, with the CTU decoder of
+ * the thread slot each task runs on. With wavefronts, each row trails the row above by two CTUs, which is what the
+ * CABAC synchronisation, the intra prediction and the motion vector prediction of a CTU depend on. The contexts of
+ * the wavefront synchronisation and of dependent slice segments are handed over in m_entropyCodingSyncContextState
+ * and m_lastSliceSegmentEndContextState exactly as the serial path does. Tiles do not depend on each other at all.
+ \param  ppcSubstreams   substreams of the slice segment, one per CTU row or tile
+ \param  pcPic           picture being decoded
+ \param  pcSlice         slice segment being decoded
+ \param  startCtuRsAddr  first CTU of the slice segment
+ \param  bTiles          distribute whole tiles instead of CTU rows
+ */
+Void TDecSlice::xDecodeInParallel( TComInputBitstream** ppcSubstreams, TComPic* pcPic, TComSlice* pcSlice, UInt startCtuRsAddr, Bool bTiles )
+{
+  TComPicSym* pcPicSym         = pcPic->getPicSym();
+  const UInt frameWidthInCtus  = pcPicSym->getFrameWidthInCtus();
+  const UInt frameHeightInCtus = pcPicSym->getFrameHeightInCtus();
+
+  xCreateCtuWorkers( pcSlice, frameHeightInCtus );
+
+  m_pcParallelPic            = pcPic;
+  m_ppcParallelSubstreams    = ppcSubstreams;
+  m_uiParallelStartCtuRsAddr = startCtuRsAddr;
+  m_bParallelTiles           = bTiles;
+
+  if ( bTiles )
+  {
+    m_uiFirstJob = pcPicSym->getTileIdxMap( startCtuRsAddr );
+    m_uiLastJob  = m_uiFirstJob + pcSlice->getNumberOfSubstreamSizes();
+
+    // all CTUs are initialised beforehand, so that the slice and tile checks on CTUs of other tiles do not race with
+    // their initialisation
+    const UInt startCtuTsAddr    = pcPicSym->getCtuRsToTsAddrMap( startCtuRsAddr );
+    const TComTile* pcLastTile   = pcPicSym->getTComTile( m_uiLastJob );
+    const UInt boundingCtuTsAddr = pcPicSym->getCtuRsToTsAddrMap( pcLastTile->getFirstCtuRsAddr() )
+                                 + pcLastTile->getTileWidthInCtus() * pcLastTile->getTileHeightInCtus();
+    for ( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++ )
+    {
+      const UInt ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap( ctuTsAddr );
+      pcPic->getCtu( ctuRsAddr )->initCtu( pcPic, ctuRsAddr );
+    }
+  }
+  else
+  {
+    m_uiFirstJob = startCtuRsAddr / frameWidthInCtus;
+    m_uiLastJob  = m_uiFirstJob + pcSlice->getNumberOfSubstreamSizes();
+
+    // the rows above the slice segment have been decoded before
+    for ( UInt row = 0; row < frameHeightInCtus; row++ )
+    {
+      m_puiRowProgress[row] = row < m_uiFirstJob ? frameWidthInCtus : 0;
+    }
+  }
+
+  for ( Int i = 0; i < m_iNumCtuWorkers; i++ )
+  {
+    m_pcCtuWorkers[i].initSlice( pcSlice );
+  }
+
+  TComTaskGroup cGroup;
+  m_acCtuJobs.resize( m_uiLastJob + 1 );
+  for ( UInt uiJob = m_uiFirstJob; uiJob <= m_uiLastJob; uiJob++ )
+  {
+    m_acCtuJobs[uiJob].init( this, uiJob );
+    m_pcThreadPool->submit( &m_acCtuJobs[uiJob], &cGroup );
+  }
+  m_pcThreadPool->wait( &cGroup );
+
+  if ( bTiles )
+  {
+    return;
+  }
+
+  // the contexts stored last in coding order are the ones the serial path would have kept
+  for ( Int row = m_uiLastJob; row >= Int( m_uiFirstJob ); row-- )
+  {
+    const UInt rowStartX = ( UInt( row ) == m_uiFirstJob ) ? startCtuRsAddr % frameWidthInCtus : 0;
+    if ( rowStartX <= 1 && m_puiRowProgress[row] >= 2 )
+    {
+      m_entropyCodingSyncContextState.loadContexts( &m_pcRowSyncContextStates[row] );
+      break;
+    }
+  }
+}
+
+/** A tile can always be started. A CTU row is started once the row above has decoded its first two CTUs, so that a
+ * row never waits for a row that has not been started yet.
+ \param  uiJob         CTU row or tile index
+ \returns true if the job can be started
+ */
+Bool TDecSlice::isCtuJobReady( UInt uiJob )
+{
+  if ( m_bParallelTiles || uiJob == m_uiFirstJob )
+  {
+    return true;
+  }
+  const UInt requiredProgress = std::min( 2u, m_pcParallelPic->getPicSym()->getFrameWidthInCtus() );
+  m_cRowMutex.lock();
+  const Bool bReady = m_puiRowProgress[uiJob - 1] >= requiredProgress;
+  m_cRowMutex.unlock();
+  return bReady;
+}
+
+/** Decode a CTU row or tile of the slice segment being decoded.
+ \param  iThreadIdx    thread slot of the pool, selects the CTU decoder
+ \param  uiJob         CTU row or tile index
+ */
+Void TDecSlice::decodeCtuJob( Int iThreadIdx, UInt uiJob )
+{
+  if ( m_bParallelTiles )
+  {
+    xDecodeTile( &m_pcCtuWorkers[iThreadIdx], uiJob );
+  }
+  else
+  {
+    xDecodeCtuRow( &m_pcCtuWorkers[iThreadIdx], uiJob );
+  }
+}
+
+/** Reconstruct the CTUs of the slice segment in coding order with the CTU decoder of the executing thread, each one
+ * as soon as it has been parsed.
+ \param  iThreadIdx    thread slot of the pool, selects the CTU decoder
+ */
+Void TDecSlice::reconstructCtus( Int iThreadIdx )
+{
+  TComPic* pcPic   = m_pcParallelPic;
+  TDecCu*  pcCuDec = m_pcCtuWorkers[iThreadIdx].getCuDecoder();
+
+  for ( UInt ctuTsAddr = m_uiReconStartCtuTsAddr; ; ctuTsAddr++ )
+  {
+    m_cRowMutex.lock();
+    while ( m_uiParsedCtuTsAddr <= ctuTsAddr && !m_bParsingFinished )
+    {
+      m_cRowProgressCond.wait( m_cRowMutex );
+    }
+    const Bool bParsed = ctuTsAddr < m_uiParsedCtuTsAddr;
+    m_cRowMutex.unlock();
+
+    if ( !bParsed )
+    {
+      break;
+    }
+    const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap( ctuTsAddr );
+    pcCuDec->decompressCtu( pcPic->getCtu( ctuRsAddr ) );
+    m_pcGopDecoder->ctuReconstructed( pcPic, ctuRsAddr );
+  }
+}
+
+/** Decode the (already initialised) CTUs of one tile from its own substream, in tile scan. The tile starts from the
+ * initial contexts, the slice segment starting at the first CTU of a tile.
+ \param  pcWorker      CTU decoder of the executing thread
+ \param  uiTileIdx     tile index in the picture
+ */
+Void TDecSlice::xDecodeTile( TDecCtuWorker* pcWorker, UInt uiTileIdx )
+{
+  TComPic*        pcPic             = m_pcParallelPic;
+  TComPicSym*     pcPicSym          = pcPic->getPicSym();
+  TComSlice*      pcSlice           = pcPic->getSlice( pcPic->getCurrSliceIdx() );
+  const TComTile* pcTile            = pcPicSym->getTComTile( uiTileIdx );
+  const UInt      startCtuTsAddr    = pcPicSym->getCtuRsToTsAddrMap( pcTile->getFirstCtuRsAddr() );
+  const UInt      boundingCtuTsAddr = startCtuTsAddr + pcTile->getTileWidthInCtus() * pcTile->getTileHeightInCtus();
+  TDecSbac*       pcSbacDecoder     = pcWorker->getSbacDecoder();
+  TDecEntropy*    pcEntropyDecoder  = pcWorker->getEntropyDecoder();
+
+  pcEntropyDecoder->setEntropyDecoder( pcSbacDecoder );
+  pcEntropyDecoder->setBitstream     ( m_ppcParallelSubstreams[uiTileIdx - m_uiFirstJob] );
+  pcEntropyDecoder->resetEntropy     ( pcSlice );
+
+  Bool isLastCtuOfSliceSegment = false;
+  for ( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++ )
+  {
+    const UInt  ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap( ctuTsAddr );
+    TComDataCU* pCtu      = pcPic->getCtu( ctuRsAddr );
+
+    if ( pcSlice->getSPS()->getUseSAO() )
+    {
+      xParseSAOBlkParam( pcPic, pcSlice, ctuRsAddr, pcSbacDecoder );
+    }
+
+    pcWorker->getCuDecoder()->decodeCtu     ( pCtu, isLastCtuOfSliceSegment );
+    pcWorker->getCuDecoder()->decompressCtu ( pCtu );
+    m_pcGopDecoder->ctuReconstructed( pcPic, ctuRsAddr );
+
+    // the substream is terminated at the end of the tile, which for the last tile is the end of the slice segment
+    if ( isLastCtuOfSliceSegment || ctuTsAddr + 1 == boundingCtuTsAddr )
+    {
+      UInt binVal;
+      pcSbacDecoder->parseTerminatingBit( binVal );
+      assert( binVal );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+      pcSbacDecoder->parseRemainingBytes(!isLastCtuOfSliceSegment);
+#endif
+
+      if (isLastCtuOfSliceSegment)
+      {
+        if(!pcSlice->getDependentSliceSegmentFlag())
+        {
+          pcSlice->setSliceCurEndCtuTsAddr( ctuTsAddr+1 );
+        }
+        pcSlice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
+
+        if( pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag() )
+        {
+          m_lastSliceSegmentEndContextState.loadContexts( pcSbacDecoder );//ctx end of dep.slice
+        }
+      }
+      break;
+    }
+  }
+
+  // only the last substream ends the slice segment
+  assert( isLastCtuOfSliceSegment == ( uiTileIdx == m_uiLastJob ) );
+}
+
+/** Decode the CTUs of one CTU row of the slice segment from its own substream. Before each CTU, the row waits until
+ * the row above has decoded the CTU above-right.
+ \param  pcWorker      CTU decoder of the executing thread
+ \param  uiCtuRow      CTU row to be decoded
+ */
+Void TDecSlice::xDecodeCtuRow( TDecCtuWorker* pcWorker, UInt uiCtuRow )
+{
+  TComPic*        pcPic             = m_pcParallelPic;
+  TComSlice*      pcSlice           = pcPic->getSlice( pcPic->getCurrSliceIdx() );
+  const UInt      frameWidthInCtus  = pcPic->getPicSym()->getFrameWidthInCtus();
+  const UInt      startCtuRsAddr    = std::max( uiCtuRow * frameWidthInCtus, m_uiParallelStartCtuRsAddr );
+  const UInt      boundingCtuRsAddr = ( uiCtuRow + 1 ) * frameWidthInCtus;
+  const Bool      depSliceSegmentsEnabled = pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
+  TDecSbac*       pcSbacDecoder     = pcWorker->getSbacDecoder();
+  TDecEntropy*    pcEntropyDecoder  = pcWorker->getEntropyDecoder();
+
+  pcEntropyDecoder->setEntropyDecoder( pcSbacDecoder );
+  pcEntropyDecoder->setBitstream     ( m_ppcParallelSubstreams[uiCtuRow - m_uiFirstJob] );
+  pcEntropyDecoder->resetEntropy     ( pcSlice );
+
+  // a dependent slice segment continues with the contexts at the end of the previous slice segment
+  if ( uiCtuRow == m_uiFirstJob && depSliceSegmentsEnabled && pcSlice->getDependentSliceSegmentFlag()
+    && m_uiParallelStartCtuRsAddr != 0 && frameWidthInCtus >= 2 )
+  {
+    pcSbacDecoder->loadContexts( &m_lastSliceSegmentEndContextState );
+  }
+
+  Bool isLastCtuOfSliceSegment = false;
+  for ( UInt ctuRsAddr = startCtuRsAddr; ctuRsAddr < boundingCtuRsAddr; ctuRsAddr++ )
+  {
+    const UInt ctuXPosInCtus = ctuRsAddr % frameWidthInCtus;
+
+    // wait for the CTU above-right
+    if ( uiCtuRow > m_uiFirstJob )
+    {
+      const UInt requiredProgress = std::min( ctuXPosInCtus + 2, frameWidthInCtus );
+      m_cRowMutex.lock();
+      while ( m_puiRowProgress[uiCtuRow - 1] < requiredProgress )
+      {
+        m_cRowProgressCond.wait( m_cRowMutex );
+      }
+      m_cRowMutex.unlock();
+    }
+
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+    pCtu->initCtu( pcPic, ctuRsAddr );
+
+    // synchronise the contexts with the upper-right CTU at the start of the row, if it is available. When the slice
+    // segment starts at the beginning of a row, the row above was decoded by an earlier slice segment.
+    if ( ctuXPosInCtus == 0 )
+    {
+      TComDataCU *pCtuUp = pCtu->getCtuAbove();
+      if ( pCtuUp && frameWidthInCtus > 1 )
+      {
+        TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+        if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+        {
+          pcSbacDecoder->loadContexts( uiCtuRow == m_uiFirstJob ? &m_entropyCodingSyncContextState : &m_pcRowSyncContextStates[uiCtuRow - 1] );
+        }
+      }
+    }
+
+    if ( pcSlice->getSPS()->getUseSAO() )
+    {
+      xParseSAOBlkParam( pcPic, pcSlice, ctuRsAddr, pcSbacDecoder );
+    }
+
+    pcWorker->getCuDecoder()->decodeCtu     ( pCtu, isLastCtuOfSliceSegment );
+    pcWorker->getCuDecoder()->decompressCtu ( pCtu );
+    m_pcGopDecoder->ctuReconstructed( pcPic, ctuRsAddr );
+
+    // store the contexts after the second CTU of the row for the row below
+    if ( ctuXPosInCtus == 1 )
+    {
+      m_pcRowSyncContextStates[uiCtuRow].loadContexts( pcSbacDecoder );
+    }
+
+    m_cRowMutex.lock();
+    m_puiRowProgress[uiCtuRow] = ctuXPosInCtus + 1;
+    m_cRowProgressCond.broadcast();
+    m_cRowMutex.unlock();
+    m_pcThreadPool->wakeUp();
+
+    // the substream is terminated at the end of the row or of the slice segment
+    if ( isLastCtuOfSliceSegment || ctuXPosInCtus + 1 == frameWidthInCtus )
+    {
+      UInt binVal;
+      pcSbacDecoder->parseTerminatingBit( binVal );
+      assert( binVal );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+      pcSbacDecoder->parseRemainingBytes(!isLastCtuOfSliceSegment);
+#endif
+
+      if (isLastCtuOfSliceSegment)
+      {
+        const UInt ctuTsAddr = pcPic->getPicSym()->getCtuRsToTsAddrMap( ctuRsAddr );
+        if(!pcSlice->getDependentSliceSegmentFlag())
+        {
+          pcSlice->setSliceCurEndCtuTsAddr( ctuTsAddr+1 );
+        }
+        pcSlice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
+
+        if( depSliceSegmentsEnabled )
+        {
+          m_lastSliceSegmentEndContextState.loadContexts( pcSbacDecoder );//ctx end of dep.slice
+        }
+      }
+      break;
+    }
+  }
+
+  // only the last substream ends the slice segment
+  assert( isLastCtuOfSliceSegment == ( uiCtuRow == m_uiLastJob ) );
+}
+
+// ====================================================================================================================
+// TDecCtuJob
+// ====================================================================================================================
+
+Bool TDecCtuJob::isReady()
+{
+  return m_pcSliceDecoder->isCtuJobReady( m_uiJob );
+}
+
+Void TDecCtuJob::run( Int iThreadIdx )
+{
+  m_pcSliceDecoder->decodeCtuJob( iThreadIdx, m_uiJob );
+}
+
+Void TDecReconJob::run( Int iThreadIdx )
+{
+  m_pcSliceDecoder->reconstructCtus( iThreadIdx );
+}
+
 ParameterSetManagerDecoder::ParameterSetManagerDecoder()
 : m_vpsBuffer(MAX_NUM_VPS)
 , m_spsBuffer(MAX_NUM_SPS)
@@ -45,18 +45,53 @@
 #include "TLibCommon/CommonDef.h"
 #include "TLibCommon/TComBitStream.h"
 #include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TDecEntropy.h"
 #include "TDecCu.h"
 #include "TDecSbac.h"
 #include "TDecBinCoderCABAC.h"
+#include "TDecCtuWorker.h"
+#include <vector>
 
 //! \ingroup TLibDecoder
 //! \{
 
+class TDecSlice;
+class TDecGop;
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
 
+/// CTU row (wavefront substream) or tile of the slice segment being decoded, run by the thread pool
+class TDecCtuJob : public TComTask
+{
+public:
+  TDecCtuJob() : m_pcSliceDecoder( NULL ), m_uiJob( 0 ) {}
+
+  Void  init    ( TDecSlice* pcSliceDecoder, UInt uiJob ) { m_pcSliceDecoder = pcSliceDecoder; m_uiJob = uiJob; }
+  Bool  isReady ();
+  Void  run     ( Int iThreadIdx );
+
+private:
+  TDecSlice*  m_pcSliceDecoder;
+  UInt        m_uiJob;                                  ///< CTU row or tile index
+};
+
+/// reconstruction of the CTUs of the slice segment being parsed, run by the thread pool
+class TDecReconJob : public TComTask
+{
+public:
+  TDecReconJob() : m_pcSliceDecoder( NULL ) {}
+
+  Void  init    ( TDecSlice* pcSliceDecoder ) { m_pcSliceDecoder = pcSliceDecoder; }
+  Bool  isReady () { return true; }
+  Void  run     ( Int iThreadIdx );
+
+private:
+  TDecSlice*  m_pcSliceDecoder;
+};
+
 /// slice decoder class
 class TDecSlice
 {
@@ -64,6 +99,48 @@ private:
   // access channel
   TDecEntropy*    m_pcEntropyDecoder;
   TDecCu*         m_pcCuDecoder;
+  TDecGop*        m_pcGopDecoder;                       ///< filters the CTU rows of the picture as they are reconstructed
+  TComThreadPool* m_pcThreadPool;                       ///< thread pool of the decoder, NULL when running single-threaded
+
+  // parallel wavefront and tile decoding
+  TDecCtuWorker*  m_pcCtuWorkers;                       ///< one CTU decoder per thread slot of the pool
+  Int             m_iNumCtuWorkers;                     ///< number of CTU decoders
+  ChromaFormat    m_workerChromaFormat;                 ///< chroma format the CTU decoders were created for
+  UInt            m_uiWorkerMaxCUWidth;                 ///< CTU width the CTU decoders were created for
+  UInt            m_uiWorkerMaxCUHeight;                ///< CTU height the CTU decoders were created for
+  UInt            m_uiWorkerMaxCUDepth;                 ///< maximum CU depth the CTU decoders were created for
+  UInt            m_uiWorkerMaxTrSize;                  ///< maximum transform size the CTU decoders were created for
+  TDecSbac*       m_pcRowSyncContextStates;             ///< context state after the second CTU of each CTU row
+  UInt*           m_puiRowProgress;                     ///< per CTU row: number of CTUs of the row that are decoded (counted from the left picture edge)
+  UInt            m_uiNumCtuRows;                       ///< number of CTU rows the row arrays are allocated for
+  TComMutex       m_cRowMutex;                          ///< protects m_puiRowProgress
+  TComCondition   m_cRowProgressCond;                   ///< signalled whenever a CTU is finished
+  std::vector<TDecCtuJob> m_acCtuJobs;                  ///< tasks of the CTU rows or tiles of the slice segment being decoded
+
+  // slice segment being decoded in parallel
+  TComPic*             m_pcParallelPic;                 ///< picture
+  TComInputBitstream** m_ppcParallelSubstreams;         ///< substreams of the slice segment, one per CTU row or tile
+  UInt                 m_uiParallelStartCtuRsAddr;      ///< first CTU of the slice segment
+  UInt                 m_uiFirstJob;                    ///< first CTU row or tile of the slice segment
+  UInt                 m_uiLastJob;                     ///< last CTU row or tile of the slice segment
+  Bool                 m_bParallelTiles;                ///< the jobs are tiles rather than CTU rows
+
+  // reconstruction trailing the parsing of the slice segment
+  TDecReconJob         m_cReconJob;                     ///< task reconstructing the parsed CTUs
+  UInt                 m_uiReconStartCtuTsAddr;         ///< first CTU of the slice segment
+  UInt                 m_uiParsedCtuTsAddr;             ///< the CTUs of the slice segment before this one are parsed, protected by m_cRowMutex
+  Bool                 m_bParsingFinished;              ///< the last CTU of the slice segment is parsed, protected by m_cRowMutex
+
+  Bool  xUseParallelCtuRows ( TComPic* pcPic, TComSlice* pcSlice );
+  Bool  xUseParallelTiles   ( TComPic* pcPic, TComSlice* pcSlice );
+  Bool  xUsePipelinedRecon  ( TComPic* pcPic, TComSlice* pcSlice );
+  Void  xPublishParsedCtus  ( UInt uiParsedCtuTsAddr, Bool bFinished );
+  Void  xCreateCtuWorkers   ( TComSlice* pcSlice, UInt uiFrameHeightInCtus );
+  Void  xDestroyCtuWorkers  ();
+  Void  xDecodeInParallel   ( TComInputBitstream** ppcSubstreams, TComPic* pcPic, TComSlice* pcSlice, UInt startCtuRsAddr, Bool bTiles );
+  Void  xDecodeCtuRow       ( TDecCtuWorker* pcWorker, UInt uiCtuRow );
+  Void  xDecodeTile         ( TDecCtuWorker* pcWorker, UInt uiTileIdx );
+  Void  xParseSAOBlkParam   ( TComPic* pcPic, TComSlice* pcSlice, UInt ctuRsAddr, TDecSbac* pcSbacDecoder );
 
   TDecSbac        m_lastSliceSegmentEndContextState;    ///< context storage for state at the end of the previous slice-segment (used for dependent slices only).
   TDecSbac        m_entropyCodingSyncContextState;      ///< context storate for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
@@ -72,11 +149,17 @@ public:
   TDecSlice();
   virtual ~TDecSlice();
 
-  Void  init              ( TDecEntropy* pcEntropyDecoder, TDecCu* pcMbDecoder );
+  Void  init              ( TDecEntropy* pcEntropyDecoder, TDecCu* pcMbDecoder, TDecGop* pcGopDecoder );
   Void  create            ();
   Void  destroy           ();
 
+  Void  setThreadPool     ( TComThreadPool* pcThreadPool ) { m_pcThreadPool = pcThreadPool; }
+
   Void  decompressSlice   ( TComInputBitstream** ppcSubstreams,   TComPic* pcPic, TDecSbac* pcSbacDecoder );
+
+  Bool  isCtuJobReady     ( UInt uiJob );                       ///< check whether a CTU row or tile can be started
+  Void  decodeCtuJob      ( Int iThreadIdx, UInt uiJob );       ///< decode a CTU row or tile of the current slice segment
+  Void  reconstructCtus   ( Int iThreadIdx );                   ///< reconstruct the CTUs of the current slice segment as they are parsed
 };
 
 
@@ -92,6 +175,7 @@ public:
   Void     storePrefetchedPPS(TComPPS *pps)  { m_ppsBuffer.storePS( pps->getPPSId(), pps); };
   TComPPS* getPrefetchedPPS  (Int ppsId);
   Void     applyPrefetchedPS();
+  Bool     hasPrefetchedPS  () { return !m_vpsBuffer.isEmpty() || !m_spsBuffer.isEmpty() || !m_ppsBuffer.isEmpty(); }
 
 private:
   ParameterSetMap<TComVPS> m_vpsBuffer;
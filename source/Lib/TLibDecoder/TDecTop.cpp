@@ -37,6 +37,7 @@
 
 #include "NALread.h"
 #include "TDecTop.h"
+#include "TLibCommon/TComSimd.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "TLibCommon/TComCodingStatistics.h"
 #endif
@@ -69,6 +70,14 @@ TDecTop::TDecTop()
   m_lastPOCNoOutputPriorPics = -1;
   m_craNoRaslOutputFlag = false;
   m_isNoOutputPriorPics = false;
+  m_iNumThreads = 1;
+  m_iNumFrameThreads = 1;
+  m_iSimdLevel = -1;
+  m_pcPicWorkers = NULL;
+  m_iNumPicWorkers = 0;
+  m_iFirstBusyPicWorker = 0;
+  m_iNumBusyPicWorkers = 0;
+  m_pcCurrPicWorker = NULL;
 }
 
 TDecTop::~TDecTop()
@@ -96,19 +105,67 @@ Void TDecTop::destroy()
   m_apcSlicePilot = NULL;
 
   m_cSliceDecoder.destroy();
+
+  if ( m_pcPicWorkers )
+  {
+    for ( Int i = 0; i < m_iNumPicWorkers; i++ )
+    {
+      m_pcPicWorkers[i].destroy();
+    }
+    delete [] m_pcPicWorkers;
+    m_pcPicWorkers   = NULL;
+    m_iNumPicWorkers = 0;
+  }
+
+  m_cThreadPool.destroy();
 }
 
 Void TDecTop::init()
 {
   // initialize ROM
   initROM();
+  initSimdLevel( m_iSimdLevel );
   m_cGopDecoder.init( &m_cEntropyDecoder, &m_cSbacDecoder, &m_cBinCABAC, &m_cCavlcDecoder, &m_cSliceDecoder, &m_cLoopFilter, &m_cSAO);
-  m_cSliceDecoder.init( &m_cEntropyDecoder, &m_cCuDecoder );
+  m_cSliceDecoder.init( &m_cEntropyDecoder, &m_cCuDecoder, &m_cGopDecoder );
   m_cEntropyDecoder.init(&m_cPrediction);
+
+  // the thread that calls the decoder helps the pool, so the pool needs one thread less
+  if ( m_iNumThreads > 1 )
+  {
+    m_cThreadPool.create( m_iNumThreads - 1 );
+  }
+  m_cGopDecoder.setThreadPool( getThreadPool() );
+  m_cSliceDecoder.setThreadPool( getThreadPool() );
+  m_cLoopFilter.setThreadPool( getThreadPool() );
+  m_cSAO.setThreadPool( getThreadPool() );
+
+  // frame-parallel decoding needs the pool; the trace file and the bit statistics of the analyser need the serial order
+#if !(ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS)
+  if ( getThreadPool() && m_iNumFrameThreads > 1 )
+  {
+    m_iNumPicWorkers = m_iNumFrameThreads;
+    m_pcPicWorkers   = new TDecPicWorker[m_iNumPicWorkers];
+    for ( Int i = 0; i < m_iNumPicWorkers; i++ )
+    {
+      m_pcPicWorkers[i].create( getThreadPool() );
+    }
+  }
+#endif
+}
+
+Void TDecTop::setDecodedPictureHashSEIEnabled(Int enabled)
+{
+  m_cGopDecoder.setDecodedPictureHashSEIEnabled(enabled);
+  for ( Int i = 0; i < m_iNumPicWorkers; i++ )
+  {
+    m_pcPicWorkers[i].setDecodedPictureHashSEIEnabled(enabled);
+  }
 }
 
 Void TDecTop::deletePicBuffer ( )
 {
+  finishPictures();
+
   TComList<TComPic*>::iterator  iterPic   = m_cListPic.begin();
   Int iSize = Int( m_cListPic.size() );
 
@@ -147,6 +204,7 @@ Void TDecTop::xGetNewPicBuffer ( TComSlice* pcSlice, TComPic*& rpcPic )
 
     rpcPic->create ( pcSlice->getSPS()->getPicWidthInLumaSamples(), pcSlice->getSPS()->getPicHeightInLumaSamples(), pcSlice->getSPS()->getChromaFormatIdc(), g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth,
                      conformanceWindow, defaultDisplayWindow, numReorderPics, true);
+    xInitPicProgress( rpcPic );
 
     m_cListPic.pushBack( rpcPic );
 
@@ -158,6 +216,10 @@ Void TDecTop::xGetNewPicBuffer ( TComSlice* pcSlice, TComPic*& rpcPic )
   while (iterPic != m_cListPic.end())
   {
     rpcPic = *(iterPic++);
+    if ( xIsPicInUse( rpcPic ) )
+    {
+      continue;
+    }
     if ( rpcPic->getReconMark() == false && rpcPic->getOutputMark() == false)
     {
       rpcPic->setOutputMark(false);
@@ -185,6 +247,79 @@ Void TDecTop::xGetNewPicBuffer ( TComSlice* pcSlice, TComPic*& rpcPic )
   rpcPic->destroy();
   rpcPic->create ( pcSlice->getSPS()->getPicWidthInLumaSamples(), pcSlice->getSPS()->getPicHeightInLumaSamples(), pcSlice->getSPS()->getChromaFormatIdc(), g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth,
                    conformanceWindow, defaultDisplayWindow, numReorderPics, true);
+  xInitPicProgress( rpcPic );
+}
+
+/** reset the reconstruction progress of a picture buffer about to be decoded into. With frame-parallel decoding, the
+ * border of the picture is marked as extended so that TComSlice::setRefPicList does not pad it while it is decoded;
+ * the GOP decoder pads its CTU rows as they are filtered.
+ * \param pcPic  picture buffer
+ */
+Void TDecTop::xInitPicProgress( TComPic* pcPic )
+{
+  pcPic->getReconRowProgressCounter()->setThreadPool( getThreadPool() );
+  pcPic->setReconRowProgress( 0 );
+  if ( m_iNumPicWorkers > 0 )
+  {
+    pcPic->getPicYuvRec()->setBorderExtension( true );
+  }
+}
+
+/** \param pcPic  picture of the picture buffer
+ * \returns true if the picture is being decoded by a picture worker or waits to be finished by finishPictures(), or
+ *          if it is a reference picture of such a picture
+ */
+Bool TDecTop::xIsPicInUse( TComPic* pcPic )
+{
+  for ( Int i = 0; i < m_iNumBusyPicWorkers; i++ )
+  {
+    TComPic* pcBusyPic = m_pcPicWorkers[( m_iFirstBusyPicWorker + i ) % m_iNumPicWorkers].getPic();
+    if ( pcBusyPic == pcPic )
+    {
+      return true;
+    }
+    for ( UInt uiSliceIdx = 0; uiSliceIdx < pcBusyPic->getNumAllocatedSlice(); uiSliceIdx++ )
+    {
+      TComSlice* pcSlice = pcBusyPic->getSlice( uiSliceIdx );
+      for ( UInt refList = 0; refList < NUM_REF_PIC_LIST_01 && !pcSlice->isIntra(); refList++ )
+      {
+        for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( RefPicList( refList ) ); iRefIdx++ )
+        {
+          if ( pcSlice->getRefPic( RefPicList( refList ), iRefIdx ) == pcPic )
+          {
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/** wait for the oldest picture being decoded, then print its status line and mark it for output in decoding order
+ */
+Void TDecTop::xRetirePicWorker()
+{
+  TDecPicWorker* pcWorker = &m_pcPicWorkers[m_iFirstBusyPicWorker];
+  assert( pcWorker != m_pcCurrPicWorker );
+
+  m_cThreadPool.wait( pcWorker->getTaskGroup() );
+  pcWorker->finishPicture();
+
+  m_iFirstBusyPicWorker = ( m_iFirstBusyPicWorker + 1 ) % m_iNumPicWorkers;
+  m_iNumBusyPicWorkers--;
+}
+
+/** Finish all pictures handed to the picture workers. The pictures are finished in decoding order, the picture whose
+ * slices are being collected is not affected. To be called before the pictures are output without bumping, and
+ * whenever the decoder changes state that the pictures being decoded depend on.
+ */
+Void TDecTop::finishPictures()
+{
+  while ( m_iNumBusyPicWorkers > 0 && &m_pcPicWorkers[m_iFirstBusyPicWorker] != m_pcCurrPicWorker )
+  {
+    xRetirePicWorker();
+  }
 }
 
 Void TDecTop::executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic)
@@ -197,14 +332,35 @@ Void TDecTop::executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic)
 
   TComPic*   pcPic         = m_pcPic;
 
-  // Execute Deblock + Cleanup
+  if ( m_iNumPicWorkers > 0 )
+  {
+    // hand the picture to its worker, and finish the pictures that are already decoded
+    if ( m_pcCurrPicWorker )
+    {
+      m_cThreadPool.submit( m_pcCurrPicWorker, m_pcCurrPicWorker->getTaskGroup() );
+      m_pcCurrPicWorker = NULL;
+    }
+    while ( m_iNumBusyPicWorkers > 0 )
+    {
+      TComPic* pcOldestPic = m_pcPicWorkers[m_iFirstBusyPicWorker].getPic();
+      if ( pcOldestPic->getReconRowProgress() < pcOldestPic->getFrameHeightInCtus() )
+      {
+        break;
+      }
+      xRetirePicWorker();
+    }
+  }
+  else
+  {
+    // Execute Deblock + Cleanup
 
-  m_cGopDecoder.filterPicture(pcPic);
+    m_cGopDecoder.filterPicture(pcPic);
+    m_cCuDecoder.destroy();
+  }
 
   TComSlice::sortPicList( m_cListPic ); // sorting for application output
   poc                 = pcPic->getSlice(m_uiSliceIdx-1)->getPOC();
   rpcListPic          = &m_cListPic;
-  m_cCuDecoder.destroy();
   m_bFirstSliceInPicture  = true;
 
   return;
@@ -228,6 +384,9 @@ Void TDecTop::checkNoOutputPriorPics (TComList<TComPic*>* pcListPic)
 
 Void TDecTop::xCreateLostPicture(Int iLostPoc)
 {
+  // the copied picture may be one that is being decoded
+  finishPictures();
+
   printf("\ninserting lost poc : %d\n",iLostPoc);
   TComSlice cFillSlice;
   cFillSlice.setSPS( m_parameterSetManagerDecoder.getFirstSPS() );
@@ -269,6 +428,8 @@ Void TDecTop::xCreateLostPicture(Int iLostPoc)
   cFillPic->getSlice(0)->setPOC(iLostPoc);
   cFillPic->setReconMark(true);
   cFillPic->setOutputMark(true);
+  cFillPic->getPicYuvRec()->setBorderExtension(false);
+  cFillPic->setReconRowProgress(cFillPic->getFrameHeightInCtus());
   if(m_pocRandomAccess == MAX_INT)
   {
     m_pocRandomAccess = iLostPoc;
@@ -278,6 +439,12 @@ Void TDecTop::xCreateLostPicture(Int iLostPoc)
 
 Void TDecTop::xActivateParameterSets()
 {
+  // parameter sets replaced by newly received ones are deleted, and a new SPS changes the global CTU size and bit
+  // depths: the pictures being decoded have to be finished first
+  if ( m_parameterSetManagerDecoder.hasPrefetchedPS() )
+  {
+    finishPictures();
+  }
   m_parameterSetManagerDecoder.applyPrefetchedPS();
 
   TComPPS *pps = m_parameterSetManagerDecoder.getPPS(m_apcSlicePilot->getPPSId());
@@ -286,6 +453,11 @@ Void TDecTop::xActivateParameterSets()
   TComSPS *sps = m_parameterSetManagerDecoder.getSPS(pps->getSPSId());
   assert (sps != 0);
 
+  if ( sps != m_parameterSetManagerDecoder.getActiveSPS() )
+  {
+    finishPictures();
+  }
+
   if (false == m_parameterSetManagerDecoder.activatePPS(m_apcSlicePilot->getPPSId(),m_apcSlicePilot->isIRAP()))
   {
     printf ("Parameter set activation failed!");
@@ -460,6 +632,13 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
   // actual decoding starts here
   xActivateParameterSets();
 
+  // the long-term marking of the reference pictures is updated with each picture, while the pictures being decoded
+  // depend on it
+  if ( m_bFirstSliceInPicture && m_apcSlicePilot->getSPS()->getLongTermRefsPresent() )
+  {
+    finishPictures();
+  }
+
   if (!m_apcSlicePilot->getDependentSliceSegmentFlag())
   {
     m_prevPOC = m_apcSlicePilot->getPOC();
@@ -477,7 +656,11 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     // Buffer initialize for prediction.
     m_cPrediction.initTempBuff(m_apcSlicePilot->getSPS()->getChromaFormatIdc());
     m_apcSlicePilot->applyReferencePictureSet(m_cListPic, m_apcSlicePilot->getRPS());
-    //  Get a new picture buffer
+    //  Get a new picture buffer, with a free picture worker when decoding frame-parallel
+    if ( m_iNumPicWorkers > 0 && m_iNumBusyPicWorkers == m_iNumPicWorkers )
+    {
+      xRetirePicWorker();
+    }
     xGetNewPicBuffer (m_apcSlicePilot, m_pcPic);
 
     Bool isField = false;
@@ -503,12 +686,21 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     m_pcPic->setSEIs(m_SEIs);
     m_SEIs.clear();
 
-    // Recursive structure
-    m_cCuDecoder.create ( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight, m_apcSlicePilot->getSPS()->getChromaFormatIdc() );
-    m_cCuDecoder.init   ( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
-    m_cTrQuant.init     ( g_uiMaxCUWidth, g_uiMaxCUHeight, m_apcSlicePilot->getSPS()->getMaxTrSize());
+    if ( m_iNumPicWorkers > 0 )
+    {
+      m_pcCurrPicWorker = &m_pcPicWorkers[( m_iFirstBusyPicWorker + m_iNumBusyPicWorkers ) % m_iNumPicWorkers];
+      m_iNumBusyPicWorkers++;
+      m_pcCurrPicWorker->setPicture( m_pcPic, m_apcSlicePilot );
+    }
+    else
+    {
+      // Recursive structure
+      m_cCuDecoder.create ( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight, m_apcSlicePilot->getSPS()->getChromaFormatIdc() );
+      m_cCuDecoder.init   ( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
+      m_cTrQuant.init     ( g_uiMaxCUWidth, g_uiMaxCUHeight, m_apcSlicePilot->getSPS()->getMaxTrSize());
 
-    m_cSliceDecoder.create();
+      m_cSliceDecoder.create();
+    }
   }
   else
   {
@@ -627,7 +819,14 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
   }
 
   //  Decode a picture
-  m_cGopDecoder.decompressSlice(nalu.m_Bitstream, m_pcPic);
+  if ( m_pcCurrPicWorker )
+  {
+    m_pcCurrPicWorker->addSliceSegment(nalu.m_Bitstream);
+  }
+  else
+  {
+    m_cGopDecoder.decompressSlice(nalu.m_Bitstream, m_pcPic);
+  }
 
   m_bFirstSliceInPicture = false;
   m_uiSliceIdx++;
@@ -674,6 +873,10 @@ Void TDecTop::xDecodeSEI( TComInputBitstream* bs, const NalUnitType nalUnitType
     if (activeParamSets.size()>0)
     {
       SEIActiveParameterSets *seiAps = (SEIActiveParameterSets*)(*activeParamSets.begin());
+      if ( m_parameterSetManagerDecoder.hasPrefetchedPS() )
+      {
+        finishPictures();
+      }
       m_parameterSetManagerDecoder.applyPrefetchedPS();
       assert(seiAps->activeSeqParameterSetId.size()>0);
       if (! m_parameterSetManagerDecoder.activateSPSWithSEI(seiAps->activeSeqParameterSetId[0] ))
@@ -44,8 +44,10 @@
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/SEI.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TDecGop.h"
+#include "TDecPicWorker.h"
 #include "TDecEntropy.h"
 #include "TDecSbac.h"
 #include "TDecCAVLC.h"
@@ -89,6 +91,17 @@ private:
   SEIReader               m_seiReader;
   TComLoopFilter          m_cLoopFilter;
   TComSampleAdaptiveOffset m_cSAO;
+  Int                     m_iNumThreads;      ///< number of threads, including the calling thread
+  TComThreadPool          m_cThreadPool;      ///< thread pool shared by the decoder stages
+
+  // frame-parallel decoding
+  Int                     m_iNumFrameThreads; ///< number of pictures decoded concurrently
+  Int                     m_iSimdLevel;       ///< instruction set of the SIMD kernels, -1 for the highest supported one
+  TDecPicWorker*          m_pcPicWorkers;     ///< picture workers, used in turn for the pictures in decoding order
+  Int                     m_iNumPicWorkers;   ///< number of picture workers, 0 when the pictures are decoded one after the other
+  Int                     m_iFirstBusyPicWorker; ///< worker of the oldest picture that has not been finished
+  Int                     m_iNumBusyPicWorkers;  ///< number of pictures that have not been finished
+  TDecPicWorker*          m_pcCurrPicWorker;  ///< worker collecting the slice segments of the current picture
 
   Bool isSkipPictureForBLA(Int& iPOCLastDisplay);
   Bool isRandomAccessSkipPicture(Int& iSkipFrame,  Int& iPOCLastDisplay);
@@ -115,9 +128,14 @@ public:
   Void  create  ();
   Void  destroy ();
 
-  Void setDecodedPictureHashSEIEnabled(Int enabled) { m_cGopDecoder.setDecodedPictureHashSEIEnabled(enabled); }
+  Void setDecodedPictureHashSEIEnabled(Int enabled);
 
   Void  init();
+  Void  setNumThreads(Int numThreads) { m_iNumThreads = numThreads; }   ///< to be called before init()
+  Void  setNumFrameThreads(Int numFrameThreads) { m_iNumFrameThreads = numFrameThreads; }   ///< to be called before init()
+  Void  setSimdLevel(Int simdLevel) { m_iSimdLevel = simdLevel; }   ///< to be called before init()
+  /// thread pool shared by the decoder stages, NULL when running single-threaded
+  TComThreadPool* getThreadPool() { return m_cThreadPool.getNumThreads() > 0 ? &m_cThreadPool : NULL; }
   Bool  decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay);
   Void  deletePicBuffer();
 
@@ -126,6 +144,7 @@ public:
 
 
   Void  executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic);
+  Void  finishPictures    ();
   Void  checkNoOutputPriorPics (TComList<TComPic*>* rpcListPic);
 
   Bool  getNoOutputPriorPicsFlag () { return m_isNoOutputPriorPics; }
@@ -142,6 +161,10 @@ protected:
   Void  xGetNewPicBuffer  (TComSlice* pcSlice, TComPic*& rpcPic);
   Void  xCreateLostPicture (Int iLostPOC);
 
+  Void  xInitPicProgress  (TComPic* pcPic);
+  Bool  xIsPicInUse       (TComPic* pcPic);
+  Void  xRetirePicWorker  ();
+
   Void      xActivateParameterSets();
   Bool      xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisplay);
   Void      xDecodeVPS();
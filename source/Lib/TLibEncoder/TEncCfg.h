@@ -195,8 +195,16 @@ protected:
   Bool      m_useRDOQTS;
   UInt      m_rdPenalty;
   Bool      m_bUseReducedRegionSimilarityPartitioning; // RRSP
+  Bool      m_bUseRRSP16x16;
   Bool      m_bUseSimilarityBasedDecision;
   UInt      m_uiR;
+  Int       m_SBDColocatedRef;
+  Bool      m_bSBDColocatedMerge;
+  Bool      m_bUseSBDIntra;
+  UInt      m_uiSBDIntraHighSim;
+  UInt      m_uiSBDIntraLowSim;
+  UInt      m_uiSBDShadowPeriod;                      ///< SBD shadow mode period, 0: off
+  Char*     m_pchSBDShadowFile;                       ///< CSV file of the SBD shadow mode
   Bool      m_bUseFastEnc;
   Bool      m_bUseEarlyCU;
   Bool      m_useFastDecisionForMerge;
@@ -242,6 +250,10 @@ protected:
 
   Int       m_iWaveFrontSynchro;
   Int       m_iWaveFrontSubstreams;
+  Int       m_numThreads;                                ///< number of threads used for CTU compression
+  Int       m_numFrameThreads;                           ///< number of pictures of a GOP compressed at the same time
+  Bool      m_bIncrementalLoopFilter;                    ///< deblock and collect SAO statistics CTU row by row while the picture is compressed
+  Int       m_simdLevel;                                 ///< instruction set of the SIMD kernels, -1 for the highest supported (see SimdLevel)
 
   Int       m_decodedPictureHashSEIEnabled;              ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   Int       m_bufferingPeriodSEIEnabled;
@@ -504,6 +516,7 @@ public:
   //==== Motion search ========
   Int       getFastSearch                   ()      { return  m_iFastSearch; }
   Int       getSearchRange                  ()      { return  m_iSearchRange; }
+  Int       getBipredSearchRange            ()      { return  m_bipredSearchRange; }
 
   //==== Quality control ========
   Int       getMaxDeltaQP                   ()      { return  m_iMaxDeltaQP; }
@@ -518,8 +531,16 @@ public:
   Void      setUseRDOQTS                    ( Bool  b )     { m_useRDOQTS  = b; }
   Void      setRDpenalty                    ( UInt  b )     { m_rdPenalty  = b; }
   Void      setUseRRSP                      ( Bool  b )     { m_bUseReducedRegionSimilarityPartitioning = b; }
+  Void      setUseRRSP16x16                 ( Bool  b )     { m_bUseRRSP16x16 = b; }
   Void      setUseSBD                       ( Bool  b )     { m_bUseSimilarityBasedDecision = b; }
   Void      setR                            ( UInt  r )     { m_uiR = r; }
+  Void      setSBDColocatedRef              ( Int   i )     { m_SBDColocatedRef = i; }
+  Void      setSBDColocatedMerge            ( Bool  b )     { m_bSBDColocatedMerge = b; }
+  Void      setUseSBDIntra                  ( Bool  b )     { m_bUseSBDIntra = b; }
+  Void      setSBDIntraHighSim              ( UInt  u )     { m_uiSBDIntraHighSim = u; }
+  Void      setSBDIntraLowSim               ( UInt  u )     { m_uiSBDIntraLowSim = u; }
+  Void      setSBDShadowPeriod              ( UInt  u )     { m_uiSBDShadowPeriod = u; }
+  Void      setSBDShadowFile                ( Char* pch )   { m_pchSBDShadowFile = pch; }
   Void      setUseFastEnc                   ( Bool  b )     { m_bUseFastEnc = b; }
   Void      setUseEarlyCU                   ( Bool  b )     { m_bUseEarlyCU = b; }
   Void      setUseFastDecisionForMerge      ( Bool  b )     { m_useFastDecisionForMerge = b; }
@@ -539,8 +560,16 @@ public:
   Bool      getUseRDOQTS                    ()      { return m_useRDOQTS;  }
   Int       getRDpenalty                    ()      { return m_rdPenalty;  }
   Bool      getUseRRSP                      ()      { return m_bUseReducedRegionSimilarityPartitioning; }
+  Bool      getUseRRSP16x16                 ()      { return m_bUseRRSP16x16; }
   Bool      getUseSBD                       ()      { return m_bUseSimilarityBasedDecision; }
   UInt      getR                            ()      { return m_uiR; }
+  Int       getSBDColocatedRef              ()      { return m_SBDColocatedRef; }
+  Bool      getSBDColocatedMerge            ()      { return m_bSBDColocatedMerge; }
+  Bool      getUseSBDIntra                  ()      { return m_bUseSBDIntra; }
+  UInt      getSBDIntraHighSim              ()      { return m_uiSBDIntraHighSim; }
+  UInt      getSBDIntraLowSim               ()      { return m_uiSBDIntraLowSim; }
+  UInt      getSBDShadowPeriod              ()      { return m_uiSBDShadowPeriod; }
+  Char*     getSBDShadowFile                ()      { return m_pchSBDShadowFile; }
   Bool      getUseFastEnc                   ()      { return m_bUseFastEnc; }
   Bool      getUseEarlyCU                   ()      { return m_bUseEarlyCU; }
   Bool      getUseFastDecisionForMerge      ()      { return m_useFastDecisionForMerge; }
@@ -558,6 +587,7 @@ public:
   Bool      getUseReconBasedCrossCPredictionEstimate ()                const { return m_reconBasedCrossCPredictionEstimate;  }
   Void      setUseReconBasedCrossCPredictionEstimate (const Bool value)      { m_reconBasedCrossCPredictionEstimate = value; }
   Void      setSaoOffsetBitShift(ChannelType type, UInt uiBitShift)          { m_saoOffsetBitShift[type] = uiBitShift; }
+  UInt      getSaoOffsetBitShift(ChannelType type)                     const { return m_saoOffsetBitShift[type]; }
 
   Bool getUseTransformSkip                             ()      { return m_useTransformSkip;        }
   Void setUseTransformSkip                             ( Bool b ) { m_useTransformSkip  = b;       }
@@ -617,6 +647,14 @@ public:
   Int   getWaveFrontsynchro()                                        { return m_iWaveFrontSynchro; }
   Void  setWaveFrontSubstreams(Int iWaveFrontSubstreams)             { m_iWaveFrontSubstreams = iWaveFrontSubstreams; }
   Int   getWaveFrontSubstreams()                                     { return m_iWaveFrontSubstreams; }
+  Void  setNumThreads(Int numThreads)                                { m_numThreads = numThreads; }
+  Int   getNumThreads()                                              { return m_numThreads; }
+  Void  setNumFrameThreads(Int numFrameThreads)                      { m_numFrameThreads = numFrameThreads; }
+  Int   getNumFrameThreads()                                         { return m_numFrameThreads; }
+  Void  setIncrementalLoopFilter(Bool b)                             { m_bIncrementalLoopFilter = b; }
+  Bool  getIncrementalLoopFilter()                                   { return m_bIncrementalLoopFilter; }
+  Void  setSimdLevel(Int simdLevel)                                  { m_simdLevel = simdLevel; }
+  Int   getSimdLevel()                                               { return m_simdLevel; }
   Void  setDecodedPictureHashSEIEnabled(Int b)                       { m_decodedPictureHashSEIEnabled = b; }
   Int   getDecodedPictureHashSEIEnabled()                            { return m_decodedPictureHashSEIEnabled; }
   Void  setBufferingPeriodSEIEnabled(Int b)                          { m_bufferingPeriodSEIEnabled = b; }
@@ -0,0 +1,189 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncCtuWorker.cpp
+    \brief    per-thread CTU encoder used for parallel CTU compression
+*/
+
+#include "TEncCtuWorker.h"
+#include "TEncTop.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncCtuWorker::TEncCtuWorker()
+: m_pppcRDSbacCoder  ( NULL )
+, m_pppcBinCoderCABAC( NULL )
+, m_uiTotalBits      ( 0 )
+, m_uiTotalDist      ( 0 )
+, m_dTotalCost       ( 0 )
+, m_uiWrittenBits    ( 0 )
+{
+}
+
+TEncCtuWorker::~TEncCtuWorker()
+{
+}
+
+/** create the CTU analysis engine of this worker with the same settings as the main encoder
+ * \param pcEncTop        encoder the settings are taken from
+ */
+Void TEncCtuWorker::create( TEncTop* pcEncTop )
+{
+  m_cRDGoOnSbacCoder.init( &m_cRDGoOnBinCoderCABAC );
+
+  m_pppcRDSbacCoder = new TEncSbac** [g_uiMaxCUDepth+1];
+#if FAST_BIT_EST
+  m_pppcBinCoderCABAC = new TEncBinCABACCounter** [g_uiMaxCUDepth+1];
+#else
+  m_pppcBinCoderCABAC = new TEncBinCABAC** [g_uiMaxCUDepth+1];
+#endif
+
+  for ( Int iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ )
+  {
+    m_pppcRDSbacCoder[iDepth] = new TEncSbac* [CI_NUM];
+#if FAST_BIT_EST
+    m_pppcBinCoderCABAC[iDepth] = new TEncBinCABACCounter* [CI_NUM];
+#else
+    m_pppcBinCoderCABAC[iDepth] = new TEncBinCABAC* [CI_NUM];
+#endif
+
+    for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+    {
+      m_pppcRDSbacCoder[iDepth][iCIIdx] = new TEncSbac;
+#if FAST_BIT_EST
+      m_pppcBinCoderCABAC [iDepth][iCIIdx] = new TEncBinCABACCounter;
+#else
+      m_pppcBinCoderCABAC [iDepth][iCIIdx] = new TEncBinCABAC;
+#endif
+      m_pppcRDSbacCoder   [iDepth][iCIIdx]->init( m_pppcBinCoderCABAC [iDepth][iCIIdx] );
+    }
+  }
+
+  m_cCuEncoder.create( g_uiMaxCUDepth, g_uiMaxCUWidth, g_uiMaxCUHeight, pcEncTop->getChromaFormatIdc() );
+
+  m_cTrQuant.init( 1 << pcEncTop->getQuadtreeTULog2MaxSize(),
+                   pcEncTop->getUseRDOQ(),
+                   pcEncTop->getUseRDOQTS(),
+                   true
+                  ,pcEncTop->getUseTransformSkipFast()
+#if ADAPTIVE_QP_SELECTION
+                  ,pcEncTop->getUseAdaptQpSelect()
+#endif
+                  );
+
+  m_cSearch.init( pcEncTop, &m_cTrQuant, pcEncTop->getSearchRange(), pcEncTop->getBipredSearchRange(), pcEncTop->getFastSearch(), 0,
+                  &m_cEntropyCoder, &m_cRdCost, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder );
+
+  m_cCuEncoder.init( pcEncTop, &m_cSearch, &m_cTrQuant, &m_cRdCost, &m_cEntropyCoder, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder, pcEncTop->getRateCtrl() );
+  m_cCuEncoder.setSBDShadow( pcEncTop->getSBDShadow() );
+}
+
+Void TEncCtuWorker::destroy()
+{
+  m_cCuEncoder.destroy();
+
+  if ( m_pppcRDSbacCoder == NULL )
+  {
+    return;
+  }
+
+  for ( Int iDepth = 0; iDepth < g_uiMaxCUDepth+1; iDepth++ )
+  {
+    for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+    {
+      delete m_pppcRDSbacCoder[iDepth][iCIIdx];
+      delete m_pppcBinCoderCABAC[iDepth][iCIIdx];
+    }
+    delete [] m_pppcRDSbacCoder[iDepth];
+    delete [] m_pppcBinCoderCABAC[iDepth];
+  }
+
+  delete [] m_pppcRDSbacCoder;
+  delete [] m_pppcBinCoderCABAC;
+  m_pppcRDSbacCoder   = NULL;
+  m_pppcBinCoderCABAC = NULL;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** the lambdas and chroma weights are copied from the main RD cost class, the scaling lists are set up the same way as TEncGOP does for the main encoder
+ * \param pcSlice   slice to be compressed
+ * \param pcRdCost  RD cost class of the main encoder
+ * \param pcEncCfg  encoder configuration
+ */
+Void TEncCtuWorker::initSlice( TComSlice* pcSlice, TComRdCost* pcRdCost, TEncCfg* pcEncCfg )
+{
+  m_cRdCost = *pcRdCost;
+
+#if RDOQ_CHROMA_LAMBDA
+  m_cTrQuant.setLambdas( pcSlice->getLambdas() );
+#else
+  m_cTrQuant.setLambda( pcSlice->getLambdas()[0] );
+#endif
+
+  if ( pcEncCfg->getUseScalingListId() == SCALING_LIST_OFF )
+  {
+    m_cTrQuant.setFlatScalingList( pcSlice->getSPS()->getChromaFormatIdc() );
+    m_cTrQuant.setUseScalingList( false );
+  }
+  else
+  {
+    m_cTrQuant.setScalingList( pcSlice->getScalingList(), pcSlice->getSPS()->getChromaFormatIdc() );
+    m_cTrQuant.setUseScalingList( true );
+  }
+
+  m_uiTotalBits   = 0;
+  m_uiTotalDist   = 0;
+  m_dTotalCost    = 0;
+  m_uiWrittenBits = 0;
+}
+
+/** \param pCtu           compressed CTU
+ * \param uiWrittenBits  number of bits of the RD encode of the CTU
+ */
+Void TEncCtuWorker::addCtuStatistics( TComDataCU* pCtu, UInt uiWrittenBits )
+{
+  m_uiTotalBits   += pCtu->getTotalBits();
+  m_uiTotalDist   += pCtu->getTotalDistortion();
+  m_dTotalCost    += pCtu->getTotalCost();
+  m_uiWrittenBits += uiWrittenBits;
+}
+
+//! \}
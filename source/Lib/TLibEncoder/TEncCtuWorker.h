@@ -0,0 +1,121 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncCtuWorker.h
+    \brief    per-thread CTU encoder used for parallel CTU compression (header)
+*/
+
+#ifndef __TENCCTUWORKER__
+#define __TENCCTUWORKER__
+
+// Include files
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComBitCounter.h"
+#include "TLibCommon/TComRdCost.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TEncCu.h"
+#include "TEncSearch.h"
+#include "TEncEntropy.h"
+#include "TEncSbac.h"
+#include "TEncBinCoderCABACCounter.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+class TEncTop;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// private copy of the CTU analysis engine (CU encoder, search, transform and RD SBAC coders) for one thread
+class TEncCtuWorker
+{
+private:
+  // processing units
+  TEncCu                  m_cCuEncoder;                   ///< CU encoder
+  TEncSearch              m_cSearch;                      ///< encoder search class
+  TComTrQuant             m_cTrQuant;                     ///< transform & quantization class
+  TEncEntropy             m_cEntropyCoder;                ///< entropy encoder
+  TComBitCounter          m_cBitCounter;                  ///< bit counter used for the RD encode of each CTU
+
+  // RD cost computation
+  TComRdCost              m_cRdCost;                      ///< RD cost computation class
+  TEncSbac***             m_pppcRDSbacCoder;              ///< temporal storage for RD computation
+  TEncSbac                m_cRDGoOnSbacCoder;             ///< going on SBAC model for RD stage
+  TEncSbac                m_cEntropyCodingSyncContextState; ///< contexts after the second CTU of a tile-row, used for wavefronts inside a tile
+#if FAST_BIT_EST
+  TEncBinCABACCounter***  m_pppcBinCoderCABAC;            ///< temporal CABAC state storage for RD computation
+  TEncBinCABACCounter     m_cRDGoOnBinCoderCABAC;         ///< going on bin coder CABAC for RD stage
+#else
+  TEncBinCABAC***         m_pppcBinCoderCABAC;            ///< temporal CABAC state storage for RD computation
+  TEncBinCABAC            m_cRDGoOnBinCoderCABAC;         ///< going on bin coder CABAC for RD stage
+#endif
+
+  // statistics of the CTUs compressed by this worker in the current slice
+  UInt64                  m_uiTotalBits;
+  UInt64                  m_uiTotalDist;
+  Double                  m_dTotalCost;
+  UInt                    m_uiWrittenBits;                ///< bits of the RD encode, added to the slice bit counts
+
+public:
+  TEncCtuWorker();
+  virtual ~TEncCtuWorker();
+
+  Void  create            ( TEncTop* pcEncTop );
+  Void  destroy           ();
+
+  /// copy the slice-level coding state (lambdas, weights, scaling lists) of the main encoder into this worker
+  Void  initSlice         ( TComSlice* pcSlice, TComRdCost* pcRdCost, TEncCfg* pcEncCfg );
+  /// add the results of one compressed CTU to the statistics of this worker
+  Void  addCtuStatistics  ( TComDataCU* pCtu, UInt uiWrittenBits );
+
+  TEncCu*                 getCuEncoder          () { return &m_cCuEncoder;    }
+  TEncSearch*             getPredSearch         () { return &m_cSearch;       }
+  TComTrQuant*            getTrQuant            () { return &m_cTrQuant;      }
+  TEncEntropy*            getEntropyCoder       () { return &m_cEntropyCoder; }
+  TComBitCounter*         getBitCounter         () { return &m_cBitCounter;   }
+  TComRdCost*             getRdCost             () { return &m_cRdCost;       }
+  TEncSbac***             getRDSbacCoder        () { return m_pppcRDSbacCoder;     }
+  TEncSbac*               getRDGoOnSbacCoder    () { return &m_cRDGoOnSbacCoder;   }
+  TEncSbac*               getSyncContextState   () { return &m_cEntropyCodingSyncContextState; }
+
+  UInt64                  getTotalBits          () const { return m_uiTotalBits;   }
+  UInt64                  getTotalDistortion    () const { return m_uiTotalDist;   }
+  Double                  getTotalCost          () const { return m_dTotalCost;    }
+  UInt                    getWrittenBits        () const { return m_uiWrittenBits; }
+};
+
+//! \}
+
+#endif // __TENCCTUWORKER__
@@ -40,6 +40,7 @@
 #include "TEncCu.h"
 #include "TEncAnalyze.h"
 #include "TLibCommon/Debug.h"
+#include "TLibCommon/TComThread.h"
 
 #include <cmath>
 #include <algorithm>
@@ -72,6 +73,8 @@ Void TEncCu::create(UChar uhTotalDepth, UInt uiMaxWidth, UInt uiMaxHeight, Chrom
   m_bAdoptedByC         = new Bool[m_uhTotalDepth - 1];
   m_bAdoptedByColocated = new Bool[m_uhTotalDepth - 1];
   m_uiSizeAlpha         = 0;
+  m_bSBDActive          = false;
+  m_bRRSPGrandfatherInUse = false;
   
   // m_bRRSPAdoptedDepths64x64ByA structure
   // *---*---*---*---* 
@@ -89,6 +92,10 @@ Void TEncCu::create(UChar uhTotalDepth, UInt uiMaxWidth, UInt uiMaxHeight, Chrom
   m_bReducedRangeDepths             = new Bool[m_uhTotalDepth - 2];
   m_RRSPNumOfCTUsInA                = 0;
   m_RRSPNumOfCTUsInB                = 0;
+  m_bRRSPActive                     = false;
+
+  m_bShadowRangeDepths = new Bool[m_uhTotalDepth - 1];
+  m_puhShadowDepths    = new UChar[1 << ((m_uhTotalDepth - 1) << 1)];
 
   m_ppcPredYuvBest = new TComYuv*[m_uhTotalDepth-1];
   m_ppcResiYuvBest = new TComYuv*[m_uhTotalDepth-1];
@@ -242,6 +249,17 @@ Void TEncCu::destroy()
     delete[] m_bReducedRangeDepths;
     m_bReducedRangeDepths = NULL;
   }
+  // SBD shadow mode
+  if (m_bShadowRangeDepths)
+  {
+    delete[] m_bShadowRangeDepths;
+    m_bShadowRangeDepths = NULL;
+  }
+  if (m_puhShadowDepths)
+  {
+    delete[] m_puhShadowDepths;
+    m_puhShadowDepths = NULL;
+  }
 
   if(m_ppcPredYuvBest)
   {
@@ -284,18 +302,39 @@ Void TEncCu::destroy()
  */
 Void TEncCu::init( TEncTop* pcEncTop )
 {
-  m_pcEncCfg           = pcEncTop;
-  m_pcPredSearch       = pcEncTop->getPredSearch();
-  m_pcTrQuant          = pcEncTop->getTrQuant();
-  m_pcRdCost           = pcEncTop->getRdCost();
+  init( pcEncTop, pcEncTop->getPredSearch(), pcEncTop->getTrQuant(), pcEncTop->getRdCost(),
+        pcEncTop->getEntropyCoder(), pcEncTop->getRDSbacCoder(), pcEncTop->getRDGoOnSbacCoder(), pcEncTop->getRateCtrl() );
 
-  m_pcEntropyCoder     = pcEncTop->getEntropyCoder();
   m_pcBinCABAC         = pcEncTop->getBinCABAC();
+  m_pcSBDShadow        = pcEncTop->getSBDShadow();
+}
+
+/** \param    pcEncCfg           encoder configuration
+ \param    pcPredSearch       encoder search class
+ \param    pcTrQuant          transform & quantization class
+ \param    pcRdCost           RD cost computation class
+ \param    pcEntropyCoder     entropy encoder
+ \param    pppcRDSbacCoder    SBAC coders for RD computation
+ \param    pcRDGoOnSbacCoder  going on SBAC coder for RD computation
+ \param    pcRateCtrl         rate control manager
+ */
+Void TEncCu::init( TEncCfg* pcEncCfg, TEncSearch* pcPredSearch, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost,
+                   TEncEntropy* pcEntropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder, TEncRateCtrl* pcRateCtrl )
+{
+  m_pcEncCfg           = pcEncCfg;
+  m_pcPredSearch       = pcPredSearch;
+  m_pcTrQuant          = pcTrQuant;
+  m_pcRdCost           = pcRdCost;
+
+  m_pcEntropyCoder     = pcEntropyCoder;
+  m_pcBinCABAC         = NULL;
+
+  m_pppcRDSbacCoder    = pppcRDSbacCoder;
+  m_pcRDGoOnSbacCoder  = pcRDGoOnSbacCoder;
 
-  m_pppcRDSbacCoder    = pcEncTop->getRDSbacCoder();
-  m_pcRDGoOnSbacCoder  = pcEncTop->getRDGoOnSbacCoder();
+  m_pcRateCtrl         = pcRateCtrl;
 
-  m_pcRateCtrl         = pcEncTop->getRateCtrl();
+  m_pcSBDShadow        = NULL;
 }
 
 // ====================================================================================================================
@@ -310,7 +349,22 @@ Void TEncCu::compressCtu( TComDataCU* pCtu )
   m_ppcBestCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
   m_ppcTempCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
 
-  if ( pCtu->getSlice()->getSliceType() != I_SLICE && m_pcEncCfg->getUseSBD() )
+  TEncSBDShadow::SimLevel eSimLevel = TEncSBDShadow::SIM_LOW;
+  Bool bShadow = false;
+  const Bool bIntraSlice = pCtu->getSlice()->getSliceType() == I_SLICE;
+  // without a colocated CTU (no reference picture to take it from), SBD in an inter slice and RRSP keep the full range
+  const Bool bColocated  = !bIntraSlice && getColocatedCtu(pCtu) != NULL;
+  m_bSBDActive  = m_pcEncCfg->getUseSBD() && ( bIntraSlice ? m_pcEncCfg->getUseSBDIntra() : bColocated );
+  m_bRRSPActive = m_pcEncCfg->getUseRRSP() && bColocated;
+  if ( m_bSBDActive && bIntraSlice )
+    // spatial-only Similarity Based Decision in an intra slice, there is no colocated CTU
+  {
+    buildSpatialGroupAlpha(pCtu);
+    initRangeDepths();
+
+    eSimLevel = performIntraSim();
+  }
+  else if ( m_bSBDActive )
     // Similiarity Based Decision turned on and not an intra frame
   {
     buildGroupAlpha(pCtu);
@@ -320,27 +374,50 @@ Void TEncCu::compressCtu( TComDataCU* pCtu )
     if (simLevel == 1) // high similarity
     {
       performHighSim(pCtu);
+      eSimLevel = TEncSBDShadow::SIM_HIGH;
     }
     else if (simLevel == m_uhTotalDepth - 1) // low
     {
       performLowSim();
+      eSimLevel = TEncSBDShadow::SIM_LOW;
     }
     else if (simLevel == m_uhTotalDepth - 2) // medium-low
     {
       performMediumLowSim();
+      eSimLevel = TEncSBDShadow::SIM_MEDIUM_LOW;
     }
     else // medium-high
     {
       performMediumHighSim(pCtu);
+      eSimLevel = TEncSBDShadow::SIM_MEDIUM_HIGH;
     }
   }
 
+  if ( m_bSBDActive && m_pcSBDShadow != NULL && m_pcEncCfg->getSBDShadowPeriod() > 0 )
+  {
+    bShadow = m_pcSBDShadow->addCtu( eSimLevel, m_pcEncCfg->getSBDShadowPeriod() );
+  }
+
+  // SBD shadow mode: the CTU is compressed with the full depth range first, the SBD restricted search below decides
+  Double dFullTime = 0;
+  Double dFullCost = 0;
+  if ( bShadow )
+  {
+    xCompressCtuFullRange( pCtu, dFullTime, dFullCost );
+  }
+  const Double dBefore = bShadow ? TComThread::getWallClockTime() : 0;
+
   // analysis of CU
   DEBUG_STRING_NEW(sDebug)
 
   xCompressCU( m_ppcBestCU[0], m_ppcTempCU[0], 0 DEBUG_STRING_PASS_INTO(sDebug) );
   DEBUG_STRING_OUTPUT(std::cout, sDebug)
 
+  if ( bShadow )
+  {
+    xAddShadowResult( pCtu, eSimLevel, dFullTime, TComThread::getWallClockTime() - dBefore, dFullCost );
+  }
+
 #if ADAPTIVE_QP_SELECTION
   if( m_pcEncCfg->getUseAdaptQpSelect() )
   {
@@ -480,7 +557,7 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
   Bool bOnlyDepth0 = false;
   Bool bCheck64x64 = true;
 
-  if (m_pcEncCfg->getUseRRSP() && uiDepth == 0 && rpcBestCU->getSlice()->getSliceType() != I_SLICE)
+  if (m_bRRSPActive && uiDepth == 0)
   {
     evaluateGroupA64x64(rpcBestCU);
     for (UInt ui = 0; ui < 4; ui++)
@@ -507,17 +584,17 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
         {
           bOnlyDepth0 = true;
         }
-        else if (rpcBestCU->getCUColocated(REF_PIC_LIST_0)->getCUColocated(REF_PIC_LIST_0) == NULL)
+        else if (getColocatedCtu(getColocatedCtu(rpcBestCU)) == NULL)
         {
           bOnlyDepth0 = true;
         }
-        else if (rpcBestCU->getCUColocated(REF_PIC_LIST_0)->getCUColocated(REF_PIC_LIST_0)->getDepth(0) == 0)
+        else if (getColocatedCtu(getColocatedCtu(rpcBestCU))->getDepth(0) == 0)
         {
           bOnlyDepth0 = true;
         }
       }
     }
-    bCheck64x64 = (numOfAdoptedCTUsInA64x64 > 0 || ((rpcBestCU->getCUColocated(REF_PIC_LIST_0)->getSlice()->getSliceType() == I_SLICE) && (rpcBestCU->getCUPelY() < 32)));
+    bCheck64x64 = (numOfAdoptedCTUsInA64x64 > 0 || ((getColocatedCtu(rpcBestCU)->getSlice()->getSliceType() == I_SLICE) && (rpcBestCU->getCUPelY() < 32)));
     if (!bCheck64x64)
     {
       evaluateGroupB64x64(rpcBestCU);
@@ -593,9 +670,9 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
        ( uiBPelY < rpcBestCU->getSlice()->getSPS()->getPicHeightInLumaSamples() ) )
   {
     // variable for Similarity Based Decision by R. Fan
-    Bool bSBD  = (!m_pcEncCfg->getUseSBD() || (m_pcEncCfg->getUseSBD() && m_bRangeDepths[uiDepth] && rpcBestCU->getSlice()->getSliceType() != I_SLICE) || rpcBestCU->getSlice()->getSliceType() == I_SLICE) ? true : false;
+    Bool bSBD  = !m_bSBDActive || m_bRangeDepths[uiDepth];
     // variable for Reduced Region Similarity Partitioning (RRSP)
-    Bool bRRSP = (!m_pcEncCfg->getUseRRSP() || (m_pcEncCfg->getUseRRSP() && ((uiDepth == 0 && bCheck64x64) || (uiDepth > 0 && m_bReducedRangeDepths[uiDepth - 1] == true)) && rpcBestCU->getSlice()->getSliceType() != I_SLICE) || rpcBestCU->getSlice()->getSliceType() == I_SLICE) ? true : false;
+    Bool bRRSP = !m_bRRSPActive || (uiDepth == 0 && bCheck64x64) || (uiDepth > 0 && m_bReducedRangeDepths[uiDepth - 1] == true);
     
     if (bSBD && bRRSP)
       // Similarity Based Decision is turned on, perform required inter/intra/SKIP modes
@@ -915,7 +992,7 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
 
   // SBD - Once the maximal depth in the selected range is complete, stop splitting
   Bool bSBDSplit = true;
-  if (m_pcEncCfg->getUseSBD() && rpcBestCU->getSlice()->getSliceType() != I_SLICE)
+  if (m_bSBDActive)
   {
     bSBDSplit = false;
     for (UInt ui = uiDepth + 1; ui <= g_uiMaxCUDepth - g_uiAddCUDepth; ui++)
@@ -935,7 +1012,7 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
   }
 
   Bool bRRSPSplit = true;
-  if (m_pcEncCfg->getUseRRSP() && rpcBestCU->getSlice()->getSliceType() != I_SLICE)
+  if (m_bRRSPActive)
   {
     if (uiDepth == 0 && bOnlyDepth0)
     {
@@ -968,6 +1045,12 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
         }
       }
     }
+    if (bRRSPSplit && !bBoundary && m_pcEncCfg->getUseRRSP16x16() && uiDepth > 0 && uiDepth == g_uiMaxCUDepth - g_uiAddCUDepth - 1
+        && m_bReducedRangeDepths[uiDepth - 1] && (!m_bSBDActive || m_bRangeDepths[uiDepth]))
+      // the 16x16 CU has been evaluated, the group agreement decides again whether its 8x8 CUs are evaluated
+    {
+      bRRSPSplit = evaluateRRSP8x8(rpcBestCU);
+    }
   }
 
   for (Int iQP=iMinQP; iQP<=iMaxQP; iQP++)
@@ -990,11 +1073,11 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
         pcSubTempPartCU->initSubCU( rpcTempCU, uiPartUnitIdx, uhNextDepth, iQP );           // clear sub partition datas or init.
 
         // RRSP-related algorithm
-        if (m_pcEncCfg->getUseRRSP() && uiDepth == 0 && rpcBestCU->getSlice()->getSliceType() != I_SLICE)
+        if (m_bRRSPActive && uiDepth == 0)
         {
           buildRRSPAlphaGroup(rpcTempCU, (RRSP32x32CU)uiPartUnitIdx);
           setReducedRangeDepths(getRRSPSimLevel(), rpcTempCU, (RRSP32x32CU)uiPartUnitIdx);
-          if ((rpcTempCU->getCUColocated(REF_PIC_LIST_0)->getSlice()->getSliceType() == I_SLICE) && (rpcTempCU->getCUPelY() < 32))
+          if ((getColocatedCtu(rpcTempCU)->getSlice()->getSliceType() == I_SLICE) && (rpcTempCU->getCUPelY() < 32))
             // if the previous frame was an intra frame, which tends to adopt smaller CU sizes, also evaluate a CU size of 32x32 in the first 32x32 row
           {
             m_bReducedRangeDepths[0] = true;
@@ -1442,6 +1525,10 @@ Void TEncCu::xCheckRDCostMerge2Nx2N( TComDataCU*& rpcBestCU, TComDataCU*& rpcTem
   {
     for( UInt uiMergeCand = 0; uiMergeCand < numValidMergeCand; ++uiMergeCand )
     {
+      if ( !m_pcPredSearch->isMergeCandAvailable( rpcTempCU, &cMvFieldNeighbours[2*uiMergeCand], uhInterDirNeighbours[uiMergeCand] ) )
+      {
+        continue;   // reads CTU rows of a reference picture that are not finished yet
+      }
       if(!(uiNoResidual==1 && mergeCandBuffer[uiMergeCand]==1))
       {
         if( !(bestIsSkip && uiNoResidual == 0) )
@@ -1894,6 +1981,34 @@ Void TEncCu::xCtuCollectARLStats(TComDataCU* pCtu )
 #endif
 
 
+/** Marks the depths of the CUs of a CTU that cover a rectangular region of it. The region is scanned with the
+ * minimum CU size and mapped to partition indices with the z-scan tables, so any CTU size and partition depth works.
+*\param   pcCtu             CTU to extract the depths from
+*\param   bAdoptedCUDepths  depth flags to update
+*\param   uiX               horizontal position of the region within the CTU, in luma samples
+*\param   uiY               vertical position of the region within the CTU, in luma samples
+*\param   uiWidth           width of the region, in luma samples
+*\param   uiHeight          height of the region, in luma samples
+*\returns Void
+*/
+Void TEncCu::xGetAdoptedDepthsInRegion(TComDataCU* pcCtu, Bool* bAdoptedCUDepths, UInt uiX, UInt uiY, UInt uiWidth, UInt uiHeight)
+{
+  const UInt uiNumPartInCtuWidth = 1 << g_uiMaxCUDepth;
+  const UInt uiPartWidth         = g_uiMaxCUWidth  >> g_uiMaxCUDepth;
+  const UInt uiPartHeight        = g_uiMaxCUHeight >> g_uiMaxCUDepth;
+  const UInt uiMinCUWidth        = std::max(g_uiMaxCUWidth  >> (g_uiMaxCUDepth - g_uiAddCUDepth), uiPartWidth);
+  const UInt uiMinCUHeight       = std::max(g_uiMaxCUHeight >> (g_uiMaxCUDepth - g_uiAddCUDepth), uiPartHeight);
+
+  for (UInt uiPosY = uiY; uiPosY < uiY + uiHeight; uiPosY += uiMinCUHeight)
+  {
+    for (UInt uiPosX = uiX; uiPosX < uiX + uiWidth; uiPosX += uiMinCUWidth)
+    {
+      const UInt uiRaster = (uiPosY / uiPartHeight) * uiNumPartInCtuWidth + uiPosX / uiPartWidth;
+      bAdoptedCUDepths[pcCtu->getDepth(g_auiRasterToZscan[uiRaster])] = true;
+    }
+  }
+}
+
 /** Determines which depth are adopted by the Left neighbour CTU
 *\param   pcCu
 *\param   bAdoptedCUDepths
@@ -1914,51 +2029,9 @@ Void TEncCu::getAdoptedDepthsLeft(TComDataCU* pcCU, Bool* bAdoptedCUDepths, UInt
     return;
   }
 
-  if (R == 8)
-  {
-    bAdoptedCUDepths[leftCU->getDepth(84)]  = true;
-    bAdoptedCUDepths[leftCU->getDepth(92)]  = true;
-    bAdoptedCUDepths[leftCU->getDepth(116)] = true;
-    bAdoptedCUDepths[leftCU->getDepth(124)] = true;
-    bAdoptedCUDepths[leftCU->getDepth(212)] = true;
-    bAdoptedCUDepths[leftCU->getDepth(220)] = true;
-    bAdoptedCUDepths[leftCU->getDepth(244)] = true;
-    bAdoptedCUDepths[leftCU->getDepth(252)] = true;
-  }
-  else if (R == 16)
-  {
-    for (UInt uj = 80; uj < 144; uj = uj + 32)
-    {
-      for (UInt ui = 0; ui < 16; ui = ui + 4)
-      {
-        bAdoptedCUDepths[leftCU->getDepth(uj + ui)] = true;
-      }
-    }
-    for (UInt uj = 208; uj < 272; uj = uj + 32)
-    {
-      for (UInt ui = 0; ui < 16; ui = ui + 4)
-      {
-        bAdoptedCUDepths[leftCU->getDepth(uj + ui)] = true;
-      }
-    }
-  }
-  else if (R == 32)
-  {
-    for (UInt uj = 64; uj < 320; uj = uj + 128)
-    {
-      for (UInt ui = 0; ui < 64; ui = ui + 4)
-      {
-        bAdoptedCUDepths[leftCU->getDepth(uj + ui)] = true;
-      }
-    }
-  }
-  else  // R = 64
-  {
-    for (UInt ui = 0; ui < 256; ui = ui + 4)
-    {
-      bAdoptedCUDepths[leftCU->getDepth(ui)] = true;
-    }
-  }
+  // column of width R along the right edge of the CTU
+  const UInt uiR = std::min(R, g_uiMaxCUWidth);
+  xGetAdoptedDepthsInRegion(leftCU, bAdoptedCUDepths, g_uiMaxCUWidth - uiR, 0, uiR, g_uiMaxCUHeight);
 }
 
 /** Determines which depth are adopted by the Above neighbour CTU
@@ -1981,48 +2054,9 @@ Void TEncCu::getAdoptedDepthsAbove(TComDataCU* pcCU, Bool* bAdoptedCUDepths, UIn
     return;
   }
 
-  if (R == 8)
-  {
-    bAdoptedCUDepths[aboveCU->getDepth(168)] = true;
-    bAdoptedCUDepths[aboveCU->getDepth(172)] = true;
-    bAdoptedCUDepths[aboveCU->getDepth(184)] = true;
-    bAdoptedCUDepths[aboveCU->getDepth(188)] = true;
-    bAdoptedCUDepths[aboveCU->getDepth(232)] = true;
-    bAdoptedCUDepths[aboveCU->getDepth(236)] = true;
-    bAdoptedCUDepths[aboveCU->getDepth(248)] = true;
-    bAdoptedCUDepths[aboveCU->getDepth(252)] = true;
-  }
-  else if (R == 16)
-  {
-    for (UInt uj = 160; uj < 192; uj = uj + 16)
-    {
-      for (UInt ui = 0; ui < 16; ui = ui + 4)
-      {
-        bAdoptedCUDepths[aboveCU->getDepth(uj + ui)] = true;
-      }
-    }
-    for (UInt uj = 224; uj < 256; uj = uj + 16)
-    {
-      for (UInt ui = 0; ui < 16; ui = ui + 4)
-      {
-        bAdoptedCUDepths[aboveCU->getDepth(uj + ui)] = true;
-      }
-    }
-  }
-  else if (R == 32)
-  {
-    for (UInt ui = 128; ui < 256; ui = ui + 4)
-    {
-      bAdoptedCUDepths[aboveCU->getDepth(ui)] = true;
-    }
-  }
-  else  // R = 64
-  {
-    for (UInt ui = 0; ui < 256; ui = ui + 4)
-    {
-      bAdoptedCUDepths[aboveCU->getDepth(ui)] = true;
-    }
-  }
+  // row of height R along the bottom edge of the CTU
+  const UInt uiR = std::min(R, g_uiMaxCUHeight);
+  xGetAdoptedDepthsInRegion(aboveCU, bAdoptedCUDepths, 0, g_uiMaxCUHeight - uiR, g_uiMaxCUWidth, uiR);
 }
 
 /** Determines which depth are adopted by the Above Left neighbour CTU
@@ -2045,31 +2079,10 @@ Void TEncCu::getAdoptedDepthsAboveLeft(TComDataCU* pcCU, Bool* bAdoptedCUDepths,
     return;
   }
 
-  if (R == 8)
-  {
-    bAdoptedCUDepths[aboveLeftCU->getDepth(252)]  = true;
-  }
-  else if (R == 16)
-  {
-    for (UInt ui = 240; ui < 256; ui = ui + 4)
-    {
-      bAdoptedCUDepths[aboveLeftCU->getDepth(ui)] = true;
-    }
-  }
-  else if (R == 32)
-  {
-    for (UInt ui = 192; ui < 256; ui = ui + 4)
-    {
-      bAdoptedCUDepths[aboveLeftCU->getDepth(ui)] = true;
-    }
-  }
-  else  // R = 64
-  {
-    for (UInt ui = 0; ui < 256; ui = ui + 4)
-    {
-      bAdoptedCUDepths[aboveLeftCU->getDepth(ui)] = true;
-    }
-  }
+  // RxR block in the bottom right corner of the CTU
+  const UInt uiRx = std::min(R, g_uiMaxCUWidth);
+  const UInt uiRy = std::min(R, g_uiMaxCUHeight);
+  xGetAdoptedDepthsInRegion(aboveLeftCU, bAdoptedCUDepths, g_uiMaxCUWidth - uiRx, g_uiMaxCUHeight - uiRy, uiRx, uiRy);
 
   memcpy(m_bAdoptedByC, bAdoptedCUDepths, sizeof(Bool)*(m_uhTotalDepth - 1));
 }
@@ -2094,31 +2107,10 @@ Void TEncCu::getAdoptedDepthsAboveRight(TComDataCU* pcCU, Bool* bAdoptedCUDepths
     return;
   }
 
-  if (R == 8)
-  {
-    bAdoptedCUDepths[aboveRightCU->getDepth(168)]  = true;
-  }
-  else if (R == 16)
-  {
-    for (UInt ui = 160; ui < 176; ui = ui + 4)
-    {
-      bAdoptedCUDepths[aboveRightCU->getDepth(ui)] = true;
-    }
-  }
-  else if (R == 32)
-  {
-    for (UInt ui = 128; ui < 192; ui = ui + 4)
-    {
-      bAdoptedCUDepths[aboveRightCU->getDepth(ui)] = true;
-    }
-  }
-  else  // R = 64
-  {
-    for (UInt ui = 0; ui < 256; ui = ui + 4)
-    {
-      bAdoptedCUDepths[aboveRightCU->getDepth(ui)] = true;
-    }
-  }
+  // RxR block in the bottom left corner of the CTU
+  const UInt uiRx = std::min(R, g_uiMaxCUWidth);
+  const UInt uiRy = std::min(R, g_uiMaxCUHeight);
+  xGetAdoptedDepthsInRegion(aboveRightCU, bAdoptedCUDepths, 0, g_uiMaxCUHeight - uiRy, uiRx, uiRy);
 }
 
 /** Determines which depth are adopted by the Right neighbour CTU
@@ -2141,51 +2133,9 @@ Void TEncCu::getAdoptedDepthsRight(TComDataCU* pcCU, Bool* bAdoptedCUDepths, UIn
     return;
   }
 
-  if (R == 8)
-  {
-    bAdoptedCUDepths[rightCU->getDepth(0)]   = true;
-    bAdoptedCUDepths[rightCU->getDepth(8)]   = true;
-    bAdoptedCUDepths[rightCU->getDepth(32)]  = true;
-    bAdoptedCUDepths[rightCU->getDepth(40)]  = true;
-    bAdoptedCUDepths[rightCU->getDepth(128)] = true;
-    bAdoptedCUDepths[rightCU->getDepth(136)] = true;
-    bAdoptedCUDepths[rightCU->getDepth(160)] = true;
-    bAdoptedCUDepths[rightCU->getDepth(168)] = true;
-  }
-  else if (R == 16)
-  {
-    for (UInt uj = 0; uj < 48; uj = uj + 32)
-    {
-      for (UInt ui = 0; ui < 16; ui = ui + 4)
-      {
-        bAdoptedCUDepths[rightCU->getDepth(uj + ui)] = true;
-      }
-    }
-    for (UInt uj = 128; uj < 176; uj = uj + 32)
-    {
-      for (UInt ui = 0; ui < 16; ui = ui + 4)
-      {
-        bAdoptedCUDepths[rightCU->getDepth(uj + ui)] = true;
-      }
-    }
-  }
-  else if (R == 32)
-  {
-    for (UInt uj = 0; uj < 192; uj = uj + 128)
-    {
-      for (UInt ui = 0; ui < 64; ui = ui + 4)
-      {
-        bAdoptedCUDepths[rightCU->getDepth(ui)] = true;
-      }
-    }
-  }
-  else  // R = 64
-  {
-    for (UInt ui = 0; ui < 256; ui = ui + 4)
-    {
-      bAdoptedCUDepths[rightCU->getDepth(ui)] = true;
-    }
-  }
+  // column of width R along the left edge of the CTU
+  const UInt uiR = std::min(R, g_uiMaxCUWidth);
+  xGetAdoptedDepthsInRegion(rightCU, bAdoptedCUDepths, 0, 0, uiR, g_uiMaxCUHeight);
 }
 
 /** Determines which depth are adopted by the Bottom neighbour CTU
@@ -2208,79 +2158,202 @@ Void TEncCu::getAdoptedDepthsBottom(TComDataCU* pcCU, Bool* bAdoptedCUDepths, UI
     return;
   }
 
-  if (R == 8)
+  // row of height R along the top edge of the CTU
+  const UInt uiR = std::min(R, g_uiMaxCUHeight);
+  xGetAdoptedDepthsInRegion(bottomCU, bAdoptedCUDepths, 0, 0, g_uiMaxCUWidth, uiR);
+}
+
+/** Determines which depth are adopted by the previous Colocated CTU
+*\param   pcCu
+*\param   bAdoptedCUDepths
+*\param   R
+*\returns Void
+*/
+Void TEncCu::getAdoptedDepthsColocated(TComDataCU* pcCU, Bool* bAdoptedCUDepths, UInt R)
+{
+  // initialize
+  for (UInt ui = 0; ui < m_uhTotalDepth - 1; ui++)
+  {
+    bAdoptedCUDepths[ui] = false;
+  }
+
+  TComDataCU* colocatedCU = getColocatedCtu(pcCU);
+  if (colocatedCU == NULL)
+  {
+    return;
+  }
+
+  // whole CTU
+  xGetAdoptedDepthsInRegion(colocatedCU, bAdoptedCUDepths, 0, 0, g_uiMaxCUWidth, g_uiMaxCUHeight);
+
+  // merge the depths of the colocated CTU in the other reference picture list
+  TComDataCU* otherColocatedCU = m_pcEncCfg->getSBDColocatedMerge() ? getColocatedCtu(pcCU, true) : NULL;
+  if (otherColocatedCU != NULL)
+  {
+    xGetAdoptedDepthsInRegion(otherColocatedCU, bAdoptedCUDepths, 0, 0, g_uiMaxCUWidth, g_uiMaxCUHeight);
+  }
+
+  memcpy(m_bAdoptedByColocated, bAdoptedCUDepths, sizeof(Bool)*(m_uhTotalDepth - 1));
+}
+
+/** Returns the CTU colocated with a CTU, in the reference picture selected by SBDColocatedRef among the reference
+ * pictures of its slice: the first picture of list 0, the picture nearest in POC, or the picture nearest in POC among
+ * those nearest in temporal layer. Used by SBD and RRSP, including for the colocated CTU of a colocated CTU.
+*\param   pcCU        CTU (or CU of depth 0)
+*\param   bOtherList  select in the reference picture list that does not hold the selected picture instead
+*\returns TComDataCU*  colocated CTU, NULL if pcCU is NULL or there is no reference picture to select
+*/
+TComDataCU* TEncCu::getColocatedCtu(TComDataCU* pcCU, Bool bOtherList)
+{
+  if (pcCU == NULL)
   {
-    bAdoptedCUDepths[bottomCU->getDepth(0)]  = true;
-    bAdoptedCUDepths[bottomCU->getDepth(4)]  = true;
-    bAdoptedCUDepths[bottomCU->getDepth(16)] = true;
-    bAdoptedCUDepths[bottomCU->getDepth(20)] = true;
-    bAdoptedCUDepths[bottomCU->getDepth(64)] = true;
-    bAdoptedCUDepths[bottomCU->getDepth(68)] = true;
-    bAdoptedCUDepths[bottomCU->getDepth(80)] = true;
-    bAdoptedCUDepths[bottomCU->getDepth(84)] = true;
+    return NULL;
   }
-  else if (R == 16)
+  if (m_pcEncCfg->getSBDColocatedRef() == 0 && !bOtherList)
   {
-    for (UInt uj = 0; uj < 32; uj = uj + 16)
+    return pcCU->getCUColocated(REF_PIC_LIST_0);
+  }
+
+  RefPicList eRefPicList;
+  Int        iRefIdx;
+  if (!xSelectColocatedRef(pcCU, NUM_REF_PIC_LIST_01, eRefPicList, iRefIdx))
+  {
+    return NULL;
+  }
+  if (bOtherList && !xSelectColocatedRef(pcCU, eRefPicList, eRefPicList, iRefIdx))
+  {
+    return NULL;
+  }
+  return pcCU->getSlice()->getRefPic(eRefPicList, iRefIdx)->getCtu(pcCU->getCtuRsAddr());
+}
+
+/** Selects the reference picture of the colocated CTU of SBD and RRSP, see getColocatedCtu(). Ties are resolved in
+ * favour of list 0 and of the lower reference index.
+*\param   pcCU           CTU (or CU of depth 0)
+*\param   eExcludedList  reference picture list not to select from, NUM_REF_PIC_LIST_01 for none
+*\param   reRefPicList   returns the reference picture list of the selected picture
+*\param   riRefIdx       returns the reference index of the selected picture
+*\returns Bool           false if there is no reference picture to select
+*/
+Bool TEncCu::xSelectColocatedRef(TComDataCU* pcCU, RefPicList eExcludedList, RefPicList& reRefPicList, Int& riRefIdx)
+{
+  TComSlice* pcSlice  = pcCU->getSlice();
+  const Int  iMode    = m_pcEncCfg->getSBDColocatedRef();
+  const UInt uiLists  = pcSlice->isInterB() ? 2 : ( pcSlice->isInterP() ? 1 : 0 );
+  Int        iMinCost = MAX_INT;
+
+  for (UInt uiList = 0; uiList < uiLists; uiList++)
+  {
+    const RefPicList eRefPicList = RefPicList(uiList);
+    if (eRefPicList == eExcludedList)
     {
-      for (UInt ui = 0; ui < 16; ui = ui + 4)
-      {
-        bAdoptedCUDepths[bottomCU->getDepth(uj + ui)] = true;
-      }
+      continue;
     }
-    for (UInt uj = 64; uj < 96; uj = uj + 16)
+    const Int iNumRefIdx = iMode == 0 ? std::min(1, pcSlice->getNumRefIdx(eRefPicList)) : pcSlice->getNumRefIdx(eRefPicList);
+    for (Int iRefIdx = 0; iRefIdx < iNumRefIdx; iRefIdx++)
     {
-      for (UInt ui = 0; ui < 16; ui = ui + 4)
+      TComPic* pcRefPic = pcSlice->getRefPic(eRefPicList, iRefIdx);
+      Int iCost = 0;
+      if (iMode > 0)
       {
-        bAdoptedCUDepths[bottomCU->getDepth(uj + ui)] = true;
+        iCost = abs(pcSlice->getPOC() - pcRefPic->getPOC());
       }
-    }
-  }
-  else if (R == 32)
-  {
-    for (UInt uj = 0; uj < 128; uj = uj + 64)
-    {
-      for (UInt ui = 0; ui < 64; ui = ui + 4)
+      if (iMode == 2) // the temporal layer distance comes first
       {
-        bAdoptedCUDepths[bottomCU->getDepth(ui)] = true;
+        iCost += abs((Int)pcSlice->getTLayer() - (Int)pcRefPic->getTLayer()) << 16;
+      }
+      if (iCost < iMinCost)
+      {
+        iMinCost     = iCost;
+        reRefPicList = eRefPicList;
+        riRefIdx     = iRefIdx;
       }
     }
   }
-  else  // R = 64
-  {
-    for (UInt ui = 0; ui < 256; ui = ui + 4)
-    {
-      bAdoptedCUDepths[bottomCU->getDepth(ui)] = true;
-    }
-  }
+
+  return iMinCost != MAX_INT;
 }
 
-/** Determines which depth are adopted by the previous Colocated CTU
-*\param   pcCu
-*\param   bAdoptedCUDepths
-*\param   R
+/** SBD shadow mode: compresses the CTU with the full depth range and without the RRSP limits, keeping the depth range
+ * selected by SBD for the search that decides the CTU. Everything the full search changes that the next search reads
+ * is restored afterwards (go-on SBAC coder, CTU data in the picture, fast search start points, RRSP state), so the
+ * bitstream is the same as without the shadow mode. The reconstruction written by the full search is overwritten by
+ * the search that decides the CTU.
+*\param   pCtu    CTU to compress
+*\param   rdTime  returns the wall-clock time of the full search, in seconds
+*\param   rdCost  returns the RD cost of the CTU with the full search
 *\returns Void
 */
-Void TEncCu::getAdoptedDepthsColocated(TComDataCU* pcCU, Bool* bAdoptedCUDepths, UInt R)
+Void TEncCu::xCompressCtuFullRange(TComDataCU* pCtu, Double& rdTime, Double& rdCost)
 {
-  // initialize
+  const Bool bRRSPActive = m_bRRSPActive;
+  memcpy(m_bShadowRangeDepths, m_bRangeDepths, sizeof(Bool)*(m_uhTotalDepth - 1));
+  for (UInt uiRefList = 0; uiRefList < NUM_REF_PIC_LIST_01; uiRefList++)
+  {
+    for (Int iRefIdx = 0; iRefIdx < MAX_NUM_REF; iRefIdx++)
+    {
+      m_acShadowIntegerMv2Nx2N[uiRefList][iRefIdx] = m_pcPredSearch->getIntegerMv2Nx2N(RefPicList(uiRefList), iRefIdx);
+    }
+  }
   for (UInt ui = 0; ui < m_uhTotalDepth - 1; ui++)
   {
-    bAdoptedCUDepths[ui] = false;
+    m_bRangeDepths[ui] = true;
   }
+  m_bRRSPActive = false;
 
-  TComDataCU* colocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0);
-  if (colocatedCU == NULL)
+  const Double dBefore = TComThread::getWallClockTime();
+  DEBUG_STRING_NEW(sDebug)
+  xCompressCU( m_ppcBestCU[0], m_ppcTempCU[0], 0 DEBUG_STRING_PASS_INTO(sDebug) );
+  rdTime = TComThread::getWallClockTime() - dBefore;
+  rdCost = m_ppcBestCU[0]->getTotalCost();
+  memcpy(m_puhShadowDepths, m_ppcBestCU[0]->getDepth(), sizeof(UChar)*m_ppcBestCU[0]->getTotalNumPart());
+
+  memcpy(m_bRangeDepths, m_bShadowRangeDepths, sizeof(Bool)*(m_uhTotalDepth - 1));
+  m_bRRSPActive = bRRSPActive;
+  for (UInt uiRefList = 0; uiRefList < NUM_REF_PIC_LIST_01; uiRefList++)
   {
-    return;
+    for (Int iRefIdx = 0; iRefIdx < MAX_NUM_REF; iRefIdx++)
+    {
+      m_pcPredSearch->setIntegerMv2Nx2N(RefPicList(uiRefList), iRefIdx, m_acShadowIntegerMv2Nx2N[uiRefList][iRefIdx]);
+    }
   }
+  // the go-on coder and the CTU in the picture as the slice encoder has set them up before compressCtu
+  m_pcRDGoOnSbacCoder->load( m_pppcRDSbacCoder[0][CI_CURR_BEST] );
+  pCtu->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
+  m_ppcBestCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
+  m_ppcTempCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
+}
 
-  for (UInt ui = 0; ui < 256; ui = ui + 4)
+/** SBD shadow mode: compares the full search of the CTU with the SBD restricted search that has just decided it.
+ * Only the CUs inside the picture are compared; the range includes the depths added by SBD at the picture boundary.
+*\param   pCtu       CTU
+*\param   eSimLevel  similarity level of the CTU
+*\param   dFullTime  wall-clock time of the full search, in seconds
+*\param   dSBDTime   wall-clock time of the SBD restricted search, in seconds
+*\param   dFullCost  RD cost of the CTU with the full search
+*\returns Void
+*/
+Void TEncCu::xAddShadowResult(TComDataCU* pCtu, TEncSBDShadow::SimLevel eSimLevel, Double dFullTime, Double dSBDTime, Double dFullCost)
+{
+  TComDataCU* pcBestCU  = m_ppcBestCU[0];
+  const UInt uiPicWidth  = pCtu->getSlice()->getSPS()->getPicWidthInLumaSamples();
+  const UInt uiPicHeight = pCtu->getSlice()->getSPS()->getPicHeightInLumaSamples();
+  Bool bHit       = true;
+  Bool bSameSplit = true;
+
+  for (UInt uiAbsPartIdx = 0; uiAbsPartIdx < pcBestCU->getTotalNumPart(); uiAbsPartIdx++)
   {
-    bAdoptedCUDepths[colocatedCU->getDepth(ui)] = true;
+    const UInt uiRaster = g_auiZscanToRaster[uiAbsPartIdx];
+    if (pCtu->getCUPelX() + g_auiRasterToPelX[uiRaster] >= uiPicWidth || pCtu->getCUPelY() + g_auiRasterToPelY[uiRaster] >= uiPicHeight)
+    {
+      continue;
+    }
+    const UChar uhFullDepth = m_puhShadowDepths[uiAbsPartIdx];
+    bHit       = bHit && m_bRangeDepths[uhFullDepth];
+    bSameSplit = bSameSplit && uhFullDepth == pcBestCU->getDepth(uiAbsPartIdx);
   }
 
-  memcpy(m_bAdoptedByColocated, bAdoptedCUDepths, sizeof(Bool)*(m_uhTotalDepth - 1));
+  m_pcSBDShadow->addShadowResult(eSimLevel, bHit, bSameSplit, dFullTime, dSBDTime, dFullCost, pcBestCU->getTotalCost());
 }
 
 /** initiliaze the array that holds the depths adopted by group alpha
@@ -2342,6 +2415,27 @@ Void TEncCu::buildGroupAlpha(TComDataCU* pcCU)
   delete bAdoptedCUDepths;
 }
 
+/** build the array of depths adopted by group alpha from the left, above and above left CTUs, without the colocated
+ * CTU, for the spatial-only SBD in intra slices
+*\param   pcCU
+*\returns Void
+*/
+Void TEncCu::buildSpatialGroupAlpha(TComDataCU* pcCU)
+{
+  Bool* bAdoptedCUDepths = new Bool[m_uhTotalDepth - 1];
+  UInt R = m_pcEncCfg->getR();
+  initGroupAlpha();
+
+  getAdoptedDepthsLeft(pcCU, bAdoptedCUDepths, R);
+  updateGroupAlpha(bAdoptedCUDepths);
+  getAdoptedDepthsAbove(pcCU, bAdoptedCUDepths, R);
+  updateGroupAlpha(bAdoptedCUDepths);
+  getAdoptedDepthsAboveLeft(pcCU, bAdoptedCUDepths, R);
+  updateGroupAlpha(bAdoptedCUDepths);
+
+  delete[] bAdoptedCUDepths;
+}
+
 /** initiliaze the array that holds the depths adopted by group beta
 *\returns Void
 */
@@ -2374,21 +2468,25 @@ Void TEncCu::updateGroupBeta(Bool* bAdoptedCUDepths)
 */
 Void TEncCu::buildGroupBeta(TComDataCU* pcCU)
 {
-  TComDataCU* pcColocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+  TComDataCU* pcColocatedCU = getColocatedCtu(pcCU);
   Bool* bAdoptedCUDepths = new Bool[m_uhTotalDepth - 1];
   UInt R = m_pcEncCfg->getR();
   initGroupBeta();
 
   getAdoptedDepthsAboveRight(pcCU, bAdoptedCUDepths, R);
   updateGroupBeta(bAdoptedCUDepths);
-  getAdoptedDepthsLeft(pcColocatedCU, bAdoptedCUDepths, R);
-  updateGroupBeta(bAdoptedCUDepths);
-  getAdoptedDepthsAbove(pcColocatedCU, bAdoptedCUDepths, R);
-  updateGroupBeta(bAdoptedCUDepths);
-  getAdoptedDepthsRight(pcColocatedCU, bAdoptedCUDepths, R);
-  updateGroupBeta(bAdoptedCUDepths);
-  getAdoptedDepthsBottom(pcColocatedCU, bAdoptedCUDepths, R);
-  updateGroupBeta(bAdoptedCUDepths);
+  if (pcColocatedCU != NULL)
+    // the neighbours of the colocated CTU
+  {
+    getAdoptedDepthsLeft(pcColocatedCU, bAdoptedCUDepths, R);
+    updateGroupBeta(bAdoptedCUDepths);
+    getAdoptedDepthsAbove(pcColocatedCU, bAdoptedCUDepths, R);
+    updateGroupBeta(bAdoptedCUDepths);
+    getAdoptedDepthsRight(pcColocatedCU, bAdoptedCUDepths, R);
+    updateGroupBeta(bAdoptedCUDepths);
+    getAdoptedDepthsBottom(pcColocatedCU, bAdoptedCUDepths, R);
+    updateGroupBeta(bAdoptedCUDepths);
+  }
 
   delete bAdoptedCUDepths;
 }
@@ -2639,14 +2737,24 @@ Void TEncCu::performLowSim()
   if (bEqualDepthProbabilities == true)
     // at least two depths with the same lowest probability
   {
+    // the first half of the depth levels of the CTU counts as low, the rest as high (64x64: 0-1 and 2-3,
+    // 32x32: 0-1 and 2, 16x16: 0 and 1)
+    const UInt uiNumLowDepths = m_uhTotalDepth / 2;
     UInt uiLow = 0;
     UInt uiHigh = 0;
-    uiLow += m_bAdoptedByColocated[0] ? 1 : 0;
-    uiLow += m_bAdoptedByColocated[1] ? 1 : 0;
-    uiHigh += m_bAdoptedByColocated[2] ? 1 : 0;
-    if (m_uhTotalDepth - 1 >= 3)
+    for (UInt ui = 0; ui < m_uhTotalDepth - 1; ui++)
     {
-      uiHigh += m_bAdoptedByColocated[3] ? 1 : 0;
+      if (m_bAdoptedByColocated[ui])
+      {
+        if (ui < uiNumLowDepths)
+        {
+          uiLow++;
+        }
+        else
+        {
+          uiHigh++;
+        }
+      }
     }
     if (uiLow > uiHigh)
     {
@@ -2664,6 +2772,62 @@ Void TEncCu::performLowSim()
   }
 }
 
+/** perform the spatial-only SBD of intra slices. The similarity level follows from the number of depths adopted by
+ * the spatial group alpha and the SBDIntraHighSim and SBDIntraLowSim thresholds: high similarity evaluates the adopted
+ * depths and one more, medium similarity is handled as Medium Low similarity, and low similarity (or no neighbour
+ * CTU at all) evaluates every depth.
+*\returns TEncSBDShadow::SimLevel
+*/
+TEncSBDShadow::SimLevel TEncCu::performIntraSim()
+{
+  const UInt uiNumDepths = m_uhTotalDepth - 1;
+  const UInt uiCount     = getSimLevel();
+
+  if (uiCount == 0 || uiCount >= std::min(m_pcEncCfg->getSBDIntraLowSim(), uiNumDepths)) // low
+  {
+    for (UInt ui = 0; ui < uiNumDepths; ui++)
+    {
+      m_bRangeDepths[ui] = true;
+    }
+    return TEncSBDShadow::SIM_INTRA_LOW;
+  }
+  if (uiCount <= m_pcEncCfg->getSBDIntraHighSim()) // high
+  {
+    performIntraHighSim();
+    return TEncSBDShadow::SIM_INTRA_HIGH;
+  }
+  performMediumLowSim(); // medium
+  return TEncSBDShadow::SIM_INTRA_MEDIUM;
+}
+
+/** perform High Similarity degree of the spatial-only SBD: the depths adopted by group alpha are evaluated, together
+ * with the depth succeeding the deepest one, or preceding the shallowest one if the last depth is adopted
+*\returns Void
+*/
+Void TEncCu::performIntraHighSim()
+{
+  UInt uiShallowest = m_uhTotalDepth - 1;
+  UInt uiDeepest    = 0;
+  for (UInt ui = 0; ui < m_uhTotalDepth - 1; ui++)
+  {
+    m_bRangeDepths[ui] = m_uiAlphaDepths[ui] > 0;
+    if (m_bRangeDepths[ui])
+    {
+      uiShallowest = std::min(uiShallowest, ui);
+      uiDeepest    = ui;
+    }
+  }
+
+  if (uiDeepest < m_uhTotalDepth - 2)
+  {
+    m_bRangeDepths[uiDeepest + 1] = true;
+  }
+  else if (uiShallowest > 0)
+  {
+    m_bRangeDepths[uiShallowest - 1] = true;
+  }
+}
+
 /** RRSP: updates the array that contains booleans whether neighbor CTUs in group A adopt size of 64x64
 *\param   pcCu
 *\returns Void
@@ -2698,7 +2862,7 @@ Void TEncCu::evaluateGroupA64x64(TComDataCU* pcCU)
     m_RRSPNumOfCTUsInA++;
   }
 
-  TComDataCU* colocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+  TComDataCU* colocatedCU = getColocatedCtu(pcCU);
   if (colocatedCU != NULL)
   {
     m_bRRSPAdoptedDepths64x64ByA[I] = colocatedCU->getDepth(0) == 0;  // 64x64, no matter which 8x8 CU is picked
@@ -2720,6 +2884,9 @@ Void TEncCu::evaluateGroupB64x64(TComDataCU* pcCU)
   }
   m_RRSPNumOfCTUsInB = 0;
 
+  // the neighbours of the colocated CTU do not count if there is no colocated CTU
+  TComDataCU* pcColocatedCtu = getColocatedCtu(pcCU);
+
   TComDataCU* aboveRightCU = pcCU->getCtuAboveRight();
   if (aboveRightCU != NULL)
   {
@@ -2727,28 +2894,28 @@ Void TEncCu::evaluateGroupB64x64(TComDataCU* pcCU)
     m_RRSPNumOfCTUsInB++;
   }
 
-  TComDataCU* aboveColocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuAbove();
+  TComDataCU* aboveColocatedCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuAbove() : NULL;
   if (aboveColocatedCU != NULL)
   {
     m_bRRSPAdoptedDepths64x64ByB[E] = aboveColocatedCU->getDepth(0) == 0;  // 64x64, no matter which 8x8 CU is picked
     m_RRSPNumOfCTUsInB++;
   }
 
-  TComDataCU* leftColocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuLeft();
+  TComDataCU* leftColocatedCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuLeft() : NULL;
   if (leftColocatedCU != NULL)
   {
     m_bRRSPAdoptedDepths64x64ByB[F] = leftColocatedCU->getDepth(0) == 0;  // 64x64, no matter which 8x8 CU is picked
     m_RRSPNumOfCTUsInB++;
   }
 
-  TComDataCU* aboveLeftColocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuBottom();
+  TComDataCU* aboveLeftColocatedCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuBottom() : NULL;
   if (aboveLeftColocatedCU != NULL)
   {
     m_bRRSPAdoptedDepths64x64ByB[G] = aboveLeftColocatedCU->getDepth(0) == 0;  // 64x64, no matter which 8x8 CU is picked
     m_RRSPNumOfCTUsInB++;
   }
 
-  TComDataCU* rightColocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuRight();
+  TComDataCU* rightColocatedCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuRight() : NULL;
   if (rightColocatedCU != NULL)
   {
     m_bRRSPAdoptedDepths64x64ByB[H] = rightColocatedCU->getDepth(0) == 0;  // 64x64, no matter which 8x8 CU is picked
@@ -2816,7 +2983,7 @@ UInt TEncCu::getNumOf32x32CUsInA(TComDataCU* pcCU)
     }
   }
 
-  TComDataCU* colocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+  TComDataCU* colocatedCU = getColocatedCtu(pcCU);
   if (colocatedCU != NULL)
   {
     uiDiff = uiNumOf32x32CUsInA;
@@ -2897,7 +3064,7 @@ Void TEncCu::buildRRSPAlphaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
             }
           }
         }
-        TComDataCU* colocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+        TComDataCU* colocatedCU = getColocatedCtu(pcCU);
         if (colocatedCU != NULL)
         {
           for (UInt ui = 0; ui < 64; ui = ui + 4)
@@ -2947,7 +3114,7 @@ Void TEncCu::buildRRSPAlphaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
             }
           }
         }
-        TComDataCU* colocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+        TComDataCU* colocatedCU = getColocatedCtu(pcCU);
         if (colocatedCU != NULL)
         {
           for (UInt ui = 64; ui < 128; ui = ui + 4)
@@ -2997,7 +3164,7 @@ Void TEncCu::buildRRSPAlphaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
           }
         }
       }
-      TComDataCU* colocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+      TComDataCU* colocatedCU = getColocatedCtu(pcCU);
       if (colocatedCU != NULL)
       {
         for (UInt ui = 128; ui < 192; ui = ui + 4)
@@ -3047,7 +3214,7 @@ Void TEncCu::buildRRSPAlphaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
           }
         }
       }
-      TComDataCU* colocatedCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+      TComDataCU* colocatedCU = getColocatedCtu(pcCU);
       if (colocatedCU != NULL)
       {
         for (UInt ui = 192; ui < 256; ui = ui + 4)
@@ -3085,6 +3252,9 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
     m_uiRRSPBetaReducedAdoptedDepths[ui] = 0;
   }
 
+  // the colocated CTU and its neighbours do not count if there is no colocated CTU
+  TComDataCU* pcColocatedCtu = getColocatedCtu(pcCU);
+
   // 32x32 partition of a CTU
   //  *-----*-----*
   //  |  w  |  x  |
@@ -3102,7 +3272,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
         uiTempDepth = (uiDepth == 0) ? 0 : uiDepth - 1; // indicates the depth adopted by the upper-right CU according to R=8
         m_uiRRSPBetaReducedAdoptedDepths[uiTempDepth]++;
       }
-      TComDataCU* colocatedAboveCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuAbove();
+      TComDataCU* colocatedAboveCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuAbove() : NULL;
       if (colocatedAboveCU != NULL)
       {
         for (UInt ui = 168; ui < 200; ui = ui + 16)
@@ -3116,7 +3286,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
           }
         }
       }
-      TComDataCU* colocatedLeftCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuLeft();
+      TComDataCU* colocatedLeftCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuLeft() : NULL;
       if (colocatedLeftCU != NULL)
       {
         for (UInt ui = 84; ui < 148; ui = ui + 32)
@@ -3130,7 +3300,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
           }
         }
       }
-      TComDataCU* colocatedBottomCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+      TComDataCU* colocatedBottomCU = pcColocatedCtu;
       if (colocatedBottomCU != NULL)
       {
         for (UInt ui = 128; ui < 160; ui = ui + 16)
@@ -3169,7 +3339,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
         uiTempDepth = (uiDepth == 0) ? 0 : uiDepth - 1; // indicates the depth adopted by the upper-right CU according to R=8
         m_uiRRSPBetaReducedAdoptedDepths[uiTempDepth]++;
       }
-      TComDataCU* colocatedAboveCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuAbove();
+      TComDataCU* colocatedAboveCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuAbove() : NULL;
       if (colocatedAboveCU != NULL)
       {
         for (UInt ui = 232; ui < 264; ui = ui + 16)
@@ -3183,7 +3353,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
           }
         }
       }
-      TComDataCU* colocatedLeftCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+      TComDataCU* colocatedLeftCU = pcColocatedCtu;
       if (colocatedLeftCU != NULL)
       {
         for (UInt ui = 20; ui < 84; ui = ui + 32)
@@ -3211,7 +3381,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
           }
         }
       }
-      TComDataCU* colocatedRightCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuRight();
+      TComDataCU* colocatedRightCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuRight() : NULL;
       if (colocatedRightCU != NULL)
       {
         for (UInt ui = 0; ui < 64; ui = ui + 32)
@@ -3236,7 +3406,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
         uiTempDepth = (uiDepth == 0) ? 0 : uiDepth - 1; // indicates the depth adopted by the upper-right CU according to R=8
         m_uiRRSPBetaReducedAdoptedDepths[uiTempDepth]++;
       }
-      TComDataCU* colocatedAboveCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+      TComDataCU* colocatedAboveCU = pcColocatedCtu;
       if (colocatedAboveCU != NULL)
       {
         for (UInt ui = 40; ui < 72; ui = ui + 16)
@@ -3250,7 +3420,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
           }
         }
       }
-      TComDataCU* colocatedLeftCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuLeft();
+      TComDataCU* colocatedLeftCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuLeft() : NULL;
       if (colocatedLeftCU != NULL)
       {
         for (UInt ui = 212; ui < 276; ui = ui + 32)
@@ -3264,7 +3434,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
           }
         }
       }
-      TComDataCU* colocatedBottomCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuBottom();
+      TComDataCU* colocatedBottomCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuBottom() : NULL;
       if (colocatedBottomCU != NULL)
       {
         for (UInt ui = 0; ui < 32; ui = ui + 16)
@@ -3296,7 +3466,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
     }
     case z:
     {
-      TComDataCU* colocatedAboveCU = pcCU->getCUColocated(REF_PIC_LIST_0);
+      TComDataCU* colocatedAboveCU = pcColocatedCtu;
       if (colocatedAboveCU != NULL)
       {
         for (UInt ui = 104; ui < 136; ui = ui + 16)
@@ -3324,7 +3494,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
           }
         }
       }
-      TComDataCU* colocatedBottomCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuBottom();
+      TComDataCU* colocatedBottomCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuBottom() : NULL;
       if (colocatedBottomCU != NULL)
       {
         for (UInt ui = 64; ui < 96; ui = ui + 16)
@@ -3338,7 +3508,7 @@ Void TEncCu::buildRRSPBetaGroup(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
           }
         }
       }
-      TComDataCU* colocatedRightCU = pcCU->getCUColocated(REF_PIC_LIST_0)->getCtuRight();
+      TComDataCU* colocatedRightCU = pcColocatedCtu != NULL ? pcColocatedCtu->getCtuRight() : NULL;
       if (colocatedRightCU != NULL)
       {
         for (UInt ui = 128; ui < 192; ui = ui + 32)
@@ -3547,6 +3717,131 @@ Void TEncCu::performRRSPMediumSim(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
   }
 }
 
+/** RRSP: decide whether the 8x8 CUs of a 16x16 CU are evaluated, applying the group agreement of the 32x32 CUs
+ * again at the 16x16 level. Group alpha holds the 8x8 blocks on the left, above and above-left of the 16x16 CU
+ * (from the CUs already compressed in the current picture) and the four 8x8 blocks of the colocated 16x16 CU. Group
+ * beta holds the above-right 8x8 block and the 8x8 blocks around the colocated 16x16 CU. The 8x8 CUs are not
+ * evaluated when no block of either group adopts them.
+*\param   pcCU   16x16 CU
+*\returns Bool   true if the 8x8 CUs are evaluated
+*/
+Bool TEncCu::evaluateRRSP8x8(TComDataCU* pcCU)
+{
+  TComPic*    pcPic               = pcCU->getPic();
+  TComDataCU* pcCtu               = pcPic->getCtu(pcCU->getCtuRsAddr());
+  const UInt  uiDepth8x8          = pcCU->getDepth(0) + 1;
+  const UInt  uiHalfWidth         = pcCU->getWidth(0) >> 1;
+  const UInt  uiHalfParts         = uiHalfWidth / pcPic->getMinCUWidth();
+  const UInt  uiRasterIdx         = g_auiZscanToRaster[pcCU->getZorderIdxInCtu()];
+  const UInt  uiNumPartInCtuWidth = pcPic->getNumPartInCtuWidth();
+
+  // 8x8 blocks of the 16x16 CU
+  //  *-----*-----*
+  //  |  0  |  1  |
+  //  *-----*-----*
+  //  |  2  |  3  |
+  //  *-----*-----*
+  UInt auiPartIdx[4];
+  auiPartIdx[0] = pcCU->getZorderIdxInCtu();
+  auiPartIdx[1] = g_auiRasterToZscan[uiRasterIdx + uiHalfParts];
+  auiPartIdx[2] = g_auiRasterToZscan[uiRasterIdx + uiHalfParts * uiNumPartInCtuWidth];
+  auiPartIdx[3] = g_auiRasterToZscan[uiRasterIdx + uiHalfParts * uiNumPartInCtuWidth + uiHalfParts];
+
+  UInt        uiNumBlocks = 0;
+  UInt        uiNum8x8    = 0;
+  UInt        uiNeighbourIdx;
+  TComDataCU* pcNeighbourCU;
+
+  // group alpha
+  for (UInt ui = 0; ui < 4; ui += 2)
+  {
+    pcNeighbourCU = pcCtu->getPULeft(uiNeighbourIdx, auiPartIdx[ui]);
+    if (pcNeighbourCU != NULL)
+    {
+      uiNumBlocks++;
+      uiNum8x8 += pcNeighbourCU->getDepth(uiNeighbourIdx) >= uiDepth8x8;
+    }
+  }
+  for (UInt ui = 0; ui < 2; ui++)
+  {
+    pcNeighbourCU = pcCtu->getPUAbove(uiNeighbourIdx, auiPartIdx[ui]);
+    if (pcNeighbourCU != NULL)
+    {
+      uiNumBlocks++;
+      uiNum8x8 += pcNeighbourCU->getDepth(uiNeighbourIdx) >= uiDepth8x8;
+    }
+  }
+  pcNeighbourCU = pcCtu->getPUAboveLeft(uiNeighbourIdx, auiPartIdx[0]);
+  if (pcNeighbourCU != NULL)
+  {
+    uiNumBlocks++;
+    uiNum8x8 += pcNeighbourCU->getDepth(uiNeighbourIdx) >= uiDepth8x8;
+  }
+  TComDataCU* colocatedCU = getColocatedCtu(pcCtu);
+  if (colocatedCU != NULL)
+  {
+    for (UInt ui = 0; ui < 4; ui++)
+    {
+      uiNumBlocks++;
+      uiNum8x8 += colocatedCU->getDepth(auiPartIdx[ui]) >= uiDepth8x8;
+    }
+  }
+
+  if (uiNumBlocks == 0 || uiNum8x8 > 0)
+    // no evidence, or group alpha adopts 8x8
+  {
+    return true;
+  }
+
+  // group beta
+  pcNeighbourCU = pcCtu->getPUAboveRight(uiNeighbourIdx, auiPartIdx[1]);
+  if (pcNeighbourCU != NULL && pcNeighbourCU->getDepth(uiNeighbourIdx) >= uiDepth8x8)
+  {
+    return true;
+  }
+  if (colocatedCU != NULL)
+  {
+    const Int iPelX  = pcCU->getCUPelX();
+    const Int iPelY  = pcCU->getCUPelY();
+    const Int iWidth = pcCU->getWidth(0);
+    const Int iHalf  = uiHalfWidth;
+    // left, above, right and bottom of the colocated 16x16 CU
+    const Int aiPelX[8] = { iPelX - iHalf, iPelX - iHalf, iPelX, iPelX + iHalf, iPelX + iWidth, iPelX + iWidth, iPelX, iPelX + iHalf };
+    const Int aiPelY[8] = { iPelY, iPelY + iHalf, iPelY - iHalf, iPelY - iHalf, iPelY, iPelY + iHalf, iPelY + iWidth, iPelY + iWidth };
+    for (UInt ui = 0; ui < 8; ui++)
+    {
+      if (getRRSPColocatedDepth(colocatedCU, aiPelX[ui], aiPelY[ui]) >= (Int)uiDepth8x8)
+      {
+        return true;
+      }
+    }
+  }
+
+  // groups alpha and beta agree that the 8x8 CUs are not adopted
+  return false;
+}
+
+/** RRSP: return the depth adopted at a luma position of the picture holding a colocated CTU
+*\param   pcColocatedCtu  colocated CTU
+*\param   iPelX           horizontal luma position in the picture
+*\param   iPelY           vertical luma position in the picture
+*\returns Int             depth, -1 if the position is outside the picture
+*/
+Int TEncCu::getRRSPColocatedDepth(TComDataCU* pcColocatedCtu, Int iPelX, Int iPelY)
+{
+  TComPic* pcPic = pcColocatedCtu->getPic();
+  TComSPS* pcSPS = pcColocatedCtu->getSlice()->getSPS();
+  if (iPelX < 0 || iPelY < 0 || iPelX >= (Int)pcSPS->getPicWidthInLumaSamples() || iPelY >= (Int)pcSPS->getPicHeightInLumaSamples())
+  {
+    return -1;
+  }
+
+  const UInt uiCtuRsAddr = (iPelY / g_uiMaxCUHeight) * pcPic->getFrameWidthInCtus() + iPelX / g_uiMaxCUWidth;
+  const UInt uiRasterIdx = ((iPelY % g_uiMaxCUHeight) / pcPic->getMinCUHeight()) * pcPic->getNumPartInCtuWidth()
+                         + (iPelX % g_uiMaxCUWidth) / pcPic->getMinCUWidth();
+  return pcPic->getCtu(uiCtuRsAddr)->getDepth(g_auiRasterToZscan[uiRasterIdx]);
+}
+
 /** RRSP: perform High Similarity degree
 *\param   pcCU
 *\param   uiPartUnitIdx
@@ -3558,7 +3853,6 @@ Void TEncCu::performRRSPHighSim(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
 
   UInt uiDepthAdoptedByAlpha;
   Bool bIsBetaAdoptsMoreThanAlpha = false;
-  static Bool isGrandfatherFrameInUse = false;
 
   for (UInt ui = 0; ui < m_uhTotalDepth - 2; ui++)
   {
@@ -3598,23 +3892,23 @@ Void TEncCu::performRRSPHighSim(TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx)
     if (iRRSPQP <= 35)
       // higher QPs tend to adopt the same CU sizes, hence skip using previous frames
     {
-      if (pcCU->getCUColocated(REF_PIC_LIST_0)->getCUColocated(REF_PIC_LIST_0) != NULL)
+      if (getColocatedCtu(getColocatedCtu(pcCU)) != NULL)
         // the current frame is at least the third frame
       {
-        if (!isGrandfatherFrameInUse)
+        if (!m_bRRSPGrandfatherInUse)
           // use only once, otherwise in an homogenous region a recursive loop might return to the start of the sequence 
         {
-          isGrandfatherFrameInUse = true;
-          buildRRSPAlphaGroup(pcCU->getCUColocated(REF_PIC_LIST_0), uiPartUnitIdx);
-          setReducedRangeDepths(getRRSPSimLevel(), pcCU->getCUColocated(REF_PIC_LIST_0), uiPartUnitIdx);
-          isGrandfatherFrameInUse = false; // reset
+          m_bRRSPGrandfatherInUse = true;
+          buildRRSPAlphaGroup(getColocatedCtu(pcCU), uiPartUnitIdx);
+          setReducedRangeDepths(getRRSPSimLevel(), getColocatedCtu(pcCU), uiPartUnitIdx);
+          m_bRRSPGrandfatherInUse = false; // reset
           if (uiDepthAdoptedByAlpha > 0)
           {
             m_bReducedRangeDepths[uiDepthAdoptedByAlpha - 1] = true; // similar smaller CUs might combine into a larger CU
           }
         }
       }
-      else if (!isGrandfatherFrameInUse && uiDepthAdoptedByAlpha > 0)
+      else if (!m_bRRSPGrandfatherInUse && uiDepthAdoptedByAlpha > 0)
         // evaluating the second frame
       {
         // similar smaller CUs might combine into a larger CU
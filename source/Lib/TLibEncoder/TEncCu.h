@@ -49,6 +49,7 @@
 #include "TEncEntropy.h"
 #include "TEncSearch.h"
 #include "TEncRateCtrl.h"
+#include "TEncSBDShadow.h"
 //! \ingroup TLibEncoder
 //! \{
 
@@ -80,6 +81,7 @@ private:
                                                  ///< Used in Low similarity
   UInt                    m_uiSizeAlpha;    ///< Size of group alpha for the current CTU 
                                             ///< Used in Medium Low similarity
+  Bool                    m_bSBDActive;     ///< SBD restricts the depths of the current CTU
 
   // RRSP-related Variables
   Bool*                   m_bRRSPAdoptedDepths64x64ByA;      ///< Array of CTUs in group A that adopt 64x64
@@ -88,8 +90,16 @@ private:
   UInt*                   m_uiRRSPBetaReducedAdoptedDepths;  ///< Array of depths adopted by CUs in the reduced region of group alpha
   UInt*                   m_uiRRSPGrandfatherAdoptedDepths;  ///< Array of depths adopted by CUs in the colocated 32x32 CU of the colocated 32x32 CU
   Bool*                   m_bReducedRangeDepths;             ///< Array of depths to evaluate in the current reduced region
+  Bool                    m_bRRSPActive;                     ///< RRSP restricts the depths of the current CTU (inter slice with a colocated CTU)
   UInt                    m_RRSPNumOfCTUsInA;                ///< How many CTUs are included in group A for the current CTU
   UInt                    m_RRSPNumOfCTUsInB;                ///< How many CTUs are included in group B for the current CTU
+  Bool                    m_bRRSPGrandfatherInUse;           ///< The colocated CU of the colocated CU is being evaluated (limits the recursion to one level)
+
+  // SBD shadow mode
+  TEncSBDShadow*          m_pcSBDShadow;                     ///< statistics of the SBD shadow mode, NULL if not collected
+  Bool*                   m_bShadowRangeDepths;              ///< depth range selected by SBD for the current shadow CTU
+  UChar*                  m_puhShadowDepths;                 ///< CU depths selected by the full search of the current shadow CTU
+  TComMv                  m_acShadowIntegerMv2Nx2N[NUM_REF_PIC_LIST_01][MAX_NUM_REF]; ///< fast search start points before the full search
 
 
   TComYuv**               m_ppcPredYuvBest; ///< Best Prediction Yuv for each depth
@@ -123,6 +133,10 @@ public:
   /// copy parameters from encoder class
   Void  init                ( TEncTop* pcEncTop );
 
+  /// set up with explicit processing units, used by encoders that run on their own thread
+  Void  init                ( TEncCfg* pcEncCfg, TEncSearch* pcPredSearch, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost,
+                              TEncEntropy* pcEntropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder, TEncRateCtrl* pcRateCtrl );
+
   /// create internal buffers
   Void  create              ( UChar uhTotalDepth, UInt iMaxWidth, UInt iMaxHeight, ChromaFormat chromaFormat );
 
@@ -135,6 +149,9 @@ public:
   /// CTU encoding function
   Void  encodeCtu           ( TComDataCU*  pCtu );
 
+  /// statistics the SBD shadow mode reports to
+  Void  setSBDShadow        ( TEncSBDShadow* pcSBDShadow ) { m_pcSBDShadow = pcSBDShadow; }
+
   Int   updateCtuDataISlice ( TComDataCU* pCtu, Int width, Int height );
 
 protected:
@@ -201,6 +218,15 @@ protected:
   Void  getAdoptedDepthsRight     (TComDataCU* pcCU, Bool* bDepths, UInt R);
   Void  getAdoptedDepthsBottom    (TComDataCU* pcCU, Bool* bDepths, UInt R);
   Void  getAdoptedDepthsColocated (TComDataCU* pcCU, Bool* bDepths, UInt R);
+  Void  xGetAdoptedDepthsInRegion (TComDataCU* pcCtu, Bool* bDepths, UInt uiX, UInt uiY, UInt uiWidth, UInt uiHeight);
+
+  // colocated CTU of SBD and RRSP, in the reference picture selected by SBDColocatedRef
+  TComDataCU* getColocatedCtu     (TComDataCU* pcCU, Bool bOtherList = false);
+  Bool  xSelectColocatedRef       (TComDataCU* pcCU, RefPicList eExcludedList, RefPicList& reRefPicList, Int& riRefIdx);
+
+  // SBD shadow mode
+  Void  xCompressCtuFullRange     (TComDataCU* pCtu, Double& rdTime, Double& rdCost);
+  Void  xAddShadowResult          (TComDataCU* pCtu, TEncSBDShadow::SimLevel eSimLevel, Double dFullTime, Double dSBDTime, Double dFullCost);
 
   Void  initGroupAlpha();
   Void  updateGroupAlpha(Bool* bDepths);
@@ -208,6 +234,9 @@ protected:
   // builds the array of depths that are adopted by group alpha
   Void  buildGroupAlpha(TComDataCU* pcCU);
 
+  // builds group alpha from the spatial neighbours only, for intra slices
+  Void  buildSpatialGroupAlpha(TComDataCU* pcCU);
+
   Void  initGroupBeta();
   Void  updateGroupBeta(Bool* bDepths);
 
@@ -229,6 +258,10 @@ protected:
   Void  performMediumLowSim();
   Void  performLowSim();
 
+  // spatial-only SBD in intra slices, returns the similarity level
+  TEncSBDShadow::SimLevel performIntraSim();
+  Void  performIntraHighSim();
+
   // RRSP-related Functions
   Void  evaluateGroupA64x64   (TComDataCU* pcCU);
   Void  evaluateGroupB64x64   (TComDataCU* pcCU);
@@ -240,6 +273,8 @@ protected:
   Void  performRRSPLowSim     (TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx);
   Void  performRRSPMediumSim  (TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx);
   Void  performRRSPHighSim    (TComDataCU* pcCU, RRSP32x32CU uiPartUnitIdx);
+  Bool  evaluateRRSP8x8       (TComDataCU* pcCU);
+  Int   getRRSPColocatedDepth (TComDataCU* pcColocatedCtu, Int iPelX, Int iPelY);
 };
 
 //! \}
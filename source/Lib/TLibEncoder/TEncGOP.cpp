@@ -85,7 +85,13 @@ TEncGOP::TEncGOP()
 
   m_pcCfg               = NULL;
   m_pcSliceEncoder      = NULL;
+  m_pcThreadPool        = NULL;
+  m_pcPicWorkers        = NULL;
+  m_iNumPicWorkers      = 0;
   m_pcListPic           = NULL;
+  m_pcIncLFPic          = NULL;
+  m_uiIncLFCompressedRows = 0;
+  m_uiIncLFDoneSteps    = 0;
 
   m_pcEntropyCoder      = NULL;
   m_pcCavlcCoder        = NULL;
@@ -122,6 +128,16 @@ Void  TEncGOP::create()
 
 Void  TEncGOP::destroy()
 {
+  if ( m_pcPicWorkers )
+  {
+    for ( Int i = 0; i < m_iNumPicWorkers; i++ )
+    {
+      m_pcPicWorkers[i].destroy();
+    }
+    delete [] m_pcPicWorkers;
+    m_pcPicWorkers   = NULL;
+    m_iNumPicWorkers = 0;
+  }
 }
 
 Void TEncGOP::init ( TEncTop* pcTEncTop )
@@ -142,6 +158,17 @@ Void TEncGOP::init ( TEncTop* pcTEncTop )
   m_lastBPSEI          = 0;
   m_totalCoded         = 0;
 
+  // create one picture worker per picture compressed at the same time, the pictures are tasks of the thread pool
+  m_pcThreadPool = pcTEncTop->getThreadPool();
+  if ( m_pcThreadPool && m_pcCfg->getNumFrameThreads() > 1 )
+  {
+    m_iNumPicWorkers = m_pcCfg->getNumFrameThreads();
+    m_pcPicWorkers   = new TEncPicWorker[m_iNumPicWorkers];
+    for ( Int i = 0; i < m_iNumPicWorkers; i++ )
+    {
+      m_pcPicWorkers[i].create( pcTEncTop, this );
+    }
+  }
 }
 
 SEIActiveParameterSets* TEncGOP::xCreateSEIActiveParameterSets (TComSPS *sps)
@@ -611,6 +638,10 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     m_pcCfg->setEncodedFlag(iGOPid, false);
   }
 
+  // several pictures are compressed at the same time by the picture workers, the slices are written in coding order
+  const Bool bConcurrentPictures = xUseConcurrentPictures( isField );
+  Int        iNextGOPidToStart   = 0;
+
   for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
   {
 #if EFFICIENT_FIELD_IRAP
@@ -641,72 +672,11 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     }
 #endif
 
-    UInt uiColDir = 1;
     //-- For time output for each slice
     clock_t iBeforeTime = clock();
 
-    //select uiColDir
-    Int iCloseLeft=1, iCloseRight=-1;
-    for(Int i = 0; i<m_pcCfg->getGOPEntry(iGOPid).m_numRefPics; i++)
-    {
-      Int iRef = m_pcCfg->getGOPEntry(iGOPid).m_referencePics[i];
-      if(iRef>0&&(iRef<iCloseRight||iCloseRight==-1))
-      {
-        iCloseRight=iRef;
-      }
-      else if(iRef<0&&(iRef>iCloseLeft||iCloseLeft==1))
-      {
-        iCloseLeft=iRef;
-      }
-    }
-    if(iCloseRight>-1)
-    {
-      iCloseRight=iCloseRight+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
-    }
-    if(iCloseLeft<1)
-    {
-      iCloseLeft=iCloseLeft+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
-      while(iCloseLeft<0)
-      {
-        iCloseLeft+=m_iGopSize;
-      }
-    }
-    Int iLeftQP=0, iRightQP=0;
-    for(Int i=0; i<m_iGopSize; i++)
-    {
-      if(m_pcCfg->getGOPEntry(i).m_POC==(iCloseLeft%m_iGopSize)+1)
-      {
-        iLeftQP= m_pcCfg->getGOPEntry(i).m_QPOffset;
-      }
-      if (m_pcCfg->getGOPEntry(i).m_POC==(iCloseRight%m_iGopSize)+1)
-      {
-        iRightQP=m_pcCfg->getGOPEntry(i).m_QPOffset;
-      }
-    }
-    if(iCloseRight>-1&&iRightQP<iLeftQP)
-    {
-      uiColDir=0;
-    }
-
-    /////////////////////////////////////////////////////////////////////////////////////////////////// Initial to start encoding
     Int iTimeOffset;
-    Int pocCurr;
-
-    if(iPOCLast == 0) //case first frame or first top field
-    {
-      pocCurr=0;
-      iTimeOffset = 1;
-    }
-    else if(iPOCLast == 1 && isField) //case first bottom field, just like the first frame, the poc computation is not right anymore, we set the right value
-    {
-      pocCurr = 1;
-      iTimeOffset = 1;
-    }
-    else
-    {
-      pocCurr = iPOCLast - iNumPicRcvd + m_pcCfg->getGOPEntry(iGOPid).m_POC - ((isField && m_iGopSize>1) ? 1:0);
-      iTimeOffset = m_pcCfg->getGOPEntry(iGOPid).m_POC;
-    }
+    Int pocCurr = xGetPOCCurr( iPOCLast, iNumPicRcvd, iGOPid, isField, iTimeOffset );
 
     if(pocCurr>=m_pcCfg->getFramesToBeEncoded())
     {
@@ -742,446 +712,148 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       continue;
     }
 
-    if( getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_N_LP )
-    {
-      m_iLastIDR = pocCurr;
-    }
-    // start a new access unit: create an entry in the list of output access units
-    accessUnitsInGOP.push_back(AccessUnit());
-    AccessUnit& accessUnit = accessUnitsInGOP.back();
-    xGetBuffer( rcListPic, rcListPicYuvRecOut, iNumPicRcvd, iTimeOffset, pcPic, pcPicYuvRecOut, pocCurr, isField );
-
-    //  Slice data initialization
-    pcPic->clearSliceBuffer();
-    assert(pcPic->getNumAllocatedSlice() == 1);
-    m_pcSliceEncoder->setSliceIdx(0);
-    pcPic->setCurrSliceIdx(0);
-
-    m_pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iNumPicRcvd, iGOPid, pcSlice, m_pcEncTop->getSPS(), m_pcEncTop->getPPS(), isField );
-
-    //Set Frame/Field coding
-    pcSlice->getPic()->setField(isField);
+    Double lambda            = 0.0;
+    Int actualHeadBits       = 0;
+    Int actualTotalBits      = 0;
+    Int estimatedBits        = 0;
+    Int tmpBitsBeforeWriting = 0;
+    UInt uiNumSliceSegments  = 1;
+    Bool bIncrementalLoopFilter = false;
+    Bool bReferenced            = true;
+    TEncPicWorker* pcPicWorker  = NULL;
 
-    pcSlice->setLastIDR(m_iLastIDR);
-    pcSlice->setSliceIdx(0);
-    //set default slice level flag to the same as SPS level flag
-    pcSlice->setLFCrossSliceBoundaryFlag(  pcSlice->getPPS()->getLoopFilterAcrossSlicesEnabledFlag()  );
-    pcSlice->setScalingList ( m_pcEncTop->getScalingList()  );
-    if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_OFF)
+    if ( bConcurrentPictures )
     {
-      m_pcEncTop->getTrQuant()->setFlatScalingList(pcSlice->getSPS()->getChromaFormatIdc());
-      m_pcEncTop->getTrQuant()->setUseScalingList(false);
-      m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
-    }
-    else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_DEFAULT)
-    {
-      pcSlice->setDefaultScalingList ();
-      m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getTrQuant()->setScalingList(pcSlice->getScalingList(), pcSlice->getSPS()->getChromaFormatIdc());
-      m_pcEncTop->getTrQuant()->setUseScalingList(true);
-    }
-    else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_FILE_READ)
-    {
-      pcSlice->setDefaultScalingList ();
-      if(pcSlice->getScalingList()->xParseScalingList(m_pcCfg->getScalingListFile()))
+      // keep the picture workers busy: prepare and start the following pictures in coding order. The worker of a
+      // picture is free again once the picture it compressed before (m_iNumPicWorkers back) has been written.
+      for ( ; iNextGOPidToStart < std::min( iGOPid + m_iNumPicWorkers, m_iGopSize ); iNextGOPidToStart++ )
       {
-        Bool bParsedScalingList=false; // Use of boolean so that assertion outputs useful string
-        assert(bParsedScalingList);
-        exit(1);
-      }
-      pcSlice->getScalingList()->checkDcOfMatrix();
-      m_pcEncTop->getSPS()->setScalingListPresentFlag(pcSlice->checkDefaultScalingList());
-      m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
-      m_pcEncTop->getTrQuant()->setScalingList(pcSlice->getScalingList(), pcSlice->getSPS()->getChromaFormatIdc());
-      m_pcEncTop->getTrQuant()->setUseScalingList(true);
+        Int iNextTimeOffset;
+        const Int pocNext = xGetPOCCurr( iPOCLast, iNumPicRcvd, iNextGOPidToStart, isField, iNextTimeOffset );
+        if ( pocNext >= m_pcCfg->getFramesToBeEncoded() )
+        {
+          continue;
+        }
+        TEncPicWorker* pcWorker     = &m_pcPicWorkers[iNextGOPidToStart % m_iNumPicWorkers];
+        const clock_t  iStartTime   = clock();
+        TComPic*       pcNextPic    = NULL;
+        TComPicYuv*    pcNextRecOut = NULL;
+        m_pcThreadPool->wait( pcWorker->getTaskGroup() );
+        xPreparePicture( iPOCLast, iNumPicRcvd, iNextGOPidToStart, pocNext, iNextTimeOffset, rcListPic, rcListPicYuvRecOut, isField,
+                         pcWorker->getSliceEncoder(), pcNextPic, pcNextRecOut );
+        pcWorker->setPicture( pcNextPic, pcNextRecOut, iStartTime );
+        m_pcThreadPool->submit( pcWorker, pcWorker->getTaskGroup() );
+      }
+
+      // wait for the compression of the current picture, its slices are written below
+      pcPicWorker = &m_pcPicWorkers[iGOPid % m_iNumPicWorkers];
+      m_pcThreadPool->wait( pcPicWorker->getTaskGroup() );
+      pcPic              = pcPicWorker->getPic();
+      pcPicYuvRecOut     = pcPicWorker->getPicYuvRecOut();
+      iBeforeTime        = pcPicWorker->getBeforeTime();
+      uiNumSliceSegments = pcPicWorker->getNumSliceSegments();
+      bReferenced        = pcPicWorker->isReferenced();
+      // the worker may have run the in-loop filters already, together with the compression
+      bIncrementalLoopFilter = pcPicWorker->filtersCtuRows();
     }
     else
     {
-      printf("error : ScalingList == %d no support\n",m_pcEncTop->getUseScalingListId());
-      assert(0);
-    }
-
-    if(pcSlice->getSliceType()==B_SLICE&&m_pcCfg->getGOPEntry(iGOPid).m_sliceType=='P')
-    {
-      pcSlice->setSliceType(P_SLICE);
-    }
-    if(pcSlice->getSliceType()==B_SLICE&&m_pcCfg->getGOPEntry(iGOPid).m_sliceType=='I')
-    {
-      pcSlice->setSliceType(I_SLICE);
-    }
-    
-    // Set the nal unit type
-    pcSlice->setNalUnitType(getNalUnitType(pocCurr, m_iLastIDR, isField));
-    if(pcSlice->getTemporalLayerNonReferenceFlag())
-    {
-      if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_TRAIL_R &&
-          !(m_iGopSize == 1 && pcSlice->getSliceType() == I_SLICE))
-        // Add this condition to avoid POC issues with encoder_intra_main.cfg configuration (see #1127 in bug tracker)
-      {
-        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TRAIL_N);
-      }
-      if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RADL_R)
-      {
-        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RADL_N);
-      }
-      if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RASL_R)
-      {
-        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RASL_N);
-      }
-    }
-
-#if EFFICIENT_FIELD_IRAP
-    if ( pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_W_LP
-      || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_W_RADL
-      || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_N_LP
-      || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_IDR_W_RADL
-      || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_IDR_N_LP
-      || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA )  // IRAP picture
-    {
-      m_associatedIRAPType = pcSlice->getNalUnitType();
-      m_associatedIRAPPOC = pocCurr;
-    }
-    pcSlice->setAssociatedIRAPType(m_associatedIRAPType);
-    pcSlice->setAssociatedIRAPPOC(m_associatedIRAPPOC);
-#endif
-    // Do decoding refresh marking if any
-    pcSlice->decodingRefreshMarking(m_pocCRA, m_bRefreshPending, rcListPic);
-    m_pcEncTop->selectReferencePictureSet(pcSlice, pocCurr, iGOPid);
-    pcSlice->getRPS()->setNumberOfLongtermPictures(0);
-#if !EFFICIENT_FIELD_IRAP
-    if ( pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_W_LP
-      || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_W_RADL
-      || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_N_LP
-      || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_IDR_W_RADL
-      || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_IDR_N_LP
-      || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA )  // IRAP picture
-    {
-      m_associatedIRAPType = pcSlice->getNalUnitType();
-      m_associatedIRAPPOC = pocCurr;
-    }
-    pcSlice->setAssociatedIRAPType(m_associatedIRAPType);
-    pcSlice->setAssociatedIRAPPOC(m_associatedIRAPPOC);
-#endif
-
-#if ALLOW_RECOVERY_POINT_AS_RAP
-    if ((pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false, m_iLastRecoveryPicPOC, m_pcCfg->getDecodingRefreshType() == 3) != 0) || (pcSlice->isIRAP()) 
-#if EFFICIENT_FIELD_IRAP
-      || (isField && pcSlice->getAssociatedIRAPType() >= NAL_UNIT_CODED_SLICE_BLA_W_LP && pcSlice->getAssociatedIRAPType() <= NAL_UNIT_CODED_SLICE_CRA && pcSlice->getAssociatedIRAPPOC() == pcSlice->getPOC()+1)
-#endif
-      )
-    {
-      pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS(), pcSlice->isIRAP(), m_iLastRecoveryPicPOC, m_pcCfg->getDecodingRefreshType() == 3);
-    }
-#else
-    if ((pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false) != 0) || (pcSlice->isIRAP()))
-    {
-      pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS(), pcSlice->isIRAP());
-    }
-#endif
-
-    pcSlice->applyReferencePictureSet(rcListPic, pcSlice->getRPS());
-
-    if(pcSlice->getTLayer() > 0 
-      &&  !( pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL_N     // Check if not a leading picture
-          || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL_R
-          || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL_N
-          || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL_R )
-        )
-    {
-      if(pcSlice->isTemporalLayerSwitchingPoint(rcListPic) || pcSlice->getSPS()->getTemporalIdNestingFlag())
+      xPreparePicture( iPOCLast, iNumPicRcvd, iGOPid, pocCurr, iTimeOffset, rcListPic, rcListPicYuvRecOut, isField, m_pcSliceEncoder, pcPic, pcPicYuvRecOut );
+      pcSlice     = pcPic->getSlice(0);
+      bReferenced = pcSlice->isReferenced();
+      if ( m_pcCfg->getUseRateCtrl() )
       {
-        if(pcSlice->getTemporalLayerNonReferenceFlag())
+        Int frameLevel = m_pcRateCtrl->getRCSeq()->getGOPID2Level( iGOPid );
+        if ( pcPic->getSlice(0)->getSliceType() == I_SLICE )
         {
-          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TSA_N);
+          frameLevel = 0;
         }
-        else
+        m_pcRateCtrl->initRCPic( frameLevel );
+        estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
+
+        Int sliceQP = m_pcCfg->getInitialQP();
+        if ( ( pcSlice->getPOC() == 0 && m_pcCfg->getInitialQP() > 0 ) || ( frameLevel == 0 && m_pcCfg->getForceIntraQP() ) ) // QP is specified
         {
-          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TSA_R);
+          Int    NumberBFrames = ( m_pcCfg->getGOPSize() - 1 );
+          Double dLambda_scale = 1.0 - Clip3( 0.0, 0.5, 0.05*(Double)NumberBFrames );
+          Double dQPFactor     = 0.57*dLambda_scale;
+          Int    SHIFT_QP      = 12;
+          Int    bitdepth_luma_qp_scale = 0;
+          Double qp_temp = (Double) sliceQP + bitdepth_luma_qp_scale - SHIFT_QP;
+          lambda = dQPFactor*pow( 2.0, qp_temp/3.0 );
         }
-      }
-      else if(pcSlice->isStepwiseTemporalLayerSwitchingPointCandidate(rcListPic))
-      {
-        Bool isSTSA=true;
-        for(Int ii=iGOPid+1;(ii<m_pcCfg->getGOPSize() && isSTSA==true);ii++)
+        else if ( frameLevel == 0 )   // intra case, but use the model
         {
-          Int lTid= m_pcCfg->getGOPEntry(ii).m_temporalId;
-          if(lTid==pcSlice->getTLayer())
+          m_pcSliceEncoder->calCostSliceI(pcPic);
+
+          if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
           {
-            TComReferencePictureSet* nRPS = pcSlice->getSPS()->getRPSList()->getReferencePictureSet(ii);
-            for(Int jj=0;jj<nRPS->getNumberOfPictures();jj++)
+            Int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
+            bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
+            if ( bits < 200 )
             {
-              if(nRPS->getUsed(jj))
-              {
-                Int tPoc=m_pcCfg->getGOPEntry(ii).m_POC+nRPS->getDeltaPOC(jj);
-                Int kk=0;
-                for(kk=0;kk<m_pcCfg->getGOPSize();kk++)
-                {
-                  if(m_pcCfg->getGOPEntry(kk).m_POC==tPoc)
-                    break;
-                }
-                Int tTid=m_pcCfg->getGOPEntry(kk).m_temporalId;
-                if(tTid >= pcSlice->getTLayer())
-                {
-                  isSTSA=false;
-                  break;
-                }
-              }
+              bits = 200;
             }
+            m_pcRateCtrl->getRCPic()->setTargetBits( bits );
           }
-        }
-        if(isSTSA==true)
-        {
-          if(pcSlice->getTemporalLayerNonReferenceFlag())
-          {
-            pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_N);
-          }
-          else
-          {
-            pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_R);
-          }
-        }
-      }
-    }
-    arrangeLongtermPicturesInRPS(pcSlice, rcListPic);
-    TComRefPicListModification* refPicListModification = pcSlice->getRefPicListModification();
-    refPicListModification->setRefPicListModificationFlagL0(0);
-    refPicListModification->setRefPicListModificationFlagL1(0);
-    pcSlice->setNumRefIdx(REF_PIC_LIST_0,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
-    pcSlice->setNumRefIdx(REF_PIC_LIST_1,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
-
-#if ADAPTIVE_QP_SELECTION
-    pcSlice->setTrQuant( m_pcEncTop->getTrQuant() );
-#endif
-
-    //  Set reference list
-    pcSlice->setRefPicList ( rcListPic );
-
-    //  Slice info. refinement
-    if ( (pcSlice->getSliceType() == B_SLICE) && (pcSlice->getNumRefIdx(REF_PIC_LIST_1) == 0) )
-    {
-      pcSlice->setSliceType ( P_SLICE );
-    }
-
-    if (pcSlice->getSliceType() == B_SLICE)
-    {
-      pcSlice->setColFromL0Flag(1-uiColDir);
-      Bool bLowDelay = true;
-      Int  iCurrPOC  = pcSlice->getPOC();
-      Int iRefIdx = 0;
 
-      for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_0) && bLowDelay; iRefIdx++)
-      {
-        if ( pcSlice->getRefPic(REF_PIC_LIST_0, iRefIdx)->getPOC() > iCurrPOC )
-        {
-          bLowDelay = false;
-        }
-      }
-      for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_1) && bLowDelay; iRefIdx++)
-      {
-        if ( pcSlice->getRefPic(REF_PIC_LIST_1, iRefIdx)->getPOC() > iCurrPOC )
-        {
-          bLowDelay = false;
+          list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
+          m_pcRateCtrl->getRCPic()->getLCUInitTargetBits();
+          lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
+          sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
         }
-      }
-
-      pcSlice->setCheckLDC(bLowDelay);
-    }
-    else
-    {
-      pcSlice->setCheckLDC(true);
-    }
-
-    uiColDir = 1-uiColDir;
-
-    //-------------------------------------------------------------
-    pcSlice->setRefPOCList();
-
-    pcSlice->setList1IdxToList0Idx();
-
-    if (m_pcEncTop->getTMVPModeId() == 2)
-    {
-      if (iGOPid == 0) // first picture in SOP (i.e. forward B)
-      {
-        pcSlice->setEnableTMVPFlag(0);
-      }
-      else
-      {
-        // Note: pcSlice->getColFromL0Flag() is assumed to be always 0 and getcolRefIdx() is always 0.
-        pcSlice->setEnableTMVPFlag(1);
-      }
-      pcSlice->getSPS()->setTMVPFlagsPresent(1);
-    }
-    else if (m_pcEncTop->getTMVPModeId() == 1)
-    {
-      pcSlice->getSPS()->setTMVPFlagsPresent(1);
-      pcSlice->setEnableTMVPFlag(1);
-    }
-    else
-    {
-      pcSlice->getSPS()->setTMVPFlagsPresent(0);
-      pcSlice->setEnableTMVPFlag(0);
-    }
-    /////////////////////////////////////////////////////////////////////////////////////////////////// Compress a slice
-    //  Slice compression
-    if (m_pcCfg->getUseASR())
-    {
-      m_pcSliceEncoder->setSearchRange(pcSlice);
-    }
-
-    Bool bGPBcheck=false;
-    if ( pcSlice->getSliceType() == B_SLICE)
-    {
-      if ( pcSlice->getNumRefIdx(RefPicList( 0 ) ) == pcSlice->getNumRefIdx(RefPicList( 1 ) ) )
-      {
-        bGPBcheck=true;
-        Int i;
-        for ( i=0; i < pcSlice->getNumRefIdx(RefPicList( 1 ) ); i++ )
+        else    // normal case
         {
-          if ( pcSlice->getRefPOC(RefPicList(1), i) != pcSlice->getRefPOC(RefPicList(0), i) )
-          {
-            bGPBcheck=false;
-            break;
-          }
+          list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
+          lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
+          sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
         }
-      }
-    }
-    if(bGPBcheck)
-    {
-      pcSlice->setMvdL1ZeroFlag(true);
-    }
-    else
-    {
-      pcSlice->setMvdL1ZeroFlag(false);
-    }
-    pcPic->getSlice(pcSlice->getSliceIdx())->setMvdL1ZeroFlag(pcSlice->getMvdL1ZeroFlag());
 
-    pcPic->getPicSym()->initTiles(pcSlice->getPPS());
-    pcPic->getPicSym()->initCtuTsRsAddrMaps();
+        sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, sliceQP );
+        m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
 
-    Double lambda            = 0.0;
-    Int actualHeadBits       = 0;
-    Int actualTotalBits      = 0;
-    Int estimatedBits        = 0;
-    Int tmpBitsBeforeWriting = 0;
-    if ( m_pcCfg->getUseRateCtrl() )
-    {
-      Int frameLevel = m_pcRateCtrl->getRCSeq()->getGOPID2Level( iGOPid );
-      if ( pcPic->getSlice(0)->getSliceType() == I_SLICE )
-      {
-        frameLevel = 0;
+        m_pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
       }
-      m_pcRateCtrl->initRCPic( frameLevel );
-      estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
 
-      Int sliceQP = m_pcCfg->getInitialQP();
-      if ( ( pcSlice->getPOC() == 0 && m_pcCfg->getInitialQP() > 0 ) || ( frameLevel == 0 && m_pcCfg->getForceIntraQP() ) ) // QP is specified
-      {
-        Int    NumberBFrames = ( m_pcCfg->getGOPSize() - 1 );
-        Double dLambda_scale = 1.0 - Clip3( 0.0, 0.5, 0.05*(Double)NumberBFrames );
-        Double dQPFactor     = 0.57*dLambda_scale;
-        Int    SHIFT_QP      = 12;
-        Int    bitdepth_luma_qp_scale = 0;
-        Double qp_temp = (Double) sliceQP + bitdepth_luma_qp_scale - SHIFT_QP;
-        lambda = dQPFactor*pow( 2.0, qp_temp/3.0 );
-      }
-      else if ( frameLevel == 0 )   // intra case, but use the model
+      bIncrementalLoopFilter = xUseIncrementalLoopFilter( pcPic );
+      if ( bIncrementalLoopFilter )
       {
-        m_pcSliceEncoder->calCostSliceI(pcPic);
-
-        if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
-        {
-          Int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
-          bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
-          if ( bits < 200 )
-          {
-            bits = 200;
-          }
-          m_pcRateCtrl->getRCPic()->setTargetBits( bits );
-        }
-
-        list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
-        m_pcRateCtrl->getRCPic()->getLCUInitTargetBits();
-        lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
-        sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
+        xStartIncrementalLoopFilter( pcPic );
       }
-      else    // normal case
+      uiNumSliceSegments = compressPicture( pcPic, m_pcSliceEncoder );
+      if ( bIncrementalLoopFilter )
       {
-        list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
-        lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
-        sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
+        xFinishIncrementalLoopFilter();
       }
-
-      sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, sliceQP );
-      m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
-
-      m_pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
     }
 
-    UInt uiNumSliceSegments = 1;
+    // start a new access unit: create an entry in the list of output access units
+    accessUnitsInGOP.push_back(AccessUnit());
+    AccessUnit& accessUnit = accessUnitsInGOP.back();
 
+    pcSlice = pcPic->getSlice(0);
 
     // Allocate some coders, now the number of tiles are known.
     const Int numSubstreams = pcSlice->getPPS()->getNumSubstreams();
     std::vector<TComOutputBitstream> substreamsOut(numSubstreams);
-
-    // now compress (trial encode) the various slice segments (slices, and dependent slices)
+    // the picture is deblocked and its SAO statistics are collected already if the filters trailed its compression
+    if ( !bIncrementalLoopFilter )
     {
-      const UInt numberOfCtusInFrame=pcPic->getPicSym()->getNumberOfCtusInFrame();
-      pcSlice->setSliceCurStartCtuTsAddr( 0 );
-      pcSlice->setSliceSegmentCurStartCtuTsAddr( 0 );
-
-      for(UInt nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
+      // SAO parameter estimation using non-deblocked pixels for CTU bottom and right boundary areas
+      if( pcSlice->getSPS()->getUseSAO() && m_pcCfg->getSaoCtuBoundary() )
       {
-        m_pcSliceEncoder->precompressSlice( pcPic );
-        m_pcSliceEncoder->compressSlice   ( pcPic );
-
-        const UInt curSliceSegmentEnd = pcSlice->getSliceSegmentCurEndCtuTsAddr();
-        if (curSliceSegmentEnd < numberOfCtusInFrame)
-        {
-          const Bool bNextSegmentIsDependentSlice=curSliceSegmentEnd<pcSlice->getSliceCurEndCtuTsAddr();
-          const UInt sliceBits=pcSlice->getSliceBits();
-          pcPic->allocateNewSlice();
-          // prepare for next slice
-          pcPic->setCurrSliceIdx                    ( uiNumSliceSegments );
-          m_pcSliceEncoder->setSliceIdx             ( uiNumSliceSegments   );
-          pcSlice = pcPic->getSlice                 ( uiNumSliceSegments   );
-          pcSlice->copySliceInfo                    ( pcPic->getSlice(uiNumSliceSegments-1)  );
-          pcSlice->setSliceIdx                      ( uiNumSliceSegments   );
-          if (bNextSegmentIsDependentSlice)
-          {
-            pcSlice->setSliceBits(sliceBits);
-          }
-          else
-          {
-            pcSlice->setSliceCurStartCtuTsAddr      ( curSliceSegmentEnd );
-            pcSlice->setSliceBits(0);
-          }
-          pcSlice->setDependentSliceSegmentFlag(bNextSegmentIsDependentSlice);
-          pcSlice->setSliceSegmentCurStartCtuTsAddr ( curSliceSegmentEnd );
-          uiNumSliceSegments ++;
-        }
-        nextCtuTsAddr = curSliceSegmentEnd;
+        m_pcSAO->getPreDBFStatistics(pcPic);
       }
-    }
-
-    pcSlice = pcPic->getSlice(0);
 
-    // SAO parameter estimation using non-deblocked pixels for CTU bottom and right boundary areas
-    if( pcSlice->getSPS()->getUseSAO() && m_pcCfg->getSaoCtuBoundary() )
-    {
-      m_pcSAO->getPreDBFStatistics(pcPic);
-    }
-
-    //-- Loop filter
-    Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
-    m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
-    if ( m_pcCfg->getDeblockingFilterMetric() )
-    {
-      dblMetric(pcPic, uiNumSliceSegments);
+      //-- Loop filter
+      Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
+      m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
+      if ( m_pcCfg->getDeblockingFilterMetric() )
+      {
+        dblMetric(pcPic, uiNumSliceSegments);
+      }
+      m_pcLoopFilter->loopFilterPic( pcPic );
     }
-    m_pcLoopFilter->loopFilterPic( pcPic );
 
     /////////////////////////////////////////////////////////////////////////////////////////////////// File writing
     // Set entropy coder
@@ -1476,17 +1148,29 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     if (pcSlice->getSPS()->getUseSAO())
     {
       Bool sliceEnabled[MAX_NUM_COMPONENT];
-      TComBitCounter tempBitCounter;
-      tempBitCounter.resetBits();
-      m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(&tempBitCounter);
-      m_pcSAO->initRDOCabacCoder(m_pcEncTop->getRDGoOnSbacCoder(), pcSlice);
-      m_pcSAO->SAOProcess(pcPic, sliceEnabled, pcPic->getSlice(0)->getLambdas()
+      if ( pcPicWorker && pcPicWorker->filtersCtuRows() )
+      {
+        // decided and applied by the picture worker, CTU row by CTU row
+        ::memcpy( sliceEnabled, pcPicWorker->getSAO()->getRowSliceEnabled(), sizeof( sliceEnabled ) );
+#if SAO_ENCODING_CHOICE
+        m_pcSAO->copyDisabledRate( pcPicWorker->getSAO(), pcSlice->getDepth() );
+#endif
+      }
+      else
+      {
+        TComBitCounter tempBitCounter;
+        tempBitCounter.resetBits();
+        m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(&tempBitCounter);
+        m_pcSAO->initRDOCabacCoder(m_pcEncTop->getRDGoOnSbacCoder(), pcSlice);
+        m_pcSAO->SAOProcess(pcPic, sliceEnabled, pcPic->getSlice(0)->getLambdas()
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
-                          , m_pcCfg->getSaoCtuBoundary()
+                            , m_pcCfg->getSaoCtuBoundary()
 #endif
-                         );
-      m_pcSAO->PCMLFDisableProcess(pcPic);
-      m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(NULL);
+                            , bIncrementalLoopFilter
+                           );
+        m_pcSAO->PCMLFDisableProcess(pcPic);
+        m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(NULL);
+      }
 
       //assign SAO slice header
       for(Int s=0; s< uiNumSliceSegments; s++)
@@ -1519,6 +1203,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         substreamsOut[ui].clear();
       }
 
+      pcSlice->setEncCABACTableIdx( pcSlice->getPPS()->getEncCABACTableIdx() );
       m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder, pcSlice );
       m_pcEntropyCoder->resetEntropy      ();
       /* start slice NALunit */
@@ -1657,7 +1342,13 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       }
     }
 
-    pcPic->compressMotion();
+    // the motion of a picture filtered by its worker may be read already as colocated motion by the following
+    // pictures; it is read at the positions that the compression keeps (see TComDataCU::xGetColMVP), so the
+    // compression is left out for it rather than changing the motion field under the readers
+    if ( !( pcPicWorker && pcPicWorker->filtersCtuRows() ) )
+    {
+      pcPic->compressMotion();
+    }
 
     //-- For time output for each slice
     Double dEncTime = (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
@@ -1722,7 +1413,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     }
 
     m_pcCfg->setEncodedFlag(iGOPid, true);
-    xCalculateAddPSNR( pcPic, pcPic->getPicYuvRec(), accessUnit, dEncTime, snr_conversion, printFrameMSE );
+    xCalculateAddPSNR( pcPic, pcPic->getPicYuvRec(), accessUnit, dEncTime, snr_conversion, printFrameMSE, bReferenced );
 
     //In case of field coding, compute the interlaced PSNR for both fields
     if(isField)
@@ -2000,6 +1691,14 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     pcPic->getPicYuvRec()->copyToPic(pcPicYuvRecOut);
 
     pcPic->setReconMark   ( true );
+    if ( bConcurrentPictures && !pcPicWorker->filtersCtuRows() )
+    {
+      // the reference lists of the following pictures were built while this one was being compressed, which may
+      // have padded the borders of an unfinished reconstruction: pad again from the final samples
+      pcPic->getPicYuvRec()->setBorderExtension( false );
+      pcPic->getPicYuvRec()->extendPicBorder();
+    }
+    pcPic->setReconRowProgress( pcPic->getFrameHeightInCtus() );   // release the pictures that are waiting for this reference
     m_bFirst = false;
     m_iNumPicCoded++;
     m_totalCoded ++;
@@ -2109,11 +1808,631 @@ Void TEncGOP::preLoopFilterPicAll( TComPic* pcPic, UInt64& ruiDist )
     ruiDist = xFindDistortionFrame(pcPic->getPicYuvOrg(), pcPic->getPicYuvRec());
 }
 
+/** Compress (trial encode) the slice segments of a prepared picture. Runs on the thread of a picture worker when
+ * several pictures are compressed at the same time.
+ * \param pcPic           picture prepared by xPreparePicture
+ * \param pcSliceEncoder  slice encoder the picture was prepared for
+ * \returns the number of slice segments of the picture
+ */
+UInt TEncGOP::compressPicture( TComPic* pcPic, TEncSlice* pcSliceEncoder )
+{
+  TComSlice* pcSlice       = pcPic->getSlice(0);
+  UInt uiNumSliceSegments = 1;
+
+  const UInt numberOfCtusInFrame=pcPic->getPicSym()->getNumberOfCtusInFrame();
+  pcSlice->setSliceCurStartCtuTsAddr( 0 );
+  pcSlice->setSliceSegmentCurStartCtuTsAddr( 0 );
+
+  for(UInt nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
+  {
+    pcSliceEncoder->precompressSlice( pcPic );
+    pcSliceEncoder->compressSlice   ( pcPic );
+
+    const UInt curSliceSegmentEnd = pcSlice->getSliceSegmentCurEndCtuTsAddr();
+    if (curSliceSegmentEnd < numberOfCtusInFrame)
+    {
+      const Bool bNextSegmentIsDependentSlice=curSliceSegmentEnd<pcSlice->getSliceCurEndCtuTsAddr();
+      const UInt sliceBits=pcSlice->getSliceBits();
+      pcPic->allocateNewSlice();
+      // prepare for next slice
+      pcPic->setCurrSliceIdx                    ( uiNumSliceSegments );
+      pcSliceEncoder->setSliceIdx               ( uiNumSliceSegments   );
+      pcSlice = pcPic->getSlice                 ( uiNumSliceSegments   );
+      pcSlice->copySliceInfo                    ( pcPic->getSlice(uiNumSliceSegments-1)  );
+      pcSlice->setSliceIdx                      ( uiNumSliceSegments   );
+      if (bNextSegmentIsDependentSlice)
+      {
+        pcSlice->setSliceBits(sliceBits);
+      }
+      else
+      {
+        pcSlice->setSliceCurStartCtuTsAddr      ( curSliceSegmentEnd );
+        pcSlice->setSliceBits(0);
+      }
+      pcSlice->setDependentSliceSegmentFlag(bNextSegmentIsDependentSlice);
+      pcSlice->setSliceSegmentCurStartCtuTsAddr ( curSliceSegmentEnd );
+      uiNumSliceSegments ++;
+    }
+    nextCtuTsAddr = curSliceSegmentEnd;
+  }
+
+  return uiNumSliceSegments;
+}
+
+/** Record that a CTU row of a picture is compressed. Rows may finish out of order (wavefront rows on several threads),
+ * so the filter steps only use the number of rows compressed without a gap from the top of the picture.
+ * \param pcPic     picture being compressed, ignored unless it is filtered incrementally
+ * \param uiCtuRow  CTU row in the picture
+ */
+Void TEncGOP::ctuRowCompressed( TComPic* pcPic, UInt uiCtuRow )
+{
+  m_cIncLFMutex.lock();
+  if ( pcPic != m_pcIncLFPic )
+  {
+    m_cIncLFMutex.unlock();
+    return;
+  }
+  m_abIncLFRowCompressed[uiCtuRow] = true;
+  while ( m_uiIncLFCompressedRows < m_abIncLFRowCompressed.size() && m_abIncLFRowCompressed[m_uiIncLFCompressedRows] )
+  {
+    m_uiIncLFCompressedRows++;
+  }
+  m_cIncLFMutex.unlock();
+
+  if ( m_pcThreadPool )
+  {
+    m_pcThreadPool->wakeUp();
+    return;
+  }
+
+  const UInt uiNumSteps = UInt( m_abIncLFRowCompressed.size() ) + 2;
+  while ( m_uiIncLFDoneSteps < uiNumSteps && isLoopFilterStepReady( m_uiIncLFDoneSteps ) )
+  {
+    runLoopFilterStep( m_uiIncLFDoneSteps );
+  }
+}
+
+/** The steps run one after the other. Step s needs the CTU rows up to s+1 compressed: its pre-deblocking SAO
+ * statistics of row s read the first sample line of row s+1, and the deblocking of row s-1 changes samples that the
+ * intra prediction of row s reads.
+ * \param uiStep  filter step
+ * \returns true if the step can run
+ */
+Bool TEncGOP::isLoopFilterStepReady( UInt uiStep )
+{
+  m_cIncLFMutex.lock();
+  const UInt uiNumCtuRows = UInt( m_abIncLFRowCompressed.size() );
+  const Bool bReady       = m_uiIncLFDoneSteps == uiStep && m_uiIncLFCompressedRows >= std::min( uiStep + 2, uiNumCtuRows );
+  m_cIncLFMutex.unlock();
+  return bReady;
+}
+
+/** Step s of the incremental in-loop filtering collects the pre-deblocking SAO statistics of CTU row s, deblocks CTU
+ * row s-1 and collects the SAO statistics of the then final CTU row s-2, in the order of the picture-level filters.
+ * \param uiStep  filter step, from 0 to the number of CTU rows plus one
+ */
+Void TEncGOP::runLoopFilterStep( UInt uiStep )
+{
+  TComPic*   pcPic        = m_pcIncLFPic;
+  const UInt uiNumCtuRows = pcPic->getFrameHeightInCtus();
+  const Bool bUseSAO      = pcPic->getSlice(0)->getSPS()->getUseSAO();
+
+  if ( bUseSAO && m_pcCfg->getSaoCtuBoundary() && uiStep < uiNumCtuRows )
+  {
+    m_pcSAO->getPreDBFRowStatistics( pcPic, uiStep );
+  }
+  if ( uiStep >= 1 && uiStep <= uiNumCtuRows )
+  {
+    m_pcLoopFilter->loopFilterCtuRow( pcPic, uiStep - 1 );
+  }
+  if ( bUseSAO && uiStep >= 2 )
+  {
+    m_pcSAO->getRowStatistics( pcPic, uiStep - 2 );
+  }
+
+  m_cIncLFMutex.lock();
+  m_uiIncLFDoneSteps++;
+  m_cIncLFMutex.unlock();
+}
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
 
 
+/** Prepare a picture of the GOP for its compression: picture buffer, slice header, reference picture set and lists,
+ * scaling lists and tiles. The compression settings (lambda, search range, ...) are put into the given slice encoder.
+ * \param iPOCLast           POC of the last received picture
+ * \param iNumPicRcvd        number of received pictures
+ * \param iGOPid             index of the picture in the GOP
+ * \param pocCurr            POC of the picture
+ * \param iTimeOffset        position of the picture in the GOP
+ * \param rcListPic          list of pictures
+ * \param rcListPicYuvRecOut list of output buffers of the reconstructed pictures
+ * \param isField            field coding
+ * \param pcSliceEncoder     slice encoder that will compress the picture
+ * \param rpcPic             prepared picture
+ * \param rpcPicYuvRecOut    output buffer of the reconstructed picture
+ */
+Void TEncGOP::xPreparePicture( Int iPOCLast, Int iNumPicRcvd, Int iGOPid, Int pocCurr, Int iTimeOffset, TComList<TComPic*>& rcListPic,
+                               TComList<TComPicYuv*>& rcListPicYuvRecOut, Bool isField, TEncSlice* pcSliceEncoder, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut )
+{
+  TComSlice* pcSlice;
+
+  UInt uiColDir = 1;
+  //select uiColDir
+  Int iCloseLeft=1, iCloseRight=-1;
+  for(Int i = 0; i<m_pcCfg->getGOPEntry(iGOPid).m_numRefPics; i++)
+  {
+    Int iRef = m_pcCfg->getGOPEntry(iGOPid).m_referencePics[i];
+    if(iRef>0&&(iRef<iCloseRight||iCloseRight==-1))
+    {
+      iCloseRight=iRef;
+    }
+    else if(iRef<0&&(iRef>iCloseLeft||iCloseLeft==1))
+    {
+      iCloseLeft=iRef;
+    }
+  }
+  if(iCloseRight>-1)
+  {
+    iCloseRight=iCloseRight+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
+  }
+  if(iCloseLeft<1)
+  {
+    iCloseLeft=iCloseLeft+m_pcCfg->getGOPEntry(iGOPid).m_POC-1;
+    while(iCloseLeft<0)
+    {
+      iCloseLeft+=m_iGopSize;
+    }
+  }
+  Int iLeftQP=0, iRightQP=0;
+  for(Int i=0; i<m_iGopSize; i++)
+  {
+    if(m_pcCfg->getGOPEntry(i).m_POC==(iCloseLeft%m_iGopSize)+1)
+    {
+      iLeftQP= m_pcCfg->getGOPEntry(i).m_QPOffset;
+    }
+    if (m_pcCfg->getGOPEntry(i).m_POC==(iCloseRight%m_iGopSize)+1)
+    {
+      iRightQP=m_pcCfg->getGOPEntry(i).m_QPOffset;
+    }
+  }
+  if(iCloseRight>-1&&iRightQP<iLeftQP)
+  {
+    uiColDir=0;
+  }
+
+  if( getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_N_LP )
+  {
+    m_iLastIDR = pocCurr;
+  }
+  xGetBuffer( rcListPic, rcListPicYuvRecOut, iNumPicRcvd, iTimeOffset, rpcPic, rpcPicYuvRecOut, pocCurr, isField );
+
+  //  Slice data initialization
+  rpcPic->clearSliceBuffer();
+  assert(rpcPic->getNumAllocatedSlice() == 1);
+  pcSliceEncoder->setSliceIdx(0);
+  rpcPic->setCurrSliceIdx(0);
+
+  pcSliceEncoder->initEncSlice ( rpcPic, iPOCLast, pocCurr, iNumPicRcvd, iGOPid, pcSlice, m_pcEncTop->getSPS(), m_pcEncTop->getPPS(), isField );
+
+  //Set Frame/Field coding
+  pcSlice->getPic()->setField(isField);
+
+  pcSlice->setLastIDR(m_iLastIDR);
+  pcSlice->setSliceIdx(0);
+  //set default slice level flag to the same as SPS level flag
+  pcSlice->setLFCrossSliceBoundaryFlag(  pcSlice->getPPS()->getLoopFilterAcrossSlicesEnabledFlag()  );
+  pcSlice->setScalingList ( m_pcEncTop->getScalingList()  );
+  if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_OFF)
+  {
+    pcSliceEncoder->getTrQuant()->setFlatScalingList(pcSlice->getSPS()->getChromaFormatIdc());
+    pcSliceEncoder->getTrQuant()->setUseScalingList(false);
+    m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
+    m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
+  }
+  else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_DEFAULT)
+  {
+    pcSlice->setDefaultScalingList ();
+    m_pcEncTop->getSPS()->setScalingListPresentFlag(false);
+    m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
+    pcSliceEncoder->getTrQuant()->setScalingList(pcSlice->getScalingList(), pcSlice->getSPS()->getChromaFormatIdc());
+    pcSliceEncoder->getTrQuant()->setUseScalingList(true);
+  }
+  else if(m_pcEncTop->getUseScalingListId() == SCALING_LIST_FILE_READ)
+  {
+    pcSlice->setDefaultScalingList ();
+    if(pcSlice->getScalingList()->xParseScalingList(m_pcCfg->getScalingListFile()))
+    {
+      Bool bParsedScalingList=false; // Use of boolean so that assertion outputs useful string
+      assert(bParsedScalingList);
+      exit(1);
+    }
+    pcSlice->getScalingList()->checkDcOfMatrix();
+    m_pcEncTop->getSPS()->setScalingListPresentFlag(pcSlice->checkDefaultScalingList());
+    m_pcEncTop->getPPS()->setScalingListPresentFlag(false);
+    pcSliceEncoder->getTrQuant()->setScalingList(pcSlice->getScalingList(), pcSlice->getSPS()->getChromaFormatIdc());
+    pcSliceEncoder->getTrQuant()->setUseScalingList(true);
+  }
+  else
+  {
+    printf("error : ScalingList == %d no support\n",m_pcEncTop->getUseScalingListId());
+    assert(0);
+  }
+
+  if(pcSlice->getSliceType()==B_SLICE&&m_pcCfg->getGOPEntry(iGOPid).m_sliceType=='P')
+  {
+    pcSlice->setSliceType(P_SLICE);
+  }
+  if(pcSlice->getSliceType()==B_SLICE&&m_pcCfg->getGOPEntry(iGOPid).m_sliceType=='I')
+  {
+    pcSlice->setSliceType(I_SLICE);
+  }
+  
+  // Set the nal unit type
+  pcSlice->setNalUnitType(getNalUnitType(pocCurr, m_iLastIDR, isField));
+  if(pcSlice->getTemporalLayerNonReferenceFlag())
+  {
+    if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_TRAIL_R &&
+        !(m_iGopSize == 1 && pcSlice->getSliceType() == I_SLICE))
+      // Add this condition to avoid POC issues with encoder_intra_main.cfg configuration (see #1127 in bug tracker)
+    {
+      pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TRAIL_N);
+    }
+    if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RADL_R)
+    {
+      pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RADL_N);
+    }
+    if(pcSlice->getNalUnitType()==NAL_UNIT_CODED_SLICE_RASL_R)
+    {
+      pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_RASL_N);
+    }
+  }
+
+#if EFFICIENT_FIELD_IRAP
+  if ( pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_W_LP
+    || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_W_RADL
+    || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_N_LP
+    || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_IDR_W_RADL
+    || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_IDR_N_LP
+    || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA )  // IRAP picture
+  {
+    m_associatedIRAPType = pcSlice->getNalUnitType();
+    m_associatedIRAPPOC = pocCurr;
+  }
+  pcSlice->setAssociatedIRAPType(m_associatedIRAPType);
+  pcSlice->setAssociatedIRAPPOC(m_associatedIRAPPOC);
+#endif
+  // Do decoding refresh marking if any
+  pcSlice->decodingRefreshMarking(m_pocCRA, m_bRefreshPending, rcListPic);
+  m_pcEncTop->selectReferencePictureSet(pcSlice, pocCurr, iGOPid);
+  pcSlice->getRPS()->setNumberOfLongtermPictures(0);
+#if !EFFICIENT_FIELD_IRAP
+  if ( pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_W_LP
+    || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_W_RADL
+    || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_BLA_N_LP
+    || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_IDR_W_RADL
+    || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_IDR_N_LP
+    || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA )  // IRAP picture
+  {
+    m_associatedIRAPType = pcSlice->getNalUnitType();
+    m_associatedIRAPPOC = pocCurr;
+  }
+  pcSlice->setAssociatedIRAPType(m_associatedIRAPType);
+  pcSlice->setAssociatedIRAPPOC(m_associatedIRAPPOC);
+#endif
+
+#if ALLOW_RECOVERY_POINT_AS_RAP
+  if ((pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false, m_iLastRecoveryPicPOC, m_pcCfg->getDecodingRefreshType() == 3) != 0) || (pcSlice->isIRAP()) 
+#if EFFICIENT_FIELD_IRAP
+    || (isField && pcSlice->getAssociatedIRAPType() >= NAL_UNIT_CODED_SLICE_BLA_W_LP && pcSlice->getAssociatedIRAPType() <= NAL_UNIT_CODED_SLICE_CRA && pcSlice->getAssociatedIRAPPOC() == pcSlice->getPOC()+1)
+#endif
+    )
+  {
+    pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS(), pcSlice->isIRAP(), m_iLastRecoveryPicPOC, m_pcCfg->getDecodingRefreshType() == 3);
+  }
+#else
+  if ((pcSlice->checkThatAllRefPicsAreAvailable(rcListPic, pcSlice->getRPS(), false) != 0) || (pcSlice->isIRAP()))
+  {
+    pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS(), pcSlice->isIRAP());
+  }
+#endif
+
+  pcSlice->applyReferencePictureSet(rcListPic, pcSlice->getRPS());
+
+  if(pcSlice->getTLayer() > 0 
+    &&  !( pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL_N     // Check if not a leading picture
+        || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL_R
+        || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL_N
+        || pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL_R )
+      )
+  {
+    if(pcSlice->isTemporalLayerSwitchingPoint(rcListPic) || pcSlice->getSPS()->getTemporalIdNestingFlag())
+    {
+      if(pcSlice->getTemporalLayerNonReferenceFlag())
+      {
+        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TSA_N);
+      }
+      else
+      {
+        pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_TSA_R);
+      }
+    }
+    else if(pcSlice->isStepwiseTemporalLayerSwitchingPointCandidate(rcListPic))
+    {
+      Bool isSTSA=true;
+      for(Int ii=iGOPid+1;(ii<m_pcCfg->getGOPSize() && isSTSA==true);ii++)
+      {
+        Int lTid= m_pcCfg->getGOPEntry(ii).m_temporalId;
+        if(lTid==pcSlice->getTLayer())
+        {
+          TComReferencePictureSet* nRPS = pcSlice->getSPS()->getRPSList()->getReferencePictureSet(ii);
+          for(Int jj=0;jj<nRPS->getNumberOfPictures();jj++)
+          {
+            if(nRPS->getUsed(jj))
+            {
+              Int tPoc=m_pcCfg->getGOPEntry(ii).m_POC+nRPS->getDeltaPOC(jj);
+              Int kk=0;
+              for(kk=0;kk<m_pcCfg->getGOPSize();kk++)
+              {
+                if(m_pcCfg->getGOPEntry(kk).m_POC==tPoc)
+                  break;
+              }
+              Int tTid=m_pcCfg->getGOPEntry(kk).m_temporalId;
+              if(tTid >= pcSlice->getTLayer())
+              {
+                isSTSA=false;
+                break;
+              }
+            }
+          }
+        }
+      }
+      if(isSTSA==true)
+      {
+        if(pcSlice->getTemporalLayerNonReferenceFlag())
+        {
+          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_N);
+        }
+        else
+        {
+          pcSlice->setNalUnitType(NAL_UNIT_CODED_SLICE_STSA_R);
+        }
+      }
+    }
+  }
+  arrangeLongtermPicturesInRPS(pcSlice, rcListPic);
+  TComRefPicListModification* refPicListModification = pcSlice->getRefPicListModification();
+  refPicListModification->setRefPicListModificationFlagL0(0);
+  refPicListModification->setRefPicListModificationFlagL1(0);
+  pcSlice->setNumRefIdx(REF_PIC_LIST_0,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
+  pcSlice->setNumRefIdx(REF_PIC_LIST_1,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
+
+#if ADAPTIVE_QP_SELECTION
+  pcSlice->setTrQuant( pcSliceEncoder->getTrQuant() );
+#endif
+
+  //  Set reference list
+  pcSlice->setRefPicList ( rcListPic );
+
+  //  Slice info. refinement
+  if ( (pcSlice->getSliceType() == B_SLICE) && (pcSlice->getNumRefIdx(REF_PIC_LIST_1) == 0) )
+  {
+    pcSlice->setSliceType ( P_SLICE );
+  }
+
+  if (pcSlice->getSliceType() == B_SLICE)
+  {
+    pcSlice->setColFromL0Flag(1-uiColDir);
+    Bool bLowDelay = true;
+    Int  iCurrPOC  = pcSlice->getPOC();
+    Int iRefIdx = 0;
+
+    for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_0) && bLowDelay; iRefIdx++)
+    {
+      if ( pcSlice->getRefPic(REF_PIC_LIST_0, iRefIdx)->getPOC() > iCurrPOC )
+      {
+        bLowDelay = false;
+      }
+    }
+    for (iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(REF_PIC_LIST_1) && bLowDelay; iRefIdx++)
+    {
+      if ( pcSlice->getRefPic(REF_PIC_LIST_1, iRefIdx)->getPOC() > iCurrPOC )
+      {
+        bLowDelay = false;
+      }
+    }
+
+    pcSlice->setCheckLDC(bLowDelay);
+  }
+  else
+  {
+    pcSlice->setCheckLDC(true);
+  }
+
+  uiColDir = 1-uiColDir;
+
+  //-------------------------------------------------------------
+  pcSlice->setRefPOCList();
+
+  pcSlice->setList1IdxToList0Idx();
+
+  if (m_pcEncTop->getTMVPModeId() == 2)
+  {
+    if (iGOPid == 0) // first picture in SOP (i.e. forward B)
+    {
+      pcSlice->setEnableTMVPFlag(0);
+    }
+    else
+    {
+      // Note: pcSlice->getColFromL0Flag() is assumed to be always 0 and getcolRefIdx() is always 0.
+      pcSlice->setEnableTMVPFlag(1);
+    }
+    pcSlice->getSPS()->setTMVPFlagsPresent(1);
+  }
+  else if (m_pcEncTop->getTMVPModeId() == 1)
+  {
+    pcSlice->getSPS()->setTMVPFlagsPresent(1);
+    pcSlice->setEnableTMVPFlag(1);
+  }
+  else
+  {
+    pcSlice->getSPS()->setTMVPFlagsPresent(0);
+    pcSlice->setEnableTMVPFlag(0);
+  }
+  /////////////////////////////////////////////////////////////////////////////////////////////////// Compress a slice
+  //  Slice compression
+  if (m_pcCfg->getUseASR())
+  {
+    pcSliceEncoder->setSearchRange(pcSlice);
+  }
+
+  Bool bGPBcheck=false;
+  if ( pcSlice->getSliceType() == B_SLICE)
+  {
+    if ( pcSlice->getNumRefIdx(RefPicList( 0 ) ) == pcSlice->getNumRefIdx(RefPicList( 1 ) ) )
+    {
+      bGPBcheck=true;
+      Int i;
+      for ( i=0; i < pcSlice->getNumRefIdx(RefPicList( 1 ) ); i++ )
+      {
+        if ( pcSlice->getRefPOC(RefPicList(1), i) != pcSlice->getRefPOC(RefPicList(0), i) )
+        {
+          bGPBcheck=false;
+          break;
+        }
+      }
+    }
+  }
+  if(bGPBcheck)
+  {
+    pcSlice->setMvdL1ZeroFlag(true);
+  }
+  else
+  {
+    pcSlice->setMvdL1ZeroFlag(false);
+  }
+  rpcPic->getSlice(pcSlice->getSliceIdx())->setMvdL1ZeroFlag(pcSlice->getMvdL1ZeroFlag());
+
+  // the CABAC table used while compressing is taken now: with concurrent pictures the PPS may be updated by the
+  // entropy coding of an earlier picture at any time during the compression of this one
+  pcSlice->setEncCABACTableIdx(pcSlice->getPPS()->getEncCABACTableIdx());
+  rpcPic->getSlice(pcSlice->getSliceIdx())->setEncCABACTableIdx(pcSlice->getEncCABACTableIdx());
+
+  rpcPic->getPicSym()->initTiles(pcSlice->getPPS());
+  rpcPic->getPicSym()->initCtuTsRsAddrMaps();
+}
+
+/** Pictures are compressed concurrently unless a coding tool carries state from the compression of one picture into the
+ * preparation of the next one, or modifies shared parameters during the compression: rate control, adaptive QP selection,
+ * DeltaQpRD (uses the shared loop filter), weighted prediction (switches the PPS flags), field coding, SOP description SEI
+ * (NAL unit types of the following pictures) and recovery points as RAP.
+ * \param isField  field coding
+ * \returns true if the pictures of the GOP are compressed by the picture workers
+ */
+Bool TEncGOP::xUseConcurrentPictures( Bool isField )
+{
+  return m_iNumPicWorkers > 1
+      && !isField
+      && !m_pcCfg->getUseRateCtrl()
+#if ADAPTIVE_QP_SELECTION
+      && !m_pcCfg->getUseAdaptQpSelect()
+#endif
+      && m_pcCfg->getDeltaQpRD() == 0
+      && !m_pcCfg->getUseWP()
+      && !m_pcCfg->getWPBiPred()
+      && !m_pcCfg->getSOPDescriptionSEIEnabled()
+      && m_pcCfg->getDecodingRefreshType() != 3;
+}
+
+/** The in-loop filters trail the compression of a picture when its CTU rows are finished from top to bottom and are
+ * compressed only once: a single tile, no DeltaQpRD, and no deblocking parameters derived from the whole picture
+ * (DeblockingFilterMetric). This is for the pictures compressed by the slice encoder of the GOP encoder; the picture
+ * workers filter their pictures themselves under the same conditions, see TEncPicWorker.
+ * \param pcPic  picture to be compressed
+ * \returns true if the picture is deblocked and its SAO statistics are collected while it is compressed
+ */
+Bool TEncGOP::xUseIncrementalLoopFilter( TComPic* pcPic )
+{
+  return m_pcCfg->getIncrementalLoopFilter()
+      && pcPic->getPicSym()->getNumTiles() == 1
+      && m_pcCfg->getDeltaQpRD() == 0
+      && !m_pcCfg->getDeblockingFilterMetric();
+}
+
+/** Set up the incremental in-loop filtering of a picture before it is compressed. With a thread pool, the filter steps
+ * are submitted as tasks that become ready as the CTU rows are compressed; without one, ctuRowCompressed runs them.
+ * \param pcPic  picture to be compressed
+ */
+Void TEncGOP::xStartIncrementalLoopFilter( TComPic* pcPic )
+{
+  const UInt uiNumCtuRows = pcPic->getFrameHeightInCtus();
+
+  m_pcLoopFilter->setCfg( pcPic->getSlice(0)->getPPS()->getLoopFilterAcrossTilesEnabledFlag() );
+
+  m_cIncLFMutex.lock();
+  m_pcIncLFPic            = pcPic;
+  m_abIncLFRowCompressed.assign( uiNumCtuRows, false );
+  m_uiIncLFCompressedRows = 0;
+  m_uiIncLFDoneSteps      = 0;
+  m_cIncLFMutex.unlock();
+
+  if ( m_pcThreadPool )
+  {
+    m_acIncLFSteps.resize( uiNumCtuRows + 2 );
+    for ( UInt uiStep = 0; uiStep < uiNumCtuRows + 2; uiStep++ )
+    {
+      m_acIncLFSteps[uiStep].init( this, uiStep );
+      m_pcThreadPool->submit( &m_acIncLFSteps[uiStep], &m_cIncLFGroup );
+    }
+  }
+}
+
+/** Wait for the last filter steps of the picture, after all of its CTU rows are compressed.
+ */
+Void TEncGOP::xFinishIncrementalLoopFilter()
+{
+  if ( m_pcThreadPool )
+  {
+    m_pcThreadPool->wait( &m_cIncLFGroup );
+  }
+  assert( m_uiIncLFDoneSteps == m_abIncLFRowCompressed.size() + 2 );
+
+  m_cIncLFMutex.lock();
+  m_pcIncLFPic = NULL;
+  m_cIncLFMutex.unlock();
+}
+
+/** \param iPOCLast     POC of the last received picture
+ * \param iNumPicRcvd  number of received pictures
+ * \param iGOPid       index of the picture in the GOP
+ * \param isField      field coding
+ * \param iTimeOffset  returns the position of the picture in the GOP
+ * \returns the POC of the picture with index iGOPid
+ */
+Int TEncGOP::xGetPOCCurr( Int iPOCLast, Int iNumPicRcvd, Int iGOPid, Bool isField, Int& iTimeOffset )
+{
+  Int pocCurr;
+
+  if(iPOCLast == 0) //case first frame or first top field
+  {
+    pocCurr=0;
+    iTimeOffset = 1;
+  }
+  else if(iPOCLast == 1 && isField) //case first bottom field, just like the first frame, the poc computation is not right anymore, we set the right value
+  {
+    pocCurr = 1;
+    iTimeOffset = 1;
+  }
+  else
+  {
+    pocCurr = iPOCLast - iNumPicRcvd + m_pcCfg->getGOPEntry(iGOPid).m_POC - ((isField && m_iGopSize>1) ? 1:0);
+    iTimeOffset = m_pcCfg->getGOPEntry(iGOPid).m_POC;
+  }
+  return pocCurr;
+}
+
 Void TEncGOP::xInitGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Bool isField )
 {
   assert( iNumPicRcvd > 0 );
@@ -2241,7 +2560,7 @@ static const Char* nalUnitTypeToString(NalUnitType type)
 }
 #endif
 
-Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit& accessUnit, Double dEncTime, const InputColourSpaceConversion conversion, const Bool printFrameMSE )
+Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit& accessUnit, Double dEncTime, const InputColourSpaceConversion conversion, const Bool printFrameMSE, const Bool bReferenced )
 {
   Double  dPSNR[MAX_NUM_COMPONENT];
 
@@ -2328,7 +2647,7 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
   }
 
   Char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!pcSlice->isReferenced()) c += 32;
+  if (!bReferenced) c += 32;
 
 #if ADAPTIVE_QP_SELECTION
   printf("POC %4d TId: %1d ( %c-SLICE, nQP %d QP %d ) %10d bits",
@@ -2825,4 +3144,18 @@ Void TEncGOP::dblMetric( TComPic* pcPic, UInt uiNumSlices )
   free(rowSAD);
 }
 
+// ====================================================================================================================
+// TEncLoopFilterStepTask
+// ====================================================================================================================
+
+Bool TEncLoopFilterStepTask::isReady()
+{
+  return m_pcGOPEncoder->isLoopFilterStepReady( m_uiStep );
+}
+
+Void TEncLoopFilterStepTask::run( Int iThreadIdx )
+{
+  m_pcGOPEncoder->runLoopFilterStep( m_uiStep );
+}
+
 //! \}
@@ -49,6 +49,7 @@
 #include "TLibCommon/AccessUnit.h"
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncSlice.h"
+#include "TEncPicWorker.h"
 #include "TEncEntropy.h"
 #include "TEncCavlc.h"
 #include "TEncSbac.h"
@@ -62,11 +63,27 @@
 //! \{
 
 class TEncTop;
+class TEncGOP;
 
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
 
+/// step of the in-loop filtering that trails the compression of the CTU rows of a picture, run by the thread pool
+class TEncLoopFilterStepTask : public TComTask
+{
+public:
+  TEncLoopFilterStepTask() : m_pcGOPEncoder( NULL ), m_uiStep( 0 ) {}
+
+  Void  init    ( TEncGOP* pcGOPEncoder, UInt uiStep ) { m_pcGOPEncoder = pcGOPEncoder; m_uiStep = uiStep; }
+  Bool  isReady ();
+  Void  run     ( Int iThreadIdx );
+
+private:
+  TEncGOP*    m_pcGOPEncoder;
+  UInt        m_uiStep;
+};
+
 class TEncGOP
 {
 private:
@@ -88,6 +105,9 @@ private:
   TEncTop*                m_pcEncTop;
   TEncCfg*                m_pcCfg;
   TEncSlice*              m_pcSliceEncoder;
+  TComThreadPool*         m_pcThreadPool;                 ///< pool the pictures are compressed with, NULL when running single-threaded
+  TEncPicWorker*          m_pcPicWorkers;                 ///< picture workers for concurrent picture compression, NULL for one picture at a time
+  Int                     m_iNumPicWorkers;               ///< number of picture workers
   TComList<TComPic*>*     m_pcListPic;
 
   TEncEntropy*            m_pcEntropyCoder;
@@ -121,6 +141,16 @@ private:
   Bool                    m_pictureTimingSEIPresentInAU;
   Bool                    m_nestedBufferingPeriodSEIPresentInAU;
   Bool                    m_nestedPictureTimingSEIPresentInAU;
+
+  // in-loop filtering trailing the compression of the CTU rows (IncrementalLoopFilter)
+  TComPic*                m_pcIncLFPic;                   ///< picture filtered while it is compressed, NULL if none; protected by m_cIncLFMutex
+  std::vector<Bool>       m_abIncLFRowCompressed;         ///< per CTU row: the row is compressed; protected by m_cIncLFMutex
+  UInt                    m_uiIncLFCompressedRows;        ///< number of compressed CTU rows, counted from the top; protected by m_cIncLFMutex
+  UInt                    m_uiIncLFDoneSteps;             ///< number of filter steps done; protected by m_cIncLFMutex
+  TComMutex               m_cIncLFMutex;
+  std::vector<TEncLoopFilterStepTask> m_acIncLFSteps;     ///< filter steps of the picture, one per CTU row plus two
+  TComTaskGroup           m_cIncLFGroup;
+
 public:
   TEncGOP();
   virtual ~TEncGOP();
@@ -132,6 +162,7 @@ public:
   Void  compressGOP ( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRec,
                       std::list<AccessUnit>& accessUnitsInGOP, Bool isField, Bool isTff, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE );
   Void  xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, TComOutputBitstream* pcBitstreamRedirect);
+  UInt  compressPicture   ( TComPic* pcPic, TEncSlice* pcSliceEncoder );   ///< compress the slice segments of a prepared picture
 
 
   Int   getGOPSize()          { return  m_iGopSize;  }
@@ -141,6 +172,10 @@ public:
   Void  printOutSummary      ( UInt uiNumAllPicCoded, Bool isField, const Bool printMSEBasedSNR, const Bool printSequenceMSE );
   Void  preLoopFilterPicAll  ( TComPic* pcPic, UInt64& ruiDist );
 
+  Void  ctuRowCompressed       ( TComPic* pcPic, UInt uiCtuRow );   ///< called by the slice encoder when the last CTU of a CTU row is compressed
+  Bool  isLoopFilterStepReady  ( UInt uiStep );                     ///< check whether a step of the incremental in-loop filtering can run
+  Void  runLoopFilterStep      ( UInt uiStep );                     ///< run a step of the incremental in-loop filtering
+
   TEncSlice*  getSliceEncoder()   { return m_pcSliceEncoder; }
   NalUnitType getNalUnitType( Int pocCurr, Int lastIdr, Bool isField );
   Void arrangeLongtermPicturesInRPS(TComSlice *, TComList<TComPic*>& );
@@ -152,8 +187,15 @@ protected:
 
   Void  xInitGOP          ( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Bool isField );
   Void  xGetBuffer        ( TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Int iNumPicRcvd, Int iTimeOffset, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut, Int pocCurr, Bool isField );
-
-  Void  xCalculateAddPSNR          ( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit&, Double dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE );
+  Int   xGetPOCCurr       ( Int iPOCLast, Int iNumPicRcvd, Int iGOPid, Bool isField, Int& iTimeOffset );
+  Void  xPreparePicture   ( Int iPOCLast, Int iNumPicRcvd, Int iGOPid, Int pocCurr, Int iTimeOffset, TComList<TComPic*>& rcListPic,
+                            TComList<TComPicYuv*>& rcListPicYuvRecOut, Bool isField, TEncSlice* pcSliceEncoder, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut );
+  Bool  xUseConcurrentPictures ( Bool isField );
+  Bool  xUseIncrementalLoopFilter    ( TComPic* pcPic );
+  Void  xStartIncrementalLoopFilter  ( TComPic* pcPic );
+  Void  xFinishIncrementalLoopFilter ();
+
+  Void  xCalculateAddPSNR          ( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit&, Double dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE, const Bool bReferenced );
   Void  xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic* pcPicOrgSecondField,
                                      TComPicYuv* pcPicRecFirstField, TComPicYuv* pcPicRecSecondField,
                                      const AccessUnit& accessUnit, Double dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE );
@@ -0,0 +1,287 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncPicWorker.cpp
+    \brief    picture worker used for concurrent picture compression
+*/
+
+#include "TEncPicWorker.h"
+#include "TEncTop.h"
+#include "TEncGOP.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncPicWorker::TEncPicWorker()
+: m_pcGOPEncoder      ( NULL )
+, m_pcEncSAO          ( NULL )
+, m_bFilterCtuRows    ( false )
+, m_bSaoCtuBoundary   ( false )
+, m_uiCompressedRows  ( 0 )
+, m_uiDoneFilterSteps ( 0 )
+, m_bFilterRunning    ( false )
+, m_pcPic             ( NULL )
+, m_pcPicYuvRecOut    ( NULL )
+, m_iBeforeTime       ( 0 )
+, m_uiNumSliceSegments( 0 )
+, m_bReferenced       ( false )
+{
+}
+
+TEncPicWorker::~TEncPicWorker()
+{
+}
+
+/** create the slice encoder of this worker with the same settings as the slice encoder of the encoder. The CTU rows are
+ * filtered by the worker under the conditions of the incremental in-loop filtering of TEncGOP: a single tile and no
+ * deblocking parameters derived from the whole picture (the concurrent pictures already exclude DeltaQpRD).
+ * \param pcEncTop      encoder the settings are taken from
+ * \param pcGOPEncoder  GOP encoder that hands out the pictures
+ */
+Void TEncPicWorker::create( TEncTop* pcEncTop, TEncGOP* pcGOPEncoder )
+{
+  m_pcGOPEncoder    = pcGOPEncoder;
+  m_pcEncSAO        = pcEncTop->getSAO();
+  m_bSaoCtuBoundary = pcEncTop->getSaoCtuBoundary();
+  m_bFilterCtuRows  = pcEncTop->getIncrementalLoopFilter()
+                   && pcEncTop->getNumColumnsMinus1() == 0
+                   && pcEncTop->getNumRowsMinus1() == 0
+                   && !pcEncTop->getDeblockingFilterMetric();
+
+  m_cSliceEncoder.create( pcEncTop->getSourceWidth(), pcEncTop->getSourceHeight(), pcEncTop->getChromaFormatIdc(), g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
+  m_cSliceEncoder.init  ( pcEncTop, this );
+
+  if ( m_bFilterCtuRows )
+  {
+    m_cLoopFilter.create( g_uiMaxCUDepth );
+    if ( pcEncTop->getUseSAO() )
+    {
+      m_cEncSAO.create( pcEncTop->getSourceWidth(), pcEncTop->getSourceHeight(), pcEncTop->getChromaFormatIdc(), g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth,
+                        pcEncTop->getSaoOffsetBitShift( CHANNEL_TYPE_LUMA ), pcEncTop->getSaoOffsetBitShift( CHANNEL_TYPE_CHROMA ) );
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+      m_cEncSAO.createEncData( pcEncTop->getSaoCtuBoundary() );
+#else
+      m_cEncSAO.createEncData();
+#endif
+      m_cSAORDGoOnSbacCoder.init( &m_cSAORDGoOnBinCoderCABAC );
+    }
+  }
+}
+
+Void TEncPicWorker::destroy()
+{
+  m_cSliceEncoder.destroy();
+  if ( m_bFilterCtuRows )
+  {
+    m_cLoopFilter.destroy();
+    m_cEncSAO.destroyEncData();
+    m_cEncSAO.destroy();
+  }
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param pcPic           picture, prepared for the compression with the slice encoder of this worker
+ * \param pcPicYuvRecOut  output buffer of the reconstructed picture
+ * \param iBeforeTime     start of the encoding of the picture
+ */
+Void TEncPicWorker::setPicture( TComPic* pcPic, TComPicYuv* pcPicYuvRecOut, clock_t iBeforeTime )
+{
+  m_pcPic              = pcPic;
+  m_pcPicYuvRecOut     = pcPicYuvRecOut;
+  m_iBeforeTime        = iBeforeTime;
+  m_uiNumSliceSegments = 0;
+  // the following pictures are prepared while this one is in flight: their RPS may mark it as unused for reference
+  // before it is written
+  m_bReferenced        = pcPic->getSlice( 0 )->isReferenced();
+
+  if ( m_bFilterCtuRows )
+  {
+    // the borders are padded with the CTU rows, so that the reference lists of the following pictures do not pad
+    // an unfinished reconstruction
+    pcPic->getPicYuvRec()->setBorderExtension( true );
+#if SAO_ENCODING_CHOICE
+    // the SAO slice on/off decision is taken when the picture is started, from the pictures written so far
+    if ( pcPic->getSlice( 0 )->getSPS()->getUseSAO() )
+    {
+      m_cEncSAO.copyDisabledRate( m_pcEncSAO, -1 );
+    }
+#endif
+  }
+}
+
+/** the picture is started once the reference rows needed by its first CTU row are finished, so that it does not
+ * occupy a thread of the pool while waiting
+ */
+Bool TEncPicWorker::isReady()
+{
+  return m_cSliceEncoder.areReferenceRowsReady( m_pcPic->getSlice( 0 ), 0 );
+}
+
+Void TEncPicWorker::run( Int iThreadIdx )
+{
+  if ( m_bFilterCtuRows )
+  {
+    xStartFilterCtuRows();
+  }
+
+  m_uiNumSliceSegments = m_pcGOPEncoder->compressPicture( m_pcPic, &m_cSliceEncoder );
+
+  if ( m_bFilterCtuRows )
+  {
+    // the last CTU row ran the remaining filter steps
+    assert( m_uiDoneFilterSteps == m_abRowCompressed.size() + 3 );
+    if ( m_pcPic->getSlice( 0 )->getSPS()->getUseSAO() )
+    {
+      m_cEncSAO.finishSAOProcessRows( m_pcPic );
+      m_cSAORDGoOnSbacCoder.setBitstream( NULL );
+    }
+  }
+}
+
+/** Record that a CTU row of the picture is compressed and run the filter steps that can go ahead. Rows may finish out
+ * of order (wavefront rows on several threads), so the steps only use the number of rows compressed without a gap from
+ * the top of the picture. The steps run one at a time, on the thread that finds them ready; a thread that finishes a
+ * row while another one runs the steps leaves the new steps to it.
+ * \param uiCtuRow  CTU row in the picture
+ */
+Void TEncPicWorker::ctuRowCompressed( UInt uiCtuRow )
+{
+  if ( !m_bFilterCtuRows )
+  {
+    return;
+  }
+
+  m_cFilterMutex.lock();
+  const UInt uiNumCtuRows = UInt( m_abRowCompressed.size() );
+  m_abRowCompressed[uiCtuRow] = true;
+  while ( m_uiCompressedRows < uiNumCtuRows && m_abRowCompressed[m_uiCompressedRows] )
+  {
+    m_uiCompressedRows++;
+  }
+  if ( !m_bFilterRunning )
+  {
+    m_bFilterRunning = true;
+    while ( m_uiDoneFilterSteps < uiNumCtuRows + 3 && m_uiCompressedRows >= std::min( m_uiDoneFilterSteps + 2, uiNumCtuRows ) )
+    {
+      const UInt uiStep = m_uiDoneFilterSteps;
+      m_cFilterMutex.unlock();
+      xRunFilterStep( uiStep );
+      m_cFilterMutex.lock();
+      m_uiDoneFilterSteps++;
+    }
+    m_bFilterRunning = false;
+  }
+  m_cFilterMutex.unlock();
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/** set up the filtering of the CTU rows of the picture before it is compressed
+ */
+Void TEncPicWorker::xStartFilterCtuRows()
+{
+  TComSlice* pcSlice = m_pcPic->getSlice( 0 );
+
+  m_cLoopFilter.setCfg( pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag() );
+  if ( pcSlice->getSPS()->getUseSAO() )
+  {
+    m_cSAOBitCounter.resetBits();
+    m_cSAORDGoOnSbacCoder.setBitstream( &m_cSAOBitCounter );
+    m_cEncSAO.initRDOCabacCoder( &m_cSAORDGoOnSbacCoder, pcSlice );
+    m_cEncSAO.startSAOProcessRows( m_pcPic, pcSlice->getLambdas() );
+  }
+
+  m_cFilterMutex.lock();
+  m_abRowCompressed.assign( m_pcPic->getFrameHeightInCtus(), false );
+  m_uiCompressedRows  = 0;
+  m_uiDoneFilterSteps = 0;
+  m_bFilterRunning    = false;
+  m_cFilterMutex.unlock();
+}
+
+/** Step s of the filtering of the CTU rows, in the order of the picture-level filters of TEncGOP: collect the
+ * pre-deblocking SAO statistics of CTU row s, deblock CTU row s-1, collect the SAO statistics of the then final CTU
+ * row s-2 and decide its SAO parameters, then apply the SAO to CTU row s-3, whose neighbouring rows are decided, pad
+ * it and publish it. Step s needs the CTU rows up to s+1 compressed, see TEncGOP::isLoopFilterStepReady().
+ * \param uiStep  filter step, from 0 to the number of CTU rows plus two
+ */
+Void TEncPicWorker::xRunFilterStep( UInt uiStep )
+{
+  TComPic*   pcPic        = m_pcPic;
+  const UInt uiNumCtuRows = pcPic->getFrameHeightInCtus();
+  const Bool bUseSAO      = pcPic->getSlice( 0 )->getSPS()->getUseSAO();
+  const Bool bSaoCtuBoundary = bUseSAO && m_bSaoCtuBoundary;
+
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+  if ( bSaoCtuBoundary && uiStep < uiNumCtuRows )
+  {
+    m_cEncSAO.getPreDBFRowStatistics( pcPic, uiStep );
+  }
+#endif
+  if ( uiStep >= 1 && uiStep <= uiNumCtuRows )
+  {
+    m_cLoopFilter.loopFilterCtuRow( pcPic, uiStep - 1 );
+  }
+  if ( bUseSAO && uiStep >= 2 && uiStep <= uiNumCtuRows + 1 )
+  {
+    m_cEncSAO.getRowStatistics( pcPic, uiStep - 2 );
+    m_cEncSAO.decideCtuRowParams( pcPic, uiStep - 2
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+                                , bSaoCtuBoundary
+#endif
+                                );
+  }
+  if ( uiStep >= 3 )
+  {
+    const UInt uiCtuRow = uiStep - 3;
+    if ( bUseSAO )
+    {
+      m_cEncSAO.offsetDecidedCtuRow( pcPic, uiCtuRow );
+      m_cEncSAO.PCMLFDisableProcessCtuRow( pcPic, uiCtuRow );
+    }
+    const Int iStartY = uiCtuRow * g_uiMaxCUHeight;
+    pcPic->getPicYuvRec()->extendPicBorderRows( iStartY, std::min<Int>( g_uiMaxCUHeight, pcPic->getPicYuvRec()->getHeight( COMPONENT_Y ) - iStartY ) );
+    pcPic->setReconRowProgress( uiCtuRow + 1 );
+  }
+}
+
+//! \}
@@ -0,0 +1,132 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncPicWorker.h
+    \brief    picture worker used for concurrent picture compression (header)
+*/
+
+#ifndef __TENCPICWORKER__
+#define __TENCPICWORKER__
+
+// Include files
+#include <time.h>
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComThreadPool.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComBitCounter.h"
+#include "TEncSlice.h"
+#include "TEncSampleAdaptiveOffset.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+class TEncTop;
+class TEncGOP;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** compresses the slice segments of one picture of a GOP as a task of the thread pool, with a slice encoder of its own.
+ * With IncrementalLoopFilter, the worker also runs the in-loop filters of its picture CTU row by CTU row behind the
+ * compression and publishes the finished rows, so that the following pictures can use them as references before the
+ * picture is complete.
+ */
+class TEncPicWorker : public TComTask
+{
+private:
+  TEncGOP*                m_pcGOPEncoder;                 ///< GOP encoder that prepares the pictures and writes their slices
+  TEncSlice               m_cSliceEncoder;                ///< slice encoder with a private CTU analysis engine
+  TEncSampleAdaptiveOffset* m_pcEncSAO;                   ///< SAO encoder of TEncTop, whose SAO disabled rates are taken over
+
+  // in-loop filtering trailing the compression of the CTU rows
+  Bool                    m_bFilterCtuRows;               ///< the CTU rows are filtered and published while the picture is compressed
+  TComLoopFilter          m_cLoopFilter;                  ///< deblocking filter
+  TEncSampleAdaptiveOffset m_cEncSAO;                     ///< SAO encoder
+  Bool                    m_bSaoCtuBoundary;              ///< SAO statistics of the non-deblocked samples at the CTU boundaries are used (SaoCtuBoundary)
+  TEncSbac                m_cSAORDGoOnSbacCoder;          ///< go-on SBAC coder of the SAO decisions
+#if FAST_BIT_EST
+  TEncBinCABACCounter     m_cSAORDGoOnBinCoderCABAC;      ///< bin coder of the SAO decisions
+#else
+  TEncBinCABAC            m_cSAORDGoOnBinCoderCABAC;      ///< bin coder of the SAO decisions
+#endif
+  TComBitCounter          m_cSAOBitCounter;               ///< bit counter of the SAO decisions
+  std::vector<Bool>       m_abRowCompressed;              ///< per CTU row: the row is compressed; protected by m_cFilterMutex
+  UInt                    m_uiCompressedRows;             ///< number of compressed CTU rows, counted from the top; protected by m_cFilterMutex
+  UInt                    m_uiDoneFilterSteps;            ///< number of filter steps done; protected by m_cFilterMutex
+  Bool                    m_bFilterRunning;               ///< a thread is running the filter steps; protected by m_cFilterMutex
+  TComMutex               m_cFilterMutex;
+
+  // picture being compressed
+  TComPic*                m_pcPic;                        ///< picture
+  TComPicYuv*             m_pcPicYuvRecOut;               ///< output buffer of the reconstructed picture
+  clock_t                 m_iBeforeTime;                  ///< start of the encoding of the picture, for the time output
+  UInt                    m_uiNumSliceSegments;           ///< number of slice segments the picture was split into
+  Bool                    m_bReferenced;                  ///< reference marking of the picture when it was prepared, for the log output
+  TComTaskGroup           m_cTaskGroup;                   ///< group the picture task is submitted with
+
+public:
+  TEncPicWorker();
+  virtual ~TEncPicWorker();
+
+  Void  create            ( TEncTop* pcEncTop, TEncGOP* pcGOPEncoder );
+  Void  destroy           ();
+
+  /// set the picture prepared by the GOP encoder, to be compressed when the worker is submitted to the pool
+  Void  setPicture        ( TComPic* pcPic, TComPicYuv* pcPicYuvRecOut, clock_t iBeforeTime );
+
+  Bool  isReady           ();
+  Void  run               ( Int iThreadIdx );
+
+  /// called by the slice encoder when the last CTU of a CTU row is compressed, may be called by several threads
+  Void  ctuRowCompressed  ( UInt uiCtuRow );
+
+  TEncSlice*              getSliceEncoder       () { return &m_cSliceEncoder;     }
+  TEncSampleAdaptiveOffset* getSAO              () { return &m_cEncSAO;           }
+  Bool                    filtersCtuRows        () const { return m_bFilterCtuRows;     }
+  TComTaskGroup*          getTaskGroup          () { return &m_cTaskGroup;        }
+  TComPic*                getPic                () { return m_pcPic;              }
+  TComPicYuv*             getPicYuvRecOut       () { return m_pcPicYuvRecOut;     }
+  clock_t                 getBeforeTime         () const { return m_iBeforeTime;        }
+  UInt                    getNumSliceSegments   () const { return m_uiNumSliceSegments; }
+  Bool                    isReferenced          () const { return m_bReferenced;        }
+
+private:
+  Void  xStartFilterCtuRows ();
+  Void  xRunFilterStep      ( UInt uiStep );
+};
+
+//! \}
+
+#endif // __TENCPICWORKER__
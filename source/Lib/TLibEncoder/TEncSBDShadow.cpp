@@ -0,0 +1,153 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncSBDShadow.cpp
+    \brief    statistics of the SBD shadow mode
+*/
+
+#include "TEncSBDShadow.h"
+#include <stdio.h>
+#include <string.h>
+
+//! \ingroup TLibEncoder
+//! \{
+
+static const Char* const s_apchSimLevelNames[TEncSBDShadow::NUM_SIM_LEVELS] = { "high", "medium-high", "medium-low", "low", "intra-high", "intra-medium", "intra-low" };
+
+Void TEncSBDShadow::clear()
+{
+  memset( m_acStats, 0, sizeof( m_acStats ) );
+}
+
+/**
+ * \param eLevel    similarity level of the CTU
+ * \param uiPeriod  one out of uiPeriod CTUs is a shadow CTU, 0 disables the shadow mode
+ * \returns true if the CTU is a shadow CTU
+ */
+Bool TEncSBDShadow::addCtu( SimLevel eLevel, UInt uiPeriod )
+{
+  m_cMutex.lock();
+  UInt uiNumCtus = 0;
+  for ( Int i = 0; i < NUM_SIM_LEVELS; i++ )
+  {
+    uiNumCtus += m_acStats[i].uiNumCtus;
+  }
+  m_acStats[eLevel].uiNumCtus++;
+  m_cMutex.unlock();
+
+  return uiPeriod > 0 && uiNumCtus % uiPeriod == 0;
+}
+
+Void TEncSBDShadow::addShadowResult( SimLevel eLevel, Bool bHit, Bool bSameSplit, Double dFullTime, Double dSBDTime, Double dFullCost, Double dSBDCost )
+{
+  m_cMutex.lock();
+  Stats& rcStats = m_acStats[eLevel];
+  rcStats.uiNumShadow++;
+  rcStats.uiNumHits      += bHit       ? 1 : 0;
+  rcStats.uiNumSameSplit += bSameSplit ? 1 : 0;
+  rcStats.dFullTime      += dFullTime;
+  rcStats.dSBDTime       += dSBDTime;
+  rcStats.dFullCost      += dFullCost;
+  rcStats.dSBDCost       += dSBDCost;
+  m_cMutex.unlock();
+}
+
+/**
+ * \param pchFileName  CSV file to write, the statistics are only printed if NULL
+ * \param uiDER        depth extraction region of the encoding, written to the CSV to tell the runs apart
+ */
+Void TEncSBDShadow::printOut( const Char* pchFileName, UInt uiDER )
+{
+  Stats cTotal;
+  memset( &cTotal, 0, sizeof( cTotal ) );
+  for ( Int i = 0; i < NUM_SIM_LEVELS; i++ )
+  {
+    cTotal.uiNumCtus      += m_acStats[i].uiNumCtus;
+    cTotal.uiNumShadow    += m_acStats[i].uiNumShadow;
+    cTotal.uiNumHits      += m_acStats[i].uiNumHits;
+    cTotal.uiNumSameSplit += m_acStats[i].uiNumSameSplit;
+    cTotal.dFullTime      += m_acStats[i].dFullTime;
+    cTotal.dSBDTime       += m_acStats[i].dSBDTime;
+    cTotal.dFullCost      += m_acStats[i].dFullCost;
+    cTotal.dSBDCost       += m_acStats[i].dSBDCost;
+  }
+
+  printf( "\n\nSBD shadow mode -------------------------------------------------\n" );
+  printf( "\t%-12s %8s %8s %8s %8s %10s %10s\n", "SimLevel", "CTUs", "Shadow", "Hit(%)", "Same(%)", "Saved(%)", "dRD(%)" );
+  for ( Int i = 0; i <= NUM_SIM_LEVELS; i++ )
+  {
+    const Stats& rcStats = i < NUM_SIM_LEVELS ? m_acStats[i] : cTotal;
+    const Double dShadow = rcStats.uiNumShadow ? (Double)rcStats.uiNumShadow : 1.0;
+    printf( "\t%-12s %8d %8d %8.2f %8.2f %10.2f %10.4f\n",
+            i < NUM_SIM_LEVELS ? s_apchSimLevelNames[i] : "all",
+            rcStats.uiNumCtus, rcStats.uiNumShadow,
+            100.0 * rcStats.uiNumHits / dShadow, 100.0 * rcStats.uiNumSameSplit / dShadow,
+            rcStats.dFullTime > 0 ? 100.0 * ( rcStats.dFullTime - rcStats.dSBDTime ) / rcStats.dFullTime : 0.0,
+            rcStats.dFullCost > 0 ? 100.0 * ( rcStats.dSBDCost - rcStats.dFullCost ) / rcStats.dFullCost : 0.0 );
+  }
+
+  if ( pchFileName == NULL )
+  {
+    return;
+  }
+  FILE* pFile = fopen( pchFileName, "wt" );
+  if ( pFile == NULL )
+  {
+    fprintf( stderr, "\nfailed to open SBD shadow statistics file `%s' for writing\n", pchFileName );
+    return;
+  }
+  fprintf( pFile, "DER,SimLevel,CTUs,ShadowCTUs,Hits,HitRate,SameSplit,FullTime,SBDTime,TimeSaved,FullCost,SBDCost,RDCostDelta\n" );
+  for ( Int i = 0; i < NUM_SIM_LEVELS; i++ )
+  {
+    xPrintStats( pFile, s_apchSimLevelNames[i], m_acStats[i], uiDER );
+  }
+  xPrintStats( pFile, "all", cTotal, uiDER );
+  fclose( pFile );
+}
+
+/** write one CSV line: the rates are fractions of the shadow CTUs, the time saved is relative to the full search
+ * time and the RD cost delta is the relative increase of the cost of the shadow CTUs caused by SBD
+ */
+Void TEncSBDShadow::xPrintStats( FILE* pFile, const Char* pchLevel, const Stats& rcStats, UInt uiDER )
+{
+  const Double dShadow = rcStats.uiNumShadow ? (Double)rcStats.uiNumShadow : 1.0;
+  fprintf( pFile, "%d,%s,%d,%d,%d,%f,%d,%f,%f,%f,%f,%f,%f\n",
+           uiDER, pchLevel, rcStats.uiNumCtus, rcStats.uiNumShadow,
+           rcStats.uiNumHits, rcStats.uiNumHits / dShadow, rcStats.uiNumSameSplit,
+           rcStats.dFullTime, rcStats.dSBDTime,
+           rcStats.dFullTime > 0 ? ( rcStats.dFullTime - rcStats.dSBDTime ) / rcStats.dFullTime : 0.0,
+           rcStats.dFullCost, rcStats.dSBDCost,
+           rcStats.dFullCost > 0 ? ( rcStats.dSBDCost - rcStats.dFullCost ) / rcStats.dFullCost : 0.0 );
+}
+
+//! \}
@@ -0,0 +1,116 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncSBDShadow.h
+    \brief    statistics of the SBD shadow mode (header)
+*/
+
+#ifndef __TENCSBDSHADOW__
+#define __TENCSBDSHADOW__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComThread.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** Accuracy of the Similarity Based Decision (SBD), measured by the shadow mode: every SBDShadow-th CTU that SBD
+ * restricts is also compressed with the full depth range, and the two searches are compared per similarity level.
+ * The CU encoders of all threads report to the same object.
+ */
+class TEncSBDShadow
+{
+public:
+  enum SimLevel
+  {
+    SIM_HIGH = 0,
+    SIM_MEDIUM_HIGH,
+    SIM_MEDIUM_LOW,
+    SIM_LOW,
+    SIM_INTRA_HIGH,                               ///< levels of the spatial-only SBD in intra slices
+    SIM_INTRA_MEDIUM,
+    SIM_INTRA_LOW,
+    NUM_SIM_LEVELS
+  };
+
+  TEncSBDShadow() { clear(); }
+
+  Void  clear           ();
+
+  /// count a CTU compressed with SBD, returns true when the CTU is to be compressed with the full depth range as well
+  Bool  addCtu          ( SimLevel eLevel, UInt uiPeriod );
+
+  /** add the comparison of the full search and the SBD restricted search of a shadow CTU
+   * \param eLevel          similarity level of the CTU
+   * \param bHit            all depths selected by the full search were in the SBD range
+   * \param bSameSplit      both searches selected the same CU partitioning
+   * \param dFullTime       wall-clock time of the full search, in seconds
+   * \param dSBDTime        wall-clock time of the SBD restricted search, in seconds
+   * \param dFullCost       RD cost of the CTU with the full search
+   * \param dSBDCost        RD cost of the CTU with the SBD restricted search
+   */
+  Void  addShadowResult ( SimLevel eLevel, Bool bHit, Bool bSameSplit, Double dFullTime, Double dSBDTime, Double dFullCost, Double dSBDCost );
+
+  /// print the statistics and write them to a CSV file, one line per similarity level and one for all levels
+  Void  printOut        ( const Char* pchFileName, UInt uiDER );
+
+private:
+  struct Stats
+  {
+    UInt    uiNumCtus;                            ///< CTUs compressed with SBD
+    UInt    uiNumShadow;                          ///< CTUs also compressed with the full depth range
+    UInt    uiNumHits;                            ///< shadow CTUs whose best depths were all in the SBD range
+    UInt    uiNumSameSplit;                       ///< shadow CTUs with the same partitioning in both searches
+    Double  dFullTime;
+    Double  dSBDTime;
+    Double  dFullCost;
+    Double  dSBDCost;
+  };
+
+  Void  xPrintStats     ( FILE* pFile, const Char* pchLevel, const Stats& rcStats, UInt uiDER );
+
+  Stats     m_acStats[NUM_SIM_LEVELS];
+  TComMutex m_cMutex;                             ///< protects the statistics
+};
+
+//! \}
+
+#endif // __TENCSBDSHADOW__
@@ -36,6 +36,7 @@
  \brief       estimation part of sample adaptive offset class
  */
 #include "TEncSampleAdaptiveOffset.h"
+#include "TLibCommon/TComSampleAdaptiveOffsetSIMD.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -256,10 +257,14 @@ Void TEncSampleAdaptiveOffset::initRDOCabacCoder(TEncSbac* pcRDGoOnSbacCoder, TC
 
 
 
+/** decide the SAO parameters of a deblocked picture
+ * \param isStatisticsCollected  the statistics of all CTU rows are collected already with getRowStatistics
+ */
 Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
                                          , Bool isPreDBFSamplesUsed
 #endif
+                                         , Bool isStatisticsCollected
                                           )
 {
   TComPicYuv* orgYuv= pPic->getPicYuvOrg();
@@ -271,11 +276,14 @@ Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, con
   srcYuv->extendPicBorder();
 
   //collect statistics
-  getStatistics(m_statData, orgYuv, srcYuv, pPic);
+  if(!isStatisticsCollected)
+  {
+    getStatistics(m_statData, orgYuv, srcYuv, pPic);
+  }
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
   if(isPreDBFSamplesUsed)
   {
-    addPreDBFStatistics(m_statData);
+    addPreDBFStatistics(m_statData, 0, m_numCTUsPic);
   }
 #endif
   //slice on/off
@@ -287,15 +295,96 @@ Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, con
   delete[] reconParams;
 }
 
+/** start the SAO of a picture that is decided and applied CTU row by CTU row, in the order of SAOProcess: the slice
+ * on/off decision is taken first, the CTU decisions follow in raster scan with the RDO coder state carried over.
+ * \param pPic     picture
+ * \param lambdas  lambdas of the picture
+ */
+Void TEncSampleAdaptiveOffset::startSAOProcessRows(TComPic* pPic, const Double *lambdas)
+{
+  memcpy(m_lambda, lambdas, sizeof(m_lambda));
+  decidePicParams(m_rowSliceEnabled, pPic->getSlice(0)->getDepth());
+  m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_PIC_INIT ]);
+  m_rowReconParams.assign(m_numCTUsPic, SAOBlkParam());
+}
+
+/** decide the SAO parameters of one CTU row from its collected statistics, and keep the deblocked samples of the row
+ * for the offsets. The rows are decided in order; the row and the rows above and below have to be deblocked.
+ * \param pPic      picture
+ * \param ctuRow    CTU row
+ */
+Void TEncSampleAdaptiveOffset::decideCtuRowParams(TComPic* pPic, Int ctuRow
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+                                                , Bool isPreDBFSamplesUsed
+#endif
+                                                 )
+{
+  const Int startCtuRsAddr = ctuRow*m_numCTUInWidth;
+  const Int endCtuRsAddr   = startCtuRsAddr + m_numCTUInWidth;
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+  if(isPreDBFSamplesUsed)
+  {
+    addPreDBFStatistics(m_statData, startCtuRsAddr, endCtuRsAddr);
+  }
+#endif
+  decideCtuParams(pPic, m_rowSliceEnabled, m_statData, &m_rowReconParams[0], pPic->getPicSym()->getSAOBlkParam(), startCtuRsAddr, endCtuRsAddr);
+  copyDeblockedCtuRow(pPic, ctuRow);
+}
+
+/** apply the SAO to one CTU row. The CTU rows above, at and below the row have to be decided.
+ * \param pPic      picture
+ * \param ctuRow    CTU row
+ */
+Void TEncSampleAdaptiveOffset::offsetDecidedCtuRow(TComPic* pPic, Int ctuRow)
+{
+  offsetCtuRow(ctuRow, m_tempPicYuv, pPic->getPicYuvRec(), &m_rowReconParams[0], pPic);
+}
+
+/** finish the SAO of a picture processed CTU row by CTU row, after all rows are decided
+ * \param pPic      picture
+ */
+Void TEncSampleAdaptiveOffset::finishSAOProcessRows(TComPic* pPic)
+{
+  updateDisabledRate(pPic, &m_rowReconParams[0]);
+}
+
+#if SAO_ENCODING_CHOICE
+/** take over the SAO disabled rates, which drive the slice on/off decision, of another SAO encoder
+ * \param src           SAO encoder to copy from
+ * \param picTempLayer  temporal layer to copy, -1 for all
+ */
+Void TEncSampleAdaptiveOffset::copyDisabledRate(const TEncSampleAdaptiveOffset* src, Int picTempLayer)
+{
+  for (Int compIdx = 0; compIdx < MAX_NUM_COMPONENT; compIdx++)
+  {
+    for (Int layer = 0; layer < MAX_TLAYER; layer++)
+    {
+      if (picTempLayer < 0 || layer == picTempLayer)
+      {
+        m_saoDisabledRate[compIdx][layer] = src->m_saoDisabledRate[compIdx][layer];
+      }
+    }
+  }
+}
+#endif
+
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
 Void TEncSampleAdaptiveOffset::getPreDBFStatistics(TComPic* pPic)
 {
   getStatistics(m_preDBFstatData, pPic->getPicYuvOrg(), pPic->getPicYuvRec(), pPic, true);
 }
 
-Void TEncSampleAdaptiveOffset::addPreDBFStatistics(SAOStatData*** blkStats)
+/** collect the statistics of the non-deblocked samples of one CTU row, as getPreDBFStatistics does for the picture.
+ * The rows above and below have to be reconstructed and not yet deblocked.
+ */
+Void TEncSampleAdaptiveOffset::getPreDBFRowStatistics(TComPic* pPic, Int ctuRow)
+{
+  getCtuRowStatistics(ctuRow, m_preDBFstatData, pPic->getPicYuvOrg(), pPic->getPicYuvRec(), pPic, true);
+}
+
+Void TEncSampleAdaptiveOffset::addPreDBFStatistics(SAOStatData*** blkStats, Int startCtuRsAddr, Int endCtuRsAddr)
 {
-  for(Int n=0; n< m_numCTUsPic; n++)
+  for(Int n=startCtuRsAddr; n< endCtuRsAddr; n++)
   {
     for(Int compIdx=0; compIdx < MAX_NUM_COMPONENT; compIdx++)
     {
@@ -309,7 +398,54 @@ Void TEncSampleAdaptiveOffset::addPreDBFStatistics(SAOStatData*** blkStats)
 
 #endif
 
+/** collect the statistics of the deblocked samples of one CTU row, for a following SAOProcess with
+ * isStatisticsCollected. The samples of the row and its neighbouring rows have to be deblocked. Only samples inside
+ * the picture are read, so the reconstruction can be used instead of the border-extended copy.
+ */
+Void TEncSampleAdaptiveOffset::getRowStatistics(TComPic* pPic, Int ctuRow)
+{
+  getCtuRowStatistics(ctuRow, m_statData, pPic->getPicYuvOrg(), pPic->getPicYuvRec(), pPic
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+                    , false
+#endif
+                    );
+}
+
 Void TEncSampleAdaptiveOffset::getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+                          , Bool isCalculatePreDeblockSamples
+#endif
+                          )
+{
+  if(m_pcThreadPool == NULL)
+  {
+    for(Int ctuRow = 0; ctuRow < m_numCTUInHeight; ctuRow++)
+    {
+      getCtuRowStatistics(ctuRow, blkStats, orgYuv, srcYuv, pPic
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+                        , isCalculatePreDeblockSamples
+#endif
+                        );
+    }
+    return;
+  }
+
+  //the statistics of each CTU only depend on its own samples and neighbours, collect them row by row in parallel
+  std::vector<TEncSaoStatisticsRowTask> tasks(m_numCTUInHeight);
+  TComTaskGroup group;
+  for(Int ctuRow = 0; ctuRow < m_numCTUInHeight; ctuRow++)
+  {
+    tasks[ctuRow].init(this, ctuRow, blkStats, orgYuv, srcYuv, pPic
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+                     , isCalculatePreDeblockSamples
+#endif
+                     );
+    m_pcThreadPool->submit(&tasks[ctuRow], &group);
+  }
+  m_pcThreadPool->wait(&group);
+}
+
+Void TEncSampleAdaptiveOffset::getCtuRowStatistics(Int ctuRow, SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
                           , Bool isCalculatePreDeblockSamples
 #endif
@@ -319,7 +455,7 @@ Void TEncSampleAdaptiveOffset::getStatistics(SAOStatData*** blkStats, TComPicYuv
 
   const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
 
-  for(Int ctuRsAddr= 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
+  for(Int ctuRsAddr= ctuRow*m_numCTUInWidth; ctuRsAddr < (ctuRow+1)*m_numCTUInWidth; ctuRsAddr++)
   {
     Int yPos   = (ctuRsAddr / m_numCTUInWidth)*m_maxCUHeight;
     Int xPos   = (ctuRsAddr % m_numCTUInWidth)*m_maxCUWidth;
@@ -779,6 +915,9 @@ Void TEncSampleAdaptiveOffset::deriveModeMergeRDO(Int ctuRsAddr, SAOBlkParam* me
 
 Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* reconParams, SAOBlkParam* codedParams)
 {
+  m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_PIC_INIT ]);
+
+#if RD_TEST_SAO_DISABLE_AT_PICTURE_LEVEL
   Bool allBlksDisabled = true;
   const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
   for(Int compId = COMPONENT_Y; compId < numberOfComponents; compId++)
@@ -787,17 +926,52 @@ Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled,
       allBlksDisabled = false;
   }
 
-  m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_PIC_INIT ]);
-
-  SAOBlkParam modeParam;
-  Double minCost, modeCost;
+  Double totalCost = decideCtuParams(pic, sliceEnabled, blkStats, reconParams, codedParams, 0, m_numCTUsPic);
+#else
+  decideCtuParams(pic, sliceEnabled, blkStats, reconParams, codedParams, 0, m_numCTUsPic);
+#endif
 
+  //the offsets only read srcYuv, so they are applied after all decisions (in parallel when there is a thread pool)
+  offsetCtuRows(srcYuv, resYuv, reconParams, pic);
 
 #if RD_TEST_SAO_DISABLE_AT_PICTURE_LEVEL
-  Double totalCost = 0;
+  if (!allBlksDisabled && (totalCost >= 0)) //SAO is not beneficial - disable it
+  {
+    for(Int ctuRsAddr = 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
+    {
+      codedParams[ctuRsAddr].reset();
+    }
+
+    for (UInt componentIndex = 0; componentIndex < MAX_NUM_COMPONENT; componentIndex++)
+    {
+      sliceEnabled[componentIndex] = false;
+    }
+
+    m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_PIC_INIT ]);
+  }
 #endif
 
-  for(Int ctuRsAddr=0; ctuRsAddr< m_numCTUsPic; ctuRsAddr++)
+  updateDisabledRate(pic, reconParams);
+}
+
+/** decide the SAO parameters of a range of CTUs in raster scan, continuing from the state of the RDO coder
+ * \returns the sum of the RD costs of the decided CTUs
+ */
+Double TEncSampleAdaptiveOffset::decideCtuParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, SAOBlkParam* reconParams, SAOBlkParam* codedParams, Int startCtuRsAddr, Int endCtuRsAddr)
+{
+  Bool allBlksDisabled = true;
+  const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
+  for(Int compId = COMPONENT_Y; compId < numberOfComponents; compId++)
+  {
+    if (sliceEnabled[compId])
+      allBlksDisabled = false;
+  }
+
+  SAOBlkParam modeParam;
+  Double minCost, modeCost;
+  Double totalCost = 0;
+
+  for(Int ctuRsAddr=startCtuRsAddr; ctuRsAddr< endCtuRsAddr; ctuRsAddr++)
   {
     if(allBlksDisabled)
     {
@@ -848,36 +1022,24 @@ Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled,
       }
     } //mode
 
-#if RD_TEST_SAO_DISABLE_AT_PICTURE_LEVEL
     totalCost += minCost;
-#endif
 
     m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_NEXT ]);
 
     //apply reconstructed offsets
     reconParams[ctuRsAddr] = codedParams[ctuRsAddr];
     reconstructBlkSAOParam(reconParams[ctuRsAddr], mergeList);
-    offsetCTU(ctuRsAddr, srcYuv, resYuv, reconParams[ctuRsAddr], pic);
   } //ctuRsAddr
 
-#if RD_TEST_SAO_DISABLE_AT_PICTURE_LEVEL
-  if (!allBlksDisabled && (totalCost >= 0)) //SAO is not beneficial - disable it
-  {
-    for(Int ctuRsAddr = 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
-    {
-      codedParams[ctuRsAddr].reset();
-    }
-
-    for (UInt componentIndex = 0; componentIndex < MAX_NUM_COMPONENT; componentIndex++)
-    {
-      sliceEnabled[componentIndex] = false;
-    }
-
-    m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_PIC_INIT ]);
-  }
-#endif
+  return totalCost;
+}
 
+/** update the SAO disabled rate of the temporal layer of the picture from its decided parameters
+ */
+Void TEncSampleAdaptiveOffset::updateDisabledRate(TComPic* pic, SAOBlkParam* reconParams)
+{
 #if SAO_ENCODING_CHOICE
+  const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
   Int picTempLayer = pic->getSlice(0)->getDepth();
   Int numCtusForSAOOff[MAX_NUM_COMPONENT];
 
@@ -915,16 +1077,9 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
 #endif
                         )
 {
-  if(m_lineBufWidth != m_maxCUWidth)
-  {
-    m_lineBufWidth = m_maxCUWidth;
-
-    if (m_signLineBuf1) delete[] m_signLineBuf1; m_signLineBuf1 = NULL;
-    m_signLineBuf1 = new Char[m_lineBufWidth+1];
-
-    if (m_signLineBuf2) delete[] m_signLineBuf2; m_signLineBuf2 = NULL;
-    m_signLineBuf2 = new Char[m_lineBufWidth+1];
-  }
+  // sign line buffers on the stack, so that CTUs can be processed by several threads at the same time
+  Char signLineBuf1[MAX_CU_SIZE+1];
+  Char signLineBuf2[MAX_CU_SIZE+1];
 
   Int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
   Char signLeft, signRight, signDown;
@@ -962,6 +1117,20 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
                                                  ;
 #else
         endX   = isRightAvail ? (width - skipLinesR[typeIdx]): (width - 1);
+#endif
+#if SIMD_X86
+        if ( g_simdLevel >= SIMD_SSE41 )
+        {
+          TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcLine, srcStride, orgLine, orgStride, startX, endX, endY, 1, diff, count );
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+          if ( isCalculatePreDeblockSamples && isBelowAvail )
+          {
+            TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcBlk + endY*srcStride, srcStride, orgBlk + endY*orgStride, orgStride,
+                                                        isLeftAvail ? 0 : 1, isRightAvail ? width : (width -1), skipLinesB[typeIdx], 1, diff, count );
+          }
+#endif
+          break;
+        }
 #endif
         for (y=0; y<endY; y++)
         {
@@ -1010,7 +1179,7 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
       {
         diff +=2;
         count+=2;
-        Char *signUpLine = m_signLineBuf1;
+        Char *signUpLine = signLineBuf1;
 
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
         startX = (!isCalculatePreDeblockSamples) ? 0
@@ -1031,6 +1200,24 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
           srcLine += srcStride;
           orgLine += orgStride;
         }
+#if SIMD_X86
+        if ( g_simdLevel >= SIMD_SSE41 )
+        {
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+          TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcLine, srcStride, orgLine, orgStride, startX, endX, endY - startY, srcStride, diff, count );
+#else
+          TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcLine, srcStride, orgLine, orgStride, 0, endX, endY - startY, srcStride, diff, count );
+#endif
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+          if ( isCalculatePreDeblockSamples && isBelowAvail )
+          {
+            TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcBlk + endY*srcStride, srcStride, orgBlk + endY*orgStride, orgStride,
+                                                        0, width, skipLinesB[typeIdx], srcStride, diff, count );
+          }
+#endif
+          break;
+        }
+#endif
 
         Pel* srcLineAbove = srcLine - srcStride;
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
@@ -1097,8 +1284,8 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
         count+=2;
         Char *signUpLine, *signDownLine, *signTmpLine;
 
-        signUpLine  = m_signLineBuf1;
-        signDownLine= m_signLineBuf2;
+        signUpLine  = signLineBuf1;
+        signDownLine= signLineBuf2;
 
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
@@ -1116,6 +1303,29 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
         endX   = isRightAvail ? (width - skipLinesR[typeIdx]): (width - 1);
 #endif
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+        firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
+        firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
+#else
+        firstLineStartX = isAboveLeftAvail ? 0    : 1;
+        firstLineEndX   = isAboveAvail     ? endX : 1;
+#endif
+#if SIMD_X86
+        if ( g_simdLevel >= SIMD_SSE41 )
+        {
+          // first line and middle lines
+          TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcLine, srcStride, orgLine, orgStride, firstLineStartX, firstLineEndX, 1, srcStride + 1, diff, count );
+          TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcLine + srcStride, srcStride, orgLine + orgStride, orgStride, startX, endX, endY - 1, srcStride + 1, diff, count );
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+          if ( isCalculatePreDeblockSamples && isBelowAvail )
+          {
+            TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcBlk + endY*srcStride, srcStride, orgBlk + endY*orgStride, orgStride,
+                                                        isLeftAvail ? 0 : 1, isRightAvail ? width : (width -1), skipLinesB[typeIdx], srcStride + 1, diff, count );
+          }
+#endif
+          break;
+        }
+#endif
 
         //prepare 2nd line's upper sign
         Pel* srcLineBelow = srcLine + srcStride;
@@ -1126,13 +1336,6 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
 
         //1st line
         Pel* srcLineAbove = srcLine - srcStride;
-#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
-        firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX;
-        firstLineEndX   = (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX;
-#else
-        firstLineStartX = isAboveLeftAvail ? 0    : 1;
-        firstLineEndX   = isAboveAvail     ? endX : 1;
-#endif
         for(x=firstLineStartX; x<firstLineEndX; x++)
         {
           edgeType = sgn(srcLine[x] - srcLineAbove[x-1]) - signUpLine[x+1];
@@ -1197,7 +1400,7 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
       {
         diff +=2;
         count+=2;
-        Char *signUpLine = m_signLineBuf1+1;
+        Char *signUpLine = signLineBuf1+1;
 
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
@@ -1214,17 +1417,6 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
         endX   = isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1);
 #endif
         endY   = isBelowAvail ? (height - skipLinesB[typeIdx]) : (height - 1);
-
-        //prepare 2nd line upper sign
-        Pel* srcLineBelow = srcLine + srcStride;
-        for (x=startX-1; x<endX; x++)
-        {
-          signUpLine[x] = (Char)sgn(srcLineBelow[x] - srcLine[x+1]);
-        }
-
-
-        //first line
-        Pel* srcLineAbove = srcLine - srcStride;
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
         firstLineStartX = (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX)
                                                           : startX
@@ -1236,6 +1428,33 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
         firstLineStartX = isAboveAvail ? startX : endX;
         firstLineEndX   = (!isRightAvail && isAboveRightAvail) ? width : endX;
 #endif
+#if SIMD_X86
+        if ( g_simdLevel >= SIMD_SSE41 )
+        {
+          // first line and middle lines
+          TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcLine, srcStride, orgLine, orgStride, firstLineStartX, firstLineEndX, 1, srcStride - 1, diff, count );
+          TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcLine + srcStride, srcStride, orgLine + orgStride, orgStride, startX, endX, endY - 1, srcStride - 1, diff, count );
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+          if ( isCalculatePreDeblockSamples && isBelowAvail )
+          {
+            TComSampleAdaptiveOffsetSIMD::getEdgeStats( g_simdLevel, srcBlk + endY*srcStride, srcStride, orgBlk + endY*orgStride, orgStride,
+                                                        isLeftAvail ? 0 : 1, isRightAvail ? width : (width -1), skipLinesB[typeIdx], srcStride - 1, diff, count );
+          }
+#endif
+          break;
+        }
+#endif
+
+        //prepare 2nd line upper sign
+        Pel* srcLineBelow = srcLine + srcStride;
+        for (x=startX-1; x<endX; x++)
+        {
+          signUpLine[x] = (Char)sgn(srcLineBelow[x] - srcLine[x+1]);
+        }
+
+
+        //first line
+        Pel* srcLineAbove = srcLine - srcStride;
         for(x=firstLineStartX; x<firstLineEndX; x++)
         {
           edgeType = sgn(srcLine[x] - srcLineAbove[x+1]) - signUpLine[x-1];
@@ -1306,6 +1525,24 @@ Void TEncSampleAdaptiveOffset::getBlkStats(ComponentID compIdx, SAOStatData* sta
 #endif
         endY = isBelowAvail ? (height- skipLinesB[typeIdx]) : height;
         Int shiftBits = g_bitDepth[toChannelType(compIdx)] - NUM_SAO_BO_CLASSES_LOG2;
+#if SIMD_X86
+        if ( g_simdLevel >= SIMD_SSE41 )
+        {
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+          TComSampleAdaptiveOffsetSIMD::getBandStats( g_simdLevel, srcLine, srcStride, orgLine, orgStride, startX, endX, endY, shiftBits, diff, count );
+#else
+          TComSampleAdaptiveOffsetSIMD::getBandStats( g_simdLevel, srcLine, srcStride, orgLine, orgStride, 0, endX, endY, shiftBits, diff, count );
+#endif
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+          if ( isCalculatePreDeblockSamples && isBelowAvail )
+          {
+            TComSampleAdaptiveOffsetSIMD::getBandStats( g_simdLevel, srcBlk + endY*srcStride, srcStride, orgBlk + endY*orgStride, orgStride,
+                                                        0, width, skipLinesB[typeIdx], shiftBits, diff, count );
+          }
+#endif
+          break;
+        }
+#endif
         for (y=0; y< endY; y++)
         {
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
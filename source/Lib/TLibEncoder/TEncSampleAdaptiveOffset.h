@@ -112,19 +112,42 @@ public:
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
                 , Bool isPreDBFSamplesUsed
 #endif
+                , Bool isStatisticsCollected = false
                 );
+  //CTU row by CTU row alternative to SAOProcess, for a picture whose filtered CTU rows are used before it is finished
+  Void startSAOProcessRows(TComPic* pPic, const Double *lambdas);
+  Void decideCtuRowParams(TComPic* pPic, Int ctuRow
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+                        , Bool isPreDBFSamplesUsed
+#endif
+                        );
+  Void offsetDecidedCtuRow(TComPic* pPic, Int ctuRow);
+  Void finishSAOProcessRows(TComPic* pPic);
+  const Bool* getRowSliceEnabled() const { return m_rowSliceEnabled; }
+#if SAO_ENCODING_CHOICE
+  Void copyDisabledRate(const TEncSampleAdaptiveOffset* src, Int picTempLayer);
+#endif
 public: //methods
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
   Void getPreDBFStatistics(TComPic* pPic);
+  Void getPreDBFRowStatistics(TComPic* pPic, Int ctuRow);
 #endif
+  Void getRowStatistics(TComPic* pPic, Int ctuRow);
 private: //methods
   Void getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv,TComPic* pPic
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
                    , Bool isCalculatePreDeblockSamples = false
+#endif
+                   );
+  Void getCtuRowStatistics(Int ctuRow, SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+                   , Bool isCalculatePreDeblockSamples
 #endif
                    );
   Void decidePicParams(Bool* sliceEnabled, Int picTempLayer);
   Void decideBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* reconParams, SAOBlkParam* codedParams);
+  Double decideCtuParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, SAOBlkParam* reconParams, SAOBlkParam* codedParams, Int startCtuRsAddr, Int endCtuRsAddr);
+  Void updateDisabledRate(TComPic* pic, SAOBlkParam* reconParams);
   Void getBlkStats(ComponentID compIdx, SAOStatData* statsDataTypes, Pel* srcBlk, Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height, Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
                   , Bool isCalculatePreDeblockSamples
@@ -137,7 +160,7 @@ private: //methods
   inline Int64 estSaoDist(Int64 count, Int64 offset, Int64 diffSum, Int shift);
   inline Int estIterOffset(Int typeIdx, Int classIdx, Double lambda, Int offsetInput, Int64 count, Int64 diffSum, Int shift, Int bitIncrease, Int64& bestDist, Double& bestCost, Int offsetTh );
 #if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
-  Void addPreDBFStatistics(SAOStatData*** blkStats);
+  Void addPreDBFStatistics(SAOStatData*** blkStats, Int startCtuRsAddr, Int endCtuRsAddr);
 #endif
 private: //members
   //for RDO
@@ -160,6 +183,52 @@ private: //members
 #endif
   Int                    m_skipLinesR[MAX_NUM_COMPONENT][NUM_SAO_NEW_TYPES];
   Int                    m_skipLinesB[MAX_NUM_COMPONENT][NUM_SAO_NEW_TYPES];
+
+  //CTU row by CTU row processing
+  Bool                   m_rowSliceEnabled[MAX_NUM_COMPONENT];
+  std::vector<SAOBlkParam> m_rowReconParams; //[ctu]
+
+  friend class TEncSaoStatisticsRowTask;
+};
+
+/// collection of the SAO statistics of one CTU row, run by the thread pool
+class TEncSaoStatisticsRowTask : public TComTask
+{
+public:
+  TEncSaoStatisticsRowTask() : m_pcSAO(NULL), m_ctuRow(0), m_blkStats(NULL), m_orgYuv(NULL), m_srcYuv(NULL), m_pPic(NULL)
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+  , m_isCalculatePreDeblockSamples(false)
+#endif
+  {}
+  Void init(TEncSampleAdaptiveOffset* pcSAO, Int ctuRow, SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+          , Bool isCalculatePreDeblockSamples
+#endif
+          )
+  {
+    m_pcSAO = pcSAO; m_ctuRow = ctuRow; m_blkStats = blkStats; m_orgYuv = orgYuv; m_srcYuv = srcYuv; m_pPic = pPic;
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+    m_isCalculatePreDeblockSamples = isCalculatePreDeblockSamples;
+#endif
+  }
+  Void run(Int iThreadIdx)
+  {
+    m_pcSAO->getCtuRowStatistics(m_ctuRow, m_blkStats, m_orgYuv, m_srcYuv, m_pPic
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+                               , m_isCalculatePreDeblockSamples
+#endif
+                               );
+  }
+private:
+  TEncSampleAdaptiveOffset* m_pcSAO;
+  Int            m_ctuRow;
+  SAOStatData*** m_blkStats;
+  TComPicYuv*    m_orgYuv;
+  TComPicYuv*    m_srcYuv;
+  TComPic*       m_pPic;
+#if SAO_ENCODE_ALLOW_USE_PREDEBLOCK
+  Bool           m_isCalculatePreDeblockSamples;
+#endif
 };
 
 
@@ -108,7 +108,7 @@ Void TEncSbac::resetEntropy           ()
   Int  iQp              = m_pcSlice->getSliceQp();
   SliceType eSliceType  = m_pcSlice->getSliceType();
 
-  Int  encCABACTableIdx = m_pcSlice->getPPS()->getEncCABACTableIdx();
+  Int  encCABACTableIdx = m_pcSlice->getEncCABACTableIdx();
   if (!m_pcSlice->isIntra() && (encCABACTableIdx==B_SLICE || encCABACTableIdx==P_SLICE) && m_pcSlice->getPPS()->getCabacInitPresentFlag())
   {
     eSliceType = (SliceType) encCABACTableIdx;
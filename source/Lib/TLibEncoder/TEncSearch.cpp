@@ -135,6 +135,8 @@ TEncSearch::TEncSearch()
   m_pcEncCfg                                       = NULL;
   m_pcEntropyCoder                                 = NULL;
   m_pTempPel                                       = NULL;
+  m_pIntraModePred                                 = NULL;
+  m_iRefCtuRowsBelow                               = -1;
   setWpScalingDistParam( NULL, -1, REF_PIC_LIST_X );
 }
 
@@ -149,6 +151,12 @@ TEncSearch::~TEncSearch()
     m_pTempPel = NULL;
   }
 
+  if ( m_pIntraModePred )
+  {
+    delete [] m_pIntraModePred;
+    m_pIntraModePred = NULL;
+  }
+
   if ( m_pcEncCfg )
   {
     const UInt uiNumLayersAllocated = m_pcEncCfg->getQuadtreeTULog2MaxSize()-m_pcEncCfg->getQuadtreeTULog2MinSize()+1;
@@ -248,6 +256,7 @@ Void TEncSearch::init(TEncCfg*      pcEncCfg,
   initTempBuff(cform);
 
   m_pTempPel = new Pel[g_uiMaxCUWidth*g_uiMaxCUHeight];
+  m_pIntraModePred = new Pel[NUM_INTRA_MODE*g_uiMaxCUWidth*g_uiMaxCUHeight];
 
   const UInt uiNumLayersToAllocate = pcEncCfg->getQuadtreeTULog2MaxSize()-pcEncCfg->getQuadtreeTULog2MinSize()+1;
   const UInt uiNumPartitions = 1<<(g_uiMaxCUDepth<<1);
@@ -289,6 +298,43 @@ Void TEncSearch::init(TEncCfg*      pcEncCfg,
   m_tmpYuvPred.create(MAX_CU_SIZE, MAX_CU_SIZE, pcEncCfg->getChromaFormatIdc());
 }
 
+Void TEncSearch::resetIntegerMv2Nx2N()
+{
+  for (UInt uiRefList = 0; uiRefList < NUM_REF_PIC_LIST_01; uiRefList++)
+  {
+    for (Int iRefIdx = 0; iRefIdx < MAX_NUM_REF; iRefIdx++)
+    {
+      m_integerMv2Nx2N[uiRefList][iRefIdx].setZero();
+    }
+  }
+}
+
+/** \param pcCU  CU being compressed
+ * \param rcMv  motion vector
+ * \returns true if the interpolation of the CU with the vector only reads the available CTU rows of the references
+ */
+Bool TEncSearch::isMvAvailable( TComDataCU* pcCU, const TComMv& rcMv )
+{
+  return rcMv.getVer() <= xGetMaxMvVer( pcCU );
+}
+
+/** \param pcCU        CU being compressed
+ * \param pcMvFields   motion of the merge candidate in both lists
+ * \param uhInterDir   prediction direction of the merge candidate
+ * \returns true if the motion compensation of the candidate only reads the available CTU rows of the references
+ */
+Bool TEncSearch::isMergeCandAvailable( TComDataCU* pcCU, const TComMvField* pcMvFields, UChar uhInterDir )
+{
+  for ( UInt uiRefList = 0; uiRefList < NUM_REF_PIC_LIST_01; uiRefList++ )
+  {
+    if ( ( uhInterDir & ( 1 << uiRefList ) ) && !isMvAvailable( pcCU, pcMvFields[uiRefList].getMv() ) )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 #if FASTME_SMOOTHER_MV
 #define FIRSTSEARCHSTOP     1
 #else
@@ -806,7 +852,8 @@ Distortion TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
   Distortion  uiDistBest  = std::numeric_limits<Distortion>::max();
   UInt        uiDirecBest = 0;
 
-  Pel*  piRefPos;
+  Pel*  apiRefPos[9];
+  Distortion auiDist[9];
   Int iRefStride = m_filteredBlock[0][0].getStride(COMPONENT_Y);
 
   m_pcRdCost->setDistParam( pcPatternKey, m_filteredBlock[0][0].getAddr(COMPONENT_Y), iRefStride, 1, m_cDistParam, m_pcEncCfg->getUseHADME() && bAllowUseOfHadamard );
@@ -820,24 +867,28 @@ Distortion TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
 
     Int horVal = cMvTest.getHor() * iFrac;
     Int verVal = cMvTest.getVer() * iFrac;
-    piRefPos = m_filteredBlock[ verVal & 3 ][ horVal & 3 ].getAddr(COMPONENT_Y);
+    apiRefPos[i] = m_filteredBlock[ verVal & 3 ][ horVal & 3 ].getAddr(COMPONENT_Y);
     if ( horVal == 2 && ( verVal & 1 ) == 0 )
     {
-      piRefPos += 1;
+      apiRefPos[i] += 1;
     }
     if ( ( horVal & 1 ) == 0 && verVal == 2 )
     {
-      piRefPos += iRefStride;
+      apiRefPos[i] += iRefStride;
     }
-    cMvTest = pcMvRefine[i];
-    cMvTest += rcMvFrac;
+  }
+
+  // the distortions of the nine positions against the same original block
+  setDistParamComp(COMPONENT_Y);
+  m_cDistParam.bitDepth = g_bitDepth[CHANNEL_TYPE_LUMA];
+  m_pcRdCost->getDistBatch( &m_cDistParam, apiRefPos, 9, auiDist );
 
-    setDistParamComp(COMPONENT_Y);
+  for (UInt i = 0; i < 9; i++)
+  {
+    TComMv cMvTest = pcMvRefine[i];
+    cMvTest += rcMvFrac;
 
-    m_cDistParam.pCur = piRefPos;
-    m_cDistParam.bitDepth = g_bitDepth[CHANNEL_TYPE_LUMA];
-    uiDist = m_cDistParam.DistFunc( &m_cDistParam );
-    uiDist += m_pcRdCost->getCost( cMvTest.getHor(), cMvTest.getVer() );
+    uiDist = auiDist[i] + m_pcRdCost->getCost( cMvTest.getHor(), cMvTest.getVer() );
 
     if ( uiDist < uiDistBest )
     {
@@ -2382,17 +2433,59 @@ TEncSearch::estIntraPredQT(TComDataCU* pcCU,
       const Bool bUseHadamard=pcCU->getCUTransquantBypass(0) == 0;
       m_pcRdCost->setDistParam(distParam, g_bitDepth[CHANNEL_TYPE_LUMA], piOrg, uiStride, piPred, uiStride, puRect.width, puRect.height, bUseHadamard);
       distParam.bApplyWeight = false;
+
+      // without the lossless DPCM, the modes are predicted together, those using the filtered reference samples and
+      // those using the unfiltered ones, and their distortions computed together
+      Distortion auiModeDist[NUM_INTRA_MODE];
+      const Bool bBatchModes = !(pcCU->isRDPCMEnabled(uiAbsPartIdx) && pcCU->getCUTransquantBypass(uiAbsPartIdx));
+      if ( bBatchModes )
+      {
+        DistParam batchDistParam;
+        m_pcRdCost->setDistParam(batchDistParam, g_bitDepth[CHANNEL_TYPE_LUMA], piOrg, uiStride, m_pIntraModePred, puRect.width, puRect.width, puRect.height, bUseHadamard);
+        batchDistParam.bApplyWeight = false;
+
+        for ( Int iFiltered = 0; iFiltered < 2; iFiltered++ )
+        {
+          UInt       auiModes[NUM_INTRA_MODE];
+          Pel*       apiModePred[NUM_INTRA_MODE];
+          Distortion auiDist[NUM_INTRA_MODE];
+          Int        iNumModes = 0;
+          for( Int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++ )
+          {
+            if ( TComPrediction::filteringIntraReferenceSamples(COMPONENT_Y, modeIdx, puRect.width, puRect.height, chFmt, pcCU->getSlice()->getSPS()->getDisableIntraReferenceSmoothing()) == (iFiltered != 0) )
+            {
+              auiModes[iNumModes]    = modeIdx;
+              apiModePred[iNumModes] = m_pIntraModePred + iNumModes*puRect.width*puRect.height;
+              iNumModes++;
+            }
+          }
+          predIntraAngBatch( COMPONENT_Y, auiModes, iNumModes, apiModePred, puRect.width, tuRecurseWithPU, bAboveAvail, bLeftAvail, iFiltered != 0 );
+          m_pcRdCost->getDistBatch( &batchDistParam, apiModePred, iNumModes, auiDist );
+          for ( Int i = 0; i < iNumModes; i++ )
+          {
+            auiModeDist[auiModes[i]] = auiDist[i];
+          }
+        }
+      }
+
       for( Int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++ )
       {
         UInt       uiMode = modeIdx;
         Distortion uiSad  = 0;
 
-        const Bool bUseFilter=TComPrediction::filteringIntraReferenceSamples(COMPONENT_Y, uiMode, puRect.width, puRect.height, chFmt, pcCU->getSlice()->getSPS()->getDisableIntraReferenceSmoothing());
+        if ( bBatchModes )
+        {
+          uiSad = auiModeDist[uiMode];
+        }
+        else
+        {
+          const Bool bUseFilter=TComPrediction::filteringIntraReferenceSamples(COMPONENT_Y, uiMode, puRect.width, puRect.height, chFmt, pcCU->getSlice()->getSPS()->getDisableIntraReferenceSmoothing());
 
-        predIntraAng( COMPONENT_Y, uiMode, piOrg, uiStride, piPred, uiStride, tuRecurseWithPU, bAboveAvail, bLeftAvail, bUseFilter, TComPrediction::UseDPCMForFirstPassIntraEstimation(tuRecurseWithPU, uiMode) );
+          predIntraAng( COMPONENT_Y, uiMode, piOrg, uiStride, piPred, uiStride, tuRecurseWithPU, bAboveAvail, bLeftAvail, bUseFilter, TComPrediction::UseDPCMForFirstPassIntraEstimation(tuRecurseWithPU, uiMode) );
 
-        // use hadamard transform here
-        uiSad+=distParam.DistFunc(&distParam);
+          // use hadamard transform here
+          uiSad+=distParam.DistFunc(&distParam);
+        }
 
         UInt   iModeBits = 0;
 
@@ -3013,6 +3106,10 @@ Void TEncSearch::xMergeEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPUI
   ruiCost = std::numeric_limits<Distortion>::max();
   for( UInt uiMergeCand = 0; uiMergeCand < numValidMergeCand; ++uiMergeCand )
   {
+    if ( !isMergeCandAvailable( pcCU, &cMvFieldNeighbours[2*uiMergeCand], uhInterDirNeighbours[uiMergeCand] ) )
+    {
+      continue;
+    }
     Distortion uiCostCand = std::numeric_limits<Distortion>::max();
     UInt       uiBitsCand = 0;
 
@@ -3256,8 +3353,10 @@ Void TEncSearch::predInterSearch( TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv*
       }
     }
 
-    //  Bi-directional prediction
-    if ( (pcCU->getSlice()->isInterB()) && (pcCU->isBipredRestriction(iPartIdx) == false) )
+    //  Bi-directional prediction (with MvdL1Zero, the list 1 motion is its predictor, which may point below the
+    //  available CTU rows of the reference)
+    if ( (pcCU->getSlice()->isInterB()) && (pcCU->isBipredRestriction(iPartIdx) == false)
+      && ( !pcCU->getSlice()->getMvdL1ZeroFlag() || isMvAvailable( pcCU, aacAMVPInfo[1][bestBiPRefIdxL1].m_acMvCand[bestBiPMvpL1] ) ) )
     {
 
       cMvBi[0] = cMv[0];            cMvBi[1] = cMv[1];
@@ -3529,6 +3628,16 @@ Void TEncSearch::predInterSearch( TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv*
 
       xMergeEstimation( pcCU, pcOrgYuv, iPartIdx, uiMRGInterDir, cMRGMvField, uiMRGIndex, uiMRGCost, cMvFieldNeighbours, uhInterDirNeighbours, numValidMergeCand);
 
+#if AMP_MRG
+      // AMP merge without an available merge candidate: the partitioning is not tested
+      if ( !bTestNormalMC && uiMRGCost == std::numeric_limits<Distortion>::max() )
+      {
+        pcCU->setMergeAMP( false );
+        setWpScalingDistParam( pcCU, -1, REF_PIC_LIST_X );
+        return;
+      }
+#endif
+
       if ( uiMRGCost < uiMECost )
       {
         // set Merge result
@@ -3786,7 +3895,7 @@ Distortion TEncSearch::xGetTemplateCost( TComDataCU* pcCU,
 
   TComPicYuv* pcPicYuvRef = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec();
 
-  pcCU->clipMv( cMvCand );
+  xClipSearchMv( pcCU, cMvCand );
 
   // prediction pattern
   if ( pcCU->getSlice()->getPPS()->getUseWP() && pcCU->getSlice()->getSliceType()==P_SLICE )
@@ -3919,13 +4028,44 @@ Void TEncSearch::xSetSearchRange ( TComDataCU* pcCU, TComMv& cMvPred, Int iSrchR
 
   rcMvSrchRngRB.setHor( cTmpMvPred.getHor() + (iSrchRng << iMvShift) );
   rcMvSrchRngRB.setVer( cTmpMvPred.getVer() + (iSrchRng << iMvShift) );
-  pcCU->clipMv        ( rcMvSrchRngLT );
-  pcCU->clipMv        ( rcMvSrchRngRB );
+  xClipSearchMv       ( pcCU, rcMvSrchRngLT );
+  xClipSearchMv       ( pcCU, rcMvSrchRngRB );
 
   rcMvSrchRngLT >>= iMvShift;
   rcMvSrchRngRB >>= iMvShift;
 }
 
+/** The reference CTU rows up to m_iRefCtuRowsBelow below the CTU row of the CU are available. The vertical motion is
+ * limited so that the interpolation of the whole CU stays above the first unavailable row.
+ * \param pcCU  CU being compressed
+ * \returns the largest vertical motion vector component in quarter samples, MAX_INT without restriction
+ */
+Int TEncSearch::xGetMaxMvVer( TComDataCU* pcCU )
+{
+  if ( m_iRefCtuRowsBelow < 0 )
+  {
+    return MAX_INT;
+  }
+  const Int iCtuRow = pcCU->getCUPelY() / g_uiMaxCUHeight;
+  const Int iLimitY = ( iCtuRow + 1 + m_iRefCtuRowsBelow ) * g_uiMaxCUHeight;
+  if ( iLimitY >= Int( pcCU->getSlice()->getSPS()->getPicHeightInLumaSamples() ) )
+  {
+    return MAX_INT;
+  }
+  const Int iCUBottom = pcCU->getCUPelY() + pcCU->getHeight( 0 ) - 1;
+  return ( iLimitY - 1 - iCUBottom - NTAPS_LUMA ) << 2;
+}
+
+/** clip a motion vector of the search to the picture, and to the available CTU rows of the references
+ * \param pcCU  CU being compressed
+ * \param rcMv  motion vector
+ */
+Void TEncSearch::xClipSearchMv( TComDataCU* pcCU, TComMv& rcMv )
+{
+  pcCU->clipMv( rcMv );
+  rcMv.setVer( std::min( rcMv.getVer(), xGetMaxMvVer( pcCU ) ) );
+}
+
 
 
 
@@ -4042,7 +4182,7 @@ Void TEncSearch::xTZSearch( TComDataCU*  pcCU,
   TZ_SEARCH_CONFIGURATION
 
   UInt uiSearchRange = m_iSearchRange;
-  pcCU->clipMv( rcMv );
+  xClipSearchMv( pcCU, rcMv );
   rcMv >>= 2;
   // init TZSearchStruct
   IntTZSearchStruct cStruct;
@@ -4059,7 +4199,7 @@ Void TEncSearch::xTZSearch( TComDataCU*  pcCU,
     for ( UInt index = 0; index < NUM_MV_PREDICTORS; index++ )
     {
       TComMv cMv = m_acMvPredictors[index];
-      pcCU->clipMv( cMv );
+      xClipSearchMv( pcCU, cMv );
       cMv >>= 2;
       xTZSearchHelp( pcPatternKey, cStruct, cMv.getHor(), cMv.getVer(), 0, 0 );
     }
@@ -4075,7 +4215,7 @@ Void TEncSearch::xTZSearch( TComDataCU*  pcCU,
   {
     TComMv integerMv2Nx2NPred = *pIntegerMv2Nx2NPred;
     integerMv2Nx2NPred <<= 2;
-    pcCU->clipMv( integerMv2Nx2NPred );
+    xClipSearchMv( pcCU, integerMv2Nx2NPred );
     integerMv2Nx2NPred >>= 2;
     xTZSearchHelp(pcPatternKey, cStruct, integerMv2Nx2NPred.getHor(), integerMv2Nx2NPred.getVer(), 0, 0);
 
@@ -4254,7 +4394,7 @@ Void TEncSearch::xTZSearchSelective( TComDataCU*   pcCU,
   Int   iBestY                  = 0;
   Int   iDist                   = 0;
 
-  pcCU->clipMv( rcMv );
+  xClipSearchMv( pcCU, rcMv );
   rcMv >>= 2;
   // init TZSearchStruct
   IntTZSearchStruct cStruct;
@@ -4274,7 +4414,7 @@ Void TEncSearch::xTZSearchSelective( TComDataCU*   pcCU,
     for ( UInt index = 0; index < NUM_MV_PREDICTORS; index++ )
     {
       TComMv cMv = m_acMvPredictors[index];
-      pcCU->clipMv( cMv );
+      xClipSearchMv( pcCU, cMv );
       cMv >>= 2;
       xTZSearchHelp( pcPatternKey, cStruct, cMv.getHor(), cMv.getVer(), 0, 0 );
     }
@@ -4290,7 +4430,7 @@ Void TEncSearch::xTZSearchSelective( TComDataCU*   pcCU,
   {
     TComMv integerMv2Nx2NPred = *pIntegerMv2Nx2NPred;
     integerMv2Nx2NPred <<= 2;
-    pcCU->clipMv( integerMv2Nx2NPred );
+    xClipSearchMv( pcCU, integerMv2Nx2NPred );
     integerMv2Nx2NPred >>= 2;
     xTZSearchHelp(pcPatternKey, cStruct, integerMv2Nx2NPred.getHor(), integerMv2Nx2NPred.getVer(), 0, 0);
 
@@ -114,6 +114,7 @@ protected:
 
   // Misc.
   Pel*            m_pTempPel;
+  Pel*            m_pIntraModePred;                     ///< prediction blocks of the intra modes estimated together
   const UInt*     m_puiDFilter;
   Int             m_iMaxDeltaQP;
 
@@ -123,6 +124,8 @@ protected:
 
   TComMv          m_integerMv2Nx2N[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
 
+  Int             m_iRefCtuRowsBelow;                   ///< CTU rows of the reference pictures available below the current CTU row, -1 if all are
+
 public:
   TEncSearch();
   virtual ~TEncSearch();
@@ -216,6 +219,17 @@ public:
   /// set ME search range
   Void setAdaptiveSearchRange   ( Int iDir, Int iRefIdx, Int iSearchRange) { assert(iDir < MAX_NUM_REF_LIST_ADAPT_SR && iRefIdx<Int(MAX_IDX_ADAPT_SR)); m_aaiAdaptSR[iDir][iRefIdx] = iSearchRange; }
 
+  /// integer MV of the last 2Nx2N search, the start point of the fast search of the next CU
+  const TComMv& getIntegerMv2Nx2N ( RefPicList eRefPicList, Int iRefIdx ) const               { return m_integerMv2Nx2N[eRefPicList][iRefIdx]; }
+  Void  setIntegerMv2Nx2N         ( RefPicList eRefPicList, Int iRefIdx, const TComMv& rcMv ) { m_integerMv2Nx2N[eRefPicList][iRefIdx] = rcMv; }
+  /// zero start points, so that a tile or wavefront row does not depend on the CTUs compressed before it by the same search
+  Void  resetIntegerMv2Nx2N       ();
+
+  /// restrict the motion to the CTU rows of the reference pictures that are finished, see TEncSlice::init
+  Void  setRefCtuRowsBelow        ( Int iRefCtuRowsBelow )                                    { m_iRefCtuRowsBelow = iRefCtuRowsBelow; }
+  Bool  isMvAvailable             ( TComDataCU* pcCU, const TComMv& rcMv );
+  Bool  isMergeCandAvailable      ( TComDataCU* pcCU, const TComMvField* pcMvFields, UChar uhInterDir );
+
   Void xEncPCM    (TComDataCU* pcCU, UInt uiAbsPartIdx, Pel* piOrg, Pel* piPCM, Pel* piPred, Pel* piResi, Pel* piReco, UInt uiStride, UInt uiWidth, UInt uiHeight, const ComponentID compID );
   Void IPCMSearch (TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv* rpcPredYuv, TComYuv* rpcResiYuv, TComYuv* rpcRecoYuv );
 protected:
@@ -409,6 +423,10 @@ protected:
                                     TComMv&      rcMvSrchRngLT,
                                     TComMv&      rcMvSrchRngRB );
 
+  Int  xGetMaxMvVer               ( TComDataCU*  pcCU );
+  Void xClipSearchMv              ( TComDataCU*  pcCU,
+                                    TComMv&      rcMv );
+
   Void xPatternSearchFast         ( TComDataCU*  pcCU,
                                     TComPattern* pcPatternKey,
                                     Pel*         piRefY,
@@ -37,6 +37,7 @@
 
 #include "TEncTop.h"
 #include "TEncSlice.h"
+#include "TEncPicWorker.h"
 #include <math.h>
 
 //! \ingroup TLibEncoder
@@ -54,6 +55,18 @@ TEncSlice::TEncSlice()
   m_pdRdPicLambda = NULL;
   m_pdRdPicQp     = NULL;
   m_piRdPicQp     = NULL;
+
+  m_pcThreadPool           = NULL;
+  m_pcCtuWorkers           = NULL;
+  m_iNumCtuWorkers         = 0;
+  m_pcRowSyncContextStates = NULL;
+  m_puiRowProgress         = NULL;
+  m_uiNumCtuRows           = 0;
+  m_pcParallelPic          = NULL;
+  m_bParallelTiles         = false;
+  m_pcOwnCtuEncoder        = NULL;
+  m_pcPicWorker            = NULL;
+  m_iRefCtuRowsBelow       = -1;
 }
 
 TEncSlice::~TEncSlice()
@@ -75,6 +88,11 @@ Void TEncSlice::create( Int iWidth, Int iHeight, ChromaFormat chromaFormat, UInt
     m_apcPicYuvResi  = new TComPicYuv;
     m_apcPicYuvResi->create( iWidth, iHeight, chromaFormat, iMaxCUWidth, iMaxCUHeight, uhTotalDepth );
   }
+
+  // create storage for parallel wavefront compression
+  m_uiNumCtuRows           = ( iHeight + iMaxCUHeight - 1 ) / iMaxCUHeight;
+  m_pcRowSyncContextStates = new TEncSbac[m_uiNumCtuRows];
+  m_puiRowProgress         = new UInt    [m_uiNumCtuRows];
 }
 
 Void TEncSlice::destroy()
@@ -99,9 +117,35 @@ Void TEncSlice::destroy()
   if ( m_pdRdPicLambda ) { xFree( m_pdRdPicLambda ); m_pdRdPicLambda = NULL; }
   if ( m_pdRdPicQp     ) { xFree( m_pdRdPicQp     ); m_pdRdPicQp     = NULL; }
   if ( m_piRdPicQp     ) { xFree( m_piRdPicQp     ); m_piRdPicQp     = NULL; }
+
+  // free CTU workers and wavefront storage
+  if ( m_pcCtuWorkers )
+  {
+    for ( Int i = 0; i < m_iNumCtuWorkers; i++ )
+    {
+      m_pcCtuWorkers[i].destroy();
+    }
+    delete [] m_pcCtuWorkers;
+    m_pcCtuWorkers   = NULL;
+    m_iNumCtuWorkers = 0;
+  }
+  if ( m_pcRowSyncContextStates ) { delete [] m_pcRowSyncContextStates; m_pcRowSyncContextStates = NULL; }
+  if ( m_puiRowProgress         ) { delete [] m_puiRowProgress;         m_puiRowProgress         = NULL; }
+
+  if ( m_pcOwnCtuEncoder )
+  {
+    m_pcOwnCtuEncoder->destroy();
+    delete m_pcOwnCtuEncoder;
+    m_pcOwnCtuEncoder = NULL;
+  }
 }
 
-Void TEncSlice::init( TEncTop* pcEncTop )
+/**
+ \param  pcEncTop        encoder
+ \param  pcPicWorker     picture worker of this slice encoder, which compresses with a private CTU analysis engine instead
+                         of the one of pcEncTop; NULL for the slice encoder of TEncTop
+ */
+Void TEncSlice::init( TEncTop* pcEncTop, TEncPicWorker* pcPicWorker )
 {
   m_pcCfg             = pcEncTop;
   m_pcListPic         = pcEncTop->getListPic();
@@ -124,6 +168,50 @@ Void TEncSlice::init( TEncTop* pcEncTop )
   m_pdRdPicQp         = (Double*)xMalloc( Double, m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_piRdPicQp         = (Int*   )xMalloc( Int,    m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_pcRateCtrl        = pcEncTop->getRateCtrl();
+
+  // a picture worker compresses its picture concurrently with the other pictures and needs an analysis engine of its own;
+  // the slices are written by the slice encoder of TEncTop, so the entropy coder for writing is not replaced.
+  m_pcPicWorker = pcPicWorker;
+  if ( pcPicWorker )
+  {
+    m_pcOwnCtuEncoder = new TEncCtuWorker;
+    m_pcOwnCtuEncoder->create( pcEncTop );
+    *m_pcOwnCtuEncoder->getRdCost() = *pcEncTop->getRdCost();
+
+    m_pcCuEncoder       = m_pcOwnCtuEncoder->getCuEncoder();
+    m_pcPredSearch      = m_pcOwnCtuEncoder->getPredSearch();
+    m_pcEntropyCoder    = m_pcOwnCtuEncoder->getEntropyCoder();
+    m_pcTrQuant         = m_pcOwnCtuEncoder->getTrQuant();
+    m_pcRdCost          = m_pcOwnCtuEncoder->getRdCost();
+    m_pppcRDSbacCoder   = m_pcOwnCtuEncoder->getRDSbacCoder();
+    m_pcRDGoOnSbacCoder = m_pcOwnCtuEncoder->getRDGoOnSbacCoder();
+  }
+
+  // create one CTU encoder per thread slot of the pool for parallel wavefront or tile compression
+  const Bool bMultipleTiles = m_pcCfg->getNumColumnsMinus1() > 0 || m_pcCfg->getNumRowsMinus1() > 0;
+  m_pcThreadPool = pcEncTop->getThreadPool();
+  if ( m_pcThreadPool && ( m_pcCfg->getWaveFrontsynchro() || bMultipleTiles ) )
+  {
+    m_iNumCtuWorkers = m_pcThreadPool->getNumThreadSlots();
+    m_pcCtuWorkers   = new TEncCtuWorker[m_iNumCtuWorkers];
+    for ( Int i = 0; i < m_iNumCtuWorkers; i++ )
+    {
+      m_pcCtuWorkers[i].create( pcEncTop );
+    }
+  }
+
+  // when the picture worker publishes the filtered CTU rows of its picture, a CTU row only waits for the reference
+  // rows its motion search can reach (search range and interpolation filter margin), and the search is kept within them
+  if ( pcPicWorker && pcPicWorker->filtersCtuRows() )
+  {
+    const Int iSearchRange = std::max( m_pcCfg->getSearchRange(), m_pcCfg->getBipredSearchRange() );
+    m_iRefCtuRowsBelow = ( iSearchRange + NTAPS_LUMA + g_uiMaxCUHeight - 1 ) / g_uiMaxCUHeight;
+    m_pcOwnCtuEncoder->getPredSearch()->setRefCtuRowsBelow( m_iRefCtuRowsBelow );
+    for ( Int i = 0; i < m_iNumCtuWorkers; i++ )
+    {
+      m_pcCtuWorkers[i].getPredSearch()->setRefCtuRowsBelow( m_iRefCtuRowsBelow );
+    }
+  }
 }
 
 
@@ -514,6 +602,10 @@ Void TEncSlice::setSearchRange( TComSlice* pcSlice )
       iRefPOC = pcSlice->getRefPic(e, iRefIdx)->getPOC();
       Int iNewSR = Clip3(8, iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
       m_pcPredSearch->setAdaptiveSearchRange(iDir, iRefIdx, iNewSR);
+      for ( Int i = 0; i < m_iNumCtuWorkers; i++ )
+      {
+        m_pcCtuWorkers[i].getPredSearch()->setAdaptiveSearchRange(iDir, iRefIdx, iNewSR);
+      }
     }
   }
 }
@@ -719,6 +811,19 @@ Void TEncSlice::compressSlice( TComPic* pcPic )
     }
   }
 
+  xWaitForReferenceRows( pcSlice, pcPic->getPicSym()->getCtuTsToRsAddrMap( startCtuTsAddr ) / frameWidthInCtus );
+
+  const Bool bParallelTiles = xUseParallelTiles( pcPic, pcSlice, startCtuTsAddr, boundingCtuTsAddr );
+  if ( bParallelTiles || xUseParallelCtuRows( pcPic, pcSlice ) )
+  {
+    xCompressInParallel( pcPic, pcSlice, startCtuTsAddr, boundingCtuTsAddr, bParallelTiles );
+    xRestoreWPparam( pcSlice );
+    return;
+  }
+
+  // the fast search start points are reset where the parallel paths start a job (slice segment, tile, wavefront row)
+  m_pcPredSearch->resetIntegerMv2Nx2N();
+
   // for every CTU in the slice segment (may terminate sooner if there is a byte limit on the slice-segment)
 
   for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
@@ -733,14 +838,22 @@ Void TEncSlice::compressSlice( TComPic* pcPic )
     const UInt tileXPosInCtus = firstCtuRsAddrOfTile % frameWidthInCtus;
     const UInt ctuXPosInCtus  = ctuRsAddr % frameWidthInCtus;
     
+    if ( ctuXPosInCtus == tileXPosInCtus )
+    {
+      xWaitForReferenceRows( pcSlice, ctuRsAddr / frameWidthInCtus );
+    }
+
     if (ctuRsAddr == firstCtuRsAddrOfTile)
     {
       m_pppcRDSbacCoder[0][CI_CURR_BEST]->resetEntropy();
+      // the motion search of a tile starts afresh as well, as it does when the tiles are compressed in parallel
+      m_pcPredSearch->resetIntegerMv2Nx2N();
     }
     else if ( ctuXPosInCtus == tileXPosInCtus && m_pcCfg->getWaveFrontsynchro())
     {
       // reset and then update contexts to the state at the end of the top-right CTU (if within current slice and tile).
       m_pppcRDSbacCoder[0][CI_CURR_BEST]->resetEntropy();
+      m_pcPredSearch->resetIntegerMv2Nx2N();
       // Sync if the Top-Right is available.
       TComDataCU *pCtuUp = pCtu->getCtuAbove();
       if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
@@ -889,6 +1002,12 @@ Void TEncSlice::compressSlice( TComPic* pcPic )
     m_uiPicTotalBits += pCtu->getTotalBits();
     m_dPicRdCost     += pCtu->getTotalCost();
     m_uiPicDist      += pCtu->getTotalDistortion();
+
+    // the in-loop filters may trail the compression of the CTU rows
+    if ( ctuXPosInCtus + 1 == frameWidthInCtus )
+    {
+      xCtuRowCompressed( pcPic, ctuRsAddr / frameWidthInCtus );
+    }
   }
 
   // store context state at the end of this slice-segment, in case the next slice is a dependent slice and continues using the CABAC contexts.
@@ -903,11 +1022,448 @@ Void TEncSlice::compressSlice( TComPic* pcPic )
   m_pcRDGoOnSbacCoder->setBitstream(NULL); // stop use of tempBitCounter.
 }
 
+/** Compress the CTU rows (wavefront) or the tiles of a slice segment as tasks of the thread pool, with the CTU encoder
+ * of the thread slot each task runs on. The calling thread helps until all tasks are done; the picture statistics and
+ * slice bit counts are the sums over all CTU encoders.
+ \param  pcPic             picture class
+ \param  pcSlice           slice to be compressed
+ \param  startCtuTsAddr    first CTU of the slice segment
+ \param  boundingCtuTsAddr bounding CTU of the slice segment
+ \param  bTiles            distribute whole tiles instead of CTU rows
+ */
+Void TEncSlice::xCompressInParallel( TComPic* pcPic, TComSlice* pcSlice, UInt startCtuTsAddr, UInt boundingCtuTsAddr, Bool bTiles )
+{
+  TComPicSym* pcPicSym = pcPic->getPicSym();
+
+  if ( bTiles )
+  {
+    // tiles: each tile is compressed on its own, starting from the initial contexts. All CTUs are initialised
+    // beforehand, so that the slice and tile checks on CTUs of other tiles do not race with their initialisation.
+    for ( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++ )
+    {
+      const UInt ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap( ctuTsAddr );
+      pcPic->getCtu( ctuRsAddr )->initCtu( pcPic, ctuRsAddr );
+    }
+    m_uiFirstJob = pcPicSym->getTileIdxMap( pcPicSym->getCtuTsToRsAddrMap( startCtuTsAddr ) );
+    m_uiLastJob  = pcPicSym->getTileIdxMap( pcPicSym->getCtuTsToRsAddrMap( boundingCtuTsAddr - 1 ) );
+  }
+  else
+  {
+    // wavefront: the CTU rows are compressed concurrently, each row trailing the row above by two CTUs
+    const UInt frameWidthInCtus = pcPicSym->getFrameWidthInCtus();
+    const UInt firstCtuRow      = startCtuTsAddr / frameWidthInCtus;
+    for ( UInt row = 0; row < m_uiNumCtuRows; row++ )
+    {
+      m_puiRowProgress[row] = row < firstCtuRow ? frameWidthInCtus : 0;
+    }
+    m_uiFirstJob = firstCtuRow;
+    m_uiLastJob  = ( boundingCtuTsAddr - 1 ) / frameWidthInCtus;
+  }
+  m_pcParallelPic               = pcPic;
+  m_uiParallelStartCtuTsAddr    = startCtuTsAddr;
+  m_uiParallelBoundingCtuTsAddr = boundingCtuTsAddr;
+  m_bParallelTiles              = bTiles;
+
+  for ( Int i = 0; i < m_iNumCtuWorkers; i++ )
+  {
+    m_pcCtuWorkers[i].initSlice( pcSlice, m_pcRdCost, m_pcCfg );
+  }
+
+  TComTaskGroup cGroup;
+  m_acCtuJobs.resize( m_uiLastJob + 1 );
+  for ( UInt uiJob = m_uiFirstJob; uiJob <= m_uiLastJob; uiJob++ )
+  {
+    m_acCtuJobs[uiJob].init( this, uiJob );
+    m_pcThreadPool->submit( &m_acCtuJobs[uiJob], &cGroup );
+  }
+  m_pcThreadPool->wait( &cGroup );
+
+  for ( Int i = 0; i < m_iNumCtuWorkers; i++ )
+  {
+    m_uiPicTotalBits += m_pcCtuWorkers[i].getTotalBits();
+    m_dPicRdCost     += m_pcCtuWorkers[i].getTotalCost();
+    m_uiPicDist      += m_pcCtuWorkers[i].getTotalDistortion();
+    pcSlice->setSliceBits( pcSlice->getSliceBits() + m_pcCtuWorkers[i].getWrittenBits() );
+    pcSlice->setSliceSegmentBits( pcSlice->getSliceSegmentBits() + m_pcCtuWorkers[i].getWrittenBits() );
+  }
+}
+
+/** A tile can always be started. A CTU row is started once the reference rows it needs are finished and the row above
+ * has compressed its first two CTUs, so that a row never waits for a row that has not been started yet.
+ \param  uiJob         CTU row or tile index
+ \returns true if the job can be started
+ */
+Bool TEncSlice::isCtuJobReady( UInt uiJob )
+{
+  if ( m_bParallelTiles )
+  {
+    return true;
+  }
+  if ( !areReferenceRowsReady( m_pcParallelPic->getSlice( getSliceIdx() ), uiJob ) )
+  {
+    return false;
+  }
+  if ( uiJob == m_uiFirstJob )
+  {
+    return true;
+  }
+  const UInt requiredProgress = std::min( 2u, m_pcParallelPic->getPicSym()->getFrameWidthInCtus() );
+  m_cRowMutex.lock();
+  const Bool bReady = m_puiRowProgress[uiJob - 1] >= requiredProgress;
+  m_cRowMutex.unlock();
+  return bReady;
+}
+
+/** Compress a CTU row or tile of the slice segment being compressed.
+ \param  iThreadIdx    thread slot of the pool, selects the CTU encoder
+ \param  uiJob         CTU row or tile index
+ */
+Void TEncSlice::compressCtuJob( Int iThreadIdx, UInt uiJob )
+{
+  if ( m_bParallelTiles )
+  {
+    xCompressTile( &m_pcCtuWorkers[iThreadIdx], uiJob );
+  }
+  else
+  {
+    xCompressCtuRow( &m_pcCtuWorkers[iThreadIdx], uiJob );
+  }
+}
+
+/** The parallel path is only taken when the CTUs of different rows do not depend on each other beyond the wavefront
+ * (no tiles, no CTU-level rate control, no slice ends determined by bit counts and no dependent slice segments).
+ \param  pcPic         picture class
+ \param  pcSlice       slice to be compressed
+ \returns true if the CTU rows of the slice can be compressed in parallel
+ */
+Bool TEncSlice::xUseParallelCtuRows( TComPic* pcPic, TComSlice* pcSlice )
+{
+  return m_iNumCtuWorkers > 1
+      && m_pcCfg->getWaveFrontsynchro()
+      && pcPic->getPicSym()->getNumTiles() == 1
+      && !m_pcCfg->getUseRateCtrl()
+#if ADAPTIVE_QP_SELECTION
+      && !m_pcCfg->getUseAdaptQpSelect()
+#endif
+      && pcSlice->getSliceMode() != FIXED_NUMBER_OF_BYTES
+      && pcSlice->getSliceSegmentMode() != FIXED_NUMBER_OF_BYTES
+      && !pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
+}
+
+/** Tiles are compressed in parallel when the slice segment is made of whole tiles and the CTU decisions only use
+ * data of the own tile. SBD and RRSP look at the neighbouring CTUs regardless of tile boundaries, so they keep the
+ * serial path, as do CTU-level rate control, slice ends determined by bit counts and dependent slice segments.
+ \param  pcPic             picture class
+ \param  pcSlice           slice to be compressed
+ \param  startCtuTsAddr    first CTU of the slice segment
+ \param  boundingCtuTsAddr bounding CTU of the slice segment
+ \returns true if the tiles of the slice segment can be compressed in parallel
+ */
+Bool TEncSlice::xUseParallelTiles( TComPic* pcPic, TComSlice* pcSlice, UInt startCtuTsAddr, UInt boundingCtuTsAddr )
+{
+  TComPicSym* pcPicSym = pcPic->getPicSym();
+  if ( m_iNumCtuWorkers <= 1 || pcPicSym->getNumTiles() == 1 )
+  {
+    return false;
+  }
+
+  // the slice segment has to start at the first CTU of a tile and end with the last CTU of a tile
+  const UInt startCtuRsAddr = pcPicSym->getCtuTsToRsAddrMap( startCtuTsAddr );
+  if ( pcPicSym->getTComTile( pcPicSym->getTileIdxMap( startCtuRsAddr ) )->getFirstCtuRsAddr() != startCtuRsAddr )
+  {
+    return false;
+  }
+  if ( boundingCtuTsAddr < pcPicSym->getNumberOfCtusInFrame() )
+  {
+    const UInt boundingCtuRsAddr = pcPicSym->getCtuTsToRsAddrMap( boundingCtuTsAddr );
+    if ( pcPicSym->getTComTile( pcPicSym->getTileIdxMap( boundingCtuRsAddr ) )->getFirstCtuRsAddr() != boundingCtuRsAddr )
+    {
+      return false;
+    }
+  }
+
+  return !m_pcCfg->getUseSBD()
+      && !m_pcCfg->getUseRRSP()
+      && !m_pcCfg->getUseRateCtrl()
+#if ADAPTIVE_QP_SELECTION
+      && !m_pcCfg->getUseAdaptQpSelect()
+#endif
+      && pcSlice->getSliceMode() != FIXED_NUMBER_OF_BYTES
+      && pcSlice->getSliceSegmentMode() != FIXED_NUMBER_OF_BYTES
+      && !pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
+}
+
+/** Compress the CTUs of one CTU row with the encoder of a worker. Before each CTU, waits until the row above has
+ * finished the above-right CTU; the contexts at the start of the row are synchronised as in the serial wavefront.
+ \param  pcWorker      CTU encoder used for the row
+ \param  uiCtuRow      CTU row in the picture
+ */
+Void TEncSlice::xCompressCtuRow( TEncCtuWorker* pcWorker, UInt uiCtuRow )
+{
+  TComPic*        pcPic             = m_pcParallelPic;
+  TComSlice*      pcSlice           = pcPic->getSlice(getSliceIdx());
+  const UInt      frameWidthInCtus  = pcPic->getPicSym()->getFrameWidthInCtus();
+  const UInt      startCtuRsAddr    = std::max( uiCtuRow * frameWidthInCtus, m_uiParallelStartCtuTsAddr );
+  const UInt      boundingCtuRsAddr = std::min( ( uiCtuRow + 1 ) * frameWidthInCtus, m_uiParallelBoundingCtuTsAddr );
+
+  TEncCu*         pcCuEncoder       = pcWorker->getCuEncoder();
+  TEncEntropy*    pcEntropyCoder    = pcWorker->getEntropyCoder();
+  TEncSbac***     pppcRDSbacCoder   = pcWorker->getRDSbacCoder();
+  TEncSbac*       pcRDGoOnSbacCoder = pcWorker->getRDGoOnSbacCoder();
+  TComBitCounter* pcBitCounter      = pcWorker->getBitCounter();
+  TEncBinCABAC*   pRDSbacCoder      = (TEncBinCABAC *) pppcRDSbacCoder[0][CI_CURR_BEST]->getEncBinIf();
+
+  // every row (and the first CTU of the slice) starts from the initial contexts and zero fast search start points, as
+  // in the serial wavefront, so the row does not depend on the rows compressed before by the same worker
+  pcEntropyCoder->setEntropyCoder( pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
+  pcEntropyCoder->resetEntropy   ();
+  pRDSbacCoder->setBinCountingEnableFlag( false );
+  pRDSbacCoder->setBinsCoded( 0 );
+  pcWorker->getPredSearch()->resetIntegerMv2Nx2N();
+
+  xWaitForReferenceRows( pcSlice, uiCtuRow );
+
+  for( UInt ctuRsAddr = startCtuRsAddr; ctuRsAddr < boundingCtuRsAddr; ++ctuRsAddr )
+  {
+    const UInt ctuXPosInCtus = ctuRsAddr % frameWidthInCtus;
+
+    // wait for the above and above-right CTUs
+    if ( uiCtuRow > 0 )
+    {
+      const UInt requiredProgress = std::min( ctuXPosInCtus + 2, frameWidthInCtus );
+      m_cRowMutex.lock();
+      while ( m_puiRowProgress[uiCtuRow - 1] < requiredProgress )
+      {
+        m_cRowProgressCond.wait( m_cRowMutex );
+      }
+      m_cRowMutex.unlock();
+    }
+
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+    pCtu->initCtu( pcPic, ctuRsAddr );
+
+    // update contexts to the state at the end of the top-right CTU (if within current slice)
+    if ( ctuXPosInCtus == 0 && pCtu->getCtuAbove() && frameWidthInCtus > 1 )
+    {
+      TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+      if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+      {
+        pppcRDSbacCoder[0][CI_CURR_BEST]->loadContexts( &m_pcRowSyncContextStates[uiCtuRow - 1] );
+      }
+    }
+
+    // set go-on entropy coder
+    pcEntropyCoder->setEntropyCoder ( pcRDGoOnSbacCoder, pcSlice );
+    pcEntropyCoder->setBitstream( pcBitCounter );
+    pcBitCounter->resetBits();
+    pcRDGoOnSbacCoder->load( pppcRDSbacCoder[0][CI_CURR_BEST] );
+    ((TEncBinCABAC*)pcRDGoOnSbacCoder->getEncBinIf())->setBinCountingEnableFlag(true);
+
+    // run CTU trial encoder
+    pcCuEncoder->compressCtu( pCtu );
+
+    // encode CTU with the decided modes to update the contexts and count the bits
+    pcEntropyCoder->setEntropyCoder ( pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
+    pcEntropyCoder->setBitstream( pcBitCounter );
+    pRDSbacCoder->setBinCountingEnableFlag( true );
+    pppcRDSbacCoder[0][CI_CURR_BEST]->resetBits();
+    pRDSbacCoder->setBinsCoded( 0 );
+
+    pcCuEncoder->encodeCtu( pCtu );
+
+    pRDSbacCoder->setBinCountingEnableFlag( false );
+
+    pcWorker->addCtuStatistics( pCtu, pcEntropyCoder->getNumberOfWrittenBits() );
+
+    // store probabilities of second CTU in line, used by the row below
+    if ( ctuXPosInCtus == 1 )
+    {
+      m_pcRowSyncContextStates[uiCtuRow].loadContexts( pppcRDSbacCoder[0][CI_CURR_BEST] );
+    }
+
+    m_cRowMutex.lock();
+    m_puiRowProgress[uiCtuRow] = ctuXPosInCtus + 1;
+    m_cRowProgressCond.broadcast();
+    m_cRowMutex.unlock();
+    m_pcThreadPool->wakeUp();
+
+    if ( ctuXPosInCtus + 1 == frameWidthInCtus )
+    {
+      xCtuRowCompressed( pcPic, uiCtuRow );
+    }
+  }
+
+  // stop use of the bit counter
+  pppcRDSbacCoder[0][CI_CURR_BEST]->setBitstream(NULL);
+  pcRDGoOnSbacCoder->setBitstream(NULL);
+}
+
+/** Compress the (already initialised) CTUs of one tile with the encoder of a worker. The tile starts from the initial contexts
+ * and zero fast search start points, so it does not depend on the tiles the worker compressed before; with
+ * wavefronts, each CTU row of the tile is synchronised with the second CTU of the row above as in the serial encoder.
+ \param  pcWorker      CTU encoder used for the tile
+ \param  uiTileIdx     tile index in the picture
+ */
+Void TEncSlice::xCompressTile( TEncCtuWorker* pcWorker, UInt uiTileIdx )
+{
+  TComPic*        pcPic             = m_pcParallelPic;
+  TComPicSym*     pcPicSym          = pcPic->getPicSym();
+  TComSlice*      pcSlice           = pcPic->getSlice(getSliceIdx());
+  const TComTile* pcTile            = pcPicSym->getTComTile( uiTileIdx );
+  const UInt      frameWidthInCtus  = pcPicSym->getFrameWidthInCtus();
+  const UInt      tileXPosInCtus    = pcTile->getFirstCtuRsAddr() % frameWidthInCtus;
+  const UInt      startCtuTsAddr    = pcPicSym->getCtuRsToTsAddrMap( pcTile->getFirstCtuRsAddr() );
+  const UInt      boundingCtuTsAddr = startCtuTsAddr + pcTile->getTileWidthInCtus() * pcTile->getTileHeightInCtus();
+  const Bool      wavefrontsEnabled = m_pcCfg->getWaveFrontsynchro();
+
+  TEncCu*         pcCuEncoder       = pcWorker->getCuEncoder();
+  TEncEntropy*    pcEntropyCoder    = pcWorker->getEntropyCoder();
+  TEncSbac***     pppcRDSbacCoder   = pcWorker->getRDSbacCoder();
+  TEncSbac*       pcRDGoOnSbacCoder = pcWorker->getRDGoOnSbacCoder();
+  TComBitCounter* pcBitCounter      = pcWorker->getBitCounter();
+  TEncBinCABAC*   pRDSbacCoder      = (TEncBinCABAC *) pppcRDSbacCoder[0][CI_CURR_BEST]->getEncBinIf();
+
+  pcEntropyCoder->setEntropyCoder( pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
+  pcEntropyCoder->resetEntropy   ();
+  pRDSbacCoder->setBinCountingEnableFlag( false );
+  pRDSbacCoder->setBinsCoded( 0 );
+  pcWorker->getPredSearch()->resetIntegerMv2Nx2N();
+
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+  {
+    const UInt ctuRsAddr     = pcPicSym->getCtuTsToRsAddrMap( ctuTsAddr );
+    const UInt ctuXPosInCtus = ctuRsAddr % frameWidthInCtus;
+
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+    if ( ctuTsAddr != startCtuTsAddr && ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+    {
+      // reset and then update contexts to the state at the end of the top-right CTU (if within current slice and tile).
+      pppcRDSbacCoder[0][CI_CURR_BEST]->resetEntropy();
+      pcWorker->getPredSearch()->resetIntegerMv2Nx2N();
+      if ( ctuXPosInCtus + 1 < frameWidthInCtus )
+      {
+        TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+        if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+        {
+          pppcRDSbacCoder[0][CI_CURR_BEST]->loadContexts( pcWorker->getSyncContextState() );
+        }
+      }
+    }
+
+    // set go-on entropy coder
+    pcEntropyCoder->setEntropyCoder ( pcRDGoOnSbacCoder, pcSlice );
+    pcEntropyCoder->setBitstream( pcBitCounter );
+    pcBitCounter->resetBits();
+    pcRDGoOnSbacCoder->load( pppcRDSbacCoder[0][CI_CURR_BEST] );
+    ((TEncBinCABAC*)pcRDGoOnSbacCoder->getEncBinIf())->setBinCountingEnableFlag(true);
+
+    // run CTU trial encoder
+    pcCuEncoder->compressCtu( pCtu );
+
+    // encode CTU with the decided modes to update the contexts and count the bits
+    pcEntropyCoder->setEntropyCoder ( pppcRDSbacCoder[0][CI_CURR_BEST], pcSlice );
+    pcEntropyCoder->setBitstream( pcBitCounter );
+    pRDSbacCoder->setBinCountingEnableFlag( true );
+    pppcRDSbacCoder[0][CI_CURR_BEST]->resetBits();
+    pRDSbacCoder->setBinsCoded( 0 );
+
+    pcCuEncoder->encodeCtu( pCtu );
+
+    pRDSbacCoder->setBinCountingEnableFlag( false );
+
+    pcWorker->addCtuStatistics( pCtu, pcEntropyCoder->getNumberOfWrittenBits() );
+
+    // store probabilities of second CTU in line into buffer
+    if ( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled )
+    {
+      pcWorker->getSyncContextState()->loadContexts( pppcRDSbacCoder[0][CI_CURR_BEST] );
+    }
+  }
+
+  // stop use of the bit counter
+  pppcRDSbacCoder[0][CI_CURR_BEST]->setBitstream(NULL);
+  pcRDGoOnSbacCoder->setBitstream(NULL);
+}
+
+/** When pictures are compressed concurrently (slice encoder of a picture worker), wait until the reference pictures
+ * are finished down to the CTU rows that the compression of a CTU row can read. If the picture workers publish the
+ * filtered CTU rows of their pictures, these are the rows within the search range and the interpolation filter margin
+ * below the CTU row (the motion search and the merge candidates are kept within them, see TEncSearch); otherwise a
+ * reference is only released as a whole, once its in-loop filters, its border padding and the writing of its slices
+ * are done.
+ \param  pcSlice       slice being compressed
+ \param  uiCtuRow      CTU row about to be compressed
+ */
+Void TEncSlice::xWaitForReferenceRows( TComSlice* pcSlice, UInt uiCtuRow )
+{
+  if ( m_pcOwnCtuEncoder == NULL || pcSlice->isIntra() )
+  {
+    return;
+  }
+
+  for ( Int iList = 0; iList < ( pcSlice->isInterB() ? 2 : 1 ); iList++ )
+  {
+    const RefPicList eRefPicList = RefPicList( iList );
+    for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( eRefPicList ); iRefIdx++ )
+    {
+      TComPic*   pcRefPic     = pcSlice->getRefPic( eRefPicList, iRefIdx );
+      const UInt uiNumCtuRows = pcRefPic->getFrameHeightInCtus();
+      pcRefPic->waitForReconRows( m_iRefCtuRowsBelow < 0 ? uiNumCtuRows : std::min( uiCtuRow + 1 + m_iRefCtuRowsBelow, uiNumCtuRows ) );
+    }
+  }
+}
+
+/** Non-blocking counterpart of xWaitForReferenceRows(), used by the picture and CTU row tasks of the thread pool so
+ * that they are only started once they can go ahead without waiting for the references.
+ \param  pcSlice       slice to be compressed
+ \param  uiCtuRow      CTU row about to be compressed
+ \returns true if the reference rows needed by the CTU row are finished
+ */
+Bool TEncSlice::areReferenceRowsReady( TComSlice* pcSlice, UInt uiCtuRow )
+{
+  if ( m_pcOwnCtuEncoder == NULL || pcSlice->isIntra() )
+  {
+    return true;
+  }
+
+  for ( Int iList = 0; iList < ( pcSlice->isInterB() ? 2 : 1 ); iList++ )
+  {
+    const RefPicList eRefPicList = RefPicList( iList );
+    for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( eRefPicList ); iRefIdx++ )
+    {
+      TComPic*   pcRefPic     = pcSlice->getRefPic( eRefPicList, iRefIdx );
+      const UInt uiNumCtuRows = pcRefPic->getFrameHeightInCtus();
+      if ( pcRefPic->getReconRowProgress() < ( m_iRefCtuRowsBelow < 0 ? uiNumCtuRows : std::min( uiCtuRow + 1 + m_iRefCtuRowsBelow, uiNumCtuRows ) ) )
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/** A CTU row of the picture is compressed: the in-loop filters of the picture worker or of the GOP encoder may trail it.
+ \param  pcPic         picture being compressed
+ \param  uiCtuRow      CTU row in the picture
+ */
+Void TEncSlice::xCtuRowCompressed( TComPic* pcPic, UInt uiCtuRow )
+{
+  if ( m_pcPicWorker )
+  {
+    m_pcPicWorker->ctuRowCompressed( uiCtuRow );
+  }
+  else
+  {
+    m_pcGOPEncoder->ctuRowCompressed( pcPic, uiCtuRow );
+  }
+}
+
 /**
  \param  rpcPic        picture class
  \retval rpcBitstream  bitstream class
  */
-Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded )
+Void TEncSlice::encodeSlice  ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded )
 {
   TComSlice* pcSlice                 = pcPic->getSlice(getSliceIdx());
 
@@ -1221,4 +1777,18 @@ Double TEncSlice::xGetQPValueAccordingToLambda ( Double lambda )
   return 4.2005*log(lambda) + 13.7122;
 }
 
+// ====================================================================================================================
+// TEncCtuJob
+// ====================================================================================================================
+
+Bool TEncCtuJob::isReady()
+{
+  return m_pcSliceEncoder->isCtuJobReady( m_uiJob );
+}
+
+Void TEncCtuJob::run( Int iThreadIdx )
+{
+  m_pcSliceEncoder->compressCtuJob( iThreadIdx, m_uiJob );
+}
+
 //! \}
@@ -43,7 +43,9 @@
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TEncCu.h"
+#include "TEncCtuWorker.h"
 #include "WeightPredAnalysis.h"
 #include "TEncRateCtrl.h"
 
@@ -52,11 +54,28 @@
 
 class TEncTop;
 class TEncGOP;
+class TEncSlice;
+class TEncPicWorker;
 
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
 
+/// CTU row (wavefront) or tile of the slice segment being compressed, run by the thread pool
+class TEncCtuJob : public TComTask
+{
+public:
+  TEncCtuJob() : m_pcSliceEncoder( NULL ), m_uiJob( 0 ) {}
+
+  Void  init    ( TEncSlice* pcSliceEncoder, UInt uiJob ) { m_pcSliceEncoder = pcSliceEncoder; m_uiJob = uiJob; }
+  Bool  isReady ();
+  Void  run     ( Int iThreadIdx );
+
+private:
+  TEncSlice*  m_pcSliceEncoder;
+  UInt        m_uiJob;                                          ///< CTU row or tile index
+};
+
 /// slice encoder class
 class TEncSlice
   : public WeightPredAnalysis
@@ -98,7 +117,36 @@ private:
   TEncSbac                m_lastSliceSegmentEndContextState;    ///< context storage for state at the end of the previous slice-segment (used for dependent slices only).
   TEncSbac                m_entropyCodingSyncContextState;      ///< context storate for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
 
+  // parallel wavefront and tile compression
+  TComThreadPool*         m_pcThreadPool;                       ///< pool the CTU rows and tiles are compressed with, NULL when running single-threaded
+  TEncCtuWorker*          m_pcCtuWorkers;                       ///< one CTU encoder per thread slot of the pool
+  Int                     m_iNumCtuWorkers;                     ///< number of CTU encoders
+  TEncSbac*               m_pcRowSyncContextStates;             ///< context state after the second CTU of each CTU row
+  UInt*                   m_puiRowProgress;                     ///< per CTU row: number of CTUs of the row that are compressed (counted from the left picture edge)
+  UInt                    m_uiNumCtuRows;                       ///< number of CTU rows in the picture
+  TComMutex               m_cRowMutex;                          ///< protects the row progress
+  TComCondition           m_cRowProgressCond;                   ///< signalled whenever a CTU is finished
+  TComPic*                m_pcParallelPic;                      ///< picture whose CTU rows or tiles are being compressed
+  UInt                    m_uiParallelStartCtuTsAddr;           ///< first CTU of the slice segment being compressed
+  UInt                    m_uiParallelBoundingCtuTsAddr;        ///< bounding CTU of the slice segment being compressed
+  Bool                    m_bParallelTiles;                     ///< jobs are tiles (true) or CTU rows (false)
+  UInt                    m_uiFirstJob;                         ///< first CTU row or tile of the slice segment
+  UInt                    m_uiLastJob;                          ///< last CTU row or tile of the slice segment
+  std::vector<TEncCtuJob> m_acCtuJobs;                          ///< tasks of the CTU rows or tiles, indexed by row or tile
+
+  // concurrent picture compression
+  TEncCtuWorker*          m_pcOwnCtuEncoder;                    ///< private CTU analysis engine of a picture worker, NULL for the slice encoder of TEncTop
+  TEncPicWorker*          m_pcPicWorker;                        ///< picture worker this slice encoder belongs to, NULL for the slice encoder of TEncTop
+  Int                     m_iRefCtuRowsBelow;                   ///< CTU rows of the reference pictures needed below the current CTU row, -1 for whole pictures
+
   Void     setUpLambda(TComSlice* slice, const Double dLambda, Int iQP);
+  Bool     xUseParallelCtuRows ( TComPic* pcPic, TComSlice* pcSlice );
+  Bool     xUseParallelTiles   ( TComPic* pcPic, TComSlice* pcSlice, UInt startCtuTsAddr, UInt boundingCtuTsAddr );
+  Void     xCompressInParallel ( TComPic* pcPic, TComSlice* pcSlice, UInt startCtuTsAddr, UInt boundingCtuTsAddr, Bool bTiles );
+  Void     xCompressCtuRow     ( TEncCtuWorker* pcWorker, UInt uiCtuRow );
+  Void     xCompressTile       ( TEncCtuWorker* pcWorker, UInt uiTileIdx );
+  Void     xWaitForReferenceRows ( TComSlice* pcSlice, UInt uiCtuRow );
+  Void     xCtuRowCompressed   ( TComPic* pcPic, UInt uiCtuRow );
   Void     calculateBoundingCtuTsAddrForSlice(UInt &startCtuTSAddrSlice, UInt &boundingCtuTSAddrSlice, Bool &haveReachedTileBoundary, TComPic* pcPic, const Bool encodingSlice, const Int sliceMode, const Int sliceArgument, const UInt uiSliceCurEndCtuTSAddr);
 
 public:
@@ -107,7 +155,7 @@ public:
 
   Void    create              ( Int iWidth, Int iHeight, ChromaFormat chromaFormat, UInt iMaxCUWidth, UInt iMaxCUHeight, UChar uhTotalDepth );
   Void    destroy             ();
-  Void    init                ( TEncTop* pcEncTop );
+  Void    init                ( TEncTop* pcEncTop, TEncPicWorker* pcPicWorker = NULL );
 
   /// preparation of slice encoding (reference marking, QP and lambda)
   Void    initEncSlice        ( TComPic*  pcPic, Int pocLast, Int pocCurr, Int iNumPicRcvd,
@@ -116,6 +164,9 @@ public:
   // compress and encode slice
   Void    precompressSlice    ( TComPic* pcPic                                     );      ///< precompress slice for multi-loop opt.
   Void    compressSlice       ( TComPic* pcPic                                     );      ///< analysis stage of slice
+  Bool    isCtuJobReady       ( UInt uiJob );                                           ///< check whether a CTU row can be started
+  Void    compressCtuJob      ( Int iThreadIdx, UInt uiJob );                           ///< compress a CTU row or tile of the current slice
+  Bool    areReferenceRowsReady ( TComSlice* pcSlice, UInt uiCtuRow );                  ///< check whether the reference rows needed by a CTU row are finished
   Void    calCostSliceI       ( TComPic* pcPic );
   Void    encodeSlice         ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded );
 
@@ -123,6 +174,7 @@ public:
   Void    setSearchRange      ( TComSlice* pcSlice  );                                  ///< set ME range adaptively
 
   TEncCu*        getCUEncoder() { return m_pcCuEncoder; }                        ///< CU encoder
+  TComTrQuant*   getTrQuant()   { return m_pcTrQuant;   }                        ///< transform & quantization used for the compression
   Void    xDetermineStartAndBoundingCtuTsAddr  ( UInt& startCtuTsAddr, UInt& boundingCtuTsAddr, TComPic* pcPic, const Bool encodingSlice );
   UInt    getSliceIdx()         { return m_uiSliceIdx;                    }
   Void    setSliceIdx(UInt i)   { m_uiSliceIdx = i;                       }
@@ -39,6 +39,7 @@
 #include "TEncTop.h"
 #include "TEncPic.h"
 #include "TLibCommon/TComChromaFormat.h"
+#include "TLibCommon/TComSimd.h"
 #if FAST_BIT_EST
 #include "TLibCommon/ContextModel.h"
 #endif
@@ -89,6 +90,16 @@ Void TEncTop::create ()
   // initialize global variables
   initROM();
 
+  // select the SIMD kernels before the classes that use them are initialised
+  initSimdLevel( getSimdLevel() );
+  m_cRdCost.init();
+
+  // the thread that calls the encoder helps the pool, so the pool needs one thread less
+  if ( getNumThreads() > 1 )
+  {
+    m_cThreadPool.create( getNumThreads() - 1 );
+  }
+
   // create processing unit classes
   m_cGOPEncoder.        create( );
   m_cSliceEncoder.      create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, g_uiMaxCUWidth, g_uiMaxCUHeight, g_uiMaxCUDepth );
@@ -110,6 +121,8 @@ Void TEncTop::create ()
 #endif
 
   m_cLoopFilter.create( g_uiMaxCUDepth );
+  m_cLoopFilter.setThreadPool( getThreadPool() );
+  m_cEncSAO.setThreadPool( getThreadPool() );
 
   if ( m_RCEnableRateControl )
   {
@@ -178,6 +191,8 @@ Void TEncTop::destroy ()
   delete [] m_pppcRDSbacCoder;
   delete [] m_pppcBinCoderCABAC;
 
+  m_cThreadPool.destroy();
+
   // destroy ROM
   destroyROM();
 
@@ -442,6 +457,8 @@ Void TEncTop::xGetNewPicBuffer ( TComPic*& rpcPic )
     m_cListPic.pushBack( rpcPic );
   }
   rpcPic->setReconMark (false);
+  rpcPic->getReconRowProgressCounter()->setThreadPool( getThreadPool() );
+  rpcPic->setReconRowProgress( 0 );
 
   m_iPOCLast++;
   m_iNumPicRcvd++;
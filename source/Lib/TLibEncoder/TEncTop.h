@@ -44,6 +44,7 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/AccessUnit.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TLibVideoIO/TVideoIOYuv.h"
 
@@ -111,6 +112,9 @@ private:
 
   TComScalingList         m_scalingList;                 ///< quantization matrix information
   TEncRateCtrl            m_cRateCtrl;                    ///< Rate control class
+  TEncSBDShadow           m_cSBDShadow;                   ///< statistics of the SBD shadow mode
+
+  TComThreadPool          m_cThreadPool;                  ///< thread pool shared by the encoder stages
 
 protected:
   Void  xGetNewPicBuffer  ( TComPic*& rpcPic );           ///< get picture buffer which will be processed
@@ -142,10 +146,13 @@ public:
   TEncGOP*                getGOPEncoder         () { return  &m_cGOPEncoder;          }
   TEncSlice*              getSliceEncoder       () { return  &m_cSliceEncoder;        }
   TEncCu*                 getCuEncoder          () { return  &m_cCuEncoder;           }
+  TEncSBDShadow*          getSBDShadow          () { return  &m_cSBDShadow;           }
   TEncEntropy*            getEntropyCoder       () { return  &m_cEntropyCoder;        }
   TEncCavlc*              getCavlcCoder         () { return  &m_cCavlcCoder;          }
   TEncSbac*               getSbacCoder          () { return  &m_cSbacCoder;           }
   TEncBinCABAC*           getBinCABAC           () { return  &m_cBinCoderCABAC;       }
+  /// thread pool shared by the encoder stages, NULL when running single-threaded
+  TComThreadPool*         getThreadPool         () { return  m_cThreadPool.getNumThreads() > 0 ? &m_cThreadPool : NULL; }
 
   TComRdCost*             getRdCost             () { return  &m_cRdCost;              }
   TEncSbac***             getRDSbacCoder        () { return  m_pppcRDSbacCoder;       }
@@ -173,7 +180,14 @@ public:
                TComList<TComPicYuv*>& rcListPicYuvRecOut,
                std::list<AccessUnit>& accessUnitsOut, Int& iNumEncoded, Bool isTff);
 
-  Void printSummary(Bool isField) { m_cGOPEncoder.printOutSummary (m_uiNumAllPicCoded, isField, m_printMSEBasedSequencePSNR, m_printSequenceMSE); }
+  Void printSummary(Bool isField)
+  {
+    m_cGOPEncoder.printOutSummary (m_uiNumAllPicCoded, isField, m_printMSEBasedSequencePSNR, m_printSequenceMSE);
+    if ( getSBDShadowPeriod() > 0 )
+    {
+      m_cSBDShadow.printOut( getSBDShadowFile(), getR() );
+    }
+  }
 
 };
 